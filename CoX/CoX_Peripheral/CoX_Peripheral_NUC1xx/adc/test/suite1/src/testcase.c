@@ -24,6 +24,10 @@ const tTestCase * const* g_psPatterns[] =  {
     // xcore test
     //
     psPatternXadc, 
+    psPatternXadc2,
+    psPatternXadc3,
+    psPatternXadc4,
+    psPatternXadc5,
 
     //
     // end
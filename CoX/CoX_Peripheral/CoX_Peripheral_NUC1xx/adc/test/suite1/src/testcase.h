@@ -58,6 +58,10 @@ extern const tTestCase * const* g_psPatterns[];
 //
 //*****************************************************************************
 extern const tTestCase * const psPatternXadc[];
+extern const tTestCase * const psPatternXadc2[];
+extern const tTestCase * const psPatternXadc3[];
+extern const tTestCase * const psPatternXadc4[];
+extern const tTestCase * const psPatternXadc5[];
 
 
 
@@ -0,0 +1,295 @@
+//*****************************************************************************
+//
+//! @page xadc_testcase xadc PDMA ring test
+//!
+//! File: @ref xadctest2.c
+//!
+//! <h2>Description</h2>
+//! This module implements the test sequence for the xadc sub component.<br><br>
+//! - \p Board: NUC140 <br><br>
+//! - \p Last-Time(about): 0.5s <br><br>
+//! - \p Phenomenon: Success or failure information will be printed on the UART. <br><br>
+//! .
+//!
+//! <h2>Preconditions</h2>
+//! The module requires the following options:<br><br>
+//! - \p Option-define:
+//! <br>(1)None.<br><br>
+//! - \p Option-hardware:
+//! <br>(1)Connect an USB cable to the development board.<br><br>
+//! - \p Option-OtherModule:
+//! <br>Connect an COM cable to the development board.<br>
+//! .
+//! In case some of the required options are not enabled then some or all tests
+//! may be skipped or result FAILED.<br>
+//!
+//! <h2>Test Cases</h2>
+//! The module contain those sub tests:<br><br>
+//! - \subpage test_xadc_ring
+//! .
+//! \file xadctest2.c
+//! \brief xadc test source file
+//! \brief xadc test header file <br>
+//
+//*****************************************************************************
+
+#include "xhw_types.h"
+#include "xhw_memmap.h"
+#include "xhw_ints.h"
+#include "xhw_adc.h"
+#include "xsysctl.h"
+#include "xgpio.h"
+#include "xadc.h"
+#include "xdma.h"
+#include "xcore.h"
+#include "test.h"
+
+//*****************************************************************************
+//
+//!\page test_xadc_ring test_xadc_ring
+//!
+//!<h2>Description</h2>
+//!Test the continuous scan into a PDMA ring: half and full callbacks, the
+//!per channel blocks and the channel release. <br>
+//!
+//
+//*****************************************************************************
+
+//
+// Channels 0, 1 and the band-gap on 7, eight scans in the ring.
+//
+#define ADC_TEST_RING_FRAMES    8
+#define ADC_TEST_RING_CHANNELS  3
+#define ADC_TEST_RING_CALLS     4
+
+static unsigned long ulRingBuf[ADC_TEST_RING_FRAMES * ADC_TEST_RING_CHANNELS];
+static unsigned short usRingBlock[ADC_TEST_RING_FRAMES *
+                                  ADC_TEST_RING_CHANNELS];
+static tADCRing sRing;
+
+//
+// What the callback saw, in call order, and the samples found different from
+// the ring.
+//
+static unsigned long ulRingEvent[ADC_TEST_RING_CALLS];
+static unsigned long ulRingCount[ADC_TEST_RING_CALLS];
+static void *pvRingBlock[ADC_TEST_RING_CALLS];
+static unsigned long ulRingMismatch;
+static volatile unsigned long ulRingCalls;
+
+//*****************************************************************************
+//
+//! \brief Ring callback of the PDMA ring test, records the call and checks
+//! the block against the half of the ring.
+//!
+//! \return 0.
+//
+//*****************************************************************************
+static unsigned long
+xadcRingCallback(void *pvCBData, unsigned long ulEvent,
+                 unsigned long ulMsgParam, void *pvMsgData)
+{
+    tADCRing *psRing = (tADCRing *)pvCBData;
+    unsigned short *pusBlock = (unsigned short *)pvMsgData;
+    unsigned long i, k, ulHalf;
+
+    if(ulRingCalls < ADC_TEST_RING_CALLS)
+    {
+        ulRingEvent[ulRingCalls] = ulEvent;
+        ulRingCount[ulRingCalls] = ulMsgParam;
+        pvRingBlock[ulRingCalls] = pvMsgData;
+
+        ulHalf = (ulEvent & ADC_RING_EVENT_FULL) ? 1 : 0;
+        for(k = 0; k < psRing->ulChannels; k++)
+        {
+            for(i = 0; i < ulMsgParam; i++)
+            {
+                if(pusBlock[k * ulMsgParam + i] !=
+                   (psRing->pulRing[(ulHalf * ulMsgParam + i) *
+                                    psRing->ulChannels + k] & 0xFFFF))
+                {
+                    ulRingMismatch++;
+                }
+            }
+        }
+    }
+    ulRingCalls++;
+    return 0;
+}
+
+//*****************************************************************************
+//
+//! \brief Get the Test description of xadc005 ring test.
+//!
+//! \return the desccription of the xadc005 test.
+//
+//*****************************************************************************
+static char* xadc005GetTest(void)
+{
+    return "xadc, 005, xadc PDMA ring test";
+}
+
+//*****************************************************************************
+//
+//! \brief something should do before the test execute of xadc005 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xadc005Setup(void)
+{
+    xSPinTypeADC(ADC0, PA0);
+    xSPinTypeADC(ADC1, PA1);
+
+    SysCtlPeripheralReset(SYSCTL_PERIPH_ADC);
+    SysCtlPeripheralClockSourceSet(SYSCTL_PERIPH_ADC_S_EXT12M);
+    SysCtlIPClockDividerSet(SYSCTL_PERIPH_ADC_D | 2);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC);
+
+    SysCtlPeripheralReset(SYSCTL_PERIPH_PDMA);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_PDMA);
+    xIntEnable(INT_PDMA);
+}
+
+//*****************************************************************************
+//
+//! \brief something should do after the test execute of xadc005 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xadc005TearDown(void)
+{
+    ADCRingStop(ADC_BASE);
+    xIntDisable(INT_PDMA);
+    SysCtlPeripheralDisable(SYSCTL_PERIPH_PDMA);
+    SysCtlPeripheralReset(SYSCTL_PERIPH_ADC);
+}
+
+//*****************************************************************************
+//
+//! \brief xadc 005 test of ADCRingStart() and ADCRingStop().
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xadc_ADCRing_test(void)
+{
+    unsigned long i, ulTimeout, ulChannel;
+    xtBoolean bRet;
+
+    ADCConfigure(ADC_BASE, ADC_INPUT_SINGLE, ADC_OP_CONTINUOUS,
+                 ADC_TRIGGER_PROCESSOR);
+    ADCIntDisable(ADC_BASE, ADC_INT_END_CONVERSION);
+    ADCEnable(ADC_BASE);
+
+    sRing.pulRing = ulRingBuf;
+    sRing.pusBlock = usRingBlock;
+    sRing.ulFrames = ADC_TEST_RING_FRAMES;
+    sRing.pfnCallback = xadcRingCallback;
+    sRing.pvCBData = &sRing;
+
+    //
+    // Nothing to scan without a channel.
+    //
+    bRet = ADCRingStart(ADC_BASE, &sRing);
+    TestAssert(bRet == xfalse, "xadc API \"ADCRingStart()\" error!");
+
+    ADCChannelEnable(ADC_BASE, ADC_CHANNEL_0);
+    ADCChannelEnable(ADC_BASE, ADC_CHANNEL_1);
+    ADCChannle7Configure(ADC_BASE, ADC_CH7_INT_BV);
+    ADCChannelEnable(ADC_BASE, ADC_CHANNEL_7);
+
+    ulRingCalls = 0;
+    ulRingMismatch = 0;
+    bRet = ADCRingStart(ADC_BASE, &sRing);
+    TestAssert(bRet == xtrue, "xadc API \"ADCRingStart()\" error!");
+
+    //
+    // Slots in channel order, a second ring is refused while running.
+    //
+    TestAssert(sRing.ulChannels == ADC_TEST_RING_CHANNELS,
+               "xadc API \"ADCRingStart()\" error!");
+    TestAssert((sRing.ucSlot[0] == 0) && (sRing.ucSlot[1] == 1) &&
+               (sRing.ucSlot[7] == 2) &&
+               (sRing.ucSlot[2] == ADC_RING_SLOT_NONE),
+               "xadc API \"ADCRingStart()\" error!");
+    TestAssert(ADCRingStart(ADC_BASE, &sRing) == xfalse,
+               "xadc API \"ADCRingStart()\" error!");
+
+    ulTimeout = 0x100000;
+    while((ulRingCalls < ADC_TEST_RING_CALLS) && (ulTimeout != 0))
+    {
+        ulTimeout--;
+    }
+    ADCRingStop(ADC_BASE);
+    TestAssert(ulTimeout != 0, "xadc API \"ADCRingStart()\" error!");
+
+    //
+    // Halves alternate, each with its own block matching the ring.
+    //
+    for(i = 0; i < ADC_TEST_RING_CALLS; i++)
+    {
+        TestAssert((ulRingEvent[i] & (ADC_RING_EVENT_HALF |
+                                      ADC_RING_EVENT_FULL |
+                                      ADC_RING_EVENT_ERROR)) ==
+                   ((i & 1) ? ADC_RING_EVENT_FULL : ADC_RING_EVENT_HALF),
+                   "xadc API \"ADCRingStart()\" error!");
+        TestAssert(ulRingCount[i] == ADC_TEST_RING_FRAMES / 2,
+                   "xadc API \"ADCRingStart()\" error!");
+        TestAssert(pvRingBlock[i] == usRingBlock + (i & 1) *
+                   ADC_TEST_RING_CHANNELS * ADC_TEST_RING_FRAMES / 2,
+                   "xadc API \"ADCRingStart()\" error!");
+    }
+    TestAssert(ulRingMismatch == 0, "xadc API \"ADCRingStart()\" error!");
+
+    //
+    // The conversion is stopped and the PDMA channel is back in the pool.
+    //
+    TestAssert(!(xHWREG(ADC_BASE + ADC_CR) & (ADC_CR_ADST | ADC_CR_PTEN)),
+               "xadc API \"ADCRingStop()\" error!");
+    TestAssert(PDMAChannelAssignmentGet(sRing.ulDMAChannel) == xfalse,
+               "xadc API \"ADCRingStop()\" error!");
+    ulChannel = PDMAChannelDynamicAssign(xDMA_REQUEST_MEM, xDMA_REQUEST_MEM);
+    TestAssert(ulChannel == sRing.ulDMAChannel,
+               "xadc API \"ADCRingStop()\" error!");
+    PDMAChannelDeAssign(ulChannel);
+
+    //
+    // The ring starts again after a stop.
+    //
+    bRet = ADCRingStart(ADC_BASE, &sRing);
+    TestAssert(bRet == xtrue, "xadc API \"ADCRingStart()\" error!");
+    ADCRingStop(ADC_BASE);
+}
+
+//*****************************************************************************
+//
+//! \brief xadc 005 test execute main body.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xadc005Execute(void)
+{
+    xadc_ADCRing_test();
+}
+
+//
+// xadc PDMA ring test case struct.
+//
+const tTestCase sTestXAdc005Ring = {
+    xadc005GetTest,
+    xadc005Setup,
+    xadc005TearDown,
+    xadc005Execute
+};
+
+//
+// Xadc test suits.
+//
+const tTestCase * const psPatternXadc2[] =
+{
+    &sTestXAdc005Ring,
+    0
+};
@@ -0,0 +1,385 @@
+//*****************************************************************************
+//
+//! @page xadc_testcase xadc sample filter test
+//!
+//! File: @ref xadctest3.c
+//!
+//! <h2>Description</h2>
+//! This module implements the test sequence for the xadc sub component.<br><br>
+//! - \p Board: NUC140 <br><br>
+//! - \p Last-Time(about): 0.5s <br><br>
+//! - \p Phenomenon: Success or failure information will be printed on the UART. <br><br>
+//! .
+//!
+//! <h2>Preconditions</h2>
+//! The module requires the following options:<br><br>
+//! - \p Option-define:
+//! <br>(1)None.<br><br>
+//! - \p Option-hardware:
+//! <br>(1)Connect an USB cable to the development board.<br><br>
+//! - \p Option-OtherModule:
+//! <br>Connect an COM cable to the development board.<br>
+//! .
+//! In case some of the required options are not enabled then some or all tests
+//! may be skipped or result FAILED.<br>
+//!
+//! <h2>Test Cases</h2>
+//! The module contain those sub tests:<br><br>
+//! - \subpage test_xadc_filter
+//! .
+//! \file xadctest3.c
+//! \brief xadc test source file
+//! \brief xadc test header file <br>
+//
+//*****************************************************************************
+
+#include "xhw_types.h"
+#include "xhw_memmap.h"
+#include "xhw_ints.h"
+#include "xhw_adc.h"
+#include "xsysctl.h"
+#include "xadc.h"
+#include "xcore.h"
+#include "test.h"
+
+//*****************************************************************************
+//
+//!\page test_xadc_filter test_xadc_filter
+//!
+//!<h2>Description</h2>
+//!Test the sample filter: decimator, median and IIR outputs, the filtering
+//!in the end of conversion interrupt, and the cycles per sample of each
+//!stage, timed with SysTick. <br>
+//!
+//
+//*****************************************************************************
+
+//
+// Samples per benchmark run.
+//
+#define ADC_TEST_BENCH_SAMPLES  256
+
+//
+// SysTick ticks (core cycles) per input sample, for [0] a boxcar of 16, [1]
+// a third order CIC of 16, [2] a median of 5, [3] an IIR and [4] the three
+// stages together. Left in RAM for inspection with a debugger.
+//
+unsigned long g_ulADCFilterBenchCycles[5];
+
+static tADCFilter sFilter;
+
+//
+// Channel 7 results seen by the callback.
+//
+static volatile unsigned long ulFilterEvents;
+static volatile unsigned long ulFilterReady;
+
+//*****************************************************************************
+//
+//! \brief ADC callback of the filter test, counts the ends of conversion
+//! and the channel 7 filter outputs.
+//!
+//! \return 0.
+//
+//*****************************************************************************
+static unsigned long
+xadcFilterCallback(void *pvCBData, unsigned long ulEvent,
+                   unsigned long ulMsgParam, void *pvMsgData)
+{
+    if(ulEvent & xADC_EVENT_END_CONVERSION)
+    {
+        if(ulMsgParam & (1 << ADC_CHANNEL_7))
+        {
+            ulFilterReady++;
+        }
+        ulFilterEvents++;
+    }
+    return 0;
+}
+
+//*****************************************************************************
+//
+//! \brief Puts the benchmark samples into the filter.
+//!
+//! \return the SysTick ticks per sample.
+//
+//*****************************************************************************
+static unsigned long
+xadcFilterBench(tADCFilter *psFilter)
+{
+    unsigned long i, ulStart;
+
+    ulStart = xSysTickValueGet();
+    for(i = 0; i < ADC_TEST_BENCH_SAMPLES; i++)
+    {
+        ADCFilterPut(psFilter, (long)((i * 2654435761UL) >> 20));
+    }
+    return ((ulStart - xSysTickValueGet()) & 0xFFFFFF) /
+           ADC_TEST_BENCH_SAMPLES;
+}
+
+//*****************************************************************************
+//
+//! \brief Get the Test description of xadc006 filter test.
+//!
+//! \return the desccription of the xadc006 test.
+//
+//*****************************************************************************
+static char* xadc006GetTest(void)
+{
+    return "xadc, 006, xadc sample filter test";
+}
+
+//*****************************************************************************
+//
+//! \brief something should do before the test execute of xadc006 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xadc006Setup(void)
+{
+    SysCtlPeripheralReset(SYSCTL_PERIPH_ADC);
+    SysCtlPeripheralClockSourceSet(SYSCTL_PERIPH_ADC_S_EXT12M);
+    SysCtlIPClockDividerSet(SYSCTL_PERIPH_ADC_D | 2);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC);
+
+    xSysTickPeriodSet(0xFFFFFF);
+    xSysTickEnable();
+}
+
+//*****************************************************************************
+//
+//! \brief something should do after the test execute of xadc006 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xadc006TearDown(void)
+{
+    xSysTickDisable();
+    xIntDisable(INT_ADC);
+    ADCFilterChannelSet(ADC_BASE, ADC_CHANNEL_7, 0);
+    xADCIntCallbackInit(ADC_BASE, 0);
+    SysCtlPeripheralReset(SYSCTL_PERIPH_ADC);
+}
+
+//*****************************************************************************
+//
+//! \brief xadc 006 test of the stages of the sample filter.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xadc_ADCFilter_test(void)
+{
+    static const long lSpikes[8] = {10, 100, 12, 11, 9, 9, 200, 9};
+    static const long lMedian[8] = {10, 10, 12, 12, 11, 9, 9, 9};
+    unsigned long i, ulOutputs;
+
+    //
+    // A boxcar of 4 with 1 bit kept: 1 + 2 + 3 + 4 is 2.5 in Q1.
+    //
+    ADCFilterInit(&sFilter, 2, 1, 1);
+    for(i = 1; i < 4; i++)
+    {
+        TestAssert(ADCFilterPut(&sFilter, i) == xfalse,
+                   "xadc API \"ADCFilterPut()\" error!");
+    }
+    TestAssert(ADCFilterPut(&sFilter, 4) == xtrue,
+               "xadc API \"ADCFilterPut()\" error!");
+    TestAssert(ADCFilterGet(&sFilter) == 5,
+               "xadc API \"ADCFilterGet()\" error!");
+
+    //
+    // Two's complement differential results are summed as they are.
+    //
+    ADCFilterInit(&sFilter, 1, 1, 0);
+    ADCFilterPut(&sFilter, -3);
+    ADCFilterPut(&sFilter, -5);
+    TestAssert(ADCFilterGet(&sFilter) == -4,
+               "xadc API \"ADCFilterGet()\" error!");
+
+    //
+    // A third order CIC of 16 settles on the full scale in 3 outputs, with
+    // 8 bits kept.
+    //
+    ADCFilterInit(&sFilter, 4, 3, 8);
+    ulOutputs = 0;
+    for(i = 0; i < 16 * 4; i++)
+    {
+        if(ADCFilterPut(&sFilter, 4095))
+        {
+            ulOutputs++;
+        }
+    }
+    TestAssert(ulOutputs == 4, "xadc API \"ADCFilterPut()\" error!");
+    TestAssert(ADCFilterGet(&sFilter) == (4095L << 8),
+               "xadc API \"ADCFilterGet()\" error!");
+
+    //
+    // A median of 3 drops the single spikes.
+    //
+    ADCFilterInit(&sFilter, 0, 1, 0);
+    ADCFilterMedianSet(&sFilter, 3);
+    for(i = 0; i < 8; i++)
+    {
+        TestAssert(ADCFilterPut(&sFilter, lSpikes[i]) == xtrue,
+                   "xadc API \"ADCFilterPut()\" error!");
+        TestAssert(ADCFilterGet(&sFilter) == lMedian[i],
+                   "xadc API \"ADCFilterMedianSet()\" error!");
+    }
+
+    //
+    // An IIR of 1/4 on a step of 1000: 250, then 437.5 rounded.
+    //
+    ADCFilterInit(&sFilter, 0, 1, 0);
+    ADCFilterIIRSet(&sFilter, 2);
+    ADCFilterPut(&sFilter, 0);
+    ADCFilterPut(&sFilter, 1000);
+    TestAssert(ADCFilterGet(&sFilter) == 250,
+               "xadc API \"ADCFilterIIRSet()\" error!");
+    ADCFilterPut(&sFilter, 1000);
+    TestAssert(ADCFilterGet(&sFilter) == 438,
+               "xadc API \"ADCFilterIIRSet()\" error!");
+
+    ADCFilterReset(&sFilter);
+    TestAssert(ADCFilterGet(&sFilter) == 0,
+               "xadc API \"ADCFilterReset()\" error!");
+    ADCFilterPut(&sFilter, 1000);
+    TestAssert(ADCFilterGet(&sFilter) == 1000,
+               "xadc API \"ADCFilterReset()\" error!");
+}
+
+//*****************************************************************************
+//
+//! \brief xadc 006 test of the filtering in ADCIntHandler().
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xadc_ADCFilterChannel_test(void)
+{
+    unsigned long i, ulTimeout;
+
+    //
+    // The band-gap on channel 7, a boxcar of 4 with 1 bit kept.
+    //
+    ADCConfigure(ADC_BASE, ADC_INPUT_SINGLE, ADC_OP_SINGLE_CYCLE,
+                 ADC_TRIGGER_PROCESSOR);
+    ADCChannle7Configure(ADC_BASE, ADC_CH7_INT_BV);
+    ADCChannelEnable(ADC_BASE, ADC_CHANNEL_7);
+    ADCFilterInit(&sFilter, 2, 1, 1);
+    ADCFilterChannelSet(ADC_BASE, ADC_CHANNEL_7, &sFilter);
+
+    ulFilterEvents = 0;
+    ulFilterReady = 0;
+    xADCIntCallbackInit(ADC_BASE, xadcFilterCallback);
+    ADCIntEnable(ADC_BASE, ADC_INT_END_CONVERSION);
+    xIntEnable(INT_ADC);
+    ADCEnable(ADC_BASE);
+
+    for(i = 1; i <= 8; i++)
+    {
+        ADCProcessorTrigger(ADC_BASE);
+        ulTimeout = 0x10000;
+        while((ulFilterEvents < i) && (ulTimeout != 0))
+        {
+            ulTimeout--;
+        }
+        TestAssert(ulTimeout != 0, "xadc API \"ADCFilterChannelSet()\" error!");
+    }
+
+    //
+    // An output every fourth conversion, within the 13 bit range.
+    //
+    TestAssert(ulFilterReady == 2, "xadc API \"ADCFilterChannelSet()\" error!");
+    TestAssert((ADCFilterGet(&sFilter) > 0) &&
+               (ADCFilterGet(&sFilter) < (4096L << 1)),
+               "xadc API \"ADCFilterChannelSet()\" error!");
+
+    //
+    // Without the filter the callback gets no output.
+    //
+    ADCFilterChannelSet(ADC_BASE, ADC_CHANNEL_7, 0);
+    for(i = 9; i <= 12; i++)
+    {
+        ADCProcessorTrigger(ADC_BASE);
+        ulTimeout = 0x10000;
+        while((ulFilterEvents < i) && (ulTimeout != 0))
+        {
+            ulTimeout--;
+        }
+    }
+    TestAssert(ulFilterReady == 2, "xadc API \"ADCFilterChannelSet()\" error!");
+}
+
+//*****************************************************************************
+//
+//! \brief xadc 006 benchmark of the stages of the sample filter.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xadc_ADCFilterBench_test(void)
+{
+    ADCFilterInit(&sFilter, 4, 1, 2);
+    g_ulADCFilterBenchCycles[0] = xadcFilterBench(&sFilter);
+
+    ADCFilterInit(&sFilter, 4, 3, 8);
+    g_ulADCFilterBenchCycles[1] = xadcFilterBench(&sFilter);
+
+    ADCFilterInit(&sFilter, 0, 1, 0);
+    ADCFilterMedianSet(&sFilter, 5);
+    g_ulADCFilterBenchCycles[2] = xadcFilterBench(&sFilter);
+
+    ADCFilterInit(&sFilter, 0, 1, 0);
+    ADCFilterIIRSet(&sFilter, 4);
+    g_ulADCFilterBenchCycles[3] = xadcFilterBench(&sFilter);
+
+    ADCFilterInit(&sFilter, 4, 1, 2);
+    ADCFilterMedianSet(&sFilter, 5);
+    ADCFilterIIRSet(&sFilter, 4);
+    g_ulADCFilterBenchCycles[4] = xadcFilterBench(&sFilter);
+
+    //
+    // Decimating first leaves the median and the IIR a sixteenth of the
+    // samples.
+    //
+    TestAssert(g_ulADCFilterBenchCycles[4] <
+               g_ulADCFilterBenchCycles[0] + g_ulADCFilterBenchCycles[2],
+               "xadc API \"ADCFilterPut()\" error!");
+}
+
+//*****************************************************************************
+//
+//! \brief xadc 006 test execute main body.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xadc006Execute(void)
+{
+    xadc_ADCFilter_test();
+    xadc_ADCFilterChannel_test();
+    xadc_ADCFilterBench_test();
+}
+
+//
+// xadc sample filter test case struct.
+//
+const tTestCase sTestXAdc006Filter = {
+    xadc006GetTest,
+    xadc006Setup,
+    xadc006TearDown,
+    xadc006Execute
+};
+
+//
+// Xadc test suits.
+//
+const tTestCase * const psPatternXadc3[] =
+{
+    &sTestXAdc006Filter,
+    0
+};
@@ -0,0 +1,348 @@
+//*****************************************************************************
+//
+//! @page xadc_testcase xadc threshold watch test
+//!
+//! File: @ref xadctest4.c
+//!
+//! <h2>Description</h2>
+//! This module implements the test sequence for the xadc sub component.<br><br>
+//! - \p Board: NUC140 <br><br>
+//! - \p Last-Time(about): 0.5s <br><br>
+//! - \p Phenomenon: Success or failure information will be printed on the UART. <br><br>
+//! .
+//!
+//! <h2>Preconditions</h2>
+//! The module requires the following options:<br><br>
+//! - \p Option-define:
+//! <br>(1)None.<br><br>
+//! - \p Option-hardware:
+//! <br>(1)Connect an USB cable to the development board.<br><br>
+//! - \p Option-OtherModule:
+//! <br>Connect an COM cable to the development board.<br>
+//! .
+//! In case some of the required options are not enabled then some or all tests
+//! may be skipped or result FAILED.<br>
+//!
+//! <h2>Test Cases</h2>
+//! The module contain those sub tests:<br><br>
+//! - \subpage test_xadc_watch
+//! .
+//! \file xadctest4.c
+//! \brief xadc test source file
+//! \brief xadc test header file <br>
+//
+//*****************************************************************************
+
+#include "xhw_types.h"
+#include "xhw_memmap.h"
+#include "xhw_ints.h"
+#include "xhw_adc.h"
+#include "xsysctl.h"
+#include "xadc.h"
+#include "xcore.h"
+#include "test.h"
+
+//*****************************************************************************
+//
+//!\page test_xadc_watch test_xadc_watch
+//!
+//!<h2>Description</h2>
+//!Test the threshold watch on the band-gap voltage of channel 7: comparator
+//!settings, crossing events, rotation through the windows and stop. <br>
+//!
+//
+//*****************************************************************************
+
+//
+// Windows on the band-gap (about 1.2V of 3.3V): around it, above it and
+// below it.
+//
+static tADCWatchWindow sWindows[3] = {
+    {ADC_CHANNEL_7, 1, 4095, 0},
+    {ADC_CHANNEL_7, 3000, 4000, 0},
+    {ADC_CHANNEL_7, 100, 200, 0}
+};
+
+static tADCWatch sWatch;
+
+//
+// What the callbacks saw: crossings of the watch, in order, and the
+// comparator events of the ADC callback.
+//
+static unsigned long ulWatchState[4];
+static unsigned long ulWatchWindow[4];
+static volatile unsigned long ulWatchCalls;
+static volatile unsigned long ulWatchCompEvents;
+
+//*****************************************************************************
+//
+//! \brief Watch callback of the threshold watch test, records the crossing.
+//!
+//! \return 0.
+//
+//*****************************************************************************
+static unsigned long
+xadcWatchCallback(void *pvCBData, unsigned long ulEvent,
+                  unsigned long ulMsgParam, void *pvMsgData)
+{
+    if(ulWatchCalls < 4)
+    {
+        ulWatchState[ulWatchCalls] = ulEvent;
+        ulWatchWindow[ulWatchCalls] = ulMsgParam;
+    }
+    ulWatchCalls++;
+    return 0;
+}
+
+//*****************************************************************************
+//
+//! \brief ADC callback of the threshold watch test, counts the comparator
+//! events.
+//!
+//! \return 0.
+//
+//*****************************************************************************
+static unsigned long
+xadcWatchCompCallback(void *pvCBData, unsigned long ulEvent,
+                      unsigned long ulMsgParam, void *pvMsgData)
+{
+    if(ulEvent & (xADC_EVENT_COMP0 | xADC_EVENT_COMP1))
+    {
+        ulWatchCompEvents++;
+    }
+    return 0;
+}
+
+//*****************************************************************************
+//
+//! \brief Waits for a number of crossings.
+//!
+//! \return xtrue if they came in time.
+//
+//*****************************************************************************
+static xtBoolean
+xadcWatchWait(unsigned long ulCalls)
+{
+    unsigned long ulTimeout = 0x100000;
+
+    while((ulWatchCalls < ulCalls) && (ulTimeout != 0))
+    {
+        ulTimeout--;
+    }
+    return (ulTimeout != 0) ? xtrue : xfalse;
+}
+
+//*****************************************************************************
+//
+//! \brief Get the Test description of xadc007 watch test.
+//!
+//! \return the desccription of the xadc007 test.
+//
+//*****************************************************************************
+static char* xadc007GetTest(void)
+{
+    return "xadc, 007, xadc threshold watch test";
+}
+
+//*****************************************************************************
+//
+//! \brief something should do before the test execute of xadc007 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xadc007Setup(void)
+{
+    SysCtlPeripheralReset(SYSCTL_PERIPH_ADC);
+    SysCtlPeripheralClockSourceSet(SYSCTL_PERIPH_ADC_S_EXT12M);
+    SysCtlIPClockDividerSet(SYSCTL_PERIPH_ADC_D | 2);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC);
+
+    //
+    // The band-gap converted continuously, no end of conversion interrupt.
+    //
+    ADCConfigure(ADC_BASE, ADC_INPUT_SINGLE, ADC_OP_CONTINUOUS,
+                 ADC_TRIGGER_PROCESSOR);
+    ADCChannle7Configure(ADC_BASE, ADC_CH7_INT_BV);
+    ADCChannelEnable(ADC_BASE, ADC_CHANNEL_7);
+    ADCIntDisable(ADC_BASE, ADC_INT_END_CONVERSION);
+    xADCIntCallbackInit(ADC_BASE, xadcWatchCompCallback);
+    xIntEnable(INT_ADC);
+    ADCEnable(ADC_BASE);
+    ADCProcessorTrigger(ADC_BASE);
+}
+
+//*****************************************************************************
+//
+//! \brief something should do after the test execute of xadc007 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xadc007TearDown(void)
+{
+    ADCWatchStop(ADC_BASE);
+    ADCConvertStop(ADC_BASE);
+    xIntDisable(INT_ADC);
+    xADCIntCallbackInit(ADC_BASE, 0);
+    SysCtlPeripheralReset(SYSCTL_PERIPH_ADC);
+}
+
+//*****************************************************************************
+//
+//! \brief xadc 007 test of ADCWatchStart() on a single window.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xadc_ADCWatch_test(void)
+{
+    unsigned long ulReg;
+    xtBoolean bRet;
+
+    sWatch.psWindows = &sWindows[1];
+    sWatch.ulWindows = 1;
+    sWatch.ulMatchCnt = 4;
+    sWatch.pfnCallback = xadcWatchCallback;
+    sWatch.pvCBData = 0;
+
+    //
+    // Inside at start: leaving below the low bound, or reaching the high
+    // bound, with the debounce count.
+    //
+    ulWatchCalls = 0;
+    ulWatchCompEvents = 0;
+    bRet = ADCWatchStart(ADC_BASE, &sWatch);
+    TestAssert(bRet == xtrue, "xadc API \"ADCWatchStart()\" error!");
+    TestAssert(ADCWatchStart(ADC_BASE, &sWatch) == xfalse,
+               "xadc API \"ADCWatchStart()\" error!");
+
+    //
+    // The band-gap is below this window.
+    //
+    TestAssert(xadcWatchWait(1) == xtrue,
+               "xadc API \"ADCWatchStart()\" error!");
+    TestAssert((ulWatchState[0] == ADC_WATCH_BELOW) &&
+               (ulWatchWindow[0] == 0) &&
+               (sWindows[1].ulState == ADC_WATCH_BELOW),
+               "xadc API \"ADCWatchStart()\" error!");
+
+    //
+    // Turned to see the result come back above the low bound, or jump
+    // above the high one.
+    //
+    ulReg = xHWREG(ADC_BASE + ADC_CMPR0);
+    TestAssert((ulReg & (ADC_CMPRX_CMPD_M | ADC_CMPRX_CMPMATCNT_M |
+                         ADC_CMPRX_CMPCH_M | ADC_CMPRX_CMPCOND |
+                         ADC_CMPRX_CMPIE | ADC_CMPRX_CMPEN)) ==
+               ((3000 << ADC_CMPRX_CMPD_S) | (4 << ADC_CMPRX_CMPMATCNT_S) |
+                (7 << ADC_CMPRX_CMPCH_S) | ADC_COMP_GREATER_EQUAL |
+                ADC_CMPRX_CMPIE | ADC_CMPRX_CMPEN),
+               "xadc API \"ADCWatchStart()\" error!");
+    ulReg = xHWREG(ADC_BASE + ADC_CMPR1);
+    TestAssert((ulReg & (ADC_CMPRX_CMPD_M | ADC_CMPRX_CMPCOND)) ==
+               ((4000 << ADC_CMPRX_CMPD_S) | ADC_COMP_GREATER_EQUAL),
+               "xadc API \"ADCWatchStart()\" error!");
+
+    //
+    // No more crossing while the result stays below, and the comparator
+    // events are not passed to the ADC callback.
+    //
+    TestAssert(xadcWatchWait(2) == xfalse,
+               "xadc API \"ADCWatchStart()\" error!");
+    TestAssert(ulWatchCompEvents == 0, "xadc API \"ADCWatchStart()\" error!");
+
+    ADCWatchStop(ADC_BASE);
+    TestAssert((xHWREG(ADC_BASE + ADC_CMPR0) == 0) &&
+               (xHWREG(ADC_BASE + ADC_CMPR1) == 0),
+               "xadc API \"ADCWatchStop()\" error!");
+}
+
+//*****************************************************************************
+//
+//! \brief xadc 007 test of ADCWatchRotate().
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xadc_ADCWatchRotate_test(void)
+{
+    xtBoolean bRet;
+
+    sWatch.psWindows = sWindows;
+    sWatch.ulWindows = 3;
+    sWatch.ulMatchCnt = 2;
+
+    //
+    // The window around the band-gap stays quiet.
+    //
+    ulWatchCalls = 0;
+    bRet = ADCWatchStart(ADC_BASE, &sWatch);
+    TestAssert(bRet == xtrue, "xadc API \"ADCWatchStart()\" error!");
+    TestAssert(xadcWatchWait(1) == xfalse,
+               "xadc API \"ADCWatchRotate()\" error!");
+
+    //
+    // Each window is reported once the comparators come to it.
+    //
+    ADCWatchRotate(ADC_BASE);
+    TestAssert(sWatch.ulCurrent == 1, "xadc API \"ADCWatchRotate()\" error!");
+    TestAssert(xadcWatchWait(1) == xtrue,
+               "xadc API \"ADCWatchRotate()\" error!");
+    TestAssert((ulWatchState[0] == ADC_WATCH_BELOW) &&
+               (ulWatchWindow[0] == 1),
+               "xadc API \"ADCWatchRotate()\" error!");
+
+    ADCWatchRotate(ADC_BASE);
+    TestAssert(xadcWatchWait(2) == xtrue,
+               "xadc API \"ADCWatchRotate()\" error!");
+    TestAssert((ulWatchState[1] == ADC_WATCH_ABOVE) &&
+               (ulWatchWindow[1] == 2),
+               "xadc API \"ADCWatchRotate()\" error!");
+
+    //
+    // Back to the first window, the states are kept.
+    //
+    ADCWatchRotate(ADC_BASE);
+    TestAssert(sWatch.ulCurrent == 0, "xadc API \"ADCWatchRotate()\" error!");
+    TestAssert(xadcWatchWait(3) == xfalse,
+               "xadc API \"ADCWatchRotate()\" error!");
+    TestAssert((sWindows[0].ulState == ADC_WATCH_INSIDE) &&
+               (sWindows[1].ulState == ADC_WATCH_BELOW) &&
+               (sWindows[2].ulState == ADC_WATCH_ABOVE),
+               "xadc API \"ADCWatchRotate()\" error!");
+
+    ADCWatchStop(ADC_BASE);
+}
+
+//*****************************************************************************
+//
+//! \brief xadc 007 test execute main body.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xadc007Execute(void)
+{
+    xadc_ADCWatch_test();
+    xadc_ADCWatchRotate_test();
+}
+
+//
+// xadc threshold watch test case struct.
+//
+const tTestCase sTestXAdc007Watch = {
+    xadc007GetTest,
+    xadc007Setup,
+    xadc007TearDown,
+    xadc007Execute
+};
+
+//
+// Xadc test suits.
+//
+const tTestCase * const psPatternXadc4[] =
+{
+    &sTestXAdc007Watch,
+    0
+};
@@ -0,0 +1,302 @@
+//*****************************************************************************
+//
+//! @page xadc_testcase xadc calibration cache test
+//!
+//! File: @ref xadctest5.c
+//!
+//! <h2>Description</h2>
+//! This module implements the test sequence for the xadc sub component.<br><br>
+//! - \p Board: NUC140 <br><br>
+//! - \p Last-Time(about): 0.5s <br><br>
+//! - \p Phenomenon: Success or failure information will be printed on the UART. <br><br>
+//! .
+//!
+//! <h2>Preconditions</h2>
+//! The module requires the following options:<br><br>
+//! - \p Option-define:
+//! <br>(1)None.<br><br>
+//! - \p Option-hardware:
+//! <br>(1)Connect an USB cable to the development board.<br><br>
+//! - \p Option-OtherModule:
+//! <br>Connect an COM cable to the development board.<br>
+//! .
+//! In case some of the required options are not enabled then some or all tests
+//! may be skipped or result FAILED.<br>
+//!
+//! <h2>Test Cases</h2>
+//! The module contain those sub tests:<br><br>
+//! - \subpage test_xadc_calibration
+//! .
+//! \file xadctest5.c
+//! \brief xadc test source file
+//! \brief xadc test header file <br>
+//
+//*****************************************************************************
+
+#include "xhw_types.h"
+#include "xhw_memmap.h"
+#include "xhw_adc.h"
+#include "xsysctl.h"
+#include "xadc.h"
+#include "xcore.h"
+#include "test.h"
+
+//*****************************************************************************
+//
+//!\page test_xadc_calibration test_xadc_calibration
+//!
+//!<h2>Description</h2>
+//!Test the calibration cache: skipped while the configuration and the ADC
+//!calibration hold, run again on a change, a reset or a drift, and the time
+//!saved, timed with SysTick. <br>
+//!
+//
+//*****************************************************************************
+
+//
+// SysTick ticks of ADCCalibrationCheck(), [0] calibrating and [1] skipping.
+// Left in RAM for inspection with a debugger.
+//
+unsigned long g_ulADCCalBenchTicks[2];
+
+static tADCCalibration sCal;
+
+//*****************************************************************************
+//
+//! \brief Resets the ADC and configures it for the calibration test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+xadcCalibrationADCInit(void)
+{
+    SysCtlPeripheralReset(SYSCTL_PERIPH_ADC);
+    ADCConfigure(ADC_BASE, ADC_INPUT_SINGLE, ADC_OP_SINGLE_CYCLE,
+                 ADC_TRIGGER_PROCESSOR);
+    ADCChannelEnable(ADC_BASE, ADC_CHANNEL_0);
+    ADCEnable(ADC_BASE);
+}
+
+//*****************************************************************************
+//
+//! \brief Get the Test description of xadc008 calibration test.
+//!
+//! \return the desccription of the xadc008 test.
+//
+//*****************************************************************************
+static char* xadc008GetTest(void)
+{
+    return "xadc, 008, xadc calibration cache test";
+}
+
+//*****************************************************************************
+//
+//! \brief something should do before the test execute of xadc008 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xadc008Setup(void)
+{
+    SysCtlPeripheralClockSourceSet(SYSCTL_PERIPH_ADC_S_EXT12M);
+    SysCtlIPClockDividerSet(SYSCTL_PERIPH_ADC_D | 2);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC);
+    xadcCalibrationADCInit();
+
+    xSysTickPeriodSet(0xFFFFFF);
+    xSysTickEnable();
+}
+
+//*****************************************************************************
+//
+//! \brief something should do after the test execute of xadc008 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xadc008TearDown(void)
+{
+    xSysTickDisable();
+    SysCtlPeripheralReset(SYSCTL_PERIPH_ADC);
+}
+
+//*****************************************************************************
+//
+//! \brief xadc 008 test of ADCCalibrationCheck().
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xadc_ADCCalibrationCheck_test(void)
+{
+    unsigned long ulStart;
+    xtBoolean bRet;
+
+    sCal.ulTempDrift = 8;
+    sCal.ulSupplyDrift = 16;
+    sCal.ulFingerprint = 0;
+    sCal.ulRunning = 0;
+    sCal.ulCalibrations = 0;
+    sCal.ulSkipped = 0;
+
+    //
+    // An empty record calibrates, and reads the band-gap and the sensor.
+    //
+    ulStart = xSysTickValueGet();
+    bRet = ADCCalibrationCheck(ADC_BASE, &sCal);
+    g_ulADCCalBenchTicks[0] = (ulStart - xSysTickValueGet()) & 0xFFFFFF;
+    TestAssert(bRet == xtrue, "xadc API \"ADCCalibrationCheck()\" error!");
+    TestAssert(ADCCalibrationDone(ADC_BASE) == xtrue,
+               "xadc API \"ADCCalibrationCheck()\" error!");
+    TestAssert((sCal.ulCalibrations == 1) && (sCal.ulFingerprint != 0),
+               "xadc API \"ADCCalibrationCheck()\" error!");
+    TestAssert((sCal.ulBandGap > 0) && (sCal.ulBandGap < 0xFFF) &&
+               (sCal.ulTemp > 0) && (sCal.ulTemp < 0xFFF),
+               "xadc API \"ADCCalibrationCheck()\" error!");
+
+    //
+    // The ADC configuration is left as it was.
+    //
+    TestAssert((xHWREG(ADC_BASE + ADC_CHER) &
+                (ADC_CHER_CHEN_M | ADC_CHER_PRESEL_M)) == ADC_CHER_CHEN0,
+               "xadc API \"ADCCalibrationCheck()\" error!");
+    TestAssert((xHWREG(ADC_BASE + ADC_CR) & ADC_CR_ADMD_M) ==
+               ADC_CR_ADMD_SINGLE_CYCLE,
+               "xadc API \"ADCCalibrationCheck()\" error!");
+
+    //
+    // Nothing changed, skipped.
+    //
+    ulStart = xSysTickValueGet();
+    bRet = ADCCalibrationCheck(ADC_BASE, &sCal);
+    g_ulADCCalBenchTicks[1] = (ulStart - xSysTickValueGet()) & 0xFFFFFF;
+    TestAssert(bRet == xfalse, "xadc API \"ADCCalibrationCheck()\" error!");
+    TestAssert((sCal.ulCalibrations == 1) && (sCal.ulSkipped == 1),
+               "xadc API \"ADCCalibrationCheck()\" error!");
+    TestAssert(g_ulADCCalBenchTicks[1] < g_ulADCCalBenchTicks[0],
+               "xadc API \"ADCCalibrationCheck()\" error!");
+
+    //
+    // A new input type, and back, calls for a calibration each.
+    //
+    ADCConfigure(ADC_BASE, ADC_INPUT_DIFF | ADC_DIFF_2C, ADC_OP_SINGLE_CYCLE,
+                 ADC_TRIGGER_PROCESSOR);
+    TestAssert(ADCCalibrationCheck(ADC_BASE, &sCal) == xtrue,
+               "xadc API \"ADCCalibrationCheck()\" error!");
+    ADCConfigure(ADC_BASE, ADC_INPUT_SINGLE, ADC_OP_SINGLE_CYCLE,
+                 ADC_TRIGGER_PROCESSOR);
+    TestAssert(ADCCalibrationCheck(ADC_BASE, &sCal) == xtrue,
+               "xadc API \"ADCCalibrationCheck()\" error!");
+    TestAssert(ADCCalibrationCheck(ADC_BASE, &sCal) == xfalse,
+               "xadc API \"ADCCalibrationCheck()\" error!");
+
+    //
+    // A reset of the ADC drops the calibration.
+    //
+    xadcCalibrationADCInit();
+    TestAssert(ADCCalibrationCheck(ADC_BASE, &sCal) == xtrue,
+               "xadc API \"ADCCalibrationCheck()\" error!");
+    TestAssert(sCal.ulCalibrations == 4,
+               "xadc API \"ADCCalibrationCheck()\" error!");
+}
+
+//*****************************************************************************
+//
+//! \brief xadc 008 test of ADCCalibrationUpdate().
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xadc_ADCCalibrationUpdate_test(void)
+{
+    unsigned long ulStatus, ulTimeout, ulTemp;
+
+    //
+    // No drift since the calibration.
+    //
+    ulStatus = ADCCalibrationUpdate(ADC_BASE, &sCal);
+    TestAssert(ulStatus == ADC_CAL_VALID,
+               "xadc API \"ADCCalibrationUpdate()\" error!");
+
+    //
+    // A drift of the temperature starts a calibration and returns, the
+    // next calls complete it.
+    //
+    ulTemp = sCal.ulTemp;
+    sCal.ulTemp += 4 * sCal.ulTempDrift;
+    ulStatus = ADCCalibrationUpdate(ADC_BASE, &sCal);
+    TestAssert(ulStatus == ADC_CAL_RUNNING,
+               "xadc API \"ADCCalibrationUpdate()\" error!");
+    TestAssert(sCal.ulRunning == 1,
+               "xadc API \"ADCCalibrationUpdate()\" error!");
+
+    ulTimeout = 0x10000;
+    do
+    {
+        ulStatus = ADCCalibrationUpdate(ADC_BASE, &sCal);
+        ulTimeout--;
+    }
+    while((ulStatus == ADC_CAL_RUNNING) && (ulTimeout != 0));
+    TestAssert(ulStatus == ADC_CAL_DONE,
+               "xadc API \"ADCCalibrationUpdate()\" error!");
+    TestAssert((sCal.ulRunning == 0) && (sCal.ulCalibrations == 5),
+               "xadc API \"ADCCalibrationUpdate()\" error!");
+
+    //
+    // The codes of the new calibration are the current ones.
+    //
+    TestAssert(((sCal.ulTemp > ulTemp) ? (sCal.ulTemp - ulTemp) :
+                (ulTemp - sCal.ulTemp)) <= sCal.ulTempDrift,
+               "xadc API \"ADCCalibrationUpdate()\" error!");
+    ulStatus = ADCCalibrationUpdate(ADC_BASE, &sCal);
+    TestAssert(ulStatus == ADC_CAL_VALID,
+               "xadc API \"ADCCalibrationUpdate()\" error!");
+
+    //
+    // Same for the supply.
+    //
+    sCal.ulBandGap += 4 * sCal.ulSupplyDrift;
+    ulStatus = ADCCalibrationUpdate(ADC_BASE, &sCal);
+    TestAssert(ulStatus == ADC_CAL_RUNNING,
+               "xadc API \"ADCCalibrationUpdate()\" error!");
+    ulTimeout = 0x10000;
+    while((ADCCalibrationUpdate(ADC_BASE, &sCal) != ADC_CAL_DONE) &&
+          (ulTimeout != 0))
+    {
+        ulTimeout--;
+    }
+    TestAssert(ulTimeout != 0, "xadc API \"ADCCalibrationUpdate()\" error!");
+}
+
+//*****************************************************************************
+//
+//! \brief xadc 008 test execute main body.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xadc008Execute(void)
+{
+    xadc_ADCCalibrationCheck_test();
+    xadc_ADCCalibrationUpdate_test();
+}
+
+//
+// xadc calibration cache test case struct.
+//
+const tTestCase sTestXAdc008Calibration = {
+    xadc008GetTest,
+    xadc008Setup,
+    xadc008TearDown,
+    xadc008Execute
+};
+
+//
+// Xadc test suits.
+//
+const tTestCase * const psPatternXadc5[] =
+{
+    &sTestXAdc008Calibration,
+    0
+};
@@ -0,0 +1,282 @@
+//*****************************************************************************
+//
+//! @page xdma_testcase xcore api test
+//!
+//! File: @ref dmatest05.c
+//!
+//! <h2>Description</h2>
+//! This module implements the test sequence for the xdma sub component.<br><br>
+//! - \p Board: NUC140 <br><br>
+//! - \p Last-Time(about): 0.5s <br><br>
+//! - \p Phenomenon: Success or failure information will be printed on the UART. <br><br>
+//! .
+//!
+//! <h2>Preconditions</h2>
+//! The module requires the following options:<br><br>
+//! - \p Option-define:
+//! <br>(1)None.<br><br>
+//! - \p Option-hardware:
+//! <br>(1)Connect an USB cable to the development board.<br><br>
+//! - \p Option-OtherModule:
+//! <br>Connect an COM cable to the development board.<br>
+//! .
+//! In case some of the required options are not enabled then some or all tests
+//! may be skipped or result FAILED.<br>
+//!
+//! <h2>Test Cases</h2>
+//! The module contain those sub tests:<br><br>
+//! - \subpage test_xdma_dispatch
+//! .
+//! \file dmatest05.c
+//! \brief xdma test source file
+//! \brief xdma test header file <br>
+//*****************************************************************************
+
+#include "xhw_types.h"
+#include "xhw_ints.h"
+#include "xsysctl.h"
+#include "xhw_sysctl.h"
+#include "xhw_dma.h"
+#include "xdma.h"
+#include "xcore.h"
+#include "test.h"
+
+//*****************************************************************************
+//
+//!\page test_xdma_dispatch test_xdma_dispatch
+//!
+//!<h2>Description</h2>
+//!Test the PDMA channel allocation and the interrupt dispatch: callback
+//!data, transfer done and half transfer events. <br>
+//!
+//
+//*****************************************************************************
+
+//
+// Two memory to memory transfers running together.
+//
+static unsigned long ulDispatchSrc[2][16];
+static unsigned long ulDispatchDst[2][16];
+
+//
+// What the callback saw, per transfer: events in order and the data.
+//
+static unsigned long ulDispatchEvent[2][4];
+static void *pvDispatchData[2][4];
+static volatile unsigned long ulDispatchCalls[2];
+
+//*****************************************************************************
+//
+//! \brief Channel callback of the dispatch test, records the call.
+//!
+//! \return 0.
+//
+//*****************************************************************************
+static unsigned long
+xdmaDispatchCallback(void *pvCBData, unsigned long ulEvent,
+                     unsigned long ulMsgParam, void *pvMsgData)
+{
+    unsigned long ulIndex = (pvCBData == ulDispatchDst[1]) ? 1 : 0;
+
+    if(ulDispatchCalls[ulIndex] < 4)
+    {
+        ulDispatchEvent[ulIndex][ulDispatchCalls[ulIndex]] = ulMsgParam;
+        pvDispatchData[ulIndex][ulDispatchCalls[ulIndex]] = pvCBData;
+    }
+    ulDispatchCalls[ulIndex]++;
+    return 0;
+}
+
+//*****************************************************************************
+//
+//! \brief Get the Test description of xdma006 dispatch test.
+//!
+//! \return the desccription of the xdma006 test.
+//
+//*****************************************************************************
+static char* xDma006GetTest(void)
+{
+    return "xdma, 006, xdma channel allocation and dispatch test";
+}
+
+//*****************************************************************************
+//
+//! \brief something should do before the test execute of xdma006 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xDma006Setup(void)
+{
+    SysCtlPeripheralReset(SYSCTL_PERIPH_PDMA);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_PDMA);
+    xIntEnable(INT_PDMA);
+}
+
+//*****************************************************************************
+//
+//! \brief something should do after the test execute of xdma006 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xDma006TearDown(void)
+{
+    xIntDisable(INT_PDMA);
+    SysCtlPeripheralDisable(SYSCTL_PERIPH_PDMA);
+}
+
+//*****************************************************************************
+//
+//! \brief xdma 006 test of the free channel bitmap.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xdmaAssignTest(void)
+{
+    unsigned long i, ulChannel;
+
+    for(i = 0; i < PDMA_CHANNEL_COUNT; i++)
+    {
+        PDMAChannelDeAssign(i);
+    }
+
+    //
+    // Lowest free channel first, none left after nine.
+    //
+    for(i = 0; i < PDMA_CHANNEL_COUNT; i++)
+    {
+        ulChannel = PDMAChannelDynamicAssign(xDMA_REQUEST_MEM,
+                                             xDMA_REQUEST_MEM);
+        TestAssert(ulChannel == i, "dma API error!");
+        TestAssert(PDMAChannelAssignmentGet(i) == xtrue, "dma API error!");
+    }
+    ulChannel = PDMAChannelDynamicAssign(xDMA_REQUEST_MEM, xDMA_REQUEST_MEM);
+    TestAssert(ulChannel == xDMA_CHANNEL_NOT_EXIST, "dma API error!");
+
+    //
+    // A freed channel is handed out again.
+    //
+    PDMAChannelDeAssign(5);
+    TestAssert(PDMAChannelAssignmentGet(5) == xfalse, "dma API error!");
+    ulChannel = PDMAChannelDynamicAssign(xDMA_REQUEST_MEM, xDMA_REQUEST_MEM);
+    TestAssert(ulChannel == 5, "dma API error!");
+
+    for(i = 0; i < PDMA_CHANNEL_COUNT; i++)
+    {
+        PDMAChannelDeAssign(i);
+    }
+}
+
+//*****************************************************************************
+//
+//! \brief xdma 006 test of the interrupt dispatch.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xdmaDispatchTest(void)
+{
+    unsigned long i, j, ulTimeout;
+    unsigned long ulChannel[2];
+
+    for(i = 0; i < 2; i++)
+    {
+        for(j = 0; j < 16; j++)
+        {
+            ulDispatchSrc[i][j] = (i << 16) | j;
+            ulDispatchDst[i][j] = 0;
+        }
+        ulDispatchCalls[i] = 0;
+    }
+
+    //
+    // Channel 0 reports the half, channel 1 only the end.
+    //
+    for(i = 0; i < 2; i++)
+    {
+        ulChannel[i] = PDMAChannelDynamicAssign(xDMA_REQUEST_MEM,
+                                                xDMA_REQUEST_MEM);
+        TestAssert(ulChannel[i] != xDMA_CHANNEL_NOT_EXIST, "dma API error!");
+        PDMAEnable(ulChannel[i]);
+        PDMAChannelIntCallbackInit(ulChannel[i], xdmaDispatchCallback);
+        PDMAChannelIntCallbackDataSet(ulChannel[i], ulDispatchDst[i]);
+        PDMAChannelIntEnable(ulChannel[i], (i == 0) ?
+                             (PDMA_EVENT_TC | PDMA_EVENT_HALF) :
+                             PDMA_EVENT_TC);
+        PDMAChannelControlSet(ulChannel[i], PDMA_WIDTH_32BIT |
+                              PDMA_SRC_DIR_INC | PDMA_DST_DIR_INC);
+    }
+    for(i = 0; i < 2; i++)
+    {
+        PDMAChannelTransferSet(ulChannel[i], ulDispatchSrc[i],
+                               ulDispatchDst[i], sizeof(ulDispatchSrc[i]));
+    }
+
+    ulTimeout = 0x10000;
+    while(((ulDispatchCalls[0] < 2) || (ulDispatchCalls[1] < 1)) &&
+          (ulTimeout != 0))
+    {
+        ulTimeout--;
+    }
+    TestAssert(ulTimeout != 0, "dma API error!");
+
+    TestAssert(ulDispatchCalls[0] == 2, "dma API error!");
+    TestAssert(ulDispatchEvent[0][0] == PDMA_EVENT_HALF, "dma API error!");
+    TestAssert(ulDispatchEvent[0][1] == PDMA_EVENT_TC, "dma API error!");
+    TestAssert(pvDispatchData[0][0] == ulDispatchDst[0], "dma API error!");
+    TestAssert(pvDispatchData[0][1] == ulDispatchDst[0], "dma API error!");
+
+    TestAssert(ulDispatchCalls[1] == 1, "dma API error!");
+    TestAssert(ulDispatchEvent[1][0] == PDMA_EVENT_TC, "dma API error!");
+    TestAssert(pvDispatchData[1][0] == ulDispatchDst[1], "dma API error!");
+
+    //
+    // Both halves of the split transfer landed.
+    //
+    for(i = 0; i < 2; i++)
+    {
+        for(j = 0; j < 16; j++)
+        {
+            TestAssert(ulDispatchDst[i][j] == ulDispatchSrc[i][j],
+                       "dma API error!");
+        }
+        PDMADisable(ulChannel[i]);
+        PDMAChannelDeAssign(ulChannel[i]);
+        TestAssert(PDMAChannelIntCallbackGet(ulChannel[i]) == 0,
+                   "dma API error!");
+    }
+}
+
+//*****************************************************************************
+//
+//! \brief xdma 006 test execute main body.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xDma006Execute(void)
+{
+    xdmaAssignTest();
+    xdmaDispatchTest();
+}
+
+//
+// xdma dispatch test case struct.
+//
+const tTestCase sTestXDma006 = {
+    xDma006GetTest,
+    xDma006Setup,
+    xDma006TearDown,
+    xDma006Execute
+};
+
+//
+// Xdma test suits.
+//
+const tTestCase * const psPatternXdma05[] =
+{
+    &sTestXDma006,
+    0
+};
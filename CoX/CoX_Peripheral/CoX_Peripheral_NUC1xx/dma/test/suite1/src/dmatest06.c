@@ -0,0 +1,242 @@
+//*****************************************************************************
+//
+//! @page xdma_testcase xcore api test
+//!
+//! File: @ref dmatest06.c
+//!
+//! <h2>Description</h2>
+//! This module implements the test sequence for the xdma sub component.<br><br>
+//! - \p Board: NUC140 <br><br>
+//! - \p Last-Time(about): 0.5s <br><br>
+//! - \p Phenomenon: Success or failure information will be printed on the UART. <br><br>
+//! .
+//!
+//! <h2>Preconditions</h2>
+//! The module requires the following options:<br><br>
+//! - \p Option-define:
+//! <br>(1)None.<br><br>
+//! - \p Option-hardware:
+//! <br>(1)Connect an USB cable to the development board.<br><br>
+//! - \p Option-OtherModule:
+//! <br>Connect an COM cable to the development board.<br>
+//! .
+//! In case some of the required options are not enabled then some or all tests
+//! may be skipped or result FAILED.<br>
+//!
+//! <h2>Test Cases</h2>
+//! The module contain those sub tests:<br><br>
+//! - \subpage test_xdma_chain
+//! .
+//! \file dmatest06.c
+//! \brief xdma test source file
+//! \brief xdma test header file <br>
+//*****************************************************************************
+
+#include "xhw_types.h"
+#include "xhw_ints.h"
+#include "xsysctl.h"
+#include "xhw_sysctl.h"
+#include "xhw_dma.h"
+#include "xdma.h"
+#include "xcore.h"
+#include "test.h"
+
+//*****************************************************************************
+//
+//!\page test_xdma_chain test_xdma_chain
+//!
+//!<h2>Description</h2>
+//!Test PDMA descriptor chains: a header, payload and trailer gathered into
+//!one buffer with a single completion callback. <br>
+//!
+//
+//*****************************************************************************
+
+//
+// Frame pieces of different widths.
+//
+static unsigned char ucChainHeader[3] = {0xA1, 0xA2, 0xA3};
+static unsigned long ulChainPayload[4] = {0x04030201, 0x08070605,
+                                          0x0C0B0A09, 0x100F0E0D};
+static unsigned short usChainTrailer[1] = {0xBBAA};
+static unsigned long ulChainFill = 0x5A5A5A5A;
+
+//
+// Gathered frame: header, pad to a word, payload, trailer, filled tail.
+//
+static unsigned long ulChainFrame[8];
+
+static tPDMAChainDesc sChainDesc[4];
+
+//
+// What the callback saw.
+//
+static volatile unsigned long ulChainCalls;
+static unsigned long ulChainEvent;
+static void *pvChainData;
+
+//*****************************************************************************
+//
+//! \brief Channel callback of the chain test, records the call.
+//!
+//! \return 0.
+//
+//*****************************************************************************
+static unsigned long
+xdmaChainCallback(void *pvCBData, unsigned long ulEvent,
+                  unsigned long ulMsgParam, void *pvMsgData)
+{
+    ulChainEvent = ulMsgParam;
+    pvChainData = pvCBData;
+    ulChainCalls++;
+    return 0;
+}
+
+//*****************************************************************************
+//
+//! \brief Get the Test description of xdma007 chain test.
+//!
+//! \return the desccription of the xdma007 test.
+//
+//*****************************************************************************
+static char* xDma007GetTest(void)
+{
+    return "xdma, 007, xdma descriptor chain test";
+}
+
+//*****************************************************************************
+//
+//! \brief something should do before the test execute of xdma007 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xDma007Setup(void)
+{
+    SysCtlPeripheralReset(SYSCTL_PERIPH_PDMA);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_PDMA);
+    xIntEnable(INT_PDMA);
+}
+
+//*****************************************************************************
+//
+//! \brief something should do after the test execute of xdma007 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xDma007TearDown(void)
+{
+    xIntDisable(INT_PDMA);
+    SysCtlPeripheralDisable(SYSCTL_PERIPH_PDMA);
+}
+
+//*****************************************************************************
+//
+//! \brief xdma 007 test of PDMAChannelChainStart().
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xdmaChainTest(void)
+{
+    unsigned long i, ulChannel, ulTimeout;
+    unsigned char *pucFrame = (unsigned char *)ulChainFrame;
+
+    for(i = 0; i < 8; i++)
+    {
+        ulChainFrame[i] = 0;
+    }
+
+    sChainDesc[0].pvSrcAddr = ucChainHeader;
+    sChainDesc[0].pvDstAddr = pucFrame;
+    sChainDesc[0].ulTransferSize = 3;
+    sChainDesc[0].ulControl = PDMA_WIDTH_8BIT | PDMA_SRC_DIR_INC |
+                              PDMA_DST_DIR_INC;
+    sChainDesc[1].pvSrcAddr = ulChainPayload;
+    sChainDesc[1].pvDstAddr = &ulChainFrame[1];
+    sChainDesc[1].ulTransferSize = 16;
+    sChainDesc[1].ulControl = PDMA_WIDTH_32BIT | PDMA_SRC_DIR_INC |
+                              PDMA_DST_DIR_INC;
+    sChainDesc[2].pvSrcAddr = usChainTrailer;
+    sChainDesc[2].pvDstAddr = &ulChainFrame[5];
+    sChainDesc[2].ulTransferSize = 2;
+    sChainDesc[2].ulControl = PDMA_WIDTH_16BIT | PDMA_SRC_DIR_INC |
+                              PDMA_DST_DIR_INC;
+    sChainDesc[3].pvSrcAddr = &ulChainFill;
+    sChainDesc[3].pvDstAddr = &ulChainFrame[6];
+    sChainDesc[3].ulTransferSize = 8;
+    sChainDesc[3].ulControl = PDMA_WIDTH_32BIT | PDMA_SRC_DIR_FIXED |
+                              PDMA_DST_DIR_INC;
+
+    ulChannel = PDMAChannelDynamicAssign(xDMA_REQUEST_MEM, xDMA_REQUEST_MEM);
+    TestAssert(ulChannel != xDMA_CHANNEL_NOT_EXIST, "dma API error!");
+    PDMAEnable(ulChannel);
+    PDMAChannelIntCallbackInit(ulChannel, xdmaChainCallback);
+    PDMAChannelIntCallbackDataSet(ulChannel, sChainDesc);
+    PDMAChannelIntEnable(ulChannel, PDMA_EVENT_TC | PDMA_EVENT_ERROR);
+
+    ulChainCalls = 0;
+    PDMAChannelChainStart(ulChannel, sChainDesc, 4);
+
+    ulTimeout = 0x10000;
+    while(PDMAChannelIsBusy(ulChannel) && (ulTimeout != 0))
+    {
+        ulTimeout--;
+    }
+    TestAssert(ulTimeout != 0, "dma API error!");
+
+    //
+    // One callback, at the end of the chain.
+    //
+    TestAssert(ulChainCalls == 1, "dma API error!");
+    TestAssert(ulChainEvent == PDMA_EVENT_TC, "dma API error!");
+    TestAssert(pvChainData == sChainDesc, "dma API error!");
+
+    for(i = 0; i < 3; i++)
+    {
+        TestAssert(pucFrame[i] == ucChainHeader[i], "dma API error!");
+    }
+    TestAssert(pucFrame[3] == 0, "dma API error!");
+    for(i = 0; i < 4; i++)
+    {
+        TestAssert(ulChainFrame[1 + i] == ulChainPayload[i], "dma API error!");
+    }
+    TestAssert(ulChainFrame[5] == usChainTrailer[0], "dma API error!");
+    TestAssert(ulChainFrame[6] == ulChainFill, "dma API error!");
+    TestAssert(ulChainFrame[7] == ulChainFill, "dma API error!");
+
+    PDMADisable(ulChannel);
+    PDMAChannelDeAssign(ulChannel);
+}
+
+//*****************************************************************************
+//
+//! \brief xdma 007 test execute main body.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xDma007Execute(void)
+{
+    xdmaChainTest();
+}
+
+//
+// xdma chain test case struct.
+//
+const tTestCase sTestXDma007 = {
+    xDma007GetTest,
+    xDma007Setup,
+    xDma007TearDown,
+    xDma007Execute
+};
+
+//
+// Xdma test suits.
+//
+const tTestCase * const psPatternXdma06[] =
+{
+    &sTestXDma007,
+    0
+};
@@ -0,0 +1,341 @@
+//*****************************************************************************
+//
+//! @page xdma_testcase xcore api test
+//!
+//! File: @ref dmatest07.c
+//!
+//! <h2>Description</h2>
+//! This module implements the test sequence for the xdma sub component.<br><br>
+//! - \p Board: NUC140 <br><br>
+//! - \p Last-Time(about): 1s <br><br>
+//! - \p Phenomenon: Success or failure information will be printed on the UART. <br><br>
+//! .
+//!
+//! <h2>Preconditions</h2>
+//! The module requires the following options:<br><br>
+//! - \p Option-define:
+//! <br>(1)None.<br><br>
+//! - \p Option-hardware:
+//! <br>(1)Connect an USB cable to the development board.<br><br>
+//! - \p Option-OtherModule:
+//! <br>Connect an COM cable to the development board.<br>
+//! .
+//! In case some of the required options are not enabled then some or all tests
+//! may be skipped or result FAILED.<br>
+//!
+//! <h2>Test Cases</h2>
+//! The module contain those sub tests:<br><br>
+//! - \subpage test_xdma_mem
+//! .
+//! \file dmatest07.c
+//! \brief xdma test source file
+//! \brief xdma test header file <br>
+//*****************************************************************************
+
+#include "xhw_types.h"
+#include "xhw_ints.h"
+#include "xsysctl.h"
+#include "xhw_sysctl.h"
+#include "xhw_dma.h"
+#include "xdma.h"
+#include "xcore.h"
+#include "test.h"
+
+//*****************************************************************************
+//
+//!\page test_xdma_mem test_xdma_mem
+//!
+//!<h2>Description</h2>
+//!Test PDMAMemCopy() and PDMAMemFill() at every alignment, with and without
+//!callback, and measure the size where the PDMA beats the CPU at 50 MHz. <br>
+//!
+//
+//*****************************************************************************
+
+//
+// Block sizes of the benchmark.
+//
+#define DMA_MEM_BENCH_SIZES     8
+
+static unsigned long ulMemBenchSize[DMA_MEM_BENCH_SIZES] =
+{
+    16, 32, 64, 128, 256, 512, 1024, 2048
+};
+
+static unsigned long ulMemSrc[2048 / 4 + 1];
+static unsigned long ulMemDst[2048 / 4 + 1];
+
+//
+// SysTick ticks per size, [size][0] for the CPU and [size][1] for the PDMA,
+// and the smallest size the PDMA wins at, 0 if none. Left in RAM for
+// inspection with a debugger.
+//
+unsigned long g_ulDMAMemBenchTicks[DMA_MEM_BENCH_SIZES][2];
+unsigned long g_ulDMAMemCrossover;
+
+static volatile unsigned long ulMemCalls;
+static unsigned long ulMemEvent;
+static void *pvMemData;
+
+//*****************************************************************************
+//
+//! \brief Completion callback of the memory test, records the call.
+//!
+//! \return 0.
+//
+//*****************************************************************************
+static unsigned long
+xdmaMemCallback(void *pvCBData, unsigned long ulEvent,
+                unsigned long ulMsgParam, void *pvMsgData)
+{
+    ulMemEvent = ulMsgParam;
+    pvMemData = pvMsgData;
+    ulMemCalls++;
+    return 0;
+}
+
+//*****************************************************************************
+//
+//! \brief Checks that a copy landed and nothing around it was touched.
+//!
+//! \return xtrue if the destination is right.
+//
+//*****************************************************************************
+static xtBoolean
+xdmaMemCheck(unsigned long ulDstOff, unsigned long ulSrcOff,
+             unsigned long ulSize)
+{
+    unsigned char *pucDst = (unsigned char *)ulMemDst;
+    unsigned char *pucSrc = (unsigned char *)ulMemSrc;
+    unsigned long i;
+
+    for(i = 0; i < sizeof(ulMemDst); i++)
+    {
+        if((i >= ulDstOff) && (i < ulDstOff + ulSize))
+        {
+            if(pucDst[i] != pucSrc[i - ulDstOff + ulSrcOff])
+            {
+                return xfalse;
+            }
+        }
+        else if(pucDst[i] != 0xEE)
+        {
+            return xfalse;
+        }
+    }
+    return xtrue;
+}
+
+//*****************************************************************************
+//
+//! \brief Get the Test description of xdma008 memory test.
+//!
+//! \return the desccription of the xdma008 test.
+//
+//*****************************************************************************
+static char* xDma008GetTest(void)
+{
+    return "xdma, 008, xdma memory copy and fill test";
+}
+
+//*****************************************************************************
+//
+//! \brief something should do before the test execute of xdma008 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xDma008Setup(void)
+{
+    //
+    // Set SysClk 50MHz using Extern 12M oscillator
+    //
+    xSysCtlClockSet(50000000, xSYSCTL_OSC_MAIN | xSYSCTL_XTAL_12MHZ);
+
+    SysCtlPeripheralReset(SYSCTL_PERIPH_PDMA);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_PDMA);
+    xIntEnable(INT_PDMA);
+
+    xSysTickPeriodSet(0xFFFFFF);
+    xSysTickEnable();
+}
+
+//*****************************************************************************
+//
+//! \brief something should do after the test execute of xdma008 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xDma008TearDown(void)
+{
+    unsigned long ulTemp;
+
+    xSysTickDisable();
+    xIntDisable(INT_PDMA);
+    PDMAMemThresholdSet(PDMA_MEM_CPU_THRESHOLD);
+
+    ulTemp = SYSCTL_SYSDIV_1|SYSCTL_XTAL_12MHZ|SYSCTL_OSC_MAIN|SYSCTL_PLL_PWRDN
+                                                           | SYSCTL_INT_OSC_DIS;
+    SysCtlHClockSet(ulTemp);
+
+    SysCtlPeripheralClockSourceSet(SYSCTL_PERIPH_UART_S_EXT12M);
+    SysCtlIPClockDividerSet(SYSCTL_PERIPH_UART_D|0);
+
+    SysCtlPeripheralDisable(SYSCTL_PERIPH_PDMA);
+}
+
+//*****************************************************************************
+//
+//! \brief xdma 008 test of the copy and fill results.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xdmaMemFunctionTest(void)
+{
+    unsigned char *pucDst = (unsigned char *)ulMemDst;
+    unsigned long i, ulDstOff, ulSrcOff, ulTimeout;
+
+    for(i = 0; i < sizeof(ulMemSrc); i++)
+    {
+        ((unsigned char *)ulMemSrc)[i] = i * 7 + 1;
+    }
+
+    //
+    // Every source and destination offset in a word, through the PDMA.
+    //
+    PDMAMemThresholdSet(0);
+    for(ulDstOff = 0; ulDstOff < 4; ulDstOff++)
+    {
+        for(ulSrcOff = 0; ulSrcOff < 4; ulSrcOff++)
+        {
+            for(i = 0; i < sizeof(ulMemDst); i++)
+            {
+                pucDst[i] = 0xEE;
+            }
+            TestAssert(PDMAMemCopy(pucDst + ulDstOff,
+                                   (unsigned char *)ulMemSrc + ulSrcOff,
+                                   301, 0, 0) == xtrue, "dma API error!");
+            TestAssert(xdmaMemCheck(ulDstOff, ulSrcOff, 301) == xtrue,
+                       "dma API error!");
+        }
+    }
+
+    //
+    // Unaligned fill, the bytes around it are left alone.
+    //
+    for(i = 0; i < sizeof(ulMemDst); i++)
+    {
+        pucDst[i] = 0xEE;
+    }
+    TestAssert(PDMAMemFill(pucDst + 3, 0x5A, 250, 0, 0) == xtrue,
+               "dma API error!");
+    TestAssert(pucDst[2] == 0xEE, "dma API error!");
+    TestAssert(pucDst[253] == 0xEE, "dma API error!");
+    for(i = 3; i < 253; i++)
+    {
+        TestAssert(pucDst[i] == 0x5A, "dma API error!");
+    }
+
+    //
+    // Callback completion, the caller returns before the copy is done.
+    //
+    for(i = 0; i < sizeof(ulMemDst); i++)
+    {
+        pucDst[i] = 0xEE;
+    }
+    ulMemCalls = 0;
+    PDMAMemCopy(ulMemDst, ulMemSrc, 2048, xdmaMemCallback, 0);
+    ulTimeout = 0x10000;
+    while(PDMAMemBusy() && (ulTimeout != 0))
+    {
+        ulTimeout--;
+    }
+    TestAssert(ulTimeout != 0, "dma API error!");
+    TestAssert(ulMemCalls == 1, "dma API error!");
+    TestAssert(ulMemEvent == PDMA_EVENT_TC, "dma API error!");
+    TestAssert(pvMemData == ulMemDst, "dma API error!");
+    TestAssert(xdmaMemCheck(0, 0, 2048) == xtrue, "dma API error!");
+
+    //
+    // Below the threshold the CPU does it and calls back at once.
+    //
+    PDMAMemThresholdSet(PDMA_MEM_CPU_THRESHOLD);
+    ulMemCalls = 0;
+    PDMAMemFill(ulMemDst, 0, 8, xdmaMemCallback, 0);
+    TestAssert(ulMemCalls == 1, "dma API error!");
+    TestAssert((ulMemDst[0] == 0) && (ulMemDst[1] == 0), "dma API error!");
+}
+
+//*****************************************************************************
+//
+//! \brief xdma 008 benchmark of the PDMA against the CPU copy loop.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xdmaMemBenchTest(void)
+{
+    unsigned long i, j, ulStart;
+
+    g_ulDMAMemCrossover = 0;
+    for(i = 0; i < DMA_MEM_BENCH_SIZES; i++)
+    {
+        for(j = 0; j < 2; j++)
+        {
+            //
+            // A threshold above the size forces the CPU, 0 the PDMA.
+            //
+            PDMAMemThresholdSet((j == 0) ? 0xFFFFFFFF : 0);
+            ulStart = xSysTickValueGet();
+            PDMAMemCopy(ulMemDst, ulMemSrc, ulMemBenchSize[i], 0, 0);
+            g_ulDMAMemBenchTicks[i][j] = (ulStart - xSysTickValueGet()) &
+                                         0xFFFFFF;
+        }
+        if((g_ulDMAMemCrossover == 0) &&
+           (g_ulDMAMemBenchTicks[i][1] < g_ulDMAMemBenchTicks[i][0]))
+        {
+            g_ulDMAMemCrossover = ulMemBenchSize[i];
+        }
+    }
+
+    //
+    // The PDMA is started and waited for by the CPU, a small block must
+    // not be faster by PDMA.
+    //
+    TestAssert(g_ulDMAMemBenchTicks[0][1] >= g_ulDMAMemBenchTicks[0][0],
+               "dma API error!");
+}
+
+//*****************************************************************************
+//
+//! \brief xdma 008 test execute main body.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xDma008Execute(void)
+{
+    xdmaMemFunctionTest();
+    xdmaMemBenchTest();
+}
+
+//
+// xdma memory test case struct.
+//
+const tTestCase sTestXDma008 = {
+    xDma008GetTest,
+    xDma008Setup,
+    xDma008TearDown,
+    xDma008Execute
+};
+
+//
+// Xdma test suits.
+//
+const tTestCase * const psPatternXdma07[] =
+{
+    &sTestXDma008,
+    0
+};
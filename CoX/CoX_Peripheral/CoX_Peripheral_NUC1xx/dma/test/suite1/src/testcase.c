@@ -28,6 +28,9 @@ const tTestCase * const* g_psPatterns[] =  {
     psPatternXdma02,
     psPatternXdma03,
     psPatternXdma04,
+    psPatternXdma05,
+    psPatternXdma06,
+    psPatternXdma07,
     //
     // end
     //
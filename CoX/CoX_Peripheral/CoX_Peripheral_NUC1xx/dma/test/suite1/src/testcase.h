@@ -75,6 +75,9 @@ extern const tTestCase * const psPatternXdma02[];
 
 extern const tTestCase * const psPatternXdma03[];
 extern const tTestCase * const psPatternXdma04[];
+extern const tTestCase * const psPatternXdma05[];
+extern const tTestCase * const psPatternXdma06[];
+extern const tTestCase * const psPatternXdma07[];
 
 //*****************************************************************************
 //
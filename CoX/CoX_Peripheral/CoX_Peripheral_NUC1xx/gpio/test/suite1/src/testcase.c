@@ -25,6 +25,9 @@ const tTestCase * const* g_psPatterns[] =  {
     //
     psPatternxgpio1, 
     psPatternxgpio2,
+    psPatternxgpio3,
+    psPatternxgpio4,
+    psPatternxgpio5,
     
     //
     // end
@@ -59,6 +59,9 @@ extern const tTestCase * const* g_psPatterns[];
 //*****************************************************************************
 extern const tTestCase * const psPatternxgpio1[];
 extern const tTestCase * const psPatternxgpio2[];
+extern const tTestCase * const psPatternxgpio3[];
+extern const tTestCase * const psPatternxgpio4[];
+extern const tTestCase * const psPatternxgpio5[];
 
 
 
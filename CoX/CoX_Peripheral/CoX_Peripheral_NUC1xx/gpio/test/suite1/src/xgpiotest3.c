@@ -0,0 +1,273 @@
+//*****************************************************************************
+//
+//! @page xgpio_testcase xgpio interrupt dispatch test
+//!
+//! File: @ref xgpiotest3.c
+//!
+//! <h2>Description</h2>
+//! This module implements the test sequence for the xgpio sub component.<br><br>
+//! - \p Board: NUC140 <br><br>
+//! - \p Last-Time(about): 0.5s <br><br>
+//! - \p Phenomenon: Success or failure information will be printed on the UART. <br><br>
+//! .
+//!
+//! <h2>Preconditions</h2>
+//! The module requires the following options:<br><br>
+//! - \p Option-define:
+//! <br>(1)None.<br><br>
+//! - \p Option-hardware:
+//! <br>(1)Connect an USB cable to the development board.<br>
+//! (2)PA.12, PA.13 and PC.7 left unconnected.<br><br>
+//! - \p Option-OtherModule:
+//! <br>Connect an COM cable to the development board.<br>
+//! .
+//! In case some of the required options are not enabled then some or all tests
+//! may be skipped or result FAILED.<br>
+//!
+//! <h2>Test Cases</h2>
+//! The module contain those sub tests:<br><br>
+//! - \subpage test_xgpio_dispatch
+//! .
+//! \file xgpiotest3.c
+//! \brief xgpio test source file
+//! \brief xgpio test header file <br>
+//
+//*****************************************************************************
+
+#include "xhw_types.h"
+#include "xhw_memmap.h"
+#include "xhw_ints.h"
+#include "xsysctl.h"
+#include "xgpio.h"
+#include "xcore.h"
+#include "test.h"
+
+//*****************************************************************************
+//
+//!\page test_xgpio_dispatch test_xgpio_dispatch
+//!
+//!<h2>Description</h2>
+//!Test the per pin interrupt dispatch: pins of two ports with their own
+//!callback, the pin, the port and the edge given to each. The pins are
+//!quasi-bidirectional, so writing them makes the edges. <br>
+//!
+//
+//*****************************************************************************
+
+//
+// What the callbacks saw, per pin: PA.12, PA.13 and PC.7.
+//
+static volatile unsigned long ulDispatchCalls[3];
+static unsigned long ulDispatchEvent[3];
+static unsigned long ulDispatchPin[3];
+static void *pvDispatchPort[3];
+
+//*****************************************************************************
+//
+//! \brief Records a call of a pin callback.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+xgpioDispatchRecord(unsigned long ulIndex, unsigned long ulEvent,
+                    unsigned long ulMsgParam, void *pvMsgData)
+{
+    ulDispatchEvent[ulIndex] = ulEvent;
+    ulDispatchPin[ulIndex] = ulMsgParam;
+    pvDispatchPort[ulIndex] = pvMsgData;
+    ulDispatchCalls[ulIndex]++;
+}
+
+//*****************************************************************************
+//
+//! \brief Callbacks of PA.12, PA.13 and PC.7.
+//!
+//! \return 0.
+//
+//*****************************************************************************
+static unsigned long
+xgpioPA12Callback(void *pvCBData, unsigned long ulEvent,
+                  unsigned long ulMsgParam, void *pvMsgData)
+{
+    xgpioDispatchRecord(0, ulEvent, ulMsgParam, pvMsgData);
+    return 0;
+}
+
+static unsigned long
+xgpioPA13Callback(void *pvCBData, unsigned long ulEvent,
+                  unsigned long ulMsgParam, void *pvMsgData)
+{
+    xgpioDispatchRecord(1, ulEvent, ulMsgParam, pvMsgData);
+    return 0;
+}
+
+static unsigned long
+xgpioPC7Callback(void *pvCBData, unsigned long ulEvent,
+                 unsigned long ulMsgParam, void *pvMsgData)
+{
+    xgpioDispatchRecord(2, ulEvent, ulMsgParam, pvMsgData);
+    return 0;
+}
+
+//*****************************************************************************
+//
+//! \brief Waits for a pin callback count.
+//!
+//! \return xtrue if it was reached in time.
+//
+//*****************************************************************************
+static xtBoolean
+xgpioDispatchWait(unsigned long ulIndex, unsigned long ulCalls)
+{
+    unsigned long ulTimeout = 0x10000;
+
+    while((ulDispatchCalls[ulIndex] < ulCalls) && (ulTimeout != 0))
+    {
+        ulTimeout--;
+    }
+    return (ulTimeout != 0) ? xtrue : xfalse;
+}
+
+//*****************************************************************************
+//
+//! \brief Get the Test description of xgpio003 dispatch test.
+//!
+//! \return the desccription of the xgpio003 test.
+//
+//*****************************************************************************
+static char* xgpio003GetTest(void)
+{
+    return "xgpio, 003, xgpio per pin interrupt dispatch test";
+}
+
+//*****************************************************************************
+//
+//! \brief Something should do before the test execute of xgpio003 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xgpio003Setup(void)
+{
+    unsigned long i;
+
+    SysCtlKeyAddrUnlock();
+    xSysCtlClockSet(12000000, xSYSCTL_XTAL_12MHZ | xSYSCTL_OSC_MAIN);
+    xSysCtlPeripheralEnable(xSYSCTL_PERIPH_GPIOA);
+
+    for(i = 0; i < 3; i++)
+    {
+        ulDispatchCalls[i] = 0;
+    }
+
+    //
+    // Quasi-bidirectional pins idle high.
+    //
+    xGPIODirModeSet(xGPIO_PORTA_BASE, xGPIO_PIN_12 | xGPIO_PIN_13,
+                    xGPIO_DIR_MODE_QB);
+    xGPIODirModeSet(xGPIO_PORTC_BASE, xGPIO_PIN_7, xGPIO_DIR_MODE_QB);
+    xGPIOPinWrite(xGPIO_PORTA_BASE, xGPIO_PIN_12 | xGPIO_PIN_13, 1);
+    xGPIOPinWrite(xGPIO_PORTC_BASE, xGPIO_PIN_7, 1);
+}
+
+//*****************************************************************************
+//
+//! \brief Something should do after the test execute of xgpio003 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xgpio003TearDown(void)
+{
+    xIntDisable(xINT_GPIOA);
+    xIntDisable(xINT_GPIOC);
+    xGPIOPinIntDisable(xGPIO_PORTA_BASE, xGPIO_PIN_12 | xGPIO_PIN_13);
+    xGPIOPinIntDisable(xGPIO_PORTC_BASE, xGPIO_PIN_7);
+    xGPIOPinIntCallbackInit(xGPIO_PORTA_BASE, xGPIO_PIN_12 | xGPIO_PIN_13, 0);
+    xGPIOPinIntCallbackInit(xGPIO_PORTC_BASE, xGPIO_PIN_7, 0);
+    xGPIODirModeSet(xGPIO_PORTA_BASE, xGPIO_PIN_12 | xGPIO_PIN_13,
+                    xGPIO_DIR_MODE_IN);
+    xGPIODirModeSet(xGPIO_PORTC_BASE, xGPIO_PIN_7, xGPIO_DIR_MODE_IN);
+}
+
+//*****************************************************************************
+//
+//! \brief xgpio003 test execute main body.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xgpio003Execute(void)
+{
+    xGPIOPinIntCallbackInit(xGPIO_PORTA_BASE, xGPIO_PIN_12, xgpioPA12Callback);
+    xGPIOPinIntCallbackInit(xGPIO_PORTA_BASE, xGPIO_PIN_13, xgpioPA13Callback);
+    xGPIOPinIntCallbackInit(xGPIO_PORTC_BASE, xGPIO_PIN_7, xgpioPC7Callback);
+    xGPIOPinIntEnable(xGPIO_PORTA_BASE, xGPIO_PIN_12, xGPIO_FALLING_EDGE);
+    xGPIOPinIntEnable(xGPIO_PORTA_BASE, xGPIO_PIN_13, xGPIO_RISING_EDGE);
+    xGPIOPinIntEnable(xGPIO_PORTC_BASE, xGPIO_PIN_7, xGPIO_BOTH_EDGES);
+    xIntEnable(xINT_GPIOA);
+    xIntEnable(xINT_GPIOC);
+
+    //
+    // PA.12 falls: only its callback, with its pin and port.
+    //
+    xGPIOPinWrite(xGPIO_PORTA_BASE, xGPIO_PIN_12, 0);
+    TestAssert(xgpioDispatchWait(0, 1) == xtrue, "xgpio API error!");
+    TestAssert(ulDispatchEvent[0] == xGPIO_FALLING_EDGE, "xgpio API error!");
+    TestAssert(ulDispatchPin[0] == xGPIO_PIN_12, "xgpio API error!");
+    TestAssert(pvDispatchPort[0] == (void *)xGPIO_PORTA_BASE,
+               "xgpio API error!");
+    TestAssert(ulDispatchCalls[1] == 0, "xgpio API error!");
+
+    //
+    // PA.13 falls then rises, only the rising edge is enabled.
+    //
+    xGPIOPinWrite(xGPIO_PORTA_BASE, xGPIO_PIN_13, 0);
+    xGPIOPinWrite(xGPIO_PORTA_BASE, xGPIO_PIN_13, 1);
+    TestAssert(xgpioDispatchWait(1, 1) == xtrue, "xgpio API error!");
+    TestAssert(ulDispatchEvent[1] == xGPIO_RISING_EDGE, "xgpio API error!");
+    TestAssert(ulDispatchPin[1] == xGPIO_PIN_13, "xgpio API error!");
+    TestAssert(ulDispatchCalls[0] == 1, "xgpio API error!");
+
+    //
+    // PC.7 on both edges, on the other interrupt of the ports.
+    //
+    xGPIOPinWrite(xGPIO_PORTC_BASE, xGPIO_PIN_7, 0);
+    TestAssert(xgpioDispatchWait(2, 1) == xtrue, "xgpio API error!");
+    TestAssert(ulDispatchEvent[2] == xGPIO_FALLING_EDGE, "xgpio API error!");
+    xGPIOPinWrite(xGPIO_PORTC_BASE, xGPIO_PIN_7, 1);
+    TestAssert(xgpioDispatchWait(2, 2) == xtrue, "xgpio API error!");
+    TestAssert(ulDispatchEvent[2] == xGPIO_RISING_EDGE, "xgpio API error!");
+    TestAssert(pvDispatchPort[2] == (void *)xGPIO_PORTC_BASE,
+               "xgpio API error!");
+
+    //
+    // Without its callback a pin is only cleared.
+    //
+    xGPIOPinIntCallbackInit(xGPIO_PORTA_BASE, xGPIO_PIN_12, 0);
+    xGPIOPinWrite(xGPIO_PORTA_BASE, xGPIO_PIN_12, 1);
+    xGPIOPinWrite(xGPIO_PORTA_BASE, xGPIO_PIN_12, 0);
+    TestAssert(xgpioDispatchWait(0, 2) == xfalse, "xgpio API error!");
+    TestAssert((xGPIOPinIntStatus(xGPIO_PORTA_BASE) & xGPIO_PIN_12) == 0,
+               "xgpio API error!");
+}
+
+//
+// xgpio003 dispatch test case struct.
+//
+const tTestCase sTestxGpio003Dispatch = {
+    xgpio003GetTest,
+    xgpio003Setup,
+    xgpio003TearDown,
+    xgpio003Execute
+};
+
+//
+// Xgpio test suits.
+//
+const tTestCase * const psPatternxgpio3[] =
+{
+    &sTestxGpio003Dispatch,
+    0
+};
@@ -0,0 +1,234 @@
+//*****************************************************************************
+//
+//! @page xgpio_testcase xgpio bit output test
+//!
+//! File: @ref xgpiotest4.c
+//!
+//! <h2>Description</h2>
+//! This module implements the test sequence for the xgpio sub component.<br><br>
+//! - \p Board: NUC140 <br><br>
+//! - \p Last-Time(about): 0.5s <br><br>
+//! - \p Phenomenon: Success or failure information will be printed on the UART. <br><br>
+//! .
+//!
+//! <h2>Preconditions</h2>
+//! The module requires the following options:<br><br>
+//! - \p Option-define:
+//! <br>(1)None.<br><br>
+//! - \p Option-hardware:
+//! <br>(1)Connect an USB cable to the development board.<br>
+//! (2)PC.12 and PC.13 left unconnected, or driving LEDs only.<br><br>
+//! - \p Option-OtherModule:
+//! <br>Connect an COM cable to the development board.<br>
+//! .
+//! In case some of the required options are not enabled then some or all tests
+//! may be skipped or result FAILED.<br>
+//!
+//! <h2>Test Cases</h2>
+//! The module contain those sub tests:<br><br>
+//! - \subpage test_xgpio_bit_write
+//! .
+//! \file xgpiotest4.c
+//! \brief xgpio test source file
+//! \brief xgpio test header file <br>
+//
+//*****************************************************************************
+
+#include "xhw_types.h"
+#include "xhw_memmap.h"
+#include "xhw_ints.h"
+#include "xhw_gpio.h"
+#include "xsysctl.h"
+#include "xgpio.h"
+#include "xcore.h"
+#include "test.h"
+
+//*****************************************************************************
+//
+//!\page test_xgpio_bit_write test_xgpio_bit_write
+//!
+//!<h2>Description</h2>
+//!Test the single pin writes through the bit output registers: only the pin
+//!written changes, and the toggle rate against the read-modify-write of
+//!GPIO_DOUT, timed with SysTick. <br>
+//!
+//
+//*****************************************************************************
+
+//
+// Number of toggles timed per write form.
+//
+#define GPIO_TEST_BENCH_TOGGLES 1000
+
+//
+// SysTick ticks spent on the toggles, [0] for the read-modify-write of
+// GPIO_DOUT, [1] for GPIOPinWrite() and [2] for xGPIOSPinWrite(). Left in
+// RAM for inspection with a debugger.
+//
+unsigned long g_ulGPIOBenchTicks[3];
+
+//*****************************************************************************
+//
+//! \brief Get the Test description of xgpio004 bit write test.
+//!
+//! \return the desccription of the xgpio004 test.
+//
+//*****************************************************************************
+static char* xgpio004GetTest(void)
+{
+    return "xgpio, 004, xgpio bit output register write test";
+}
+
+//*****************************************************************************
+//
+//! \brief Something should do before the test execute of xgpio004 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xgpio004Setup(void)
+{
+    SysCtlKeyAddrUnlock();
+    xSysCtlClockSet(12000000, xSYSCTL_XTAL_12MHZ | xSYSCTL_OSC_MAIN);
+    xSysCtlPeripheralEnable(xSYSCTL_PERIPH_GPIOC);
+
+    xGPIODirModeSet(xGPIO_PORTC_BASE, xGPIO_PIN_12 | xGPIO_PIN_13,
+                    xGPIO_DIR_MODE_OUT);
+    xGPIOPinWrite(xGPIO_PORTC_BASE, xGPIO_PIN_12 | xGPIO_PIN_13, 1);
+
+    xSysTickPeriodSet(0xFFFFFF);
+    xSysTickEnable();
+}
+
+//*****************************************************************************
+//
+//! \brief Something should do after the test execute of xgpio004 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xgpio004TearDown(void)
+{
+    xSysTickDisable();
+    xGPIOPinWrite(xGPIO_PORTC_BASE, xGPIO_PIN_12 | xGPIO_PIN_13, 1);
+    xGPIODirModeSet(xGPIO_PORTC_BASE, xGPIO_PIN_12 | xGPIO_PIN_13,
+                    xGPIO_DIR_MODE_IN);
+}
+
+//*****************************************************************************
+//
+//! \brief xgpio004 test of the pin writes.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xgpio_BitWrite_test(void)
+{
+    //
+    // The bit register of a pin is the one of its port and pin.
+    //
+    TestAssert(GPIOPinBitAddr(GPIO_PORTC_BASE, GPIO_PIN_12) ==
+               GPIO_PORTA_BASE + GPIOC12_DOUT,
+               "xgpio, \"GPIOPinBitAddr\" error!");
+    TestAssert(GPIOPinIndex(GPIO_PIN_0) == 0,
+               "xgpio, \"GPIOPinIndex\" error!");
+    TestAssert(GPIOPinIndex(GPIO_PIN_15) == 15,
+               "xgpio, \"GPIOPinIndex\" error!");
+
+    //
+    // Only the pin written changes.
+    //
+    xGPIOSPinWrite(PC12, 0);
+    TestAssert((xHWREG(GPIO_PORTC_BASE + GPIO_DOUT) &
+                (GPIO_PIN_12 | GPIO_PIN_13)) == GPIO_PIN_13,
+               "xgpio, \"GPIOSPinWrite\" error!");
+    xGPIOPinWrite(xGPIO_PORTC_BASE, xGPIO_PIN_13, 0);
+    TestAssert((xHWREG(GPIO_PORTC_BASE + GPIO_DOUT) &
+                (GPIO_PIN_12 | GPIO_PIN_13)) == 0,
+               "xgpio, \"GPIOPinWrite\" error!");
+    xGPIOSPinWrite(PC12, 1);
+    TestAssert((xHWREG(GPIO_PORTC_BASE + GPIO_DOUT) &
+                (GPIO_PIN_12 | GPIO_PIN_13)) == GPIO_PIN_12,
+               "xgpio, \"GPIOSPinWrite\" error!");
+
+    //
+    // Several pins at once.
+    //
+    xGPIOPinWrite(xGPIO_PORTC_BASE, xGPIO_PIN_12 | xGPIO_PIN_13, 1);
+    TestAssert((xHWREG(GPIO_PORTC_BASE + GPIO_DOUT) &
+                (GPIO_PIN_12 | GPIO_PIN_13)) == (GPIO_PIN_12 | GPIO_PIN_13),
+               "xgpio, \"GPIOPinWrite\" error!");
+}
+
+//*****************************************************************************
+//
+//! \brief xgpio004 toggle rate of the write forms.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xgpio_BitWriteBench_test(void)
+{
+    unsigned long i, ulStart;
+
+    ulStart = xSysTickValueGet();
+    for(i = 0; i < GPIO_TEST_BENCH_TOGGLES; i++)
+    {
+        xHWREG(GPIO_PORTC_BASE + GPIO_DOUT) =
+            ((i & 1) ? (xHWREG(GPIO_PORTC_BASE + GPIO_DOUT) | GPIO_PIN_12) :
+                       (xHWREG(GPIO_PORTC_BASE + GPIO_DOUT) & ~GPIO_PIN_12));
+    }
+    g_ulGPIOBenchTicks[0] = (ulStart - xSysTickValueGet()) & 0xFFFFFF;
+
+    ulStart = xSysTickValueGet();
+    for(i = 0; i < GPIO_TEST_BENCH_TOGGLES; i++)
+    {
+        xGPIOPinWrite(xGPIO_PORTC_BASE, xGPIO_PIN_12, i);
+    }
+    g_ulGPIOBenchTicks[1] = (ulStart - xSysTickValueGet()) & 0xFFFFFF;
+
+    ulStart = xSysTickValueGet();
+    for(i = 0; i < GPIO_TEST_BENCH_TOGGLES; i++)
+    {
+        xGPIOSPinWrite(PC12, i);
+    }
+    g_ulGPIOBenchTicks[2] = (ulStart - xSysTickValueGet()) & 0xFFFFFF;
+
+    //
+    // The bit store beats the read-modify-write it replaces.
+    //
+    TestAssert(g_ulGPIOBenchTicks[2] < g_ulGPIOBenchTicks[0],
+               "xgpio, \"GPIOSPinWrite\" error!");
+}
+
+//*****************************************************************************
+//
+//! \brief xgpio004 test execute main body.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xgpio004Execute(void)
+{
+    xgpio_BitWrite_test();
+    xgpio_BitWriteBench_test();
+}
+
+//
+// xgpio bit write test case struct.
+//
+const tTestCase sTestxGpio004BitWrite = {
+    xgpio004GetTest,
+    xgpio004Setup,
+    xgpio004TearDown,
+    xgpio004Execute
+};
+
+//
+// xgpio test suits.
+//
+const tTestCase * const psPatternxgpio4[] =
+{
+    &sTestxGpio004BitWrite,
+    0
+};
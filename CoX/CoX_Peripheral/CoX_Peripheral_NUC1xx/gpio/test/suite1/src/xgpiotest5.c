@@ -0,0 +1,308 @@
+//*****************************************************************************
+//
+//! @page xgpio_testcase xgpio parallel bus test
+//!
+//! File: @ref xgpiotest5.c
+//!
+//! <h2>Description</h2>
+//! This module implements the test sequence for the xgpio sub component.<br><br>
+//! - \p Board: NUC140 <br><br>
+//! - \p Last-Time(about): 0.5s <br><br>
+//! - \p Phenomenon: Success or failure information will be printed on the UART. <br><br>
+//! .
+//!
+//! <h2>Preconditions</h2>
+//! The module requires the following options:<br><br>
+//! - \p Option-define:
+//! <br>(1)None.<br><br>
+//! - \p Option-hardware:
+//! <br>(1)Connect an USB cable to the development board.<br>
+//! (2)PC.12 - PC.15, PE.0, PE.1 and PE.5 left unconnected, or driving LEDs
+//! only.<br><br>
+//! - \p Option-OtherModule:
+//! <br>Connect an COM cable to the development board.<br>
+//! .
+//! In case some of the required options are not enabled then some or all tests
+//! may be skipped or result FAILED.<br>
+//!
+//! <h2>Test Cases</h2>
+//! The module contain those sub tests:<br><br>
+//! - \subpage test_xgpio_bus
+//! .
+//! \file xgpiotest5.c
+//! \brief xgpio test source file
+//! \brief xgpio test header file <br>
+//
+//*****************************************************************************
+
+#include "xhw_types.h"
+#include "xhw_memmap.h"
+#include "xhw_ints.h"
+#include "xhw_gpio.h"
+#include "xsysctl.h"
+#include "xgpio.h"
+#include "xcore.h"
+#include "test.h"
+
+//*****************************************************************************
+//
+//!\page test_xgpio_bus test_xgpio_bus
+//!
+//!<h2>Description</h2>
+//!Test the GPIO parallel bus: runs of contiguous and scattered data pins,
+//!data written to GPIO_DOUT and read back from GPIO_PIN, the strobes, and
+//!the write rate against pin by pin writes, timed with SysTick. <br>
+//!
+//
+//*****************************************************************************
+
+//
+// Number of bus writes timed per write form.
+//
+#define GPIO_TEST_BENCH_WRITES  100
+
+//
+// Data pins of the buses: PC.12 - PC.15 in order, the same out of order,
+// and PE.5, PE.0, PE.1, the last two below their data bits.
+//
+static const unsigned long ulBusPinsIn[4] =
+{
+    GPIO_PIN_12, GPIO_PIN_13, GPIO_PIN_14, GPIO_PIN_15
+};
+static const unsigned long ulBusPinsOut[4] =
+{
+    GPIO_PIN_14, GPIO_PIN_15, GPIO_PIN_12, GPIO_PIN_13
+};
+static const unsigned long ulBusPinsDown[3] =
+{
+    GPIO_PIN_5, GPIO_PIN_0, GPIO_PIN_1
+};
+
+static tGPIOBus sBus;
+
+//
+// SysTick ticks spent on the bus writes, [0] for pin by pin writes of the
+// 4 data pins and [1] for GPIOBusDataWrite(). Left in RAM for inspection
+// with a debugger.
+//
+unsigned long g_ulGPIOBusBenchTicks[2];
+
+//*****************************************************************************
+//
+//! \brief Get the Test description of xgpio005 bus test.
+//!
+//! \return the desccription of the xgpio005 test.
+//
+//*****************************************************************************
+static char* xgpio005GetTest(void)
+{
+    return "xgpio, 005, xgpio parallel bus test";
+}
+
+//*****************************************************************************
+//
+//! \brief Something should do before the test execute of xgpio005 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xgpio005Setup(void)
+{
+    SysCtlKeyAddrUnlock();
+    xSysCtlClockSet(12000000, xSYSCTL_XTAL_12MHZ | xSYSCTL_OSC_MAIN);
+    xSysCtlPeripheralEnable(xSYSCTL_PERIPH_GPIOC);
+    xSysCtlPeripheralEnable(xSYSCTL_PERIPH_GPIOE);
+
+    xSysTickPeriodSet(0xFFFFFF);
+    xSysTickEnable();
+}
+
+//*****************************************************************************
+//
+//! \brief Something should do after the test execute of xgpio005 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xgpio005TearDown(void)
+{
+    xSysTickDisable();
+    xGPIOPinWrite(xGPIO_PORTC_BASE, xGPIO_PIN_12 | xGPIO_PIN_13 |
+                  xGPIO_PIN_14 | xGPIO_PIN_15, 1);
+    xGPIODirModeSet(xGPIO_PORTC_BASE, xGPIO_PIN_12 | xGPIO_PIN_13 |
+                    xGPIO_PIN_14 | xGPIO_PIN_15, xGPIO_DIR_MODE_IN);
+    xGPIODirModeSet(xGPIO_PORTE_BASE, xGPIO_PIN_0 | xGPIO_PIN_1 |
+                    xGPIO_PIN_5, xGPIO_DIR_MODE_IN);
+}
+
+//*****************************************************************************
+//
+//! \brief xgpio005 test of the data pins of a bus.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xgpio_BusData_test(void)
+{
+    unsigned long i;
+
+    //
+    // Contiguous pins make one run.
+    //
+    GPIOBusInit(&sBus, GPIO_PORTC_BASE, ulBusPinsIn, 4);
+    TestAssert((sBus.ulRuns == 1) && (sBus.lRunShift[0] == 12) &&
+               (sBus.ulPins == 0xF000),
+               "xgpio, \"GPIOBusInit\" error!");
+    TestAssert(((xHWREG(GPIO_PORTC_BASE + GPIO_PMD) >> 24) & 0xFF) == 0x55,
+               "xgpio, \"GPIOBusInit\" error!");
+    for(i = 0; i < 16; i++)
+    {
+        GPIOBusDataWrite(&sBus, i);
+        TestAssert((xHWREG(GPIO_PORTC_BASE + GPIO_DOUT) & 0xF000) == i << 12,
+                   "xgpio, \"GPIOBusDataWrite\" error!");
+        TestAssert(GPIOBusDataRead(&sBus) == i,
+                   "xgpio, \"GPIOBusDataRead\" error!");
+    }
+
+    //
+    // Scattered pins, a run per pair.
+    //
+    GPIOBusInit(&sBus, GPIO_PORTC_BASE, ulBusPinsOut, 4);
+    TestAssert((sBus.ulRuns == 2) && (sBus.ulRunBits[0] == 3) &&
+               (sBus.lRunShift[0] == 14) && (sBus.ulRunBits[1] == 0xC) &&
+               (sBus.lRunShift[1] == 10),
+               "xgpio, \"GPIOBusInit\" error!");
+    GPIOBusDataWrite(&sBus, 0x1);
+    TestAssert((xHWREG(GPIO_PORTC_BASE + GPIO_DOUT) & 0xF000) == GPIO_PIN_14,
+               "xgpio, \"GPIOBusDataWrite\" error!");
+    GPIOBusDataWrite(&sBus, 0x6);
+    TestAssert((xHWREG(GPIO_PORTC_BASE + GPIO_DOUT) & 0xF000) ==
+               (GPIO_PIN_15 | GPIO_PIN_12),
+               "xgpio, \"GPIOBusDataWrite\" error!");
+    for(i = 0; i < 16; i++)
+    {
+        GPIOBusDataWrite(&sBus, i);
+        TestAssert(GPIOBusDataRead(&sBus) == i,
+                   "xgpio, \"GPIOBusDataRead\" error!");
+    }
+
+    //
+    // Pins below their data bits shift right.
+    //
+    GPIOBusInit(&sBus, GPIO_PORTE_BASE, ulBusPinsDown, 3);
+    TestAssert((sBus.ulRuns == 2) && (sBus.lRunShift[0] == 5) &&
+               (sBus.lRunShift[1] == -1),
+               "xgpio, \"GPIOBusInit\" error!");
+    for(i = 0; i < 8; i++)
+    {
+        GPIOBusDataWrite(&sBus, i);
+        TestAssert((xHWREG(GPIO_PORTE_BASE + GPIO_DOUT) & 0x23) ==
+                   (((i & 1) << 5) | (i >> 1)),
+                   "xgpio, \"GPIOBusDataWrite\" error!");
+        TestAssert(GPIOBusDataRead(&sBus) == i,
+                   "xgpio, \"GPIOBusDataRead\" error!");
+    }
+}
+
+//*****************************************************************************
+//
+//! \brief xgpio005 test of the strobed cycles of a bus.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xgpio_BusCycle_test(void)
+{
+    //
+    // 2 data pins, RS, RW and E on the port C pins left.
+    //
+    GPIOBusInit(&sBus, GPIO_PORTC_BASE, ulBusPinsIn, 2);
+    GPIOBusStrobeSet(&sBus, GPIO_PORTC_BASE, GPIO_PIN_14,
+                     GPIO_PORTC_BASE, GPIO_PIN_15, 0, 0);
+    GPIOBusTimingSet(&sBus, 1, 1);
+
+    GPIOBusWrite(&sBus, GPIO_BUS_RS_DATA, 2);
+    TestAssert((xHWREG(GPIO_PORTC_BASE + GPIO_DOUT) & 0xF000) ==
+               (GPIO_PIN_13 | GPIO_PIN_14),
+               "xgpio, \"GPIOBusWrite\" error!");
+    GPIOBusWrite(&sBus, GPIO_BUS_RS_COMMAND, 1);
+    TestAssert((xHWREG(GPIO_PORTC_BASE + GPIO_DOUT) & 0xF000) == GPIO_PIN_12,
+               "xgpio, \"GPIOBusWrite\" error!");
+
+    //
+    // A read leaves RW high and the data pins outputs.
+    //
+    GPIOBusRead(&sBus, GPIO_BUS_RS_DATA);
+    TestAssert((xHWREG(GPIO_PORTC_BASE + GPIO_DOUT) & 0xC000) ==
+               (GPIO_PIN_14 | GPIO_PIN_15),
+               "xgpio, \"GPIOBusRead\" error!");
+    TestAssert(((xHWREG(GPIO_PORTC_BASE + GPIO_PMD) >> 24) & 0xF) == 0x5,
+               "xgpio, \"GPIOBusRead\" error!");
+}
+
+//*****************************************************************************
+//
+//! \brief xgpio005 write rate of a bus against pin by pin writes.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xgpio_BusBench_test(void)
+{
+    unsigned long i, ulStart;
+
+    GPIOBusInit(&sBus, GPIO_PORTC_BASE, ulBusPinsIn, 4);
+
+    ulStart = xSysTickValueGet();
+    for(i = 0; i < GPIO_TEST_BENCH_WRITES; i++)
+    {
+        xGPIOSPinWrite(PC12, i & 1);
+        xGPIOSPinWrite(PC13, (i >> 1) & 1);
+        xGPIOSPinWrite(PC14, (i >> 2) & 1);
+        xGPIOSPinWrite(PC15, (i >> 3) & 1);
+    }
+    g_ulGPIOBusBenchTicks[0] = (ulStart - xSysTickValueGet()) & 0xFFFFFF;
+
+    ulStart = xSysTickValueGet();
+    for(i = 0; i < GPIO_TEST_BENCH_WRITES; i++)
+    {
+        GPIOBusDataWrite(&sBus, i);
+    }
+    g_ulGPIOBusBenchTicks[1] = (ulStart - xSysTickValueGet()) & 0xFFFFFF;
+
+    TestAssert(g_ulGPIOBusBenchTicks[1] < g_ulGPIOBusBenchTicks[0],
+               "xgpio, \"GPIOBusDataWrite\" error!");
+}
+
+//*****************************************************************************
+//
+//! \brief xgpio005 test execute main body.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xgpio005Execute(void)
+{
+    xgpio_BusData_test();
+    xgpio_BusCycle_test();
+    xgpio_BusBench_test();
+}
+
+//
+// xgpio parallel bus test case struct.
+//
+const tTestCase sTestxGpio005Bus = {
+    xgpio005GetTest,
+    xgpio005Setup,
+    xgpio005TearDown,
+    xgpio005Execute
+};
+
+//
+// xgpio test suits.
+//
+const tTestCase * const psPatternxgpio5[] =
+{
+    &sTestxGpio005Bus,
+    0
+};
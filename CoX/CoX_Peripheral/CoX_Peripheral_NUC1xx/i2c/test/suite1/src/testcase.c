@@ -28,6 +28,11 @@ const tTestCase * const* g_psPatterns[] =  {
  //  psPatternXi2c002,
     psPatternXi2c003,
  //   psPatternXi2c004,
+    psPatternXi2c005,
+    psPatternXi2c006,
+    psPatternXi2c007,
+    psPatternXi2c008,
+    psPatternXi2c009,
     //
     // end
     //
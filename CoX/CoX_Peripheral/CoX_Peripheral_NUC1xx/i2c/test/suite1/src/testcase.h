@@ -61,6 +61,11 @@ extern const tTestCase * const psPatternXi2c001[];
 extern const tTestCase * const psPatternXi2c002[];
 extern const tTestCase * const psPatternXi2c003[];
 extern const tTestCase * const psPatternXi2c004[];
+extern const tTestCase * const psPatternXi2c005[];
+extern const tTestCase * const psPatternXi2c006[];
+extern const tTestCase * const psPatternXi2c007[];
+extern const tTestCase * const psPatternXi2c008[];
+extern const tTestCase * const psPatternXi2c009[];
 
 
 //*****************************************************************************
@@ -0,0 +1,289 @@
+//*****************************************************************************
+//
+//! @page xi2c_testcase xi2c master job queue test
+//!
+//! File: @ref xi2ctest5.c
+//!
+//! <h2>Description</h2>
+//! This module implements the test sequence for the xi2c sub component.<br><br>
+//! - \p Board: NUC140 board <br><br>
+//! - \p Last-Time(about): 0.5s <br><br>
+//! - \p Phenomenon: Success or failure information will be printed on the UART. <br><br>
+//! .
+//!
+//! <h2>Preconditions</h2>
+//! The module requires the following options:<br><br>
+//! - \p Option-define:
+//! <br>(1)None.<br><br>
+//! - \p Option-hardware:
+//! <br>(1)Connect an USB cable to the development board.<br>
+//! (2)Pull-ups on PA.8/PA.9 (I2C0), the sensors at 0x48 and 0x28 are
+//! optional.<br><br>
+//! - \p Option-OtherModule:
+//! <br>Connect an COM cable to the development board.<br>
+//! .
+//! In case some of the required options are not enabled then some or all tests
+//! may be skipped or result FAILED.<br>
+//!
+//! <h2>Test Cases</h2>
+//! The module contain those sub tests:<br><br>
+//! - \subpage test_xi2c_master_job
+//! .
+//! \file xi2ctest5.c
+//! \brief xi2c test source file
+//! \brief xi2c test header file <br>
+//
+//*****************************************************************************
+
+#include "xhw_types.h"
+#include "xhw_memmap.h"
+#include "xhw_ints.h"
+#include "xsysctl.h"
+#include "xgpio.h"
+#include "xi2c.h"
+#include "xcore.h"
+#include "test.h"
+
+//*****************************************************************************
+//
+//!\page test_xi2c_master_job test_xi2c_master_job
+//!
+//!<h2>Description</h2>
+//!Test the I2C master job queue: jobs of several drivers on one bus, run in
+//!order with their own callback and status. <br>
+//!
+//
+//*****************************************************************************
+
+//
+// Number of jobs, the last one is queued by the callback of the first.
+//
+#define I2C_TEST_JOB_COUNT      5
+
+//
+// An STLM75 temperature read, an AD7417 ADC read, an empty job, a write to
+// a reserved address nobody acknowledges, and a second STLM75 read.
+//
+static unsigned char ucJobLM75Reg[1] = {0x00};
+static unsigned char ucJobLM75Temp[2];
+static unsigned char ucJobAD7417Reg[1] = {0x04};
+static unsigned char ucJobAD7417Adc[2];
+static unsigned char ucJobNobody[2] = {0x55, 0xAA};
+static unsigned char ucJobLM75Again[2];
+
+static tI2CMasterJob sI2CJob[I2C_TEST_JOB_COUNT];
+
+//
+// What the callback saw, in call order: job index and status.
+//
+static unsigned long ulJobOrder[I2C_TEST_JOB_COUNT];
+static unsigned long ulJobStatus[I2C_TEST_JOB_COUNT];
+static volatile unsigned long ulJobCalls;
+
+//*****************************************************************************
+//
+//! \brief Job callback of the queue test, records the call.
+//!
+//! \return 0.
+//
+//*****************************************************************************
+static unsigned long
+xi2cJobCallback(void *pvCBData, unsigned long ulEvent,
+                unsigned long ulMsgParam, void *pvMsgData)
+{
+    unsigned long ulIndex = (unsigned long)pvCBData;
+
+    if(ulJobCalls < I2C_TEST_JOB_COUNT)
+    {
+        ulJobOrder[ulJobCalls] = ulIndex;
+        ulJobStatus[ulJobCalls] = ulEvent;
+    }
+    ulJobCalls++;
+
+    //
+    // The first driver reads its sensor again, behind the jobs queued.
+    //
+    if(ulIndex == 0)
+    {
+        I2CMasterJobSubmit(I2C0_BASE, &sI2CJob[4]);
+    }
+    return 0;
+}
+
+//*****************************************************************************
+//
+//! \brief Fills one job of the queue test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+xi2cJobSet(unsigned long ulIndex, unsigned long ulSlave,
+           const void *pvWBuf, unsigned long ulWLen,
+           void *pvRBuf, unsigned long ulRLen)
+{
+    sI2CJob[ulIndex].sCfg.ulSlave = ulSlave;
+    sI2CJob[ulIndex].sCfg.pvWBuf = pvWBuf;
+    sI2CJob[ulIndex].sCfg.ulWLen = ulWLen;
+    sI2CJob[ulIndex].sCfg.pvRBuf = pvRBuf;
+    sI2CJob[ulIndex].sCfg.ulRLen = ulRLen;
+    sI2CJob[ulIndex].pfnCallback = xi2cJobCallback;
+    sI2CJob[ulIndex].pvCBData = (void *)ulIndex;
+}
+
+//*****************************************************************************
+//
+//! \brief Get the Test description of xi2c005 job test.
+//!
+//! \return the desccription of the xi2c005 test.
+//
+//*****************************************************************************
+static char* xI2C005GetTest(void)
+{
+    return "xI2C [005]: Master job queue with interrupt mode";
+}
+
+//*****************************************************************************
+//
+//! \brief something should do before the test execute of xi2c005 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xI2C005Setup(void)
+{
+    SysCtlKeyAddrUnlock();
+    xSysCtlClockSet(12000000, xSYSCTL_XTAL_12MHZ | xSYSCTL_OSC_MAIN);
+
+    //
+    // Congigure the i2c pin
+    //
+    xSPinTypeI2C(I2C0SCK, PA9);
+    xSPinTypeI2C(I2C0DATA, PA8);
+
+    //
+    // Enable the i2c peripheral
+    //
+    xSysCtlPeripheralEnable(xSYSCTL_PERIPH_I2C0);
+    I2CMasterInit(I2C0_BASE, 100000);
+}
+
+//*****************************************************************************
+//
+//! \brief something should do after the test execute of xi2c005 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xI2C005TearDown(void)
+{
+    I2CIntDisable(I2C0_BASE);
+    xSysCtlPeripheralReset(xSYSCTL_PERIPH_I2C0);
+}
+
+//*****************************************************************************
+//
+//! \brief xi2c 005 test of I2CMasterJobSubmit().
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xi2c_I2CMasterJob_test(void)
+{
+    unsigned long i, ulTimeout;
+
+    xi2cJobSet(0, 0x48, ucJobLM75Reg, 1, ucJobLM75Temp, 2);
+    xi2cJobSet(1, 0x28, ucJobAD7417Reg, 1, ucJobAD7417Adc, 2);
+    xi2cJobSet(2, 0x48, 0, 0, 0, 0);
+    xi2cJobSet(3, 0x7F, ucJobNobody, 2, 0, 0);
+    xi2cJobSet(4, 0x48, 0, 0, ucJobLM75Again, 2);
+
+    //
+    // Four jobs queued at once, the caller does not wait.
+    //
+    ulJobCalls = 0;
+    for(i = 0; i < 4; i++)
+    {
+        I2CMasterJobSubmit(I2C0_BASE, &sI2CJob[i]);
+    }
+    TestAssert(sI2CJob[3].ulStatus == I2C_JOB_PENDING,
+               "xi2c, \"I2C MasterJobSubmit\" error!");
+    TestAssert(I2CMasterJobBusy(I2C0_BASE) == xtrue,
+               "xi2c, \"I2C MasterJobBusy\" error!");
+
+    ulTimeout = 0x100000;
+    while(I2CMasterJobBusy(I2C0_BASE) && (ulTimeout != 0))
+    {
+        ulTimeout--;
+    }
+    TestAssert(ulTimeout != 0, "xi2c, \"I2C MasterJobSubmit\" error!");
+    TestAssert(ulJobCalls == I2C_TEST_JOB_COUNT,
+               "xi2c, \"I2C MasterJobSubmit\" error!");
+
+    //
+    // Queue order, then the job queued from the callback.
+    //
+    for(i = 0; i < I2C_TEST_JOB_COUNT; i++)
+    {
+        TestAssert(ulJobOrder[i] == i, "xi2c, \"I2C MasterJobSubmit\" error!");
+        TestAssert(ulJobStatus[i] == sI2CJob[i].ulStatus,
+                   "xi2c, \"I2C MasterJobSubmit\" error!");
+        TestAssert(sI2CJob[i].ulStatus != I2C_JOB_PENDING,
+                   "xi2c, \"I2C MasterJobSubmit\" error!");
+    }
+
+    //
+    // A job without data needs no slave, nobody answers the reserved
+    // address. The sensors may be fitted or not, a missing one is a NACK.
+    //
+    TestAssert(sI2CJob[2].ulStatus == I2C_JOB_DONE,
+               "xi2c, \"I2C MasterJobSubmit\" error!");
+    TestAssert(sI2CJob[3].ulStatus == I2C_JOB_NACK,
+               "xi2c, \"I2C MasterJobSubmit\" error!");
+    for(i = 0; i < I2C_TEST_JOB_COUNT; i++)
+    {
+        if(sI2CJob[i].ulStatus == I2C_JOB_DONE)
+        {
+            TestAssert(sI2CJob[i].sCfg.ulWCount == sI2CJob[i].sCfg.ulWLen,
+                       "xi2c, \"I2C MasterJobSubmit\" error!");
+            TestAssert(sI2CJob[i].sCfg.ulRCount == sI2CJob[i].sCfg.ulRLen,
+                       "xi2c, \"I2C MasterJobSubmit\" error!");
+        }
+        else
+        {
+            TestAssert(sI2CJob[i].ulStatus == I2C_JOB_NACK,
+                       "xi2c, \"I2C MasterJobSubmit\" error!");
+        }
+    }
+}
+
+//*****************************************************************************
+//
+//! \brief xi2c 005 test execute main body.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xI2C005Execute(void)
+{
+    xi2c_I2CMasterJob_test();
+}
+
+//
+// xi2c master job queue test case struct.
+//
+const tTestCase sTestxI2C005MasterJob = {
+    xI2C005GetTest,
+    xI2C005Setup,
+    xI2C005TearDown,
+    xI2C005Execute
+};
+
+//
+// Xi2c test suits.
+//
+const tTestCase * const psPatternXi2c005[] =
+{
+    &sTestxI2C005MasterJob,
+    0
+};
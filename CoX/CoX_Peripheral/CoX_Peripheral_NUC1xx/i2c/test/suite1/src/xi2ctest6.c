@@ -0,0 +1,206 @@
+//*****************************************************************************
+//
+//! @page xi2c_testcase xi2c bus error and recovery test
+//!
+//! File: @ref xi2ctest6.c
+//!
+//! <h2>Description</h2>
+//! This module implements the test sequence for the xi2c sub component.<br><br>
+//! - \p Board: NUC140 board <br><br>
+//! - \p Last-Time(about): 0.5s <br><br>
+//! - \p Phenomenon: Success or failure information will be printed on the UART. <br><br>
+//! .
+//!
+//! <h2>Preconditions</h2>
+//! The module requires the following options:<br><br>
+//! - \p Option-define:
+//! <br>(1)None.<br><br>
+//! - \p Option-hardware:
+//! <br>(1)Connect an USB cable to the development board.<br>
+//! (2)Pull-ups on PA.8/PA.9 (I2C0).<br><br>
+//! - \p Option-OtherModule:
+//! <br>Connect an COM cable to the development board.<br>
+//! .
+//! In case some of the required options are not enabled then some or all tests
+//! may be skipped or result FAILED.<br>
+//!
+//! <h2>Test Cases</h2>
+//! The module contain those sub tests:<br><br>
+//! - \subpage test_xi2c_recover
+//! .
+//! \file xi2ctest6.c
+//! \brief xi2c test source file
+//! \brief xi2c test header file <br>
+//
+//*****************************************************************************
+
+#include "xhw_types.h"
+#include "xhw_memmap.h"
+#include "xhw_ints.h"
+#include "xhw_i2c.h"
+#include "xsysctl.h"
+#include "xgpio.h"
+#include "xi2c.h"
+#include "xcore.h"
+#include "test.h"
+
+//*****************************************************************************
+//
+//!\page test_xi2c_recover test_xi2c_recover
+//!
+//!<h2>Description</h2>
+//!Test the master error codes, the error counters and the bus recovery. <br>
+//!
+//
+//*****************************************************************************
+
+//
+// Nobody acknowledges the reserved address 0x7F.
+//
+static unsigned char ucNobodyBuf[2] = {0x55, 0xAA};
+static tI2CMasterTransferCfg sNobodyCfg;
+
+//*****************************************************************************
+//
+//! \brief Get the Test description of xi2c006 recovery test.
+//!
+//! \return the desccription of the xi2c006 test.
+//
+//*****************************************************************************
+static char* xI2C006GetTest(void)
+{
+    return "xI2C [006]: Master error counters and bus recovery";
+}
+
+//*****************************************************************************
+//
+//! \brief something should do before the test execute of xi2c006 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xI2C006Setup(void)
+{
+    SysCtlKeyAddrUnlock();
+    xSysCtlClockSet(12000000, xSYSCTL_XTAL_12MHZ | xSYSCTL_OSC_MAIN);
+
+    //
+    // Congigure the i2c pin
+    //
+    xSPinTypeI2C(I2C0SCK, PA9);
+    xSPinTypeI2C(I2C0DATA, PA8);
+
+    //
+    // Enable the i2c peripheral
+    //
+    xSysCtlPeripheralEnable(xSYSCTL_PERIPH_I2C0);
+    I2CMasterInit(I2C0_BASE, 100000);
+    I2CErrorCountClear(I2C0_BASE);
+}
+
+//*****************************************************************************
+//
+//! \brief something should do after the test execute of xi2c006 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xI2C006TearDown(void)
+{
+    xSysCtlPeripheralReset(xSYSCTL_PERIPH_I2C0);
+}
+
+//*****************************************************************************
+//
+//! \brief xi2c 006 test of the error codes and of I2CBusRecover().
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xi2c_I2CBusRecover_test(void)
+{
+    tI2CErrorCount sCount;
+    unsigned long ulClk;
+    xtBoolean bRet;
+
+    sNobodyCfg.ulSlave = 0x7F;
+    sNobodyCfg.pvWBuf = ucNobodyBuf;
+    sNobodyCfg.ulWLen = 2;
+    sNobodyCfg.pvRBuf = 0;
+    sNobodyCfg.ulRLen = 0;
+
+    //
+    // A NACK fails the polling transfer and is counted, the timeout
+    // counter is left off as it was found.
+    //
+    bRet = I2CMasterTransfer(I2C0_BASE, &sNobodyCfg, I2C_TRANSFER_POLLING);
+    TestAssert(bRet == xfalse, "xi2c, \"I2C MasterTransfer\" error!");
+    TestAssert(I2CMasterErrorGet(I2C0_BASE) == I2C_MASTER_ERR_NACK,
+               "xi2c, \"I2C MasterErrorGet\" error!");
+    TestAssert(!(xHWREG(I2C0_BASE + I2C_O_TOC) & I2C_TOC_ENTI),
+               "xi2c, \"I2C MasterTransfer\" error!");
+    I2CErrorCountGet(I2C0_BASE, &sCount);
+    TestAssert((sCount.ulNack == 1) && (sCount.ulTimeout == 0) &&
+               (sCount.ulRecover == 0),
+               "xi2c, \"I2C ErrorCountGet\" error!");
+
+    //
+    // Recovery keeps the clock divider and the timeout setting, and the
+    // bus is usable after it.
+    //
+    I2CTimeoutCounterSet(I2C0_BASE, I2C_TIMEOUT_EN, I2C_TIMEOUT_DIV4);
+    ulClk = xHWREG(I2C0_BASE + I2C_O_CLK);
+    I2CBusRecover(I2C0_BASE);
+    TestAssert(xHWREG(I2C0_BASE + I2C_O_CLK) == ulClk,
+               "xi2c, \"I2C BusRecover\" error!");
+    TestAssert((xHWREG(I2C0_BASE + I2C_O_TOC) &
+                (I2C_TOC_ENTI | I2C_TOC_DIV4)) ==
+               (I2C_TOC_ENTI | I2C_TOC_DIV4),
+               "xi2c, \"I2C BusRecover\" error!");
+    TestAssert(xHWREG(I2C0_BASE + I2C_O_CON) & I2C_CON_ENS1,
+               "xi2c, \"I2C BusRecover\" error!");
+
+    bRet = I2CMasterTransfer(I2C0_BASE, &sNobodyCfg, I2C_TRANSFER_POLLING);
+    TestAssert(bRet == xfalse, "xi2c, \"I2C MasterTransfer\" error!");
+    TestAssert(I2CMasterErrorGet(I2C0_BASE) == I2C_MASTER_ERR_NACK,
+               "xi2c, \"I2C MasterErrorGet\" error!");
+    I2CErrorCountGet(I2C0_BASE, &sCount);
+    TestAssert((sCount.ulNack == 2) && (sCount.ulRecover == 1),
+               "xi2c, \"I2C ErrorCountGet\" error!");
+
+    I2CErrorCountClear(I2C0_BASE);
+    I2CErrorCountGet(I2C0_BASE, &sCount);
+    TestAssert((sCount.ulNack == 0) && (sCount.ulRecover == 0),
+               "xi2c, \"I2C ErrorCountClear\" error!");
+}
+
+//*****************************************************************************
+//
+//! \brief xi2c 006 test execute main body.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xI2C006Execute(void)
+{
+    xi2c_I2CBusRecover_test();
+}
+
+//
+// xi2c bus recovery test case struct.
+//
+const tTestCase sTestxI2C006Recover = {
+    xI2C006GetTest,
+    xI2C006Setup,
+    xI2C006TearDown,
+    xI2C006Execute
+};
+
+//
+// Xi2c test suits.
+//
+const tTestCase * const psPatternXi2c006[] =
+{
+    &sTestxI2C006Recover,
+    0
+};
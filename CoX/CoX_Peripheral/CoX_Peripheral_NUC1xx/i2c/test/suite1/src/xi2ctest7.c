@@ -0,0 +1,304 @@
+//*****************************************************************************
+//
+//! @page xi2c_testcase xi2c register map slave test
+//!
+//! File: @ref xi2ctest7.c
+//!
+//! <h2>Description</h2>
+//! This module implements the test sequence for the xi2c sub component.<br><br>
+//! - \p Board: NUC140 board <br><br>
+//! - \p Last-Time(about): 0.5s <br><br>
+//! - \p Phenomenon: Success or failure information will be printed on the UART. <br><br>
+//! .
+//!
+//! <h2>Preconditions</h2>
+//! The module requires the following options:<br><br>
+//! - \p Option-define:
+//! <br>(1)None.<br><br>
+//! - \p Option-hardware:
+//! <br>(1)Connect an USB cable to the development board.<br>
+//! (2)Connect PA.8 to PA.10 and PA.9 to PA.11 (I2C0 to I2C1), with
+//! pull-ups.<br><br>
+//! - \p Option-OtherModule:
+//! <br>Connect an COM cable to the development board.<br>
+//! .
+//! In case some of the required options are not enabled then some or all tests
+//! may be skipped or result FAILED.<br>
+//!
+//! <h2>Test Cases</h2>
+//! The module contain those sub tests:<br><br>
+//! - \subpage test_xi2c_slave_regmap
+//! .
+//! \file xi2ctest7.c
+//! \brief xi2c test source file
+//! \brief xi2c test header file <br>
+//
+//*****************************************************************************
+
+#include "xhw_types.h"
+#include "xhw_memmap.h"
+#include "xhw_ints.h"
+#include "xsysctl.h"
+#include "xgpio.h"
+#include "xi2c.h"
+#include "xcore.h"
+#include "test.h"
+
+//*****************************************************************************
+//
+//!\page test_xi2c_slave_regmap test_xi2c_slave_regmap
+//!
+//!<h2>Description</h2>
+//!Test the register map slave: I2C1 serves the map, I2C0 is the master.
+//!Pointer auto-increment and wrap, write masks and write notify. <br>
+//!
+//
+//*****************************************************************************
+
+//
+// Address the register map is served on.
+//
+#define I2C_TEST_REG_SLAVE      0x3A
+
+//
+// Four registers: register 1 has its high nibble read-only, register 2 is
+// read-only.
+//
+static unsigned char ucRegs[4];
+static const unsigned char ucRegWriteMask[4] = {0xFF, 0x0F, 0x00, 0xFF};
+static tI2CSlaveRegMap sRegMap;
+
+static unsigned char ucRegWBuf[4];
+static unsigned char ucRegRBuf[4];
+static tI2CMasterTransferCfg sRegCfg;
+
+//
+// What the write notify callback saw.
+//
+static volatile unsigned long ulRegNotifyCalls;
+static unsigned long ulRegFirst;
+static unsigned long ulRegWritten;
+static void *pvRegMap;
+
+//*****************************************************************************
+//
+//! \brief Write notify callback of the register map, records the call.
+//!
+//! \return 0.
+//
+//*****************************************************************************
+static unsigned long
+xi2cRegCallback(void *pvCBData, unsigned long ulEvent,
+                unsigned long ulMsgParam, void *pvMsgData)
+{
+    ulRegFirst = ulEvent;
+    ulRegWritten = ulMsgParam;
+    pvRegMap = pvMsgData;
+    ulRegNotifyCalls++;
+    return 0;
+}
+
+//*****************************************************************************
+//
+//! \brief Polling transfer of the master to the register map slave.
+//!
+//! \return xtrue if the slave acknowledged everything.
+//
+//*****************************************************************************
+static xtBoolean
+xi2cRegTransfer(unsigned long ulWLen, unsigned long ulRLen)
+{
+    sRegCfg.ulSlave = I2C_TEST_REG_SLAVE;
+    sRegCfg.pvWBuf = ucRegWBuf;
+    sRegCfg.ulWLen = ulWLen;
+    sRegCfg.pvRBuf = (ulRLen != 0) ? ucRegRBuf : 0;
+    sRegCfg.ulRLen = ulRLen;
+    return I2CMasterTransfer(I2C0_BASE, &sRegCfg, I2C_TRANSFER_POLLING);
+}
+
+//*****************************************************************************
+//
+//! \brief Waits for the write notify of the slave after the STOP.
+//!
+//! \return xtrue if it came in time.
+//
+//*****************************************************************************
+static xtBoolean
+xi2cRegNotifyWait(unsigned long ulCalls)
+{
+    unsigned long ulTimeout = 0x10000;
+
+    while((ulRegNotifyCalls < ulCalls) && (ulTimeout != 0))
+    {
+        ulTimeout--;
+    }
+    return (ulTimeout != 0) ? xtrue : xfalse;
+}
+
+//*****************************************************************************
+//
+//! \brief Get the Test description of xi2c007 register map test.
+//!
+//! \return the desccription of the xi2c007 test.
+//
+//*****************************************************************************
+static char* xI2C007GetTest(void)
+{
+    return "xI2C [007]: Register map slave served from the interrupt";
+}
+
+//*****************************************************************************
+//
+//! \brief something should do before the test execute of xi2c007 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xI2C007Setup(void)
+{
+    SysCtlKeyAddrUnlock();
+    xSysCtlClockSet(12000000, xSYSCTL_XTAL_12MHZ | xSYSCTL_OSC_MAIN);
+
+    //
+    // Congigure the i2c pin
+    //
+    xSPinTypeI2C(I2C0SCK, PA9);
+    xSPinTypeI2C(I2C0DATA, PA8);
+    xSPinTypeI2C(I2C1SCK, PA11);
+    xSPinTypeI2C(I2C1DATA, PA10);
+
+    //
+    // Enable the i2c peripheral
+    //
+    xSysCtlPeripheralEnable(xSYSCTL_PERIPH_I2C0);
+    xSysCtlPeripheralEnable(xSYSCTL_PERIPH_I2C1);
+    I2CMasterInit(I2C0_BASE, 100000);
+    I2CSlaveInit(I2C1_BASE, I2C_TEST_REG_SLAVE, I2C_GENERAL_CALL_DIS);
+}
+
+//*****************************************************************************
+//
+//! \brief something should do after the test execute of xi2c007 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xI2C007TearDown(void)
+{
+    I2CSlaveRegMapSet(I2C1_BASE, 0, 0);
+    I2CIntDisable(I2C1_BASE);
+    xSysCtlPeripheralReset(xSYSCTL_PERIPH_I2C0);
+    xSysCtlPeripheralReset(xSYSCTL_PERIPH_I2C1);
+}
+
+//*****************************************************************************
+//
+//! \brief xi2c 007 test of I2CSlaveRegMapSet().
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xi2c_I2CSlaveRegMap_test(void)
+{
+    xtBoolean bRet;
+
+    ucRegs[0] = 0x10;
+    ucRegs[1] = 0xA5;
+    ucRegs[2] = 0x5A;
+    ucRegs[3] = 0x33;
+    sRegMap.pucRegs = ucRegs;
+    sRegMap.pucWriteMask = ucRegWriteMask;
+    sRegMap.ulCount = 4;
+    sRegMap.pfnCallback = xi2cRegCallback;
+    sRegMap.pvCBData = 0;
+    ulRegNotifyCalls = 0;
+    I2CSlaveRegMapSet(I2C1_BASE, 0, &sRegMap);
+
+    //
+    // Pointer 1, then registers 1 and 2 through their write masks.
+    //
+    ucRegWBuf[0] = 1;
+    ucRegWBuf[1] = 0x11;
+    ucRegWBuf[2] = 0x22;
+    bRet = xi2cRegTransfer(3, 0);
+    TestAssert(bRet == xtrue, "xi2c, \"I2C SlaveRegMapSet\" error!");
+    TestAssert(xi2cRegNotifyWait(1) == xtrue,
+               "xi2c, \"I2C SlaveRegMapSet\" error!");
+    TestAssert((ulRegFirst == 1) && (ulRegWritten == 2) &&
+               (pvRegMap == &sRegMap),
+               "xi2c, \"I2C SlaveRegMapSet\" error!");
+    TestAssert((ucRegs[1] == 0xA1) && (ucRegs[2] == 0x5A),
+               "xi2c, \"I2C SlaveRegMapSet\" error!");
+
+    //
+    // Pointer write, repeated START and a read of three registers. Only
+    // the pointer was written, nothing is notified.
+    //
+    ucRegWBuf[0] = 1;
+    bRet = xi2cRegTransfer(1, 3);
+    TestAssert(bRet == xtrue, "xi2c, \"I2C SlaveRegMapSet\" error!");
+    TestAssert((ucRegRBuf[0] == 0xA1) && (ucRegRBuf[1] == 0x5A) &&
+               (ucRegRBuf[2] == 0x33),
+               "xi2c, \"I2C SlaveRegMapSet\" error!");
+    TestAssert(ulRegNotifyCalls == 1, "xi2c, \"I2C SlaveRegMapSet\" error!");
+
+    //
+    // The pointer wraps from the last register to the first.
+    //
+    ucRegWBuf[0] = 3;
+    ucRegWBuf[1] = 0x44;
+    ucRegWBuf[2] = 0x55;
+    bRet = xi2cRegTransfer(3, 0);
+    TestAssert(bRet == xtrue, "xi2c, \"I2C SlaveRegMapSet\" error!");
+    TestAssert(xi2cRegNotifyWait(2) == xtrue,
+               "xi2c, \"I2C SlaveRegMapSet\" error!");
+    TestAssert((ulRegFirst == 3) && (ulRegWritten == 2),
+               "xi2c, \"I2C SlaveRegMapSet\" error!");
+    TestAssert((ucRegs[3] == 0x44) && (ucRegs[0] == 0x55),
+               "xi2c, \"I2C SlaveRegMapSet\" error!");
+
+    //
+    // A read alone goes on from the pointer kept, register 1.
+    //
+    bRet = xi2cRegTransfer(0, 1);
+    TestAssert(bRet == xtrue, "xi2c, \"I2C SlaveRegMapSet\" error!");
+    TestAssert(ucRegRBuf[0] == 0xA1, "xi2c, \"I2C SlaveRegMapSet\" error!");
+
+    //
+    // Without a map the address is no longer acknowledged.
+    //
+    I2CSlaveRegMapSet(I2C1_BASE, 0, 0);
+    bRet = xi2cRegTransfer(1, 0);
+    TestAssert(bRet == xfalse, "xi2c, \"I2C SlaveRegMapSet\" error!");
+}
+
+//*****************************************************************************
+//
+//! \brief xi2c 007 test execute main body.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xI2C007Execute(void)
+{
+    xi2c_I2CSlaveRegMap_test();
+}
+
+//
+// xi2c register map slave test case struct.
+//
+const tTestCase sTestxI2C007RegMap = {
+    xI2C007GetTest,
+    xI2C007Setup,
+    xI2C007TearDown,
+    xI2C007Execute
+};
+
+//
+// Xi2c test suits.
+//
+const tTestCase * const psPatternXi2c007[] =
+{
+    &sTestxI2C007RegMap,
+    0
+};
@@ -0,0 +1,285 @@
+//*****************************************************************************
+//
+//! @page xi2c_testcase xi2c master interrupt handler benchmark
+//!
+//! File: @ref xi2ctest8.c
+//!
+//! <h2>Description</h2>
+//! This module implements the test sequence for the xi2c sub component.<br><br>
+//! - \p Board: NUC140 board <br><br>
+//! - \p Last-Time(about): 0.5s <br><br>
+//! - \p Phenomenon: Success or failure information will be printed on the UART. <br><br>
+//! .
+//!
+//! <h2>Preconditions</h2>
+//! The module requires the following options:<br><br>
+//! - \p Option-define:
+//! <br>(1)None.<br><br>
+//! - \p Option-hardware:
+//! <br>(1)Connect an USB cable to the development board.<br>
+//! (2)Connect PA.8 to PA.10 and PA.9 to PA.11 (I2C0 to I2C1), with
+//! pull-ups.<br><br>
+//! - \p Option-OtherModule:
+//! <br>Connect an COM cable to the development board.<br>
+//! .
+//! In case some of the required options are not enabled then some or all tests
+//! may be skipped or result FAILED.<br>
+//!
+//! <h2>Test Cases</h2>
+//! The module contain those sub tests:<br><br>
+//! - \subpage test_xi2c_master_bench
+//! .
+//! \file xi2ctest8.c
+//! \brief xi2c test source file
+//! \brief xi2c test header file <br>
+//
+//*****************************************************************************
+
+#include "xhw_types.h"
+#include "xhw_memmap.h"
+#include "xhw_ints.h"
+#include "xhw_i2c.h"
+#include "xsysctl.h"
+#include "xgpio.h"
+#include "xi2c.h"
+#include "xcore.h"
+#include "test.h"
+
+//*****************************************************************************
+//
+//!\page test_xi2c_master_bench test_xi2c_master_bench
+//!
+//!<h2>Description</h2>
+//!Measure the time I2CMasterHandler() takes per data byte. I2C1 serves a
+//!register map, I2C0 runs a master job whose interrupts are taken by the
+//!test, so each handler call can be timed with SysTick. <br>
+//!
+//
+//*****************************************************************************
+
+//
+// Address the register map is served on, and its size.
+//
+#define I2C_TEST_BENCH_SLAVE    0x3B
+#define I2C_TEST_BENCH_REGS     16
+
+static unsigned char ucBenchRegs[I2C_TEST_BENCH_REGS];
+static tI2CSlaveRegMap sBenchMap;
+
+static unsigned char ucBenchWBuf[I2C_TEST_BENCH_REGS + 1];
+static unsigned char ucBenchRBuf[I2C_TEST_BENCH_REGS];
+static tI2CMasterJob sBenchJob;
+
+//
+// SysTick ticks spent in the handler on data bytes, [0] for the write and
+// [1] for the read, and the number of data bytes. Left in RAM for
+// inspection with a debugger.
+//
+unsigned long g_ulI2CMasterBenchTicks[2];
+unsigned long g_ulI2CMasterBenchBytes[2];
+
+//*****************************************************************************
+//
+//! \brief Runs the bench job, calling the master handler on each event.
+//!
+//! \return xtrue if the job ended in time.
+//
+//*****************************************************************************
+static xtBoolean
+xi2cBenchRun(unsigned long ulIndex)
+{
+    unsigned long ulTimeout, ulStatus, ulStart, ulTicks;
+
+    I2CMasterJobSubmit(I2C0_BASE, &sBenchJob);
+    xIntDisable(INT_I2C0);
+
+    g_ulI2CMasterBenchTicks[ulIndex] = 0;
+    g_ulI2CMasterBenchBytes[ulIndex] = 0;
+    ulTimeout = 0x100000;
+    while(I2CMasterJobBusy(I2C0_BASE) && (ulTimeout != 0))
+    {
+        ulTimeout--;
+        if(!(xHWREG(I2C0_BASE + I2C_O_CON) & I2C_CON_SI))
+        {
+            continue;
+        }
+        ulStatus = xHWREG(I2C0_BASE + I2C_O_STATUS) & I2C_STATUS_M;
+        ulStart = xSysTickValueGet();
+        I2CMasterHandler(I2C0_BASE);
+        ulTicks = (ulStart - xSysTickValueGet()) & 0xFFFFFF;
+
+        //
+        // The data byte events, not the address or the end of the job
+        //
+        if((ulStatus == I2C_I2STAT_M_TX_DAT_ACK) ||
+           (ulStatus == I2C_I2STAT_M_RX_DAT_ACK))
+        {
+            g_ulI2CMasterBenchTicks[ulIndex] += ulTicks;
+            g_ulI2CMasterBenchBytes[ulIndex]++;
+        }
+    }
+    xIntPendClear(INT_I2C0);
+    return (ulTimeout != 0) ? xtrue : xfalse;
+}
+
+//*****************************************************************************
+//
+//! \brief Get the Test description of xi2c008 benchmark test.
+//!
+//! \return the desccription of the xi2c008 test.
+//
+//*****************************************************************************
+static char* xI2C008GetTest(void)
+{
+    return "xI2C [008]: Master interrupt handler time per data byte";
+}
+
+//*****************************************************************************
+//
+//! \brief something should do before the test execute of xi2c008 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xI2C008Setup(void)
+{
+    SysCtlKeyAddrUnlock();
+    xSysCtlClockSet(12000000, xSYSCTL_XTAL_12MHZ | xSYSCTL_OSC_MAIN);
+
+    //
+    // Congigure the i2c pin
+    //
+    xSPinTypeI2C(I2C0SCK, PA9);
+    xSPinTypeI2C(I2C0DATA, PA8);
+    xSPinTypeI2C(I2C1SCK, PA11);
+    xSPinTypeI2C(I2C1DATA, PA10);
+
+    //
+    // Enable the i2c peripheral
+    //
+    xSysCtlPeripheralEnable(xSYSCTL_PERIPH_I2C0);
+    xSysCtlPeripheralEnable(xSYSCTL_PERIPH_I2C1);
+    I2CMasterInit(I2C0_BASE, 100000);
+    I2CSlaveInit(I2C1_BASE, I2C_TEST_BENCH_SLAVE, I2C_GENERAL_CALL_DIS);
+
+    xSysTickPeriodSet(0xFFFFFF);
+    xSysTickEnable();
+}
+
+//*****************************************************************************
+//
+//! \brief something should do after the test execute of xi2c008 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xI2C008TearDown(void)
+{
+    xSysTickDisable();
+    I2CSlaveRegMapSet(I2C1_BASE, 0, 0);
+    I2CIntDisable(I2C0_BASE);
+    I2CIntDisable(I2C1_BASE);
+    xSysCtlPeripheralReset(xSYSCTL_PERIPH_I2C0);
+    xSysCtlPeripheralReset(xSYSCTL_PERIPH_I2C1);
+}
+
+//*****************************************************************************
+//
+//! \brief xi2c 008 benchmark of I2CMasterHandler().
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xi2c_I2CMasterHandler_bench(void)
+{
+    unsigned long i;
+
+    sBenchMap.pucRegs = ucBenchRegs;
+    sBenchMap.pucWriteMask = 0;
+    sBenchMap.ulCount = I2C_TEST_BENCH_REGS;
+    sBenchMap.pfnCallback = 0;
+    I2CSlaveRegMapSet(I2C1_BASE, 0, &sBenchMap);
+
+    //
+    // Pointer 0, then every register.
+    //
+    ucBenchWBuf[0] = 0;
+    for(i = 0; i < I2C_TEST_BENCH_REGS; i++)
+    {
+        ucBenchWBuf[i + 1] = 0x80 + i;
+    }
+    sBenchJob.sCfg.ulSlave = I2C_TEST_BENCH_SLAVE;
+    sBenchJob.sCfg.pvWBuf = ucBenchWBuf;
+    sBenchJob.sCfg.ulWLen = I2C_TEST_BENCH_REGS + 1;
+    sBenchJob.sCfg.pvRBuf = 0;
+    sBenchJob.sCfg.ulRLen = 0;
+    sBenchJob.pfnCallback = 0;
+    TestAssert(xi2cBenchRun(0) == xtrue,
+               "xi2c, \"I2C MasterHandler\" error!");
+    TestAssert(sBenchJob.ulStatus == I2C_JOB_DONE,
+               "xi2c, \"I2C MasterHandler\" error!");
+    TestAssert(sBenchJob.sCfg.ulWCount == I2C_TEST_BENCH_REGS + 1,
+               "xi2c, \"I2C MasterHandler\" error!");
+
+    //
+    // Pointer 0, repeated START and every register back.
+    //
+    sBenchJob.sCfg.ulWLen = 1;
+    sBenchJob.sCfg.pvRBuf = ucBenchRBuf;
+    sBenchJob.sCfg.ulRLen = I2C_TEST_BENCH_REGS;
+    TestAssert(xi2cBenchRun(1) == xtrue,
+               "xi2c, \"I2C MasterHandler\" error!");
+    TestAssert(sBenchJob.ulStatus == I2C_JOB_DONE,
+               "xi2c, \"I2C MasterHandler\" error!");
+    TestAssert(sBenchJob.sCfg.ulRCount == I2C_TEST_BENCH_REGS,
+               "xi2c, \"I2C MasterHandler\" error!");
+    for(i = 0; i < I2C_TEST_BENCH_REGS; i++)
+    {
+        TestAssert(ucBenchRBuf[i] == 0x80 + i,
+                   "xi2c, \"I2C MasterHandler\" error!");
+    }
+
+    //
+    // A data byte is one table lookup and one load or store: well under
+    // 150 cycles per byte, against a byte time of 1080 cycles here.
+    //
+    for(i = 0; i < 2; i++)
+    {
+        TestAssert(g_ulI2CMasterBenchBytes[i] != 0,
+                   "xi2c, \"I2C MasterHandler\" error!");
+        TestAssert(g_ulI2CMasterBenchTicks[i] <
+                   150 * g_ulI2CMasterBenchBytes[i],
+                   "xi2c, \"I2C MasterHandler\" error!");
+    }
+}
+
+//*****************************************************************************
+//
+//! \brief xi2c 008 test execute main body.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xI2C008Execute(void)
+{
+    xi2c_I2CMasterHandler_bench();
+}
+
+//
+// xi2c master handler benchmark test case struct.
+//
+const tTestCase sTestxI2C008Bench = {
+    xI2C008GetTest,
+    xI2C008Setup,
+    xI2C008TearDown,
+    xI2C008Execute
+};
+
+//
+// Xi2c test suits.
+//
+const tTestCase * const psPatternXi2c008[] =
+{
+    &sTestxI2C008Bench,
+    0
+};
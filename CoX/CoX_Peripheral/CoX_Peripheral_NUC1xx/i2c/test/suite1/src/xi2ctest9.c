@@ -0,0 +1,233 @@
+//*****************************************************************************
+//
+//! @page xi2c_testcase xi2c sensor register access test
+//!
+//! File: @ref xi2ctest9.c
+//!
+//! <h2>Description</h2>
+//! This module implements the test sequence for the xi2c sub component.<br><br>
+//! - \p Board: NUC140 board <br><br>
+//! - \p Last-Time(about): 0.5s <br><br>
+//! - \p Phenomenon: Success or failure information will be printed on the UART. <br><br>
+//! .
+//!
+//! <h2>Preconditions</h2>
+//! The module requires the following options:<br><br>
+//! - \p Option-define:
+//! <br>(1)None.<br><br>
+//! - \p Option-hardware:
+//! <br>(1)Connect an USB cable to the development board.<br>
+//! (2)Connect PA.8 to PA.10 and PA.9 to PA.11 (I2C0 to I2C1), with
+//! pull-ups.<br><br>
+//! - \p Option-OtherModule:
+//! <br>Connect an COM cable to the development board.<br>
+//! .
+//! In case some of the required options are not enabled then some or all tests
+//! may be skipped or result FAILED.<br>
+//!
+//! <h2>Test Cases</h2>
+//! The module contain those sub tests:<br><br>
+//! - \subpage test_xi2c_reg_access
+//! .
+//! \file xi2ctest9.c
+//! \brief xi2c test source file
+//! \brief xi2c test header file <br>
+//
+//*****************************************************************************
+
+#include "xhw_types.h"
+#include "xhw_memmap.h"
+#include "xhw_ints.h"
+#include "xsysctl.h"
+#include "xgpio.h"
+#include "xi2c.h"
+#include "xcore.h"
+#include "test.h"
+
+//*****************************************************************************
+//
+//!\page test_xi2c_reg_access test_xi2c_reg_access
+//!
+//!<h2>Description</h2>
+//!Test the sensor register access API: I2C1 serves a register map, I2C0
+//!reads and writes it with 8 and 16-bit, burst and batch accesses. <br>
+//!
+//
+//*****************************************************************************
+
+//
+// Address the register map is served on, and its size.
+//
+#define I2C_TEST_REG_DEVICE     0x3C
+#define I2C_TEST_REG_COUNT      8
+
+static unsigned char ucDevRegs[I2C_TEST_REG_COUNT];
+static tI2CSlaveRegMap sDevMap;
+
+//*****************************************************************************
+//
+//! \brief Get the Test description of xi2c009 register access test.
+//!
+//! \return the desccription of the xi2c009 test.
+//
+//*****************************************************************************
+static char* xI2C009GetTest(void)
+{
+    return "xI2C [009]: Sensor register read and write helpers";
+}
+
+//*****************************************************************************
+//
+//! \brief something should do before the test execute of xi2c009 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xI2C009Setup(void)
+{
+    SysCtlKeyAddrUnlock();
+    xSysCtlClockSet(12000000, xSYSCTL_XTAL_12MHZ | xSYSCTL_OSC_MAIN);
+
+    //
+    // Congigure the i2c pin
+    //
+    xSPinTypeI2C(I2C0SCK, PA9);
+    xSPinTypeI2C(I2C0DATA, PA8);
+    xSPinTypeI2C(I2C1SCK, PA11);
+    xSPinTypeI2C(I2C1DATA, PA10);
+
+    //
+    // Enable the i2c peripheral
+    //
+    xSysCtlPeripheralEnable(xSYSCTL_PERIPH_I2C0);
+    xSysCtlPeripheralEnable(xSYSCTL_PERIPH_I2C1);
+    I2CMasterInit(I2C0_BASE, 100000);
+    I2CSlaveInit(I2C1_BASE, I2C_TEST_REG_DEVICE, I2C_GENERAL_CALL_DIS);
+}
+
+//*****************************************************************************
+//
+//! \brief something should do after the test execute of xi2c009 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xI2C009TearDown(void)
+{
+    I2CSlaveRegMapSet(I2C1_BASE, 0, 0);
+    I2CIntDisable(I2C1_BASE);
+    xSysCtlPeripheralReset(xSYSCTL_PERIPH_I2C0);
+    xSysCtlPeripheralReset(xSYSCTL_PERIPH_I2C1);
+}
+
+//*****************************************************************************
+//
+//! \brief xi2c 009 test of the I2CReg API.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xi2c_I2CRegAccess_test(void)
+{
+    unsigned char ucValue, ucBurst[4], ucBatch[3];
+    unsigned short usValue;
+    tI2CRegRead sReads[2];
+    unsigned long i;
+    xtBoolean bRet;
+
+    for(i = 0; i < I2C_TEST_REG_COUNT; i++)
+    {
+        ucDevRegs[i] = 0x40 + i;
+    }
+    sDevMap.pucRegs = ucDevRegs;
+    sDevMap.pucWriteMask = 0;
+    sDevMap.ulCount = I2C_TEST_REG_COUNT;
+    sDevMap.pfnCallback = 0;
+    I2CSlaveRegMapSet(I2C1_BASE, 0, &sDevMap);
+
+    //
+    // 8 and 16-bit writes, MSB first.
+    //
+    bRet = I2CRegWrite8(I2C0_BASE, I2C_TEST_REG_DEVICE, 2, 0x5A);
+    TestAssert(bRet == xtrue, "xi2c, \"I2C RegWrite8\" error!");
+    TestAssert(ucDevRegs[2] == 0x5A, "xi2c, \"I2C RegWrite8\" error!");
+    bRet = I2CRegWrite16(I2C0_BASE, I2C_TEST_REG_DEVICE, 4, 0x1234);
+    TestAssert(bRet == xtrue, "xi2c, \"I2C RegWrite16\" error!");
+    TestAssert((ucDevRegs[4] == 0x12) && (ucDevRegs[5] == 0x34),
+               "xi2c, \"I2C RegWrite16\" error!");
+
+    //
+    // 8 and 16-bit reads.
+    //
+    bRet = I2CRegRead8(I2C0_BASE, I2C_TEST_REG_DEVICE, 2, &ucValue);
+    TestAssert((bRet == xtrue) && (ucValue == 0x5A),
+               "xi2c, \"I2C RegRead8\" error!");
+    bRet = I2CRegRead16(I2C0_BASE, I2C_TEST_REG_DEVICE, 4, &usValue);
+    TestAssert((bRet == xtrue) && (usValue == 0x1234),
+               "xi2c, \"I2C RegRead16\" error!");
+
+    //
+    // A burst over the register pointer auto-increment.
+    //
+    bRet = I2CRegReadBurst(I2C0_BASE, I2C_TEST_REG_DEVICE, 0, ucBurst, 4);
+    TestAssert(bRet == xtrue, "xi2c, \"I2C RegReadBurst\" error!");
+    TestAssert((ucBurst[0] == 0x40) && (ucBurst[1] == 0x41) &&
+               (ucBurst[2] == 0x5A) && (ucBurst[3] == 0x43),
+               "xi2c, \"I2C RegReadBurst\" error!");
+
+    //
+    // Two reads in one transaction.
+    //
+    sReads[0].ucReg = 7;
+    sReads[0].pucBuf = &ucBatch[0];
+    sReads[0].ulLen = 1;
+    sReads[1].ucReg = 4;
+    sReads[1].pucBuf = &ucBatch[1];
+    sReads[1].ulLen = 2;
+    bRet = I2CRegReadBatch(I2C0_BASE, I2C_TEST_REG_DEVICE, sReads, 2);
+    TestAssert(bRet == xtrue, "xi2c, \"I2C RegReadBatch\" error!");
+    TestAssert((ucBatch[0] == 0x47) && (ucBatch[1] == 0x12) &&
+               (ucBatch[2] == 0x34),
+               "xi2c, \"I2C RegReadBatch\" error!");
+
+    //
+    // Nobody acknowledges the reserved address 0x7F.
+    //
+    bRet = I2CRegRead8(I2C0_BASE, 0x7F, 0, &ucValue);
+    TestAssert(bRet == xfalse, "xi2c, \"I2C RegRead8\" error!");
+    TestAssert(I2CMasterErrorGet(I2C0_BASE) == I2C_MASTER_ERR_NACK,
+               "xi2c, \"I2C RegRead8\" error!");
+    bRet = I2CRegReadBatch(I2C0_BASE, 0x7F, sReads, 2);
+    TestAssert(bRet == xfalse, "xi2c, \"I2C RegReadBatch\" error!");
+}
+
+//*****************************************************************************
+//
+//! \brief xi2c 009 test execute main body.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xI2C009Execute(void)
+{
+    xi2c_I2CRegAccess_test();
+}
+
+//
+// xi2c register access test case struct.
+//
+const tTestCase sTestxI2C009RegAccess = {
+    xI2C009GetTest,
+    xI2C009Setup,
+    xI2C009TearDown,
+    xI2C009Execute
+};
+
+//
+// Xi2c test suits.
+//
+const tTestCase * const psPatternXi2c009[] =
+{
+    &sTestxI2C009RegAccess,
+    0
+};
@@ -41,12 +41,32 @@
 #include "xhw_ints.h"
 #include "xhw_memmap.h"
 #include "xhw_types.h"
+#include "xhw_sysctl.h"
 #include "xadc.h"
 #include "xdebug.h"
 #include "xcore.h"
+#include "xdma.h"
+#include "xsysctl.h"
 
 static xtEventCallback g_pfnADCHandlerCallbacks[1] = {0};
 
+//
+// The acquisition running into a PDMA ring, 0 if none.
+//
+static tADCRing *g_psADCRing = 0;
+
+//
+// Filters run at the end of conversion, per channel, and the channels that
+// have one.
+//
+static tADCFilter *g_psADCFilters[8] = {0};
+static unsigned long g_ulADCFilterChannels = 0;
+
+//
+// The threshold watch owning the comparators, 0 if none.
+//
+static tADCWatch *g_psADCWatch = 0;
+
 //*****************************************************************************
 //
 //! \brief Configure the mode and trigger source of a sample sequence.
@@ -276,7 +296,8 @@ xADCCompConditionConfig(unsigned long ulBase, unsigned long ulCompID,
 //! param of pfnCallback
 //! - pvCBData not used, always 0.
 //! - ulEvent is the interrupt event..
-//! - ulMsgParam not used, always 0.
+//! - ulMsgParam is the bit mask of the channels with a new filter output,
+//! see ADCFilterChannelSet(), 0 if none.
 //! - pvMsgData not used, always 0.
 //! .
 //!
@@ -295,6 +316,125 @@ xADCIntCallbackInit(unsigned long ulBase,
     g_pfnADCHandlerCallbacks[0] = pfnCallback;
 }
 
+//*****************************************************************************
+//
+//! \internal
+//! \brief Puts the conversion results into the channel filters.
+//!
+//! \param ulBase is the base address of the ADC module.
+//!
+//! \return the bit mask of the channels with a new filter output.
+//
+//*****************************************************************************
+static unsigned long
+ADCFilterRun(unsigned long ulBase)
+{
+    unsigned long i, ulChannels;
+    unsigned long ulReady = 0;
+
+    ulChannels = g_ulADCFilterChannels;
+    for(i = 0; ulChannels != 0; i++, ulChannels >>= 1)
+    {
+        if((ulChannels & 1) &&
+           ADCFilterPut(g_psADCFilters[i], (long)ADCDataGet(ulBase, i)))
+        {
+            ulReady |= (1 << i);
+        }
+    }
+    return ulReady;
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Sets the comparators on the current window of the watch.
+//!
+//! Comparator 0 watches the low bound and comparator 1 the high bound, each
+//! in the direction the result leaves the state of the window.
+//!
+//! \param ulBase is the base address of the ADC module.
+//! \param psWatch is the watch.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+ADCWatchArm(unsigned long ulBase, tADCWatch *psWatch)
+{
+    tADCWatchWindow *psWindow;
+    unsigned long ulConfig;
+
+    psWindow = &psWatch->psWindows[psWatch->ulCurrent];
+    ulConfig = (psWindow->ulChannel << ADC_CMPRX_CMPCH_S) |
+               (psWatch->ulMatchCnt << ADC_CMPRX_CMPMATCNT_S) |
+               ADC_CMPRX_CMPIE | ADC_CMPRX_CMPEN;
+
+    //
+    // Disabled first so the match counts start again on the new channel
+    //
+    xHWREG(ulBase + ADC_CMPR0) = 0;
+    xHWREG(ulBase + ADC_CMPR1) = 0;
+    xHWREG(ulBase + ADC_SR) = ADC_SR_CMPF0 | ADC_SR_CMPF1;
+
+    xHWREG(ulBase + ADC_CMPR0) = ulConfig |
+                                 (psWindow->ulLow << ADC_CMPRX_CMPD_S) |
+                                 ((psWindow->ulState == ADC_WATCH_BELOW) ?
+                                  ADC_COMP_GREATER_EQUAL : ADC_COMP_LESS_THAN);
+    xHWREG(ulBase + ADC_CMPR1) = ulConfig |
+                                 (psWindow->ulHigh << ADC_CMPRX_CMPD_S) |
+                                 ((psWindow->ulState == ADC_WATCH_ABOVE) ?
+                                  ADC_COMP_LESS_THAN : ADC_COMP_GREATER_EQUAL);
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Handles a comparator match of the threshold watch.
+//!
+//! \param ulBase is the base address of the ADC module.
+//! \param ulIntFlags is the ADC_SR content.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+ADCWatchRun(unsigned long ulBase, unsigned long ulIntFlags)
+{
+    tADCWatch *psWatch = g_psADCWatch;
+    tADCWatchWindow *psWindow;
+    unsigned long ulState;
+
+    psWindow = &psWatch->psWindows[psWatch->ulCurrent];
+
+    //
+    // A crossing of the high bound wins if both are seen together
+    //
+    if(psWindow->ulState == ADC_WATCH_BELOW)
+    {
+        ulState = (ulIntFlags & ADC_SR_CMPF1) ? ADC_WATCH_ABOVE :
+                                                ADC_WATCH_INSIDE;
+    }
+    else if(psWindow->ulState == ADC_WATCH_ABOVE)
+    {
+        ulState = (ulIntFlags & ADC_SR_CMPF0) ? ADC_WATCH_BELOW :
+                                                ADC_WATCH_INSIDE;
+    }
+    else
+    {
+        ulState = (ulIntFlags & ADC_SR_CMPF1) ? ADC_WATCH_ABOVE :
+                                                ADC_WATCH_BELOW;
+    }
+
+    psWindow->ulState = ulState;
+    ADCWatchArm(ulBase, psWatch);
+
+    if(psWatch->pfnCallback != 0)
+    {
+        psWatch->pfnCallback(psWatch->pvCBData, ulState, psWatch->ulCurrent,
+                             psWindow);
+    }
+}
+
 //*****************************************************************************
 //
 //! \brief ADC0 Interrupt Handler.
@@ -311,6 +451,7 @@ ADCIntHandler(void)
     unsigned long ulBase = ADC_BASE;
     unsigned long ulIntFlags;
     unsigned long ulEventFlags = 0;
+    unsigned long ulReady = 0;
 
     //
     // Get Int flags
@@ -328,6 +469,24 @@ ADCIntHandler(void)
     if(ulIntFlags & ADC_SR_ADF)
     {
         ulEventFlags |= xADC_EVENT_END_CONVERSION;
+
+        //
+        // The results are filtered before the application sees the event
+        //
+        if(g_ulADCFilterChannels != 0)
+        {
+            ulReady = ADCFilterRun(ulBase);
+        }
+    }
+
+    //
+    // The comparators belong to the threshold watch while it runs
+    //
+    if((g_psADCWatch != 0) &&
+       (ulIntFlags & (ADC_SR_CMPF0 | ADC_SR_CMPF1)))
+    {
+        ADCWatchRun(ulBase, ulIntFlags);
+        ulIntFlags &= ~(ADC_SR_CMPF0 | ADC_SR_CMPF1);
     }
 
     //
@@ -348,7 +507,7 @@ ADCIntHandler(void)
 
     if(ulEventFlags && g_pfnADCHandlerCallbacks[0])
     {
-        g_pfnADCHandlerCallbacks[0](0, ulEventFlags, 0, 0);
+        g_pfnADCHandlerCallbacks[0](0, ulEventFlags, ulReady, 0);
     } 
 
     //
@@ -1365,3 +1524,981 @@ ADCCompDisable(unsigned long ulBase, unsigned long ulComp)
     xHWREG(ulBase + ADC_CMPR0 + (4 * ulComp)) &= ~ADC_CMPRX_CMPEN;
 }
 
+//*****************************************************************************
+//
+//! \internal
+//! \brief Splits a done half of the ring into per channel blocks.
+//!
+//! \param psRing is the acquisition.
+//! \param ulHalf is the half, 0 or 1.
+//!
+//! \return the block of the half.
+//
+//*****************************************************************************
+static unsigned short *
+ADCRingDeinterleave(tADCRing *psRing, unsigned long ulHalf)
+{
+    unsigned long i, k, ulCount, ulChannels;
+    const unsigned long *pulSrc;
+    unsigned short *pusBlock, *pusDst;
+
+    ulChannels = psRing->ulChannels;
+    ulCount = psRing->ulFrames / 2;
+    pusBlock = psRing->pusBlock + ulHalf * ulChannels * ulCount;
+
+    for(k = 0; k < ulChannels; k++)
+    {
+        pulSrc = psRing->pulRing + ulHalf * ulChannels * ulCount + k;
+        pusDst = pusBlock + k * ulCount;
+        for(i = 0; i < ulCount; i++)
+        {
+            pusDst[i] = (unsigned short)(*pulSrc & ADC_DRX_RSLT_M);
+            pulSrc += ulChannels;
+        }
+    }
+    return pusBlock;
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Restarts the scan at the start of the ring.
+//!
+//! \param psRing is the acquisition.
+//!
+//! The conversion is stopped, the PDMA channel reset and armed for the whole
+//! ring, then the scan is started again by software, so the first word of
+//! the ring is the lowest enabled channel whatever was lost before.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+ADCRingRestart(tADCRing *psRing)
+{
+    ADCConvertStop(ADC_BASE);
+    PDMAChannelSoftwareReset(psRing->ulDMAChannel);
+    PDMAChannelIntFlagClear(psRing->ulDMAChannel, PDMA_EVENT_TC);
+    PDMAChannelTransferSet(psRing->ulDMAChannel,
+                           (void *)(ADC_BASE + ADC_PDMA), psRing->pulRing,
+                           psRing->ulFrames * psRing->ulChannels * 4);
+    xADCOverflowClear(ADC_BASE);
+    ADCProcessorTrigger(ADC_BASE);
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief PDMA callback of the ring.
+//!
+//! The second half of the ring is started by the PDMA handler. Results
+//! converted while the PDMA is not armed are lost without an overrun and
+//! would shift the channel slots, so the scan is restarted with the ring at
+//! its end, before the done half is split. After an overrun in the first
+//! half it is restarted as well, once the half is handed over.
+//!
+//! \return 0.
+//
+//*****************************************************************************
+static unsigned long
+ADCRingCallback(void *pvCBData, unsigned long ulEvent,
+                unsigned long ulMsgParam, void *pvMsgData)
+{
+    tADCRing *psRing = (tADCRing *)pvCBData;
+    unsigned short *pusBlock;
+    unsigned long ulFlags;
+    unsigned long ulHalf;
+
+    if(ulMsgParam & PDMA_EVENT_ERROR)
+    {
+        ADCRingStop(ADC_BASE);
+        if(psRing->pfnCallback != 0)
+        {
+            psRing->pfnCallback(psRing->pvCBData, ADC_RING_EVENT_ERROR, 0, 0);
+        }
+        return 0;
+    }
+
+    if(ulMsgParam & PDMA_EVENT_TC)
+    {
+        ulHalf = 1;
+        ulFlags = ADC_RING_EVENT_FULL;
+    }
+    else
+    {
+        ulHalf = 0;
+        ulFlags = ADC_RING_EVENT_HALF;
+    }
+
+    //
+    // A result overwritten before the PDMA got it, the half misses samples
+    //
+    if(xADCOverflow(ADC_BASE))
+    {
+        xADCOverflowClear(ADC_BASE);
+        psRing->ulOverruns++;
+        ulFlags |= ADC_RING_EVENT_OVERRUN;
+    }
+
+    if(ulHalf == 1)
+    {
+        ADCRingRestart(psRing);
+    }
+
+    pusBlock = ADCRingDeinterleave(psRing, ulHalf);
+    if(psRing->pfnCallback != 0)
+    {
+        psRing->pfnCallback(psRing->pvCBData, ulFlags, psRing->ulFrames / 2,
+                            pusBlock);
+    }
+
+    //
+    // The second half is shifted too, drop it and start over
+    //
+    if((ulHalf == 0) && (ulFlags & ADC_RING_EVENT_OVERRUN))
+    {
+        ADCRingRestart(psRing);
+    }
+    return 0;
+}
+
+//*****************************************************************************
+//
+//! \brief Starts a continuous scan acquisition into a PDMA ring.
+//!
+//! \param ulBase is the base address of the ADC module.
+//! \param psRing is the acquisition, \e pulRing, \e pusBlock, \e ulFrames,
+//! \e pfnCallback and \e pvCBData filled by the caller.
+//!
+//! The enabled channels are scanned continuously and every result is moved
+//! from ADC_PDMA into the ring by a PDMA channel, without CPU. When a half of
+//! the ring is done the PDMA interrupt splits it into one block per channel
+//! (see \ref tADCRing) and calls the callback with \b ADC_RING_EVENT_HALF or
+//! \b ADC_RING_EVENT_FULL, while the other half fills. The callback must be
+//! done with a block before the same half is done again.
+//!
+//! An overrun of the ADC seen at the end of a half, xADCOverflow(), is
+//! counted in \e ulOverruns and flagged with \b ADC_RING_EVENT_OVERRUN.
+//! The scan is restarted at the start of the ring after an overrun and at
+//! every end of the ring, so the channel slots stay in place, and the next
+//! block after an overrun is the first half. The restart is done by
+//! software, also with the external trigger.
+//!
+//! The channels, the input mode and the trigger must be configured before,
+//! the end of conversion interrupt disabled and INT_PDMA enabled. The
+//! operation mode is set to continuous scan. With the processor trigger the
+//! conversion is started here, else on the external trigger.
+//!
+//! \return xtrue if the acquisition is started, xfalse if no channel is
+//! enabled, no PDMA channel is free or an acquisition is running.
+//
+//*****************************************************************************
+xtBoolean
+ADCRingStart(unsigned long ulBase, tADCRing *psRing)
+{
+    unsigned long i, ulEnabled, ulSize, ulChannel;
+
+    //
+    // Check the arguments
+    //
+    xASSERT(ulBase == ADC_BASE);
+    xASSERT((psRing != 0) && (psRing->pulRing != 0) &&
+            (psRing->pusBlock != 0));
+    xASSERT((psRing->ulFrames != 0) && !(psRing->ulFrames & 1));
+
+    if(g_psADCRing != 0)
+    {
+        return xfalse;
+    }
+
+    //
+    // Results come in ascending channel order, a slot per enabled channel
+    //
+    ulEnabled = (xHWREG(ulBase + ADC_CHER) & ADC_CHER_CHEN_M) >>
+                ADC_CHER_CHEN_S;
+    psRing->ulChannels = 0;
+    for(i = 0; i < 8; i++)
+    {
+        if(ulEnabled & (1 << i))
+        {
+            psRing->ucSlot[i] = (unsigned char)psRing->ulChannels++;
+        }
+        else
+        {
+            psRing->ucSlot[i] = ADC_RING_SLOT_NONE;
+        }
+    }
+    if(psRing->ulChannels == 0)
+    {
+        return xfalse;
+    }
+
+    ulSize = psRing->ulFrames * psRing->ulChannels * 4;
+    xASSERT(ulSize <= 0xFFFF);
+
+    ulChannel = PDMAChannelDynamicAssign(xDMA_REQUEST_ADC_RX,
+                                         xDMA_REQUEST_MEM);
+    if(ulChannel == xDMA_CHANNEL_NOT_EXIST)
+    {
+        return xfalse;
+    }
+    psRing->ulDMAChannel = ulChannel;
+    psRing->ulOverruns = 0;
+    g_psADCRing = psRing;
+
+    PDMAEnable(ulChannel);
+    PDMAChannelIntCallbackInit(ulChannel, ADCRingCallback);
+    PDMAChannelIntCallbackDataSet(ulChannel, psRing);
+    PDMAChannelIntEnable(ulChannel, PDMA_EVENT_TC | PDMA_EVENT_HALF |
+                                    PDMA_EVENT_ERROR);
+    PDMAChannelControlSet(ulChannel, PDMA_WIDTH_32BIT | PDMA_SRC_DIR_FIXED |
+                                     PDMA_DST_DIR_INC);
+    PDMAChannelTransferSet(ulChannel, (void *)(ulBase + ADC_PDMA),
+                           psRing->pulRing, ulSize);
+
+    //
+    // Stale results would count as an overrun of the first half
+    //
+    xADCOverflowClear(ulBase);
+
+    xHWREG(ulBase + ADC_CR) = (xHWREG(ulBase + ADC_CR) & ~ADC_CR_ADMD_M) |
+                              ADC_CR_ADMD_CONTINUOUS;
+    ADCPDMAEnable(ulBase);
+    if(!(xHWREG(ulBase + ADC_CR) & ADC_CR_TRGEN))
+    {
+        ADCProcessorTrigger(ulBase);
+    }
+
+    return xtrue;
+}
+
+//*****************************************************************************
+//
+//! \brief Stops the acquisition into a PDMA ring.
+//!
+//! \param ulBase is the base address of the ADC module.
+//!
+//! The conversion is stopped and the PDMA channel freed. The callback is not
+//! called for the half being filled. Nothing is done if no acquisition runs.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+ADCRingStop(unsigned long ulBase)
+{
+    tADCRing *psRing;
+
+    //
+    // Check the arguments
+    //
+    xASSERT(ulBase == ADC_BASE);
+
+    psRing = g_psADCRing;
+    if(psRing == 0)
+    {
+        return;
+    }
+
+    ADCConvertStop(ulBase);
+    ADCPDMADisable(ulBase);
+    PDMADisable(psRing->ulDMAChannel);
+    PDMAChannelDeAssign(psRing->ulDMAChannel);
+    g_psADCRing = 0;
+}
+
+//*****************************************************************************
+//
+//! \brief Initializes a sample filter with its decimator.
+//!
+//! \param psFilter is the filter.
+//! \param ulRatio is the log2 of the decimation ratio, 0 to
+//! \b ADC_FILTER_RATIO_MAX. 0 passes every sample.
+//! \param ulOrder is the CIC order of the decimator, 1 (boxcar) to
+//! \b ADC_FILTER_ORDER_MAX.
+//! \param ulGrowth is the number of bits kept from the oversampling, 0 to
+//! \b ADC_FILTER_GROWTH_MAX, no more than ulOrder * ulRatio.
+//!
+//! The decimator sums 2^ulRatio samples into one, ulOrder times, so its gain
+//! is 2^(ulOrder * ulRatio). The sum is rounded down to ulGrowth bits more
+//! than the ADC: 4 samples of a noisy input make 1 more bit, 16 make 2. The
+//! order must be such that ulOrder * ulRatio is at most 19, for the sums to
+//! fit in 32 bits. The median and the IIR filter are off, see
+//! ADCFilterMedianSet() and ADCFilterIIRSet().
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+ADCFilterInit(tADCFilter *psFilter, unsigned long ulRatio,
+              unsigned long ulOrder, unsigned long ulGrowth)
+{
+    //
+    // Check the arguments
+    //
+    xASSERT(psFilter != 0);
+    xASSERT(ulRatio <= ADC_FILTER_RATIO_MAX);
+    xASSERT((ulOrder >= 1) && (ulOrder <= ADC_FILTER_ORDER_MAX));
+    xASSERT((ulGrowth <= ADC_FILTER_GROWTH_MAX) &&
+            (ulGrowth <= ulOrder * ulRatio));
+    xASSERT(ulOrder * ulRatio <= 19);
+
+    psFilter->ucRatio = (unsigned char)ulRatio;
+    psFilter->ucOrder = (unsigned char)ulOrder;
+    psFilter->ucShift = (unsigned char)(ulOrder * ulRatio - ulGrowth);
+    psFilter->ucWindow = 0;
+    psFilter->ucIIRShift = 0;
+    ADCFilterReset(psFilter);
+}
+
+//*****************************************************************************
+//
+//! \brief Sets the median filter of a sample filter.
+//!
+//! \param psFilter is the filter.
+//! \param ulWindow is the number of decimated samples the median is taken
+//! over, odd and up to \b ADC_FILTER_MEDIAN_MAX, 0 to turn the median off.
+//!
+//! The median removes single spikes a mean would spread. Until the window
+//! is full the median of the samples held is given. The filter is reset.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+ADCFilterMedianSet(tADCFilter *psFilter, unsigned long ulWindow)
+{
+    //
+    // Check the arguments
+    //
+    xASSERT(psFilter != 0);
+    xASSERT((ulWindow == 0) ||
+            ((ulWindow & 1) && (ulWindow <= ADC_FILTER_MEDIAN_MAX)));
+
+    psFilter->ucWindow = (unsigned char)ulWindow;
+    ADCFilterReset(psFilter);
+}
+
+//*****************************************************************************
+//
+//! \brief Sets the IIR filter of a sample filter.
+//!
+//! \param psFilter is the filter.
+//! \param ulShift is the log2 of the time constant in decimated samples,
+//! 1 to 15, 0 to turn the IIR filter off.
+//!
+//! The filter is y += (x - y) / 2^ulShift, computed with
+//! \b ADC_FILTER_IIR_FRAC more fraction bits than the output so that small
+//! steps are not lost. It starts at the first sample. The filter is reset.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+ADCFilterIIRSet(tADCFilter *psFilter, unsigned long ulShift)
+{
+    //
+    // Check the arguments
+    //
+    xASSERT(psFilter != 0);
+    xASSERT(ulShift <= 15);
+
+    psFilter->ucIIRShift = (unsigned char)ulShift;
+    ADCFilterReset(psFilter);
+}
+
+//*****************************************************************************
+//
+//! \brief Clears the state of a sample filter, keeping its settings.
+//!
+//! \param psFilter is the filter.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+ADCFilterReset(tADCFilter *psFilter)
+{
+    unsigned long i;
+
+    //
+    // Check the arguments
+    //
+    xASSERT(psFilter != 0);
+
+    for(i = 0; i < ADC_FILTER_ORDER_MAX; i++)
+    {
+        psFilter->ulInteg[i] = 0;
+        psFilter->ulComb[i] = 0;
+    }
+    psFilter->ulPhase = 0;
+    psFilter->ucFill = 0;
+    psFilter->ucOldest = 0;
+    psFilter->ucIIRStarted = 0;
+    psFilter->lIIR = 0;
+    psFilter->lOutput = 0;
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Puts a sample into the median window.
+//!
+//! The window is kept sorted, the oldest sample is taken out and the new one
+//! inserted in place, so a sample costs one pass over the window.
+//!
+//! \return the median of the window.
+//
+//*****************************************************************************
+static long
+ADCFilterMedian(tADCFilter *psFilter, long lSample)
+{
+    unsigned long i, ulFill;
+    long *plSorted = psFilter->lSorted;
+
+    ulFill = psFilter->ucFill;
+    if(ulFill == psFilter->ucWindow)
+    {
+        //
+        // Take the oldest sample out
+        //
+        for(i = 0; plSorted[i] != psFilter->lHistory[psFilter->ucOldest]; i++)
+        {
+        }
+        for(ulFill--; i < ulFill; i++)
+        {
+            plSorted[i] = plSorted[i + 1];
+        }
+    }
+
+    psFilter->lHistory[psFilter->ucOldest] = lSample;
+    if(++psFilter->ucOldest == psFilter->ucWindow)
+    {
+        psFilter->ucOldest = 0;
+    }
+
+    //
+    // Insert the new one in place
+    //
+    for(i = ulFill; (i != 0) && (plSorted[i - 1] > lSample); i--)
+    {
+        plSorted[i] = plSorted[i - 1];
+    }
+    plSorted[i] = lSample;
+    psFilter->ucFill = (unsigned char)(ulFill + 1);
+
+    return plSorted[ulFill / 2];
+}
+
+//*****************************************************************************
+//
+//! \brief Puts an ADC sample into a sample filter.
+//!
+//! \param psFilter is the filter.
+//! \param lSample is the sample, as given by ADCDataGet().
+//!
+//! The sample goes through the decimator, the median and the IIR filter, in
+//! this order, with integer arithmetic only. The output is read with
+//! ADCFilterGet().
+//!
+//! \return xtrue if the decimation is done and a new output is ready,
+//! xfalse else.
+//
+//*****************************************************************************
+xtBoolean
+ADCFilterPut(tADCFilter *psFilter, long lSample)
+{
+    unsigned long i, ulValue, ulPrev;
+    long lValue;
+
+    //
+    // Check the arguments
+    //
+    xASSERT(psFilter != 0);
+
+    lValue = lSample;
+    if(psFilter->ucRatio != 0)
+    {
+        //
+        // Integrators at the input rate, combs at the output rate, both
+        // wrapping
+        //
+        ulValue = (unsigned long)lSample;
+        for(i = 0; i < psFilter->ucOrder; i++)
+        {
+            psFilter->ulInteg[i] += ulValue;
+            ulValue = psFilter->ulInteg[i];
+        }
+        if(++psFilter->ulPhase < (1UL << psFilter->ucRatio))
+        {
+            return xfalse;
+        }
+        psFilter->ulPhase = 0;
+        for(i = 0; i < psFilter->ucOrder; i++)
+        {
+            ulPrev = psFilter->ulComb[i];
+            psFilter->ulComb[i] = ulValue;
+            ulValue -= ulPrev;
+        }
+
+        lValue = (long)ulValue;
+        if(psFilter->ucShift != 0)
+        {
+            lValue = (lValue + (1L << (psFilter->ucShift - 1))) >>
+                     psFilter->ucShift;
+        }
+    }
+
+    if(psFilter->ucWindow > 1)
+    {
+        lValue = ADCFilterMedian(psFilter, lValue);
+    }
+
+    if(psFilter->ucIIRShift != 0)
+    {
+        lValue *= (1L << ADC_FILTER_IIR_FRAC);
+        if(psFilter->ucIIRStarted)
+        {
+            psFilter->lIIR += (lValue - psFilter->lIIR) >>
+                              psFilter->ucIIRShift;
+        }
+        else
+        {
+            psFilter->lIIR = lValue;
+            psFilter->ucIIRStarted = 1;
+        }
+        lValue = (psFilter->lIIR + (1L << (ADC_FILTER_IIR_FRAC - 1))) >>
+                 ADC_FILTER_IIR_FRAC;
+    }
+
+    psFilter->lOutput = lValue;
+    return xtrue;
+}
+
+//*****************************************************************************
+//
+//! \brief Gets the last output of a sample filter.
+//!
+//! \param psFilter is the filter.
+//!
+//! \return the last output, in Q-format with as many fraction bits as bits
+//! kept from the oversampling, 0 before the first one.
+//
+//*****************************************************************************
+long
+ADCFilterGet(tADCFilter *psFilter)
+{
+    //
+    // Check the arguments
+    //
+    xASSERT(psFilter != 0);
+
+    return psFilter->lOutput;
+}
+
+//*****************************************************************************
+//
+//! \brief Sets the filter of an ADC channel.
+//!
+//! \param ulBase is the base address of the ADC module.
+//! \param ulChannel is the channel, 0 to 7.
+//! \param psFilter is the filter, 0 to take the filter of the channel off.
+//!
+//! At each end of conversion interrupt, ADCIntHandler() puts the result of
+//! the channel into its filter before calling the callback, which gets the
+//! bit mask of the channels with a new output as ulMsgParam. The filter
+//! outputs are read with ADCFilterGet(). The end of conversion interrupt
+//! must be enabled. Samples moved by ADCRingStart() can be filtered in the
+//! ring callback with ADCFilterPut() instead.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+ADCFilterChannelSet(unsigned long ulBase, unsigned long ulChannel,
+                    tADCFilter *psFilter)
+{
+    //
+    // Check the arguments
+    //
+    xASSERT(ulBase == ADC_BASE);
+    xASSERT(ulChannel < 8);
+
+    //
+    // The handler only follows a filter once it is set
+    //
+    if(psFilter != 0)
+    {
+        g_psADCFilters[ulChannel] = psFilter;
+        g_ulADCFilterChannels |= (1 << ulChannel);
+    }
+    else
+    {
+        g_ulADCFilterChannels &= ~(1 << ulChannel);
+        g_psADCFilters[ulChannel] = 0;
+    }
+}
+
+//*****************************************************************************
+//
+//! \brief Starts a threshold watch of channels with the digital comparators.
+//!
+//! \param ulBase is the base address of the ADC module.
+//! \param psWatch is the watch, \e psWindows, \e ulWindows, \e ulMatchCnt,
+//! \e pfnCallback and \e pvCBData filled by the caller.
+//!
+//! Both comparators are put on one window: comparator 0 on its low bound
+//! and comparator 1 on its high bound. A crossing counts once the result is
+//! past the bound for \e ulMatchCnt conversions in a row, which rejects the
+//! noise. Then ADCIntHandler() updates the state of the window, turns the
+//! comparators for the next crossing and calls the callback with the new
+//! state. Nothing else wakes the CPU, which can sleep in SysCtlSleep()
+//! meanwhile.
+//!
+//! With several windows, ADCWatchRotate() moves the comparators to the next
+//! window. It is called on a schedule, a timer interrupt for instance, each
+//! window being watched for at least \e ulMatchCnt conversions of its
+//! channel. A window left while it was not watched is reported as soon as
+//! the comparators come back to it.
+//!
+//! The windows start inside. The channels must be enabled and converted
+//! continuously, the end of conversion interrupt disabled and INT_ADC
+//! enabled. The comparators belong to the watch until ADCWatchStop(), and
+//! their events are not passed to the callback of xADCIntCallbackInit().
+//!
+//! \return xtrue if the watch is started, xfalse if a watch is running.
+//
+//*****************************************************************************
+xtBoolean
+ADCWatchStart(unsigned long ulBase, tADCWatch *psWatch)
+{
+    unsigned long i;
+    xtBoolean bMasked;
+
+    //
+    // Check the arguments
+    //
+    xASSERT(ulBase == ADC_BASE);
+    xASSERT((psWatch != 0) && (psWatch->psWindows != 0) &&
+            (psWatch->ulWindows != 0));
+    xASSERT(psWatch->ulMatchCnt < 16);
+
+    if(g_psADCWatch != 0)
+    {
+        return xfalse;
+    }
+
+    for(i = 0; i < psWatch->ulWindows; i++)
+    {
+        xASSERT(psWatch->psWindows[i].ulChannel < 8);
+        xASSERT(psWatch->psWindows[i].ulLow < psWatch->psWindows[i].ulHigh);
+        xASSERT(psWatch->psWindows[i].ulHigh < 0x1000);
+        psWatch->psWindows[i].ulState = ADC_WATCH_INSIDE;
+    }
+    psWatch->ulCurrent = 0;
+
+    bMasked = xIntMasterDisable();
+    g_psADCWatch = psWatch;
+    ADCWatchArm(ulBase, psWatch);
+    if(!bMasked)
+    {
+        xIntMasterEnable();
+    }
+
+    return xtrue;
+}
+
+//*****************************************************************************
+//
+//! \brief Moves the comparators of the threshold watch to the next window.
+//!
+//! \param ulBase is the base address of the ADC module.
+//!
+//! Nothing is done if no watch runs or it has a single window.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+ADCWatchRotate(unsigned long ulBase)
+{
+    tADCWatch *psWatch;
+    xtBoolean bMasked;
+
+    //
+    // Check the arguments
+    //
+    xASSERT(ulBase == ADC_BASE);
+
+    //
+    // The ADC interrupt must not see the comparators half turned
+    //
+    bMasked = xIntMasterDisable();
+    psWatch = g_psADCWatch;
+    if((psWatch != 0) && (psWatch->ulWindows > 1))
+    {
+        if(++psWatch->ulCurrent == psWatch->ulWindows)
+        {
+            psWatch->ulCurrent = 0;
+        }
+        ADCWatchArm(ulBase, psWatch);
+    }
+    if(!bMasked)
+    {
+        xIntMasterEnable();
+    }
+}
+
+//*****************************************************************************
+//
+//! \brief Stops the threshold watch.
+//!
+//! \param ulBase is the base address of the ADC module.
+//!
+//! Both comparators are disabled. The states of the windows are kept.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+ADCWatchStop(unsigned long ulBase)
+{
+    xtBoolean bMasked;
+
+    //
+    // Check the arguments
+    //
+    xASSERT(ulBase == ADC_BASE);
+
+    bMasked = xIntMasterDisable();
+    xHWREG(ulBase + ADC_CMPR0) = 0;
+    xHWREG(ulBase + ADC_CMPR1) = 0;
+    xHWREG(ulBase + ADC_SR) = ADC_SR_CMPF0 | ADC_SR_CMPF1;
+    g_psADCWatch = 0;
+    if(!bMasked)
+    {
+        xIntMasterEnable();
+    }
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Gets the fingerprint of the ADC configuration a calibration is
+//! valid for.
+//!
+//! The input type and the ADC clock source and divider, which take separate
+//! bits, and a bit always set so that an empty record never matches.
+//!
+//! \param ulBase is the base address of the ADC module.
+//!
+//! \return the fingerprint.
+//
+//*****************************************************************************
+static unsigned long
+ADCCalibrationFingerprint(unsigned long ulBase)
+{
+    return (0x80000000 |
+            (xHWREG(ulBase + ADC_CR) & ADC_CR_DIFFEN) |
+            (xHWREG(SYSCLK_CLKSEL1) & SYSCLK_CLKSEL1_ADC_M) |
+            (xHWREG(SYSCLK_CLKDIV) & SYSCLK_CLKDIV_ADC_M));
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Converts an internal source of channel 7 once.
+//!
+//! The ADC registers are saved and restored around a single conversion by
+//! software, polled with the interrupts of the ADC off.
+//!
+//! \param ulBase is the base address of the ADC module.
+//! \param ulSource is \b ADC_CH7_INT_BV or \b ADC_CH7_INT_TS.
+//!
+//! \return the 12 bits code.
+//
+//*****************************************************************************
+static unsigned long
+ADCCalibrationSample(unsigned long ulBase, unsigned long ulSource)
+{
+    unsigned long ulCR, ulCHER, ulData;
+
+    ulCR = xHWREG(ulBase + ADC_CR);
+    ulCHER = xHWREG(ulBase + ADC_CHER);
+
+    xHWREG(ulBase + ADC_CHER) = ulSource | ADC_CHER_CHEN7;
+    xHWREG(ulBase + ADC_CR) = ADC_CR_ADMD_SINGLE | ADC_CR_ADEN;
+    xHWREG(ulBase + ADC_SR) = ADC_SR_ADF;
+    xHWREG(ulBase + ADC_CR) |= ADC_CR_ADST;
+    while(!(xHWREG(ulBase + ADC_SR) & ADC_SR_ADF))
+    {
+    }
+    ulData = xHWREG(ulBase + ADC_DR7) & 0xFFF;
+    xHWREG(ulBase + ADC_SR) = ADC_SR_ADF;
+
+    xHWREG(ulBase + ADC_CHER) = ulCHER;
+    xHWREG(ulBase + ADC_CR) = ulCR & ~ADC_CR_ADST;
+
+    return ulData;
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Reads the band-gap and the temperature sensor.
+//!
+//! The band-gap is converted first, the time the sensor needs to settle.
+//!
+//! \param ulBase is the base address of the ADC module.
+//! \param pulTemp is where the temperature sensor code is stored.
+//! \param pulBandGap is where the band-gap code is stored.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+ADCCalibrationMeasure(unsigned long ulBase, unsigned long *pulTemp,
+                      unsigned long *pulBandGap)
+{
+    SysCtlTempatureSensorEnable(xtrue);
+    *pulBandGap = ADCCalibrationSample(ulBase, ADC_CH7_INT_BV);
+    *pulTemp = ADCCalibrationSample(ulBase, ADC_CH7_INT_TS);
+    SysCtlTempatureSensorEnable(xfalse);
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Starts a self calibration, CALEN written 0 then 1.
+//!
+//! \param ulBase is the base address of the ADC module.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+ADCCalibrationRestart(unsigned long ulBase)
+{
+    xHWREG(ulBase + ADC_CALR) &= ~ADC_CALR_CALEN;
+    xHWREG(ulBase + ADC_CALR) |= ADC_CALR_CALEN;
+}
+
+//*****************************************************************************
+//
+//! \brief Calibrates the ADC unless its calibration still holds.
+//!
+//! \param ulBase is the base address of the ADC module.
+//! \param psCal is the record of the last calibration.
+//!
+//! To be called after ADCConfigure() and at each wake up, instead of a self
+//! calibration every time. The calibration is skipped when the ADC still
+//! holds one (a reset of the ADC or ADCCalibrationDisable() drops it) done
+//! for the same input type and ADC clock, the fingerprint in \e psCal.
+//! Else the band-gap and the temperature sensor are read for
+//! ADCCalibrationUpdate() and the calibration is run, waiting for it.
+//!
+//! The self calibration of the ADC is kept inside the ADC and cannot be
+//! saved: after a reset of the ADC it is always run.
+//!
+//! The ADC must be enabled and not converting.
+//!
+//! \return xtrue if a calibration was run, xfalse if it was skipped.
+//
+//*****************************************************************************
+xtBoolean
+ADCCalibrationCheck(unsigned long ulBase, tADCCalibration *psCal)
+{
+    unsigned long ulFingerprint;
+
+    //
+    // Check the arguments
+    //
+    xASSERT(ulBase == ADC_BASE);
+    xASSERT(psCal != 0);
+
+    ulFingerprint = ADCCalibrationFingerprint(ulBase);
+    if(!psCal->ulRunning && (psCal->ulFingerprint == ulFingerprint) &&
+       ((xHWREG(ulBase + ADC_CALR) & (ADC_CALR_CALEN | ADC_CALR_CALDONE)) ==
+        (ADC_CALR_CALEN | ADC_CALR_CALDONE)))
+    {
+        psCal->ulSkipped++;
+        return xfalse;
+    }
+
+    ADCCalibrationMeasure(ulBase, &psCal->ulTemp, &psCal->ulBandGap);
+    ADCCalibrationRestart(ulBase);
+    while(!ADCCalibrationDone(ulBase))
+    {
+    }
+
+    psCal->ulFingerprint = ulFingerprint;
+    psCal->ulRunning = 0;
+    psCal->ulCalibrations++;
+    return xtrue;
+}
+
+//*****************************************************************************
+//
+//! \brief Recalibrates the ADC in the background when the temperature or the
+//! supply drifts.
+//!
+//! \param ulBase is the base address of the ADC module.
+//! \param psCal is the record of the last calibration, from
+//! ADCCalibrationCheck().
+//!
+//! To be called from time to time, between conversions. Without a
+//! calibration running, the band-gap and the temperature sensor are read
+//! (two single conversions): if the temperature code moved by more than
+//! \e ulTempDrift, the band-gap code, thus the supply, by more than
+//! \e ulSupplyDrift, or the configuration changed, a calibration is started
+//! and the function returns without waiting for it. The next calls complete
+//! it. Conversions must wait until \b ADC_CAL_DONE is returned.
+//!
+//! \return \b ADC_CAL_VALID if the calibration holds, \b ADC_CAL_RUNNING if
+//! a calibration runs, \b ADC_CAL_DONE if it has just completed.
+//
+//*****************************************************************************
+unsigned long
+ADCCalibrationUpdate(unsigned long ulBase, tADCCalibration *psCal)
+{
+    unsigned long ulTemp, ulBandGap, ulFingerprint;
+
+    //
+    // Check the arguments
+    //
+    xASSERT(ulBase == ADC_BASE);
+    xASSERT(psCal != 0);
+
+    ulFingerprint = ADCCalibrationFingerprint(ulBase);
+    if(psCal->ulRunning)
+    {
+        if(!ADCCalibrationDone(ulBase))
+        {
+            return ADC_CAL_RUNNING;
+        }
+        psCal->ulFingerprint = ulFingerprint;
+        psCal->ulRunning = 0;
+        psCal->ulCalibrations++;
+        return ADC_CAL_DONE;
+    }
+
+    ADCCalibrationMeasure(ulBase, &ulTemp, &ulBandGap);
+    if((psCal->ulFingerprint == ulFingerprint) &&
+       (xHWREG(ulBase + ADC_CALR) & ADC_CALR_CALDONE) &&
+       (((ulTemp > psCal->ulTemp) ? (ulTemp - psCal->ulTemp) :
+         (psCal->ulTemp - ulTemp)) <= psCal->ulTempDrift) &&
+       (((ulBandGap > psCal->ulBandGap) ? (ulBandGap - psCal->ulBandGap) :
+         (psCal->ulBandGap - ulBandGap)) <= psCal->ulSupplyDrift))
+    {
+        return ADC_CAL_VALID;
+    }
+
+    //
+    // The codes of this calibration are those it is started at
+    //
+    psCal->ulTemp = ulTemp;
+    psCal->ulBandGap = ulBandGap;
+    psCal->ulRunning = 1;
+    ADCCalibrationRestart(ulBase);
+    return ADC_CAL_RUNNING;
+}
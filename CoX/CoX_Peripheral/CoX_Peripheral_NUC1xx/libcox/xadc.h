@@ -1149,6 +1149,421 @@ extern void xADCCompConditionConfig(unsigned long ulBase,
 //
 //*****************************************************************************
 
+//*****************************************************************************
+//
+//! \addtogroup NUC1xx_ADC_Ring NUC1xx ADC PDMA Ring
+//! \brief Continuous scan conversion into a PDMA ring, see ADCRingStart().
+//! @{
+//
+//*****************************************************************************
+
+//
+//! The first half of the ring is done, its block is ready
+//
+#define ADC_RING_EVENT_HALF     0x00000001
+
+//
+//! The second half of the ring is done, its block is ready
+//
+#define ADC_RING_EVENT_FULL     0x00000002
+
+//
+//! A conversion result was overwritten before it was transferred, samples
+//! are missing from the block
+//
+#define ADC_RING_EVENT_OVERRUN  0x00000004
+
+//
+//! The PDMA transfer failed, the acquisition is stopped
+//
+#define ADC_RING_EVENT_ERROR    0x00000008
+
+//
+//! Slot of a channel that is not enabled
+//
+#define ADC_RING_SLOT_NONE      0xFF
+
+//*****************************************************************************
+//
+//! ADC acquisition into a PDMA ring. The caller fills the fields up to
+//! pvCBData, ADCRingStart() fills the others.
+//!
+//! The ring holds \e ulFrames scans of the enabled channels, interleaved as
+//! converted: channels in ascending order, one word per sample. Each half of
+//! the ring is split into one block per channel in \e pusBlock when it is
+//! done, the block of half h being at pusBlock + h * ulChannels * ulFrames
+//! / 2, with the ulFrames / 2 samples of enabled channel slot k at offset
+//! k * ulFrames / 2 in it.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! Ring written by the PDMA, ulFrames * ulChannels words
+    //
+    unsigned long *pulRing;
+
+    //
+    //! Per channel blocks, ulFrames * ulChannels samples
+    //
+    unsigned short *pusBlock;
+
+    //
+    //! Number of scans the ring holds, even
+    //
+    unsigned long ulFrames;
+
+    //
+    //! Called from the PDMA interrupt with pvCBData, the
+    //! \b ADC_RING_EVENT_* flags as ulEvent, the samples per channel as
+    //! ulMsgParam and the block of the half as pvMsgData
+    //
+    xtEventCallback pfnCallback;
+
+    //
+    //! Passed to the callback
+    //
+    void *pvCBData;
+
+    //
+    //! Number of enabled channels
+    //
+    unsigned long ulChannels;
+
+    //
+    //! Slot of each channel in a scan, ADC_RING_SLOT_NONE if not enabled
+    //
+    unsigned char ucSlot[8];
+
+    //
+    //! PDMA channel of the ring
+    //
+    unsigned long ulDMAChannel;
+
+    //
+    //! Number of halves with an overrun
+    //
+    unsigned long ulOverruns;
+}
+tADCRing;
+
+//*****************************************************************************
+//
+//! @}
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! \addtogroup NUC1xx_ADC_Filter NUC1xx ADC Sample Filter
+//! \brief Integer decimation and filtering of the samples of a channel, see
+//! ADCFilterInit().
+//! @{
+//
+//*****************************************************************************
+
+//
+//! Highest CIC order of the decimator
+//
+#define ADC_FILTER_ORDER_MAX    3
+
+//
+//! Highest log2 of the decimation ratio
+//
+#define ADC_FILTER_RATIO_MAX    8
+
+//
+//! Highest number of bits kept from the oversampling
+//
+#define ADC_FILTER_GROWTH_MAX   8
+
+//
+//! Longest window of the median filter
+//
+#define ADC_FILTER_MEDIAN_MAX   9
+
+//
+//! Fraction bits of the IIR filter state below the output
+//
+#define ADC_FILTER_IIR_FRAC     8
+
+//*****************************************************************************
+//
+//! Filter of the samples of one ADC channel, set up by ADCFilterInit(),
+//! ADCFilterMedianSet() and ADCFilterIIRSet(). The fields are private.
+//!
+//! The samples go through, in this order:
+//! - a CIC decimator of order 1 (boxcar) to 3, summing 2^n samples into one,
+//! which keeps up to ADC_FILTER_GROWTH_MAX bits more than the ADC,
+//! - a moving median over an odd window of decimated samples,
+//! - a first order IIR low pass y += (x - y) / 2^k.
+//! .
+//! The output is a signed integer in Q-format with as many fraction bits as
+//! bits kept from the oversampling, one ADC code being 2^growth.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! log2 of the decimation ratio, 0 without decimation
+    //
+    unsigned char ucRatio;
+
+    //
+    //! CIC order, 1 for a boxcar
+    //
+    unsigned char ucOrder;
+
+    //
+    //! Right shift of the decimator output, order * ratio - growth
+    //
+    unsigned char ucShift;
+
+    //
+    //! log2 of the IIR time constant, 0 without IIR
+    //
+    unsigned char ucIIRShift;
+
+    //
+    //! Median window, 0 without median
+    //
+    unsigned char ucWindow;
+
+    //
+    //! Median samples held, up to ucWindow
+    //
+    unsigned char ucFill;
+
+    //
+    //! Oldest sample of the median window
+    //
+    unsigned char ucOldest;
+
+    //
+    //! The IIR state is set
+    //
+    unsigned char ucIIRStarted;
+
+    //
+    //! Samples into the current decimation
+    //
+    unsigned long ulPhase;
+
+    //
+    //! Integrators and combs of the decimator, wrapping
+    //
+    unsigned long ulInteg[ADC_FILTER_ORDER_MAX];
+    unsigned long ulComb[ADC_FILTER_ORDER_MAX];
+
+    //
+    //! Median window in arrival order and sorted
+    //
+    long lHistory[ADC_FILTER_MEDIAN_MAX];
+    long lSorted[ADC_FILTER_MEDIAN_MAX];
+
+    //
+    //! IIR state, ADC_FILTER_IIR_FRAC bits below the output
+    //
+    long lIIR;
+
+    //
+    //! Last output
+    //
+    long lOutput;
+}
+tADCFilter;
+
+//*****************************************************************************
+//
+//! @}
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! \addtogroup NUC1xx_ADC_Watch NUC1xx ADC Threshold Watch
+//! \brief Window watch of channels with the digital comparators, see
+//! ADCWatchStart().
+//! @{
+//
+//*****************************************************************************
+
+//
+//! The result is below the window, as event or window state
+//
+#define ADC_WATCH_BELOW         0x00000001
+
+//
+//! The result is in the window, as event or window state
+//
+#define ADC_WATCH_INSIDE        0x00000002
+
+//
+//! The result is above the window, as event or window state
+//
+#define ADC_WATCH_ABOVE         0x00000004
+
+//*****************************************************************************
+//
+//! Window of a watched channel. The result is inside when ulLow <= result
+//! < ulHigh.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! Channel watched, 0 to 7
+    //
+    unsigned long ulChannel;
+
+    //
+    //! Lower bound of the window, 12 bits
+    //
+    unsigned long ulLow;
+
+    //
+    //! Upper bound of the window, 12 bits
+    //
+    unsigned long ulHigh;
+
+    //
+    //! Last state seen, \b ADC_WATCH_BELOW, \b ADC_WATCH_INSIDE or
+    //! \b ADC_WATCH_ABOVE
+    //
+    unsigned long ulState;
+}
+tADCWatchWindow;
+
+//*****************************************************************************
+//
+//! Threshold watch of channels. The caller fills the fields up to pvCBData,
+//! ADCWatchStart() fills the others.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! Windows watched in turn
+    //
+    tADCWatchWindow *psWindows;
+
+    //
+    //! Number of windows
+    //
+    unsigned long ulWindows;
+
+    //
+    //! Matching conversions in a row before a crossing counts, 0 to 15
+    //
+    unsigned long ulMatchCnt;
+
+    //
+    //! Called from the ADC interrupt at a crossing with pvCBData, the new
+    //! state as ulEvent, the index of the window as ulMsgParam and the
+    //! window as pvMsgData
+    //
+    xtEventCallback pfnCallback;
+
+    //
+    //! Passed to the callback
+    //
+    void *pvCBData;
+
+    //
+    //! Index of the window on the comparators
+    //
+    unsigned long ulCurrent;
+}
+tADCWatch;
+
+//*****************************************************************************
+//
+//! @}
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! \addtogroup NUC1xx_ADC_Calibration NUC1xx ADC Calibration Cache
+//! \brief Self calibration run only when needed, see ADCCalibrationCheck().
+//! @{
+//
+//*****************************************************************************
+
+//
+//! The calibration holds, nothing was started
+//
+#define ADC_CAL_VALID           0x00000000
+
+//
+//! A calibration runs, the ADC must not convert
+//
+#define ADC_CAL_RUNNING         0x00000001
+
+//
+//! A calibration has just completed
+//
+#define ADC_CAL_DONE            0x00000002
+
+//*****************************************************************************
+//
+//! Record of the last self calibration of the ADC. The caller fills the
+//! drifts, the calibration functions fill the others. The record can be
+//! kept in RAM retained in deep sleep, it is only trusted while the ADC
+//! still holds the calibration.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! Change of the temperature sensor code that calls for a calibration
+    //
+    unsigned long ulTempDrift;
+
+    //
+    //! Change of the band-gap code, the supply seen from the ADC, that
+    //! calls for a calibration
+    //
+    unsigned long ulSupplyDrift;
+
+    //
+    //! Fingerprint of the configuration calibrated, 0 if none
+    //
+    unsigned long ulFingerprint;
+
+    //
+    //! Temperature sensor code at the calibration
+    //
+    unsigned long ulTemp;
+
+    //
+    //! Band-gap code at the calibration
+    //
+    unsigned long ulBandGap;
+
+    //
+    //! A calibration started by ADCCalibrationUpdate() runs
+    //
+    unsigned long ulRunning;
+
+    //
+    //! Number of calibrations run
+    //
+    unsigned long ulCalibrations;
+
+    //
+    //! Number of calibrations skipped by ADCCalibrationCheck()
+    //
+    unsigned long ulSkipped;
+}
+tADCCalibration;
+
+//*****************************************************************************
+//
+//! @}
+//
+//*****************************************************************************
+
 //*****************************************************************************
 //
 //! \addtogroup NUC1xx_ADC_Exported_APIs NUC1xx ADC API
@@ -1197,6 +1612,28 @@ extern void ADCCompEnable(unsigned long ulBase, unsigned long ulComp);
 
 extern void ADCCompDisable(unsigned long ulBase, unsigned long ulComp);
 
+extern xtBoolean ADCRingStart(unsigned long ulBase, tADCRing *psRing);
+extern void ADCRingStop(unsigned long ulBase);
+
+extern void ADCFilterInit(tADCFilter *psFilter, unsigned long ulRatio,
+                          unsigned long ulOrder, unsigned long ulGrowth);
+extern void ADCFilterMedianSet(tADCFilter *psFilter, unsigned long ulWindow);
+extern void ADCFilterIIRSet(tADCFilter *psFilter, unsigned long ulShift);
+extern void ADCFilterReset(tADCFilter *psFilter);
+extern xtBoolean ADCFilterPut(tADCFilter *psFilter, long lSample);
+extern long ADCFilterGet(tADCFilter *psFilter);
+extern void ADCFilterChannelSet(unsigned long ulBase, unsigned long ulChannel,
+                                tADCFilter *psFilter);
+
+extern xtBoolean ADCWatchStart(unsigned long ulBase, tADCWatch *psWatch);
+extern void ADCWatchRotate(unsigned long ulBase);
+extern void ADCWatchStop(unsigned long ulBase);
+
+extern xtBoolean ADCCalibrationCheck(unsigned long ulBase,
+                                     tADCCalibration *psCal);
+extern unsigned long ADCCalibrationUpdate(unsigned long ulBase,
+                                          tADCCalibration *psCal);
+
 //*****************************************************************************
 //
 //! @}
@@ -48,25 +48,42 @@
 #include "xsysctl.h"
 #include "xdma.h"
 
+//*****************************************************************************
+//
+// Software state of one PDMA channel.
+//
+// The PDMA has no half transfer interrupt. When PDMA_EVENT_HALF is enabled
+// PDMAChannelTransferSet() programs the first half only and keeps the
+// second one here, the transfer done interrupt of the first half starts it.
+//
+//*****************************************************************************
 typedef struct
 {
     //
-    // Channel ID.
+    // Interrupt callback and its data.
     //
-    unsigned long ulChannelID;
+    xtEventCallback pfnCallback;
+    void *pvCBData;
 
     //
-    // 
+    // Events enabled by PDMAChannelIntEnable(), PDMA_EVENT_HALF included.
     //
-    xtEventCallback pfnDMAChannelHandlerCallback;
+    unsigned long ulIntFlags;
 
     //
-    // Channel Assignment status
+    // Second half of a split transfer, ulHalfSize is 0 when none is pending.
     //
-    xtBoolean bChannelAssigned;
+    unsigned long ulHalfSrc;
+    unsigned long ulHalfDst;
+    unsigned long ulHalfSize;
 
+    //
+    // Chain elements still to run, ulChainLeft is 0 when no chain runs.
+    //
+    const tPDMAChainDesc *psChain;
+    unsigned long ulChainLeft;
 }
-tDMAChannelAsssign;
+tDMAChannel;
 
 //
 // DMA Channels Address.
@@ -95,35 +112,60 @@ static unsigned long g_psDMAIPSelectReg[] =
 };
 
 #define PDMA_PDSRx(a)  (((a) >> 28) & 0x3)
-#define PDMA_PDSR_M(a) ((((a) & 0xF) << ((a) & 0x1f0000 >> 16)))
+#define PDMA_PDSR_M(a) ((((a) & 0xF) << (((a) & 0x1f0000) >> 16)))
 
 //*****************************************************************************
 //
-// An array is DMA Callback function point
+// An array is DMA channel state.
 //
 //*****************************************************************************
-// static xtEventCallback g_pfnDMAGHandlerCallbacks[9]={0};
+static tDMAChannel g_psDMAChannels[PDMA_CHANNEL_COUNT];
+
+//
+// Free channels, bit n set when channel n is not assigned.
+//
+static unsigned long g_ulDMAChannelFree = (1 << PDMA_CHANNEL_COUNT) - 1;
+
+//
+// Longest chain element of the memory service, a word multiple below the
+// 16 bit byte count limit, the number of elements it can chain and the
+// longest block it can move, longer ones are moved by the CPU.
+//
+#define PDMA_MEM_CHUNK          0xFFFC
+#define PDMA_MEM_CHAIN_MAX      4
+#define PDMA_MEM_SIZE_MAX       (PDMA_MEM_CHUNK * PDMA_MEM_CHAIN_MAX)
 
 //
-// DMA Channels Assignment table.
+// The memory service runs one DMA operation at a time.
 //
-static tDMAChannelAsssign g_psDMAChannelAssignTable[] = 
+typedef struct
 {
-    { xDMA_CHANNEL_0,   0,      xfalse },
-    { xDMA_CHANNEL_1,   0,      xfalse },            
-    { xDMA_CHANNEL_2,   0,      xfalse },
-    { xDMA_CHANNEL_3,   0,      xfalse },        
-    { xDMA_CHANNEL_4,   0,      xfalse },
-    { xDMA_CHANNEL_5,   0,      xfalse },
-    { xDMA_CHANNEL_6,   0,      xfalse },        
-    { xDMA_CHANNEL_7,   0,      xfalse },
-    { xDMA_CHANNEL_8,   0,      xfalse },            
+    unsigned long ulChannelID;
+    xtEventCallback pfnCallback;
+    void *pvCBData;
+    void *pvDst;
 
     //
-    // End.
+    // Fill pattern, read by the PDMA with a fixed source address.
     //
-    { xDMA_CHANNEL_NOT_EXIST,   xfalse },       
-         
+    unsigned long ulFill;
+
+    tPDMAChainDesc psChain[PDMA_MEM_CHAIN_MAX];
+    volatile xtBoolean bBusy;
+}
+tDMAMemOp;
+
+static tDMAMemOp g_sDMAMemOp;
+static unsigned long g_ulDMAMemThreshold = PDMA_MEM_CPU_THRESHOLD;
+
+//
+// Bit index of an isolated set bit, indexed by the top five bits of the bit
+// times the de Bruijn constant 0x077CB531.
+//
+static const unsigned char g_pucDMABitIndex[32] =
+{
+    0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+    31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9
 };
 
 //*****************************************************************************
@@ -148,11 +190,63 @@ xDMAChannelIDValid(unsigned long ulChannelID)
 #endif
 
 
+//*****************************************************************************
+//
+//! \internal
+//! \brief Get the index of the lowest set bit.
+//!
+//! \param ulMask is the bit mask, must not be 0.
+//!
+//! The Cortex-M0 has no count leading/trailing zeros instruction, the lowest
+//! bit is isolated and looked up through a de Bruijn multiply instead.
+//!
+//! \return the index of the lowest set bit of \e ulMask.
+//
+//*****************************************************************************
+static unsigned long
+PDMALowestBitGet(unsigned long ulMask)
+{
+    return g_pucDMABitIndex[(((ulMask & (0 - ulMask)) * 0x077CB531) &
+                             0xFFFFFFFF) >> 27];
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Start one chain element on a channel.
+//!
+//! \param ulBase is the channel register base.
+//! \param psDesc is the element.
+//!
+//! Only the width and address modes are taken from the element, the mode of
+//! the channel is the one set when it was assigned.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+PDMAChainElementStart(unsigned long ulBase, const tPDMAChainDesc *psDesc)
+{
+    xHWREG(ulBase + PDMA_CSR) = (xHWREG(ulBase + PDMA_CSR) &
+                                 ~(PDMA_CSR_SDA_M | PDMA_CSR_DAD_M |
+                                   PDMA_CSR_TWS_M)) |
+                                (psDesc->ulControl &
+                                 (PDMA_CSR_SDA_M | PDMA_CSR_DAD_M |
+                                  PDMA_CSR_TWS_M));
+    xHWREG(ulBase + PDMA_SAR) = (unsigned long)psDesc->pvSrcAddr;
+    xHWREG(ulBase + PDMA_DAR) = (unsigned long)psDesc->pvDstAddr;
+    xHWREG(ulBase + PDMA_BCR) = psDesc->ulTransferSize;
+    xHWREG(ulBase + PDMA_CSR) |= PDMA_CSR_TEN;
+}
+
 //*****************************************************************************
 //
 //! DMA Interrupt Handler.
 //!
-//! The interrupt handler for uDMA interrupts from the memory channel. 
+//! The interrupt handler for PDMA interrupts. Only the channels flagged in
+//! PDMA_GCRISR are visited. The callback of each channel gets its
+//! callback data and the event in \e ulMsgParam: \b PDMA_EVENT_TC,
+//! \b PDMA_EVENT_ERROR or \b PDMA_EVENT_HALF.
 //!
 //! \return None.
 //
@@ -160,39 +254,65 @@ xDMAChannelIDValid(unsigned long ulChannelID)
 void
 PDMAIntHandler(void)
 {
+    unsigned long ulPending;
     unsigned long ulChannelID;
+    unsigned long ulBase;
     unsigned long ulStatus;
-    ulStatus = xHWREG(PDMA_GCRISR);
-    for(ulChannelID = 0; 
-        g_psDMAChannelAssignTable[ulChannelID].ulChannelID != 
-        xDMA_CHANNEL_NOT_EXIST;
-        ulChannelID++)
+    unsigned long ulEvent;
+    tDMAChannel *psChannel;
+
+    ulPending = xHWREG(PDMA_GCRISR) & ((1 << PDMA_CHANNEL_COUNT) - 1);
+    while(ulPending != 0)
     {
-        if(g_psDMAChannelAssignTable[ulChannelID].bChannelAssigned == xtrue)
+        ulChannelID = PDMALowestBitGet(ulPending);
+        ulPending &= ulPending - 1;
+
+        ulBase = g_psDMAChannelAddress[ulChannelID];
+        psChannel = &g_psDMAChannels[ulChannelID];
+
+        //
+        // The status bits are write 1 to clear.
+        //
+        ulStatus = xHWREG(ulBase + PDMA_ISR) &
+                   (PDMA_EVENT_TC | PDMA_EVENT_ERROR);
+        xHWREG(ulBase + PDMA_ISR) = ulStatus;
+
+        if(ulStatus & PDMA_EVENT_ERROR)
         {
-            if (ulStatus & (1<<ulChannelID))
-            {
-    			if(xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_ISR) 
-                   & PDMA_EVENT_TC)	 											
-    			{
-    			  xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_ISR) |= 
-                  PDMA_EVENT_TC;
-    			   if (g_psDMAChannelAssignTable
-                       [ulChannelID].pfnDMAChannelHandlerCallback != 0)    		
-    		    		g_psDMAChannelAssignTable
-    		    		[ulChannelID].pfnDMAChannelHandlerCallback(0,0,1,0);							
-    			}
-    			else if(xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_ISR) 
-                   & PDMA_EVENT_ERROR)	 											
-    			{
-    			  xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_ISR) |= 
-                  PDMA_EVENT_ERROR;
-    			   if (g_psDMAChannelAssignTable
-                       [ulChannelID].pfnDMAChannelHandlerCallback != 0)    		
-    		    		g_psDMAChannelAssignTable
-    		    		[ulChannelID].pfnDMAChannelHandlerCallback(0,0,0,0);							
-    			}
-            }
+            psChannel->ulHalfSize = 0;
+            psChannel->ulChainLeft = 0;
+            ulEvent = PDMA_EVENT_ERROR;
+        }
+        else if((ulStatus & PDMA_EVENT_TC) && (psChannel->ulChainLeft != 0))
+        {
+            //
+            // Element done, the callback waits for the end of the chain.
+            //
+            PDMAChainElementStart(ulBase, psChannel->psChain);
+            psChannel->psChain++;
+            psChannel->ulChainLeft--;
+            continue;
+        }
+        else if((ulStatus & PDMA_EVENT_TC) && (psChannel->ulHalfSize != 0))
+        {
+            //
+            // First half done, start the second one.
+            //
+            xHWREG(ulBase + PDMA_SAR) = psChannel->ulHalfSrc;
+            xHWREG(ulBase + PDMA_DAR) = psChannel->ulHalfDst;
+            xHWREG(ulBase + PDMA_BCR) = psChannel->ulHalfSize;
+            xHWREG(ulBase + PDMA_CSR) |= PDMA_CSR_TEN;
+            psChannel->ulHalfSize = 0;
+            ulEvent = PDMA_EVENT_HALF;
+        }
+        else
+        {
+            ulEvent = ulStatus;
+        }
+
+        if((ulEvent & psChannel->ulIntFlags) && (psChannel->pfnCallback != 0))
+        {
+            psChannel->pfnCallback(psChannel->pvCBData, 0, ulEvent, 0);
         }
     }
 }
@@ -308,8 +428,39 @@ PDMAChannelIsBusy(unsigned long ulChannelID)
     //
     xASSERT(xDMAChannelIDValid(ulChannelID));
 
-    return ((xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_CSR) 
-            | PDMA_CSR_TEN) ? xtrue : xfalse);
+    //
+    // A chain is busy between its elements too.
+    //
+    return (((xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_CSR) 
+            & PDMA_CSR_TEN) || (g_psDMAChannels[ulChannelID].ulChainLeft != 0))
+            ? xtrue : xfalse);
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Write the hardware interrupt enables of a channel.
+//!
+//! \param ulChannelID is the channel ID.
+//!
+//! PDMA_EVENT_HALF and chains are built on the transfer done interrupt, so
+//! they need PDMA_EVENT_TC enabled in the hardware.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+PDMAChannelIERUpdate(unsigned long ulChannelID)
+{
+    unsigned long ulIntFlags = g_psDMAChannels[ulChannelID].ulIntFlags;
+
+    if((ulIntFlags & PDMA_EVENT_HALF) ||
+       (g_psDMAChannels[ulChannelID].ulChainLeft != 0))
+    {
+        ulIntFlags |= PDMA_EVENT_TC;
+    }
+    xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_IER) =
+    ulIntFlags & (PDMA_EVENT_TC | PDMA_EVENT_ERROR);
 }
 
 //*****************************************************************************
@@ -326,9 +477,12 @@ PDMAChannelIsBusy(unsigned long ulChannelID)
 //! The interrupt type can be:
 //! - PDMA_EVENT_TC
 //! - PDMA_EVENT_ERROR
+//! - PDMA_EVENT_HALF
 //! - refrence \ref NUC1xx_PDMA_Event_Flags
 //! .
 //!
+//! PDMA_EVENT_HALF takes effect from the next PDMAChannelTransferSet().
+//!
 //! \return None.
 //
 //*****************************************************************************
@@ -339,13 +493,14 @@ PDMAChannelIntEnable(unsigned long ulChannelID, unsigned long ulIntFlags)
     // Check the arguments.
     //
     xASSERT(xDMAChannelIDValid(ulChannelID));
-    xASSERT(((ulIntFlags & PDMA_EVENT_TC) == PDMA_EVENT_TC) || 
-            ((ulIntFlags & PDMA_EVENT_ERROR) == PDMA_EVENT_ERROR));
+    xASSERT((ulIntFlags != 0) && ((ulIntFlags & ~(PDMA_EVENT_TC |
+             PDMA_EVENT_ERROR | PDMA_EVENT_HALF)) == 0));
 
     //
     // Enable PDMA channel interrupt.
     //
-    xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_IER) |= ulIntFlags;
+    g_psDMAChannels[ulChannelID].ulIntFlags |= ulIntFlags;
+    PDMAChannelIERUpdate(ulChannelID);
 }
 
 //*****************************************************************************
@@ -362,6 +517,7 @@ PDMAChannelIntEnable(unsigned long ulChannelID, unsigned long ulIntFlags)
 //! The interrupt type can be:
 //! - PDMA_EVENT_TC
 //! - PDMA_EVENT_ERROR
+//! - PDMA_EVENT_HALF
 //! - refrence \ref NUC1xx_PDMA_Event_Flags
 //! .
 //!
@@ -375,13 +531,14 @@ PDMAChannelIntDisable(unsigned long ulChannelID, unsigned long ulIntFlags)
     // Check the arguments.
     //
     xASSERT(xDMAChannelIDValid(ulChannelID));
-    xASSERT(((ulIntFlags & PDMA_EVENT_TC) == PDMA_EVENT_TC) || 
-            ((ulIntFlags & PDMA_EVENT_ERROR) == PDMA_EVENT_ERROR));
+    xASSERT((ulIntFlags != 0) && ((ulIntFlags & ~(PDMA_EVENT_TC |
+             PDMA_EVENT_ERROR | PDMA_EVENT_HALF)) == 0));
 
     //
     // Disable PDMA channel interrupt.
     //
-    xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_IER) &= ~ulIntFlags;
+    g_psDMAChannels[ulChannelID].ulIntFlags &= ~ulIntFlags;
+    PDMAChannelIERUpdate(ulChannelID);
 }
 
 //*****************************************************************************
@@ -424,6 +581,8 @@ PDMAChannelDynamicAssign(unsigned long ulDMASrcRequest,
                          unsigned long ulDMADestRequest)
 {
     unsigned long ulChannelID;
+    xtBoolean bMasked;
+
     //
     // Check the arguments.
     //
@@ -456,87 +615,74 @@ PDMAChannelDynamicAssign(unsigned long ulDMASrcRequest,
         return xDMA_CHANNEL_NOT_EXIST;
     }
     
-    for(ulChannelID = 0; 
-        g_psDMAChannelAssignTable[ulChannelID].ulChannelID != xDMA_CHANNEL_NOT_EXIST;
-        ulChannelID++)
+    //
+    // Take the lowest free channel, drivers assign from their interrupt
+    // handlers too.
+    //
+    bMasked = xIntMasterDisable();
+    if(g_ulDMAChannelFree == 0)
     {
-        if(g_psDMAChannelAssignTable[ulChannelID].bChannelAssigned == xfalse)
+        if(!bMasked)
         {
-            g_psDMAChannelAssignTable[ulChannelID].bChannelAssigned = xtrue;
-            break;
+            xIntMasterEnable();
         }
+        return xDMA_CHANNEL_NOT_EXIST;
     }
-    if(!(ulDMASrcRequest & xDMA_REQUEST_MEM) && ulDMASrcRequest & 0x00000100)
+    ulChannelID = PDMALowestBitGet(g_ulDMAChannelFree);
+    g_ulDMAChannelFree &= ~(1 << ulChannelID);
+    if(!bMasked)
     {
-        if(g_psDMAChannelAssignTable[ulChannelID].ulChannelID != 
-            xDMA_CHANNEL_NOT_EXIST)
-        {
-            xHWREG(g_psDMAIPSelectReg[PDMA_PDSRx(ulDMASrcRequest)]) &= 
-            ~(PDMA_PDSR_M(ulDMASrcRequest));
-            
-            xHWREG(g_psDMAIPSelectReg[PDMA_PDSRx(ulDMASrcRequest)]) |= 
-            (PDMA_PDSR_M((ulDMASrcRequest & 0xFFFFFF0) | ulChannelID));
-            
-            xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_CSR) &= 
-            ~PDMA_CSR_MODE_M;
-            xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_CSR) |= 
-            PDMA_CSR_MODE_MTOP;
-            return ulChannelID;
-        }
-        else
-        {
-            return xDMA_CHANNEL_NOT_EXIST;
-        }
+        xIntMasterEnable();
     }
-    if(!(ulDMADestRequest & xDMA_REQUEST_MEM) && 
-       !(ulDMADestRequest & 0x00000100))
-    {
-        if(g_psDMAChannelAssignTable[ulChannelID].ulChannelID != 
-            xDMA_CHANNEL_NOT_EXIST)
-        {
-            xHWREG(g_psDMAIPSelectReg[PDMA_PDSRx(ulDMADestRequest)]) &= 
-            ~(PDMA_PDSR_M(ulDMADestRequest));
-            
-            xHWREG(g_psDMAIPSelectReg[PDMA_PDSRx(ulDMADestRequest)]) |= 
-            (PDMA_PDSR_M((ulDMADestRequest & 0xFFFFFF0) | ulChannelID));
-
-            xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_CSR) &= 
-            ~PDMA_CSR_MODE_M;
-            xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_CSR) |= 
-            PDMA_CSR_MODE_PTOM;
-            return ulChannelID;
-        }
-        else
-        {
-            return xDMA_CHANNEL_NOT_EXIST;
-        }
-    }
-    
+
     //
-    // Mem to Mem type
+    // The request IDs have bit 0 set too, so compare against 
+    // xDMA_REQUEST_MEM instead of testing its bit.
     //
-    if((ulDMASrcRequest & xDMA_REQUEST_MEM) &&
-       (ulDMADestRequest & xDMA_REQUEST_MEM))
+    if(ulDMASrcRequest != xDMA_REQUEST_MEM)
     {
-        if(g_psDMAChannelAssignTable[ulChannelID].ulChannelID != 
-            xDMA_CHANNEL_NOT_EXIST)
-        {
-            xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_CSR) &= 
-            ~PDMA_CSR_MODE_M;
-            xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_CSR) |= 
-            PDMA_CSR_MODE_MTOM;
-            return ulChannelID;
-        }
-        else
-        {
-            return xDMA_CHANNEL_NOT_EXIST;
-        }
+        //
+        // Peripheral Rx to Mem type
+        //
+        xHWREG(g_psDMAIPSelectReg[PDMA_PDSRx(ulDMASrcRequest)]) &= 
+        ~(PDMA_PDSR_M(ulDMASrcRequest));
+        
+        xHWREG(g_psDMAIPSelectReg[PDMA_PDSRx(ulDMASrcRequest)]) |= 
+        (PDMA_PDSR_M((ulDMASrcRequest & 0xFFFFFF0) | ulChannelID));
+        
+        xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_CSR) &= 
+        ~PDMA_CSR_MODE_M;
+        xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_CSR) |= 
+        PDMA_CSR_MODE_PTOM;
     }
+    else if(ulDMADestRequest != xDMA_REQUEST_MEM)
+    {
+        //
+        // Mem to peripheral Tx type
+        //
+        xHWREG(g_psDMAIPSelectReg[PDMA_PDSRx(ulDMADestRequest)]) &= 
+        ~(PDMA_PDSR_M(ulDMADestRequest));
+        
+        xHWREG(g_psDMAIPSelectReg[PDMA_PDSRx(ulDMADestRequest)]) |= 
+        (PDMA_PDSR_M((ulDMADestRequest & 0xFFFFFF0) | ulChannelID));
 
-    //
-    // when the src request is tx type, or dest request is rx type, assign false.
-    //
-    return xDMA_CHANNEL_NOT_EXIST;
+        xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_CSR) &= 
+        ~PDMA_CSR_MODE_M;
+        xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_CSR) |= 
+        PDMA_CSR_MODE_MTOP;
+    }
+    else
+    {
+        //
+        // Mem to Mem type
+        //
+        xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_CSR) &= 
+        ~PDMA_CSR_MODE_M;
+        xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_CSR) |= 
+        PDMA_CSR_MODE_MTOM;
+    }
+
+    return ulChannelID;
 }
 
 //*****************************************************************************
@@ -556,22 +702,48 @@ PDMAChannelDynamicAssign(unsigned long ulDMASrcRequest,
 void
 PDMAChannelDeAssign(unsigned long ulChannelID)
 {
-    int i;
-    
+    tDMAChannel *psChannel;
+    xtBoolean bMasked;
+
     xASSERT(xDMAChannelIDValid(ulChannelID));
 
-    for(i = 0; 
-        g_psDMAChannelAssignTable[i].ulChannelID != xDMA_CHANNEL_NOT_EXIST;
-        i++)
+    psChannel = &g_psDMAChannels[ulChannelID];
+    psChannel->pfnCallback = 0;
+    psChannel->pvCBData = 0;
+    psChannel->ulIntFlags = 0;
+    psChannel->ulHalfSize = 0;
+    psChannel->ulChainLeft = 0;
+
+    bMasked = xIntMasterDisable();
+    g_ulDMAChannelFree |= 1 << ulChannelID;
+    if(!bMasked)
     {
-        if(g_psDMAChannelAssignTable[i].ulChannelID == ulChannelID)
-        {
-            g_psDMAChannelAssignTable[i].bChannelAssigned = xfalse;
-            return;
-        }
+        xIntMasterEnable();
     }
 }
 
+//*****************************************************************************
+//
+//! \brief Get the assignment status of a channel.
+//!
+//! \param ulChannelID is the channel ID.
+//! The channel ID can be:
+//! - xDMA_CHANNEL_0
+//! - xDMA_CHANNEL_1
+//! - others refrence \ref xDMA_Channel_IDs
+//! .
+//!
+//! \return xtrue if the channel is assigned, xfalse if it is free.
+//
+//*****************************************************************************
+xtBoolean
+PDMAChannelAssignmentGet(unsigned long ulChannelID)
+{
+    xASSERT(xDMAChannelIDValid(ulChannelID));
+
+    return (g_ulDMAChannelFree & (1 << ulChannelID)) ? xfalse : xtrue;
+}
+
 //*****************************************************************************
 //
 //! \brief Sets the control parameters for a DMA channel.
@@ -669,6 +841,9 @@ PDMAChannelControlSet(unsigned long ulChannelID,
 //! For BASIC and AUTO modes, it is safe to make changes when the channel is
 //! disabled.
 //!
+//! When PDMA_EVENT_HALF is enabled the transfer is run as two halves split
+//! on an element boundary, so PDMAChannelControlSet() must be called first.
+//!
 //! \return None.
 //
 //*****************************************************************************
@@ -676,10 +851,38 @@ void
 PDMAChannelTransferSet(unsigned long ulChannelID, void *pvSrcAddr, 
                        void *pvDstAddr, unsigned long ulTransferSize)
 {
+    unsigned long ulCSR, ulUnit, ulFirst;
+    tDMAChannel *psChannel;
+
     xASSERT(xDMAChannelIDValid(ulChannelID));
 
     xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_CSR) |= PDMA_CSR_CEN;
 
+    psChannel = &g_psDMAChannels[ulChannelID];
+    psChannel->ulHalfSize = 0;
+    if(psChannel->ulIntFlags & PDMA_EVENT_HALF)
+    {
+        ulCSR = xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_CSR);
+        ulUnit = ((ulCSR & PDMA_CSR_TWS_M) == PDMA_WIDTH_8BIT) ? 1 :
+                 ((ulCSR & PDMA_CSR_TWS_M) == PDMA_WIDTH_16BIT) ? 2 : 4;
+        ulFirst = (ulTransferSize / ulUnit / 2) * ulUnit;
+        if(ulFirst != 0)
+        {
+            psChannel->ulHalfSrc = (unsigned long)pvSrcAddr;
+            psChannel->ulHalfDst = (unsigned long)pvDstAddr;
+            if((ulCSR & PDMA_CSR_SDA_M) == PDMA_SRC_DIR_INC)
+            {
+                psChannel->ulHalfSrc += ulFirst;
+            }
+            if((ulCSR & PDMA_CSR_DAD_M) == PDMA_DST_DIR_INC)
+            {
+                psChannel->ulHalfDst += ulFirst;
+            }
+            psChannel->ulHalfSize = ulTransferSize - ulFirst;
+            ulTransferSize = ulFirst;
+        }
+    }
+
     xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_SAR) = 
     (unsigned long)pvSrcAddr;
     
@@ -692,6 +895,46 @@ PDMAChannelTransferSet(unsigned long ulChannelID, void *pvSrcAddr,
     
 }
 
+//*****************************************************************************
+//
+//! \brief Run a chain of transfers on a channel.
+//!
+//! \param ulChannelID is the channel ID.
+//! \param psDesc is the array of chain elements.
+//! \param ulDescCount is the number of elements, at least 1.
+//!
+//! Each element brings its own addresses, size, width and address modes.
+//! The PDMA interrupt handler starts the next element when one is done, the
+//! callback gets \b PDMA_EVENT_TC only at the end of the chain, or
+//! \b PDMA_EVENT_ERROR when an element fails, which ends the chain.
+//! PDMA_EVENT_HALF is not reported for chains.
+//!
+//! The channel must be assigned and enabled, INT_PDMA must be enabled and
+//! \e psDesc must stay valid until the chain ends. PDMAChannelIsBusy()
+//! returns xtrue until then.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+PDMAChannelChainStart(unsigned long ulChannelID, const tPDMAChainDesc *psDesc,
+                      unsigned long ulDescCount)
+{
+    tDMAChannel *psChannel;
+
+    xASSERT(xDMAChannelIDValid(ulChannelID));
+    xASSERT((psDesc != 0) && (ulDescCount != 0));
+
+    psChannel = &g_psDMAChannels[ulChannelID];
+    psChannel->ulHalfSize = 0;
+    psChannel->psChain = psDesc + 1;
+    psChannel->ulChainLeft = ulDescCount - 1;
+    PDMAChannelIERUpdate(ulChannelID);
+
+    xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_CSR) |= PDMA_CSR_CEN;
+    PDMAChainElementStart(g_psDMAChannelAddress[ulChannelID], psDesc);
+}
+
 //*****************************************************************************
 //
 //! \brief Init the DMA channel Interrupt Callback function.
@@ -703,9 +946,10 @@ PDMAChannelTransferSet(unsigned long ulChannelID, void *pvSrcAddr,
 //! call the callback function. 
 //! 
 //! param of pfnCallback
-//! - pvCBData not used, always 0.
-//! - ulEvent is the interrupt event.
-//! - ulEvent not used, always 0..
+//! - pvCBData is the data set by PDMAChannelIntCallbackDataSet(), 0 if none.
+//! - ulEvent not used, always 0.
+//! - ulMsgParam is the event, \b PDMA_EVENT_TC, \b PDMA_EVENT_ERROR or
+//!   \b PDMA_EVENT_HALF.
 //! - pvMsgData not used, always 0.
 //! .
 //!
@@ -716,25 +960,35 @@ void
 PDMAChannelIntCallbackInit(unsigned long ulChannelID, 
                     xtEventCallback pfnCallback)
 {
-    int i;
     //
     // Check the arguments.
     //
     xASSERT(xDMAChannelIDValid(ulChannelID));
 
-    for(i = 0; g_psDMAChannelAssignTable[i].ulChannelID != 
-           xDMA_CHANNEL_NOT_EXIST;
-               i++)
-    {
-        if(g_psDMAChannelAssignTable[i].ulChannelID == ulChannelID)
-        {
-            g_psDMAChannelAssignTable[i].pfnDMAChannelHandlerCallback = 
-                pfnCallback;
+    g_psDMAChannels[ulChannelID].pfnCallback = pfnCallback;
+}
 
-            break;
-        }
-    }
-            
+//*****************************************************************************
+//
+//! \brief Set the data passed to the DMA channel Interrupt Callback function.
+//!
+//! \param ulChannelID is channel ID.
+//! \param pvCBData is passed as the \e pvCBData parameter of the callback.
+//!
+//! The data is cleared by PDMAChannelDeAssign().
+//!
+//! \return None.
+//
+//*****************************************************************************
+void 
+PDMAChannelIntCallbackDataSet(unsigned long ulChannelID, void *pvCBData)
+{
+    //
+    // Check the arguments.
+    //
+    xASSERT(xDMAChannelIDValid(ulChannelID));
+
+    g_psDMAChannels[ulChannelID].pvCBData = pvCBData;
 }
 
 //*****************************************************************************
@@ -753,24 +1007,12 @@ PDMAChannelIntCallbackInit(unsigned long ulChannelID,
 xtEventCallback 
 PDMAChannelIntCallbackGet(unsigned long ulChannelID)
 {
-    int i;
     //
     // Check the arguments.
     //
     xASSERT(xDMAChannelIDValid(ulChannelID));
 
-    for(i = 0; g_psDMAChannelAssignTable[i].ulChannelID != 
-           xDMA_CHANNEL_NOT_EXIST;
-               i++)
-    {
-        if(g_psDMAChannelAssignTable[i].ulChannelID == ulChannelID)
-        {
-            return g_psDMAChannelAssignTable[i].pfnDMAChannelHandlerCallback;
-        }
-    }
-
-    return 0;
-    
+    return g_psDMAChannels[ulChannelID].pfnCallback;
 }
 
 //*****************************************************************************
@@ -802,7 +1044,7 @@ PDMAChannelIntFlagGet(unsigned long ulChannelID, unsigned long ulIntFlags)
     xASSERT(xDMAChannelIDValid(ulChannelID));
     xASSERT((ulIntFlags == PDMA_EVENT_TC) || (ulIntFlags == PDMA_EVENT_ERROR));
 
-    return ((xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_ISR) | ulIntFlags)
+    return ((xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_ISR) & ulIntFlags)
             ? xtrue : xfalse);
 }
 
@@ -835,7 +1077,7 @@ PDMAChannelIntFlagClear(unsigned long ulChannelID, unsigned long ulIntFlags)
     xASSERT(xDMAChannelIDValid(ulChannelID));
     xASSERT((ulIntFlags == PDMA_EVENT_TC) || (ulIntFlags == PDMA_EVENT_ERROR));
 
-    xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_ISR) |= ulIntFlags;
+    xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_ISR) = ulIntFlags;
 }
 
 //*****************************************************************************
@@ -968,3 +1210,449 @@ PDMAInternalBufPointerGet(unsigned long ulChannelID)
     return xHWREG(g_psDMAChannelAddress[ulChannelID] + PDMA_CBCR);
 }
 
+//*****************************************************************************
+//
+//! \internal
+//! \brief Copies a memory block with the CPU.
+//!
+//! \param pucDst is the destination.
+//! \param pucSrc is the source.
+//! \param ulSize is the number of bytes.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+PDMAMemCopyCPU(unsigned char *pucDst, const unsigned char *pucSrc,
+               unsigned long ulSize)
+{
+    unsigned long *pulDst;
+    const unsigned long *pulSrc;
+
+    if((((unsigned long)pucDst | (unsigned long)pucSrc) & 3) == 0)
+    {
+        pulDst = (unsigned long *)pucDst;
+        pulSrc = (const unsigned long *)pucSrc;
+        while(ulSize >= 16)
+        {
+            pulDst[0] = pulSrc[0];
+            pulDst[1] = pulSrc[1];
+            pulDst[2] = pulSrc[2];
+            pulDst[3] = pulSrc[3];
+            pulDst += 4;
+            pulSrc += 4;
+            ulSize -= 16;
+        }
+        while(ulSize >= 4)
+        {
+            *pulDst++ = *pulSrc++;
+            ulSize -= 4;
+        }
+        pucDst = (unsigned char *)pulDst;
+        pucSrc = (const unsigned char *)pulSrc;
+    }
+
+    while(ulSize >= 4)
+    {
+        pucDst[0] = pucSrc[0];
+        pucDst[1] = pucSrc[1];
+        pucDst[2] = pucSrc[2];
+        pucDst[3] = pucSrc[3];
+        pucDst += 4;
+        pucSrc += 4;
+        ulSize -= 4;
+    }
+    while(ulSize != 0)
+    {
+        *pucDst++ = *pucSrc++;
+        ulSize--;
+    }
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Fills a memory block with the CPU.
+//!
+//! \param pucDst is the destination.
+//! \param ulFill is the byte to write, repeated in all four bytes.
+//! \param ulSize is the number of bytes.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+PDMAMemFillCPU(unsigned char *pucDst, unsigned long ulFill,
+               unsigned long ulSize)
+{
+    unsigned long *pulDst;
+
+    while((((unsigned long)pucDst & 3) != 0) && (ulSize != 0))
+    {
+        *pucDst++ = ulFill;
+        ulSize--;
+    }
+
+    pulDst = (unsigned long *)pucDst;
+    while(ulSize >= 16)
+    {
+        pulDst[0] = ulFill;
+        pulDst[1] = ulFill;
+        pulDst[2] = ulFill;
+        pulDst[3] = ulFill;
+        pulDst += 4;
+        ulSize -= 16;
+    }
+    while(ulSize >= 4)
+    {
+        *pulDst++ = ulFill;
+        ulSize -= 4;
+    }
+
+    pucDst = (unsigned char *)pulDst;
+    while(ulSize != 0)
+    {
+        *pucDst++ = ulFill;
+        ulSize--;
+    }
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Ends a DMA operation of the memory service.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+PDMAMemRelease(void)
+{
+    PDMAChannelIntDisable(g_sDMAMemOp.ulChannelID,
+                          PDMA_EVENT_TC | PDMA_EVENT_ERROR);
+    PDMAChannelIntCallbackInit(g_sDMAMemOp.ulChannelID, 0);
+    PDMAChannelSoftwareReset(g_sDMAMemOp.ulChannelID);
+    PDMADisable(g_sDMAMemOp.ulChannelID);
+    PDMAChannelDeAssign(g_sDMAMemOp.ulChannelID);
+    g_sDMAMemOp.bBusy = xfalse;
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief PDMA channel callback of the memory service.
+//!
+//! \return Always 0.
+//
+//*****************************************************************************
+static unsigned long
+PDMAMemCallback(void *pvCBData, unsigned long ulEvent,
+                unsigned long ulMsgParam, void *pvMsgData)
+{
+    xtEventCallback pfnCallback;
+    void *pvUserData;
+    void *pvDst;
+
+    pfnCallback = g_sDMAMemOp.pfnCallback;
+    pvUserData = g_sDMAMemOp.pvCBData;
+    pvDst = g_sDMAMemOp.pvDst;
+    PDMAMemRelease();
+
+    if(pfnCallback != 0)
+    {
+        pfnCallback(pvUserData, 0, ulMsgParam, pvDst);
+    }
+    return 0;
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Runs the aligned body of a copy or fill by DMA.
+//!
+//! \param pucDst is the destination, aligned to \e ulWidth.
+//! \param pucSrc is the source, or 0 to fill with g_sDMAMemOp.ulFill.
+//! \param ulSize is the number of bytes, a multiple of \e ulWidth.
+//! \param ulWidth is the width in bytes, 1, 2 or 4.
+//! \param pfnCallback is the completion callback, 0 to wait.
+//! \param pvCBData is passed to \e pfnCallback.
+//! \param pvUserDst is passed to \e pfnCallback as \e pvMsgData.
+//!
+//! The caller owns g_sDMAMemOp and a channel has been assigned.
+//!
+//! \return xfalse if a waited for transfer failed, xtrue otherwise.
+//
+//*****************************************************************************
+static xtBoolean
+PDMAMemStart(unsigned char *pucDst, const unsigned char *pucSrc,
+             unsigned long ulSize, unsigned long ulWidth,
+             xtEventCallback pfnCallback, void *pvCBData, void *pvUserDst)
+{
+    unsigned long ulControl, ulCount, ulChunk, ulChannelID;
+    tPDMAChainDesc *psDesc;
+    xtBoolean bOk;
+
+    if(ulSize == 0)
+    {
+        PDMAMemRelease();
+        if(pfnCallback != 0)
+        {
+            pfnCallback(pvCBData, 0, PDMA_EVENT_TC, pvUserDst);
+        }
+        return xtrue;
+    }
+
+    ulChannelID = g_sDMAMemOp.ulChannelID;
+    ulControl = (ulWidth == 4) ? PDMA_WIDTH_32BIT :
+                (ulWidth == 2) ? PDMA_WIDTH_16BIT : PDMA_WIDTH_8BIT;
+    ulControl |= PDMA_DST_DIR_INC |
+                 ((pucSrc != 0) ? PDMA_SRC_DIR_INC : PDMA_SRC_DIR_FIXED);
+
+    for(ulCount = 0; ulSize != 0; ulCount++)
+    {
+        ulChunk = (ulSize > PDMA_MEM_CHUNK) ? PDMA_MEM_CHUNK : ulSize;
+        psDesc = &g_sDMAMemOp.psChain[ulCount];
+        psDesc->pvSrcAddr = (pucSrc != 0) ? (void *)pucSrc :
+                                            &g_sDMAMemOp.ulFill;
+        psDesc->pvDstAddr = pucDst;
+        psDesc->ulTransferSize = ulChunk;
+        psDesc->ulControl = ulControl;
+        pucDst += ulChunk;
+        if(pucSrc != 0)
+        {
+            pucSrc += ulChunk;
+        }
+        ulSize -= ulChunk;
+    }
+
+    PDMAEnable(ulChannelID);
+
+    if(pfnCallback != 0)
+    {
+        g_sDMAMemOp.pfnCallback = pfnCallback;
+        g_sDMAMemOp.pvCBData = pvCBData;
+        g_sDMAMemOp.pvDst = pvUserDst;
+        PDMAChannelIntCallbackInit(ulChannelID, PDMAMemCallback);
+        PDMAChannelIntEnable(ulChannelID, PDMA_EVENT_TC | PDMA_EVENT_ERROR);
+        PDMAChannelChainStart(ulChannelID, g_sDMAMemOp.psChain, ulCount);
+        return xtrue;
+    }
+
+    //
+    // Waiting, run the elements one by one without interrupts.
+    //
+    bOk = xtrue;
+    for(psDesc = g_sDMAMemOp.psChain; bOk && (ulCount != 0); ulCount--)
+    {
+        PDMAChannelControlSet(ulChannelID, psDesc->ulControl);
+        PDMAChannelTransferSet(ulChannelID, psDesc->pvSrcAddr,
+                               psDesc->pvDstAddr, psDesc->ulTransferSize);
+        while(PDMAChannelIsBusy(ulChannelID))
+        {
+            if(PDMAChannelIntFlagGet(ulChannelID, PDMA_EVENT_ERROR))
+            {
+                bOk = xfalse;
+                break;
+            }
+        }
+        psDesc++;
+    }
+    PDMAMemRelease();
+    return bOk;
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Takes the memory service and a memory to memory channel.
+//!
+//! \return xtrue if both were free, xfalse to fall back to the CPU.
+//
+//*****************************************************************************
+static xtBoolean
+PDMAMemAcquire(void)
+{
+    xtBoolean bMasked;
+
+    bMasked = xIntMasterDisable();
+    if(g_sDMAMemOp.bBusy)
+    {
+        if(!bMasked)
+        {
+            xIntMasterEnable();
+        }
+        return xfalse;
+    }
+    g_sDMAMemOp.bBusy = xtrue;
+    if(!bMasked)
+    {
+        xIntMasterEnable();
+    }
+
+    g_sDMAMemOp.ulChannelID = PDMAChannelDynamicAssign(xDMA_REQUEST_MEM,
+                                                       xDMA_REQUEST_MEM);
+    if(g_sDMAMemOp.ulChannelID == xDMA_CHANNEL_NOT_EXIST)
+    {
+        g_sDMAMemOp.bBusy = xfalse;
+        return xfalse;
+    }
+    return xtrue;
+}
+
+//*****************************************************************************
+//
+//! \brief Copies a memory block, by DMA when it is large enough.
+//!
+//! \param pvDst is the destination.
+//! \param pvSrc is the source.
+//! \param ulSize is the number of bytes.
+//! \param pfnCallback is called when the copy is done, 0 to wait for it.
+//! \param pvCBData is passed to \e pfnCallback.
+//!
+//! The widest PDMA width the two buffers allow is used. When both have the
+//! same offset in a word, the unaligned head and tail bytes are copied by
+//! the CPU and the body by words. Blocks shorter than the threshold set by
+//! PDMAMemThresholdSet(), longer than the 4 * 0xFFFC bytes one PDMA chain of
+//! the service can move, or when the service or every channel is busy, are
+//! copied by the CPU.
+//!
+//! With \e pfnCallback the function returns once the DMA is started, INT_PDMA
+//! must be enabled and the buffers must stay valid. The callback gets
+//! \e pvCBData, \e ulMsgParam is \b PDMA_EVENT_TC or \b PDMA_EVENT_ERROR and
+//! \e pvMsgData is \e pvDst. A CPU copy calls it before returning.
+//!
+//! \return xfalse if a waited for transfer failed, xtrue otherwise.
+//
+//*****************************************************************************
+xtBoolean
+PDMAMemCopy(void *pvDst, const void *pvSrc, unsigned long ulSize,
+            xtEventCallback pfnCallback, void *pvCBData)
+{
+    unsigned char *pucDst = (unsigned char *)pvDst;
+    const unsigned char *pucSrc = (const unsigned char *)pvSrc;
+    unsigned long ulWidth, ulHead, ulBody;
+
+    xASSERT((pvDst != 0) && (pvSrc != 0));
+
+    if((ulSize < g_ulDMAMemThreshold) || (ulSize > PDMA_MEM_SIZE_MAX) ||
+       !PDMAMemAcquire())
+    {
+        PDMAMemCopyCPU(pucDst, pucSrc, ulSize);
+        if(pfnCallback != 0)
+        {
+            pfnCallback(pvCBData, 0, PDMA_EVENT_TC, pvDst);
+        }
+        return xtrue;
+    }
+
+    //
+    // Width from the offset between the buffers, head up to alignment.
+    //
+    if((((unsigned long)pucDst ^ (unsigned long)pucSrc) & 3) == 0)
+    {
+        ulWidth = 4;
+    }
+    else if((((unsigned long)pucDst ^ (unsigned long)pucSrc) & 1) == 0)
+    {
+        ulWidth = 2;
+    }
+    else
+    {
+        ulWidth = 1;
+    }
+    ulHead = (0 - (unsigned long)pucDst) & (ulWidth - 1);
+    if(ulHead > ulSize)
+    {
+        ulHead = ulSize;
+    }
+    ulBody = (ulSize - ulHead) & ~(ulWidth - 1);
+    PDMAMemCopyCPU(pucDst, pucSrc, ulHead);
+    PDMAMemCopyCPU(pucDst + ulHead + ulBody, pucSrc + ulHead + ulBody,
+                   ulSize - ulHead - ulBody);
+
+    return PDMAMemStart(pucDst + ulHead, pucSrc + ulHead, ulBody, ulWidth,
+                        pfnCallback, pvCBData, pvDst);
+}
+
+//*****************************************************************************
+//
+//! \brief Fills a memory block with a byte, by DMA when it is large enough.
+//!
+//! \param pvDst is the destination.
+//! \param ucValue is the byte to write.
+//! \param ulSize is the number of bytes.
+//! \param pfnCallback is called when the fill is done, 0 to wait for it.
+//! \param pvCBData is passed to \e pfnCallback.
+//!
+//! The unaligned head and tail bytes are written by the CPU and the body by
+//! words. The threshold, fall back and callback are as for PDMAMemCopy().
+//!
+//! \return xfalse if a waited for transfer failed, xtrue otherwise.
+//
+//*****************************************************************************
+xtBoolean
+PDMAMemFill(void *pvDst, unsigned char ucValue, unsigned long ulSize,
+            xtEventCallback pfnCallback, void *pvCBData)
+{
+    unsigned char *pucDst = (unsigned char *)pvDst;
+    unsigned long ulFill, ulHead, ulBody;
+
+    xASSERT(pvDst != 0);
+
+    ulFill = ucValue * 0x01010101;
+    if((ulSize < g_ulDMAMemThreshold) || (ulSize > PDMA_MEM_SIZE_MAX) ||
+       !PDMAMemAcquire())
+    {
+        PDMAMemFillCPU(pucDst, ulFill, ulSize);
+        if(pfnCallback != 0)
+        {
+            pfnCallback(pvCBData, 0, PDMA_EVENT_TC, pvDst);
+        }
+        return xtrue;
+    }
+
+    ulHead = (0 - (unsigned long)pucDst) & 3;
+    if(ulHead > ulSize)
+    {
+        ulHead = ulSize;
+    }
+    ulBody = (ulSize - ulHead) & ~3;
+    PDMAMemFillCPU(pucDst, ulFill, ulHead);
+    PDMAMemFillCPU(pucDst + ulHead + ulBody, ulFill, ulSize - ulHead - ulBody);
+
+    g_sDMAMemOp.ulFill = ulFill;
+    return PDMAMemStart(pucDst + ulHead, 0, ulBody, 4, pfnCallback, pvCBData,
+                        pvDst);
+}
+
+//*****************************************************************************
+//
+//! \brief Sets the size below which PDMAMemCopy() and PDMAMemFill() use the
+//! CPU.
+//!
+//! \param ulSize is the threshold in bytes, 0 to always use the PDMA.
+//!
+//! The default is \b PDMA_MEM_CPU_THRESHOLD.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+PDMAMemThresholdSet(unsigned long ulSize)
+{
+    g_ulDMAMemThreshold = ulSize;
+}
+
+//*****************************************************************************
+//
+//! \brief Gets whether a PDMAMemCopy() or PDMAMemFill() with a callback is
+//! in progress.
+//!
+//! \return xtrue until its callback has been called, xfalse otherwise.
+//
+//*****************************************************************************
+xtBoolean
+PDMAMemBusy(void)
+{
+    return g_sDMAMemOp.bBusy;
+}
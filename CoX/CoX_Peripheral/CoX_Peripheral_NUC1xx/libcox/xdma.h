@@ -473,6 +473,10 @@ extern "C"
 //! |---------------------------|----------------|--------|
 //! |xDMAIntDisable             |  Non-Mandatory |    Y   |
 //! |---------------------------|----------------|--------|
+//! |xDMAMemCopy                |  Non-Mandatory |    Y   |
+//! |---------------------------|----------------|--------|
+//! |xDMAMemFill                |  Non-Mandatory |    Y   |
+//! |---------------------------|----------------|--------|
 //! \endverbatim
 //! @{
 //
@@ -834,6 +838,42 @@ extern "C"
         }                                                                     \
         while(0)        
 
+//*****************************************************************************
+//
+//! \brief Copies a memory block, by DMA when it is large enough.
+//!
+//! \param pvDst is the destination.
+//! \param pvSrc is the source.
+//! \param ulSize is the number of bytes.
+//! \param pfnCallback is called when the copy is done, 0 to wait for it.
+//! \param pvCBData is passed to \e pfnCallback.
+//!
+//! See PDMAMemCopy().
+//!
+//! \return xfalse if a waited for transfer failed, xtrue otherwise.
+//
+//*****************************************************************************
+#define xDMAMemCopy(pvDst, pvSrc, ulSize, pfnCallback, pvCBData)              \
+        PDMAMemCopy(pvDst, pvSrc, ulSize, pfnCallback, pvCBData)
+
+//*****************************************************************************
+//
+//! \brief Fills a memory block with a byte, by DMA when it is large enough.
+//!
+//! \param pvDst is the destination.
+//! \param ucValue is the byte to write.
+//! \param ulSize is the number of bytes.
+//! \param pfnCallback is called when the fill is done, 0 to wait for it.
+//! \param pvCBData is passed to \e pfnCallback.
+//!
+//! See PDMAMemFill().
+//!
+//! \return xfalse if a waited for transfer failed, xtrue otherwise.
+//
+//*****************************************************************************
+#define xDMAMemFill(pvDst, ucValue, ulSize, pfnCallback, pvCBData)            \
+        PDMAMemFill(pvDst, ucValue, ulSize, pfnCallback, pvCBData)
+
 //*****************************************************************************
 //
 //! @}
@@ -898,6 +938,12 @@ extern "C"
 //
 #define PDMA_EVENT_ERROR        0x00000001
 
+//
+//! First half of the transfer complete. The PDMA has no such interrupt, the
+//! driver runs the transfer in two halves to emulate it.
+//
+#define PDMA_EVENT_HALF         0x00000100
+
 //*****************************************************************************
 //
 //! @}
@@ -919,9 +965,9 @@ extern "C"
 #define PDMA_SRC_DIR_INC        0x00000000
 #define PDMA_SRC_DIR_FIXED      0x00000020
 
-#define PDMA_WIDTH_8BIT         0x00000000
-#define PDMA_WIDTH_16BIT        0x00080000
-#define PDMA_WIDTH_32BIT        0x00100000
+#define PDMA_WIDTH_8BIT         0x00080000
+#define PDMA_WIDTH_16BIT        0x00100000
+#define PDMA_WIDTH_32BIT        0x00000000
 
 #define PDMA_MODE_MTOM          0x00000000
 #define PDMA_MODE_MTOP          0x00000008
@@ -933,6 +979,28 @@ extern "C"
 //
 //*****************************************************************************
 
+//*****************************************************************************
+//
+//! \addtogroup NUC1xx_PDMA_Mem_Config NUC1xx PDMA Memory Service Configure
+//! \brief Defines for PDMAMemCopy() and PDMAMemFill()
+//! @{
+//
+//*****************************************************************************
+
+//
+//! Blocks shorter than this many bytes are done by the CPU. Can be changed
+//! at run time with PDMAMemThresholdSet().
+//
+#ifndef PDMA_MEM_CPU_THRESHOLD
+#define PDMA_MEM_CPU_THRESHOLD  64
+#endif
+
+//*****************************************************************************
+//
+//! @}
+//
+//*****************************************************************************
+
 //*****************************************************************************
 //
 //! \addtogroup NUC1xx_PDMA_Request_Connections NUC1xx PDMA Request Connections
@@ -973,6 +1041,49 @@ extern "C"
 //
 //*****************************************************************************
 
+//*****************************************************************************
+//
+//! \addtogroup NUC1xx_PDMA_Exported_Types NUC1xx PDMA Exported Types
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! PDMA chain element, one transfer of a chain, see PDMAChannelChainStart()
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! Source address
+    //
+    void *pvSrcAddr;
+
+    //
+    //! Destination address
+    //
+    void *pvDstAddr;
+
+    //
+    //! Number of bytes, a multiple of the width
+    //
+    unsigned long ulTransferSize;
+
+    //
+    //! Width and address modes, as passed to PDMAChannelControlSet(). Other
+    //! bits are ignored, the mode of the channel comes from its assignment
+    //
+    unsigned long ulControl;
+}
+tPDMAChainDesc;
+
+//*****************************************************************************
+//
+//! @}
+//
+//*****************************************************************************
+
 //*****************************************************************************
 //
 //! \addtogroup NUC1xx_PDMA_Exported_APIs NUC1xx PDMA APIs
@@ -1005,9 +1116,14 @@ extern void PDMAChannelTransferSet(unsigned long ulChannelID,
                                    void *pvSrcAddr,
                                    void *pvDstAddr,
                                    unsigned long ulTransferSize);
+extern void PDMAChannelChainStart(unsigned long ulChannelID,
+                                  const tPDMAChainDesc *psDesc,
+                                  unsigned long ulDescCount);
 
 extern void PDMAChannelIntCallbackInit(unsigned long ulChannelID, 
                                 xtEventCallback pfnCallback);
+extern void PDMAChannelIntCallbackDataSet(unsigned long ulChannelID, 
+                                          void *pvCBData);
 extern xtEventCallback PDMAChannelIntCallbackGet(unsigned long ulChannelID);
 
 extern xtBoolean PDMAChannelIntFlagGet(unsigned long ulChannelID, 
@@ -1021,6 +1137,15 @@ extern unsigned long PDMARemainTransferCountGet(unsigned long ulChannelID);
 extern unsigned long PDMASharedBufferDataGet(unsigned long ulChannelID);
 extern unsigned long PDMAInternalBufPointerGet(unsigned long ulChannelID);
 
+extern xtBoolean PDMAMemCopy(void *pvDst, const void *pvSrc,
+                             unsigned long ulSize,
+                             xtEventCallback pfnCallback, void *pvCBData);
+extern xtBoolean PDMAMemFill(void *pvDst, unsigned char ucValue,
+                             unsigned long ulSize,
+                             xtEventCallback pfnCallback, void *pvCBData);
+extern void PDMAMemThresholdSet(unsigned long ulSize);
+extern xtBoolean PDMAMemBusy(void);
+
 //*****************************************************************************
 //
 //! @}
@@ -44,37 +44,16 @@
 #include "xhw_sysctl.h"
 #include "xhw_gpio.h"
 #include "xdebug.h"
+#include "xcore.h"
 #include "xsysctl.h"
 #include "xgpio.h"
 
-typedef struct
-{
-    //
-    // Pin ID.
-    //
-    unsigned long ulpinID;
-
-    //
-    // 
-    //
-    xtEventCallback pfnGPIOPinHandlerCallback;
-}
-tGPIOPinIntAsssign;
-
+//*****************************************************************************
 //
-// GPIO Pins Interrupt Assignment table.
+// Interrupt callback of every pin, indexed by port (A to E) and pin number.
 //
-static tGPIOPinIntAsssign g_psGPIOPinIntAssignTable[xGPIO_INT_NUMBER] = 
-{
-    { 0,   0 },
-    { 0,   0 },            
-    { 0,   0 },
-    { 0,   0 },        
-    { 0,   0 },
-    { 0,   0 },
-    { 0,   0 },        
-    { 0,   0 }                  
-};
+//*****************************************************************************
+static xtEventCallback g_pfnGPIOPinHandler[5][16];
 
 //*****************************************************************************
 //
@@ -120,56 +99,81 @@ GPIOBaseValid(unsigned long ulPort)
 //*****************************************************************************
 //
 //! \internal
-//! \brief GPIO A,B  ISR.
+//! \brief Calls the callbacks of the pins with an interrupt on a port.
 //!
-//! \param None
+//! \param ulPort is the base address of the GPIO port.
+//! \param ulPins is the bit-packed representation of the pins served.
+//!
+//! Only the set bits of ISRC are visited, the lowest set bit is isolated and
+//! its index taken with GPIOPinIndex(), the Cortex-M0 has no count zeros
+//! instruction.
+//! The edge of a pin with both edges enabled is told by its level now.
 //!
 //! \return None.
 //
 //*****************************************************************************
-void GPABIntHandler(void)
+static void
+GPIOPortIntDispatch(unsigned long ulPort, unsigned long ulPins)
 {
-    unsigned long ulGpaStatus, ulGpbStatus;
-    unsigned long i;
-    
-    /* Keep the interrupt source */
-    ulGpaStatus = xHWREG(GPIO_PORTA_BASE+GPIO_ISRC);
-    ulGpbStatus = xHWREG(GPIO_PORTB_BASE+GPIO_ISRC);
+    unsigned long ulStatus, ulImd, ulIen, ulLevel, ulBit, ulPin, ulEvent;
+    xtEventCallback *ppfnHandler;
 
-    /* Clear the interrupt */
-    xHWREG(GPIO_PORTA_BASE+GPIO_ISRC) = ulGpaStatus;
-    xHWREG(GPIO_PORTB_BASE+GPIO_ISRC) = ulGpbStatus;
+    /* Keep and clear the interrupt source */
+    ulStatus = xHWREG(ulPort + GPIO_ISRC) & ulPins;
+    if(ulStatus == 0)
+    {
+        return;
+    }
+    xHWREG(ulPort + GPIO_ISRC) = ulStatus;
 
-    /* Call the callback function of GPIOAB interrupt */
-    for(i=0; i<xGPIO_INT_NUMBER; i++)
+    ulImd = xHWREG(ulPort + GPIO_IMD);
+    ulIen = xHWREG(ulPort + GPIO_IEN);
+    ulLevel = xHWREG(ulPort + GPIO_PIN);
+    ppfnHandler = g_pfnGPIOPinHandler[(ulPort - GPIO_PORTA_BASE) >> 6];
+
+    while(ulStatus != 0)
     {
-        if((g_psGPIOPinIntAssignTable[i].ulpinID & 0xFFFF0000) == 
-           ((GPIO_PORTA_BASE & 0x0000FFFF) << 16))
+        ulBit = ulStatus & (0 - ulStatus);
+        ulStatus &= ~ulBit;
+        ulPin = GPIOPinIndex(ulBit);
+        if(ppfnHandler[ulPin] == 0)
         {
-            if((g_psGPIOPinIntAssignTable[i].ulpinID & 0x0000FFFF & 
-                ulGpaStatus))
-            {
-                if(g_psGPIOPinIntAssignTable[i].pfnGPIOPinHandlerCallback != 0)
-                {
-                    g_psGPIOPinIntAssignTable[i].pfnGPIOPinHandlerCallback
-                    (0,0,0,0);
-                }
-            }
+            continue;
         }
-        if((g_psGPIOPinIntAssignTable[i].ulpinID &0xFFFF0000) == 
-           ((GPIO_PORTB_BASE & 0x0000FFFF) << 16))
+
+        if(ulImd & ulBit)
         {
-            if((g_psGPIOPinIntAssignTable[i].ulpinID & 0x0000FFFF & 
-                ulGpbStatus))
-            {
-                if(g_psGPIOPinIntAssignTable[i].pfnGPIOPinHandlerCallback != 0)
-                {
-                    g_psGPIOPinIntAssignTable[i].pfnGPIOPinHandlerCallback
-                    (0,0,0,0);
-                }
-            }
+            ulEvent = (ulIen & (ulBit << 16)) ? GPIO_HIGH_LEVEL :
+                                                GPIO_LOW_LEVEL;
         }
-    } 
+        else if((ulIen & ulBit) && (ulIen & (ulBit << 16)))
+        {
+            ulEvent = (ulLevel & ulBit) ? GPIO_RISING_EDGE :
+                                          GPIO_FALLING_EDGE;
+        }
+        else
+        {
+            ulEvent = (ulIen & (ulBit << 16)) ? GPIO_RISING_EDGE :
+                                                GPIO_FALLING_EDGE;
+        }
+        ppfnHandler[ulPin](0, ulEvent, ulBit, (void *)ulPort);
+    }
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief GPIO A,B  ISR.
+//!
+//! \param None
+//!
+//! \return None.
+//
+//*****************************************************************************
+void GPABIntHandler(void)
+{
+    GPIOPortIntDispatch(GPIO_PORTA_BASE, 0xFFFF);
+    GPIOPortIntDispatch(GPIO_PORTB_BASE, 0xFFFF);
 }
 
  
@@ -185,63 +189,9 @@ void GPABIntHandler(void)
 //*****************************************************************************
 void GPCDEIntHandler(void)
 {
-    unsigned long ulGpcStatus, ulGpdStatus, ulGpeStatus;
-    unsigned long i;
-    
-    /* Keep the interrupt source */
-    ulGpcStatus = xHWREG(GPIO_PORTC_BASE+GPIO_ISRC);
-    ulGpdStatus = xHWREG(GPIO_PORTD_BASE+GPIO_ISRC);
-    ulGpeStatus = xHWREG(GPIO_PORTE_BASE+GPIO_ISRC);
-
-    /* Clear the interrupt */
-    xHWREG(GPIO_PORTC_BASE+GPIO_ISRC) = ulGpcStatus;
-    xHWREG(GPIO_PORTD_BASE+GPIO_ISRC) = ulGpdStatus;
-    xHWREG(GPIO_PORTE_BASE+GPIO_ISRC) = ulGpeStatus;
-
-    /* Call the callback function of GPIOCDE interrupt */
-    for(i=0; i<xGPIO_INT_NUMBER; i++)
-    {
-        if((g_psGPIOPinIntAssignTable[i].ulpinID &0xFFFF0000) == 
-           ((GPIO_PORTC_BASE & 0x0000FFFF) << 16))
-        {
-            if((g_psGPIOPinIntAssignTable[i].ulpinID & 0x0000FFFF & 
-                ulGpcStatus))
-            {
-                if(g_psGPIOPinIntAssignTable[i].pfnGPIOPinHandlerCallback != 0)
-                {
-                    g_psGPIOPinIntAssignTable[i].pfnGPIOPinHandlerCallback
-                    (0,0,0,0);
-                }
-            }
-        }
-        if((g_psGPIOPinIntAssignTable[i].ulpinID &0xFFFF0000) == 
-           ((GPIO_PORTD_BASE & 0x0000FFFF) << 16))
-        {
-            if((g_psGPIOPinIntAssignTable[i].ulpinID & 0x0000FFFF & 
-                ulGpdStatus))
-            {
-                if(g_psGPIOPinIntAssignTable[i].pfnGPIOPinHandlerCallback != 0)
-                {
-                    g_psGPIOPinIntAssignTable[i].pfnGPIOPinHandlerCallback
-                    (0,0,0,0);
-                }
-            }
-        }
-        if((g_psGPIOPinIntAssignTable[i].ulpinID &0xFFFF0000) == 
-           ((GPIO_PORTE_BASE & 0x0000FFFF) << 16))
-        {
-            if((g_psGPIOPinIntAssignTable[i].ulpinID & 0x0000FFFF & 
-                ulGpeStatus))
-            {
-                if(g_psGPIOPinIntAssignTable[i].pfnGPIOPinHandlerCallback != 0)
-                {
-                    g_psGPIOPinIntAssignTable[i].pfnGPIOPinHandlerCallback
-                    (0,0,0,0);
-                }
-            }
-        }
-    } 
-
+    GPIOPortIntDispatch(GPIO_PORTC_BASE, 0xFFFF);
+    GPIOPortIntDispatch(GPIO_PORTD_BASE, 0xFFFF);
+    GPIOPortIntDispatch(GPIO_PORTE_BASE, 0xFFFF);
 }
 
 //*****************************************************************************
@@ -256,21 +206,7 @@ void GPCDEIntHandler(void)
 //*****************************************************************************
 void EINT0IntHandler(void)
 {
-    unsigned long i;
-    /* For PB14, clear the INT flag */
-    xHWREG(GPIO_PORTB_BASE+GPIO_ISRC) |= GPIO_PIN_14;
-   
-    for(i=0; i<xGPIO_INT_NUMBER; i++)
-    {
-        if((g_psGPIOPinIntAssignTable[i].ulpinID) == 
-           (((GPIO_PORTB_BASE & 0x0000FFFF) << 16) | GPIO_PIN_14))
-        {
-            if(g_psGPIOPinIntAssignTable[i].pfnGPIOPinHandlerCallback != 0)
-            {
-                g_psGPIOPinIntAssignTable[i].pfnGPIOPinHandlerCallback(0,0,0,0);
-            }
-        }
-    } 
+    GPIOPortIntDispatch(GPIO_PORTB_BASE, GPIO_PIN_14);
 }                                       
 
 //*****************************************************************************
@@ -285,21 +221,7 @@ void EINT0IntHandler(void)
 //*****************************************************************************
 void EINT1IntHandler(void)
 {   
-    unsigned long i;
-    /* For PB15, clear the INT flag */
-    xHWREG(GPIO_PORTB_BASE+GPIO_ISRC) |= GPIO_PIN_15;
-    
-    for(i=0; i<xGPIO_INT_NUMBER; i++)
-    {
-        if((g_psGPIOPinIntAssignTable[i].ulpinID) == 
-           (((GPIO_PORTB_BASE & 0x0000FFFF) << 16) | GPIO_PIN_15))
-        {
-            if(g_psGPIOPinIntAssignTable[i].pfnGPIOPinHandlerCallback != 0)
-            {
-                g_psGPIOPinIntAssignTable[i].pfnGPIOPinHandlerCallback(0,0,0,0);
-            }
-        }
-    } 
+    GPIOPortIntDispatch(GPIO_PORTB_BASE, GPIO_PIN_15);
 }
 
 //*****************************************************************************
@@ -661,7 +583,15 @@ GPIOPinIntDisable(unsigned long ulPort, unsigned long ulPins)
 //! \param ulPin is the bit-packed representation of the pin.
 //! \param xtPortCallback is callback for the specified Port.
 //!
-//! Init interrupts callback for the specified Port.
+//! Init interrupts callback for the specified Port. Every pin set in
+//! \e ulPin gets the callback, 0 removes it; each pin of each port has its
+//! own callback.
+//!
+//! The callback is called from the interrupt with ulEvent the interrupt
+//! type (\b GPIO_FALLING_EDGE, \b GPIO_RISING_EDGE, \b GPIO_LOW_LEVEL or
+//! \b GPIO_HIGH_LEVEL), ulMsgParam the pin (\b GPIO_PIN_n) and pvMsgData
+//! the port base address. With both edges enabled the edge is told from
+//! the pin level when the interrupt is served.
 //!
 //! \return None.
 //
@@ -670,38 +600,25 @@ void
 GPIOPinIntCallbackInit(unsigned long ulPort, unsigned long ulPin,
                        xtEventCallback xtPortCallback)
 {
-    int i;
-    unsigned long ulPinID;
+    xtEventCallback *ppfnHandler;
+    unsigned long i;
+
     //
     // Check the arguments.
     //
     xASSERT(GPIOBaseValid(ulPort));
 
-    //
-    // changed ?? (ulPort  << 16) | i ?? to ?? (ulPort  << 16) | ulPin ?? by 
-    // niuyj 09/09/2011
-    //
-    ulPinID = (ulPort  << 16) | ulPin;
-
     //
     // Init the interrupts callback.
     //
-    for(i=0; i<xGPIO_INT_NUMBER; i++)
+    ppfnHandler = g_pfnGPIOPinHandler[(ulPort - GPIO_PORTA_BASE) >> 6];
+    for(i = 0; i < 16; i++)
     {
-        if(g_psGPIOPinIntAssignTable[i].ulpinID == ulPinID)
+        if(ulPin & (1 << i))
         {
-            g_psGPIOPinIntAssignTable[i].pfnGPIOPinHandlerCallback =
-                                         xtPortCallback;
-            break;
-        }
-        if (g_psGPIOPinIntAssignTable[i].ulpinID == 0)
-        {
-            g_psGPIOPinIntAssignTable[i].ulpinID = ulPinID;
-            g_psGPIOPinIntAssignTable[i].pfnGPIOPinHandlerCallback =
-                                         xtPortCallback;
-            break;
+            ppfnHandler[i] = xtPortCallback;
         }
-    } 
+    }
 }
 
 
@@ -823,23 +740,43 @@ GPIOPinRead(unsigned long ulPort, unsigned long ulPins)
 //! set identifies the pin to be accessed, and where bit 0 of the byte
 //! represents GPIO port pin 0, bit 1 represents GPIO port pin 1, and so on.
 //!
+//! The write is atomic against interrupts: a single pin is written through
+//! its bit output register, several pins with interrupts masked around the
+//! read-modify-write of GPIO_DOUT.
+//!
 //! \return None.
 //
 //*****************************************************************************
 void
 GPIOPinWrite(unsigned long ulPort, unsigned long ulPins, unsigned char ucVal)
 {
+    xtBoolean bMasked;
+
     //
     // Check the arguments.
     //
     xASSERT(GPIOBaseValid(ulPort));
 
+    //
+    // One pin, one store
+    //
+    if((ulPins != 0) && ((ulPins & (ulPins - 1)) == 0))
+    {
+        GPIOPinBitWrite(ulPort, ulPins, ucVal);
+        return;
+    }
+
     //
     // Write the pins.
     //
+    bMasked = xIntMasterDisable();
     xHWREG(ulPort + GPIO_DOUT) = ((ucVal & 1) ?
                                 (xHWREG(ulPort + GPIO_DOUT) | ulPins) :
                                 (xHWREG(ulPort + GPIO_DOUT) & ~(ulPins)));
+    if(!bMasked)
+    {
+        xIntMasterEnable();
+    }
 }
 
 //*****************************************************************************
@@ -1712,3 +1649,387 @@ GPIOPinFunctionSet(unsigned long ulFunction, unsigned long ulPort,
     }
 }
 
+//*****************************************************************************
+//
+//! \brief Inits a parallel bus over GPIO pins.
+//!
+//! \param psBus is the bus to init.
+//! \param ulPort is the base address of the GPIO port of the data pins.
+//! \param pulPins is the pin of each data bit, bit 0 first, one of
+//! \b GPIO_PIN_0 to \b GPIO_PIN_15 each.
+//! \param ulWidth is the number of data bits, 1 to \b GPIO_BUS_WIDTH_MAX.
+//!
+//! The data pins may be contiguous or scattered over the port, in any order.
+//! The masks and shifts moving the data between its bits and the pins are
+//! computed here once: the data bits landing on consecutive pins make one
+//! run, so a bus of contiguous pins is moved with a single shift.
+//!
+//! The data pins are set as outputs, the bus has no strobe pins and no
+//! delays until GPIOBusStrobeSet() and GPIOBusTimingSet() are called.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GPIOBusInit(tGPIOBus *psBus, unsigned long ulPort,
+            const unsigned long *pulPins, unsigned long ulWidth)
+{
+    unsigned long i, ulPin, ulLast;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT(psBus != 0);
+    xASSERT(GPIOBaseValid(ulPort));
+    xASSERT((ulWidth != 0) && (ulWidth <= GPIO_BUS_WIDTH_MAX));
+
+    psBus->ulPort = ulPort;
+    psBus->ulPins = 0;
+    psBus->ulPMDMask = 0;
+    psBus->ulWidth = ulWidth;
+    psBus->ulRuns = 0;
+
+    ulLast = 0;
+    for(i = 0; i < ulWidth; i++)
+    {
+        xASSERT((pulPins[i] != 0) && !(pulPins[i] & (pulPins[i] - 1)) &&
+                !(pulPins[i] & 0xFFFF0000) && !(psBus->ulPins & pulPins[i]));
+        ulPin = GPIOPinIndex(pulPins[i]);
+
+        //
+        // A new run unless the pin follows the one of the previous bit
+        //
+        if((i == 0) || (ulPin != ulLast + 1))
+        {
+            psBus->ulRunBits[psBus->ulRuns] = 0;
+            psBus->lRunShift[psBus->ulRuns] = (long)ulPin - (long)i;
+            psBus->ulRuns++;
+        }
+        psBus->ulRunBits[psBus->ulRuns - 1] |= 1 << i;
+        psBus->ulPins |= pulPins[i];
+        psBus->ulPMDMask |= 3 << (ulPin * 2);
+        ulLast = ulPin;
+    }
+
+    psBus->ulRSReg = 0;
+    psBus->ulRWReg = 0;
+    psBus->ulEReg = 0;
+    psBus->ulSetupDelay = 0;
+    psBus->ulPulseDelay = 0;
+
+    GPIOBusDirSet(psBus, GPIO_DIR_MODE_OUT);
+}
+
+//*****************************************************************************
+//
+//! \brief Sets the RS, RW and E strobe pins of a parallel bus.
+//!
+//! \param psBus is the bus.
+//! \param ulRSPort is the base address of the GPIO port of RS, 0 for none.
+//! \param ulRSPin is the RS pin.
+//! \param ulRWPort is the base address of the GPIO port of RW, 0 for none.
+//! \param ulRWPin is the RW pin.
+//! \param ulEPort is the base address of the GPIO port of E, 0 for none.
+//! \param ulEPin is the E pin.
+//!
+//! The strobe pins are set as outputs and E is driven low. Each strobe is
+//! then written by one store to its bit output register.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GPIOBusStrobeSet(tGPIOBus *psBus, unsigned long ulRSPort,
+                 unsigned long ulRSPin, unsigned long ulRWPort,
+                 unsigned long ulRWPin, unsigned long ulEPort,
+                 unsigned long ulEPin)
+{
+    //
+    // Check the arguments.
+    //
+    xASSERT(psBus != 0);
+    xASSERT((ulRSPort == 0) || GPIOBaseValid(ulRSPort));
+    xASSERT((ulRWPort == 0) || GPIOBaseValid(ulRWPort));
+    xASSERT((ulEPort == 0) || GPIOBaseValid(ulEPort));
+
+    psBus->ulRSReg = 0;
+    psBus->ulRWReg = 0;
+    psBus->ulEReg = 0;
+
+    if(ulRSPort != 0)
+    {
+        GPIODirModeSet(ulRSPort, GPIOPinIndex(ulRSPin), GPIO_DIR_MODE_OUT);
+        psBus->ulRSReg = GPIOPinBitAddr(ulRSPort, ulRSPin);
+    }
+    if(ulRWPort != 0)
+    {
+        GPIODirModeSet(ulRWPort, GPIOPinIndex(ulRWPin), GPIO_DIR_MODE_OUT);
+        psBus->ulRWReg = GPIOPinBitAddr(ulRWPort, ulRWPin);
+    }
+    if(ulEPort != 0)
+    {
+        psBus->ulEReg = GPIOPinBitAddr(ulEPort, ulEPin);
+        xHWREG(psBus->ulEReg) = 0;
+        GPIODirModeSet(ulEPort, GPIOPinIndex(ulEPin), GPIO_DIR_MODE_OUT);
+    }
+}
+
+//*****************************************************************************
+//
+//! \brief Sets the strobe timing of a parallel bus.
+//!
+//! \param psBus is the bus.
+//! \param ulSetupDelay is the delay from RS, RW and the data to E rising.
+//! \param ulPulseDelay is the width of the E pulse.
+//!
+//! Both delays are SysCtlDelay() counts, 0 for none.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GPIOBusTimingSet(tGPIOBus *psBus, unsigned long ulSetupDelay,
+                 unsigned long ulPulseDelay)
+{
+    //
+    // Check the arguments.
+    //
+    xASSERT(psBus != 0);
+
+    psBus->ulSetupDelay = ulSetupDelay;
+    psBus->ulPulseDelay = ulPulseDelay;
+}
+
+//*****************************************************************************
+//
+//! \brief Sets the direction and mode of the data pins of a parallel bus.
+//!
+//! \param psBus is the bus.
+//! \param ulPinIO is the direction and mode, one of the values of
+//! GPIODirModeSet().
+//!
+//! All the data pins are set by one read-modify-write of GPIO_PMD, with
+//! interrupts masked around it.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GPIOBusDirSet(const tGPIOBus *psBus, unsigned long ulPinIO)
+{
+    xtBoolean bMasked;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT(psBus != 0);
+    xASSERT((ulPinIO == GPIO_DIR_MODE_IN) || (ulPinIO == GPIO_DIR_MODE_OUT) ||
+            (ulPinIO == GPIO_DIR_MODE_OD) || (ulPinIO == GPIO_DIR_MODE_QB));
+
+    //
+    // The 2-bit mode repeated over every pin, kept for the data pins only
+    //
+    bMasked = xIntMasterDisable();
+    xHWREG(psBus->ulPort + GPIO_PMD) =
+        (xHWREG(psBus->ulPort + GPIO_PMD) & ~psBus->ulPMDMask) |
+        ((ulPinIO * 0x55555555) & psBus->ulPMDMask);
+    if(!bMasked)
+    {
+        xIntMasterEnable();
+    }
+}
+
+//*****************************************************************************
+//
+//! \brief Drives data on the data pins of a parallel bus.
+//!
+//! \param psBus is the bus.
+//! \param ulData is the data, the bits above the bus width are ignored.
+//!
+//! The data is scattered to the pins with the runs of the bus and written
+//! by one read-modify-write of GPIO_DOUT, with interrupts masked around it.
+//! No strobe pin is touched.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GPIOBusDataWrite(const tGPIOBus *psBus, unsigned long ulData)
+{
+    unsigned long i, ulOut;
+    xtBoolean bMasked;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT(psBus != 0);
+
+    ulOut = 0;
+    for(i = 0; i < psBus->ulRuns; i++)
+    {
+        if(psBus->lRunShift[i] >= 0)
+        {
+            ulOut |= (ulData & psBus->ulRunBits[i]) << psBus->lRunShift[i];
+        }
+        else
+        {
+            ulOut |= (ulData & psBus->ulRunBits[i]) >> -psBus->lRunShift[i];
+        }
+    }
+
+    bMasked = xIntMasterDisable();
+    xHWREG(psBus->ulPort + GPIO_DOUT) =
+        (xHWREG(psBus->ulPort + GPIO_DOUT) & ~psBus->ulPins) | ulOut;
+    if(!bMasked)
+    {
+        xIntMasterEnable();
+    }
+}
+
+//*****************************************************************************
+//
+//! \brief Samples the data pins of a parallel bus.
+//!
+//! \param psBus is the bus.
+//!
+//! The pins are read by one read of GPIO_PIN and gathered into the data
+//! bits with the runs of the bus. No strobe pin is touched.
+//!
+//! \return the data.
+//
+//*****************************************************************************
+unsigned long
+GPIOBusDataRead(const tGPIOBus *psBus)
+{
+    unsigned long i, ulIn, ulData;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT(psBus != 0);
+
+    ulIn = xHWREG(psBus->ulPort + GPIO_PIN);
+    ulData = 0;
+    for(i = 0; i < psBus->ulRuns; i++)
+    {
+        if(psBus->lRunShift[i] >= 0)
+        {
+            ulData |= (ulIn >> psBus->lRunShift[i]) & psBus->ulRunBits[i];
+        }
+        else
+        {
+            ulData |= (ulIn << -psBus->lRunShift[i]) & psBus->ulRunBits[i];
+        }
+    }
+    return ulData;
+}
+
+//*****************************************************************************
+//
+//! \brief Runs a write cycle on a parallel bus.
+//!
+//! \param psBus is the bus.
+//! \param ulRS is the RS level, \b GPIO_BUS_RS_COMMAND or
+//! \b GPIO_BUS_RS_DATA.
+//! \param ulData is the data.
+//!
+//! RS is set, RW is driven low and the data is driven as by
+//! GPIOBusDataWrite(). After the setup delay E is pulsed high for the pulse
+//! delay, the device latching the data on the falling edge. The strobes of
+//! the bus that are not used are skipped.
+//!
+//! The data pins must be outputs, as left by GPIOBusInit() and
+//! GPIOBusRead().
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GPIOBusWrite(const tGPIOBus *psBus, unsigned long ulRS, unsigned long ulData)
+{
+    //
+    // Check the arguments.
+    //
+    xASSERT(psBus != 0);
+
+    if(psBus->ulRSReg != 0)
+    {
+        xHWREG(psBus->ulRSReg) = ulRS & 1;
+    }
+    if(psBus->ulRWReg != 0)
+    {
+        xHWREG(psBus->ulRWReg) = 0;
+    }
+    GPIOBusDataWrite(psBus, ulData);
+
+    if(psBus->ulEReg != 0)
+    {
+        if(psBus->ulSetupDelay != 0)
+        {
+            SysCtlDelay(psBus->ulSetupDelay);
+        }
+        xHWREG(psBus->ulEReg) = 1;
+        if(psBus->ulPulseDelay != 0)
+        {
+            SysCtlDelay(psBus->ulPulseDelay);
+        }
+        xHWREG(psBus->ulEReg) = 0;
+    }
+}
+
+//*****************************************************************************
+//
+//! \brief Runs a read cycle on a parallel bus.
+//!
+//! \param psBus is the bus.
+//! \param ulRS is the RS level, \b GPIO_BUS_RS_COMMAND or
+//! \b GPIO_BUS_RS_DATA.
+//!
+//! The data pins are turned to inputs, RS is set and RW driven high. After
+//! the setup delay E is raised, the data is sampled as by GPIOBusDataRead()
+//! at the end of the pulse delay and E is lowered. The data pins are
+//! outputs again on return.
+//!
+//! \return the data read.
+//
+//*****************************************************************************
+unsigned long
+GPIOBusRead(const tGPIOBus *psBus, unsigned long ulRS)
+{
+    unsigned long ulData;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT(psBus != 0);
+
+    GPIOBusDirSet(psBus, GPIO_DIR_MODE_IN);
+    if(psBus->ulRSReg != 0)
+    {
+        xHWREG(psBus->ulRSReg) = ulRS & 1;
+    }
+    if(psBus->ulRWReg != 0)
+    {
+        xHWREG(psBus->ulRWReg) = 1;
+    }
+    if(psBus->ulSetupDelay != 0)
+    {
+        SysCtlDelay(psBus->ulSetupDelay);
+    }
+    if(psBus->ulEReg != 0)
+    {
+        xHWREG(psBus->ulEReg) = 1;
+    }
+    if(psBus->ulPulseDelay != 0)
+    {
+        SysCtlDelay(psBus->ulPulseDelay);
+    }
+    ulData = GPIOBusDataRead(psBus);
+    if(psBus->ulEReg != 0)
+    {
+        xHWREG(psBus->ulEReg) = 0;
+    }
+    GPIOBusDirSet(psBus, GPIO_DIR_MODE_OUT);
+
+    return ulData;
+}
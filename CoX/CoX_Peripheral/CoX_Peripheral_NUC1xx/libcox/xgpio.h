@@ -1117,10 +1117,11 @@ extern unsigned long xGPIODirModeGet(unsigned long ulPort,
 //! 
 //! param of pfnCallback
 //! - pvCBData not used, always 0.
-//! - ulEvent not used, always 0.
+//! - ulEvent is the interrupt type of the event, \b xGPIO_FALLING_EDGE,
+//! \b xGPIO_RISING_EDGE, \b xGPIO_LOW_LEVEL or \b xGPIO_HIGH_LEVEL.
 //! - ulMsgParam is pins which have an event.
 //! Details please refer to \ref xGPIO_General_Pin_IDs_CoX.
-//! - pvMsgData not used, always 0.
+//! - pvMsgData is the base address of the port.
 //!
 //! \return None.
 //
@@ -1411,6 +1412,90 @@ extern unsigned long xGPIODirModeGet(unsigned long ulPort,
 #define xGPIOSPinWrite(eShortPin, ucVal)                                      \
         GPIOSPinWrite(eShortPin, ucVal)
 
+//*****************************************************************************
+//
+//! GPIO parallel bus, details please refer to \ref tGPIOBus.
+//
+//*****************************************************************************
+#define xtGPIOBus               tGPIOBus
+
+//*****************************************************************************
+//
+//! \brief Init a parallel bus over GPIO pins.
+//!
+//! \param psBus is the bus to init.
+//! \param ulPort is the base address of the port of the data pins.
+//! \param pulPins is the pin of each data bit, bit 0 first.
+//! \param ulWidth is the number of data bits, 1 to 16.
+//!
+//! The data pins are set as outputs. Details please refer to GPIOBusInit().
+//!
+//! \return None.
+//
+//*****************************************************************************
+#define xGPIOBusInit(psBus, ulPort, pulPins, ulWidth)                         \
+        GPIOBusInit(psBus, ulPort, pulPins, ulWidth)
+
+//*****************************************************************************
+//
+//! \brief Set the RS, RW and E strobe pins of a parallel bus.
+//!
+//! \param psBus is the bus.
+//! \param ulRSPort, ulRSPin is the RS pin, port 0 if not used.
+//! \param ulRWPort, ulRWPin is the RW pin, port 0 if not used.
+//! \param ulEPort, ulEPin is the E pin, port 0 if not used.
+//!
+//! \return None.
+//
+//*****************************************************************************
+#define xGPIOBusStrobeSet(psBus, ulRSPort, ulRSPin, ulRWPort, ulRWPin,        \
+                          ulEPort, ulEPin)                                    \
+        GPIOBusStrobeSet(psBus, ulRSPort, ulRSPin, ulRWPort, ulRWPin,         \
+                         ulEPort, ulEPin)
+
+//*****************************************************************************
+//
+//! \brief Set the strobe timing of a parallel bus.
+//!
+//! \param psBus is the bus.
+//! \param ulSetupDelay is the delay from RS, RW and data to E rising.
+//! \param ulPulseDelay is the width of the E pulse.
+//!
+//! Both delays are xSysCtlDelay() counts, 0 for none.
+//!
+//! \return None.
+//
+//*****************************************************************************
+#define xGPIOBusTimingSet(psBus, ulSetupDelay, ulPulseDelay)                  \
+        GPIOBusTimingSet(psBus, ulSetupDelay, ulPulseDelay)
+
+//*****************************************************************************
+//
+//! \brief Run a write cycle on a parallel bus.
+//!
+//! \param psBus is the bus.
+//! \param ulRS is the RS level, 0 or 1.
+//! \param ulData is the data to write.
+//!
+//! \return None.
+//
+//*****************************************************************************
+#define xGPIOBusWrite(psBus, ulRS, ulData)                                    \
+        GPIOBusWrite(psBus, ulRS, ulData)
+
+//*****************************************************************************
+//
+//! \brief Run a read cycle on a parallel bus.
+//!
+//! \param psBus is the bus.
+//! \param ulRS is the RS level, 0 or 1.
+//!
+//! \return the data read.
+//
+//*****************************************************************************
+#define xGPIOBusRead(psBus, ulRS)                                             \
+        GPIOBusRead(psBus, ulRS)
+
 //*****************************************************************************
 //
 //! \brief Configure the alternate function of a GPIO pin.
@@ -2794,6 +2879,97 @@ extern unsigned long xGPIODirModeGet(unsigned long ulPort,
 //
 //*****************************************************************************
 
+//*****************************************************************************
+//
+//! \addtogroup NUC1xx_GPIO_Bus NUC1xx GPIO Parallel Bus
+//! \brief A parallel bus over GPIO pins: data pins of one port, contiguous or
+//! scattered, and optional RS, RW and E strobe pins.
+//! @{
+//
+//*****************************************************************************
+
+//
+//! Maximum number of data pins of a bus
+//
+#define GPIO_BUS_WIDTH_MAX      16
+
+//
+//! RS level of a command (instruction register) cycle
+//
+#define GPIO_BUS_RS_COMMAND     0
+
+//
+//! RS level of a data cycle
+//
+#define GPIO_BUS_RS_DATA        1
+
+//*****************************************************************************
+//
+//! GPIO parallel bus. The fields are set up by GPIOBusInit(),
+//! GPIOBusStrobeSet() and GPIOBusTimingSet().
+//!
+//! The data bits are split into runs, data bits landing on consecutive pins:
+//! a bus write or read takes one shift per run, one for contiguous pins.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! Port of the data pins
+    //
+    unsigned long ulPort;
+
+    //
+    //! Data pins, bit-packed as in GPIO_DOUT
+    //
+    unsigned long ulPins;
+
+    //
+    //! GPIO_PMD bits of the data pins
+    //
+    unsigned long ulPMDMask;
+
+    //
+    //! Number of data pins
+    //
+    unsigned long ulWidth;
+
+    //
+    //! Number of runs
+    //
+    unsigned long ulRuns;
+
+    //
+    //! Data bits of each run
+    //
+    unsigned long ulRunBits[GPIO_BUS_WIDTH_MAX];
+
+    //
+    //! Pin of the lowest data bit minus that bit, for each run
+    //
+    long lRunShift[GPIO_BUS_WIDTH_MAX];
+
+    //
+    //! Bit output registers of the RS, RW and E pins, 0 if not used
+    //
+    unsigned long ulRSReg;
+    unsigned long ulRWReg;
+    unsigned long ulEReg;
+
+    //
+    //! SysCtlDelay() counts from RS/RW/data to E rising and of the E pulse
+    //
+    unsigned long ulSetupDelay;
+    unsigned long ulPulseDelay;
+}
+tGPIOBus;
+
+//*****************************************************************************
+//
+//! @}
+//
+//*****************************************************************************
+
 
 //*****************************************************************************
 //
@@ -2821,8 +2997,41 @@ extern unsigned long xGPIODirModeGet(unsigned long ulPort,
 #define GPIOSPinRead(eShortPin)                                               \
         (GPIOPinRead(G##eShortPin) ? 1: 0)
 
+//
+// A short pin is written through its own bit output register, one store
+// whose address is folded at compile time.
+//
 #define GPIOSPinWrite(eShortPin, ucVal)                                       \
-        GPIOPinWrite(G##eShortPin, ucVal)
+        GPIOPinBitWriteS(G##eShortPin, ucVal)
+
+#define GPIOPinBitWriteS(ulPortPin, ucVal)                                    \
+        GPIOPinBitWrite(ulPortPin, ucVal)
+
+//
+//! Offset of the bit output register of pin 0 from the port base, the one
+//! of pin n is 4 * n further
+//
+#define GPIO_BIT_DOUT           0x00000200
+
+//
+//! Index of the pin of a one pin mask, a constant for a constant mask
+//
+#define GPIOPinIndex(ulPin)                                                   \
+        ((((ulPin) & 0xAAAA) ? 1 : 0) | (((ulPin) & 0xCCCC) ? 2 : 0) |        \
+         (((ulPin) & 0xF0F0) ? 4 : 0) | (((ulPin) & 0xFF00) ? 8 : 0))
+
+//
+//! Address of the bit output register of a pin, writing it sets the output
+//! of that pin only and reading it returns the pin level
+//
+#define GPIOPinBitAddr(ulPort, ulPin)                                         \
+        ((ulPort) + GPIO_BIT_DOUT + (GPIOPinIndex(ulPin) << 2))
+
+//
+//! Writes one pin with a single store, atomic against interrupts
+//
+#define GPIOPinBitWrite(ulPort, ulPin, ucVal)                                 \
+        (xHWREG(GPIOPinBitAddr(ulPort, ulPin)) = ((ucVal) & 1))
 
 #define GPIOSPinToPeripheralId(eShortPin)                                     \
         GPIOPinToPeripheralId(G##eShortPin)
@@ -2871,6 +3080,20 @@ extern unsigned long  GPIOPinToPort(unsigned long ulPort,
                                     unsigned long ulPin);
 extern unsigned long  GPIOPinToPin(unsigned long ulPort, 
                                    unsigned long ulPin);
+extern void GPIOBusInit(tGPIOBus *psBus, unsigned long ulPort,
+                        const unsigned long *pulPins, unsigned long ulWidth);
+extern void GPIOBusStrobeSet(tGPIOBus *psBus, unsigned long ulRSPort,
+                             unsigned long ulRSPin, unsigned long ulRWPort,
+                             unsigned long ulRWPin, unsigned long ulEPort,
+                             unsigned long ulEPin);
+extern void GPIOBusTimingSet(tGPIOBus *psBus, unsigned long ulSetupDelay,
+                             unsigned long ulPulseDelay);
+extern void GPIOBusDirSet(const tGPIOBus *psBus, unsigned long ulPinIO);
+extern void GPIOBusDataWrite(const tGPIOBus *psBus, unsigned long ulData);
+extern unsigned long GPIOBusDataRead(const tGPIOBus *psBus);
+extern void GPIOBusWrite(const tGPIOBus *psBus, unsigned long ulRS,
+                         unsigned long ulData);
+extern unsigned long GPIOBusRead(const tGPIOBus *psBus, unsigned long ulRS);
 
 //*****************************************************************************
 //
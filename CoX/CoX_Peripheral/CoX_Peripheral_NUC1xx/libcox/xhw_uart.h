@@ -594,7 +594,7 @@
 //
 //! Transmitter Empty Flag.
 //
-#define UART_FSR_TE_F           0x01000000  
+#define UART_FSR_TE_F           0x10000000  
 
 //*****************************************************************************
 //
@@ -861,6 +861,39 @@
 //
 #define UART_LIN_BCNT_TX_EN     0x00000080  
 
+//
+//! RS-485 Normal Multi-drop Operation Mode.
+//
+#define UART_LIN_BCNT_RS485_NMM 0x00000100
+
+//
+//! RS-485 Auto Address Detection Operation Mode.
+//
+#define UART_LIN_BCNT_RS485_AAD 0x00000200
+
+//
+//! RS-485 Auto Direction Mode, RTS drives the transceiver while sending.
+//
+#define UART_LIN_BCNT_RS485_AUD 0x00000400
+
+//
+//! RS-485 Address Detection Enable.
+//
+#define UART_LIN_BCNT_RS485_ADD_EN                                            \
+                                0x00008000
+
+//
+//! RS-485 Address Match Value mask.
+//
+#define UART_LIN_BCNT_ADDR_MATCH_M                                            \
+                                0xFF000000
+
+//
+//! RS-485 Address Match Value shift.
+//
+#define UART_LIN_BCNT_ADDR_MATCH_S                                            \
+                                24
+
 //*****************************************************************************
 //
 //! @}
@@ -42,9 +42,11 @@
 #include "xhw_nvic.h"
 #include "xhw_sysctl.h"
 #include "xhw_i2c.h"
+#include "xhw_gpio.h"
 #include "xdebug.h"
 #include "xcore.h"
 #include "xsysctl.h"
+#include "xgpio.h"
 #include "xi2c.h"
 
 
@@ -57,6 +59,126 @@ static tI2CConfig g_tI2CSetup[2];
 static unsigned long g_ulI2CMasterComplete[2];
 static unsigned long g_ulI2CSlaveComplete[2];
 
+//*****************************************************************************
+//
+// Master job queue of one I2C bus.
+//
+// psHead is the job on the bus, the rest of the queue follows psNext. The
+// transfer of psHead is the one in g_tI2CSetup while the queue is not empty,
+// so I2CMasterHandler() runs it like an interrupt mode I2CMasterTransfer().
+//
+//*****************************************************************************
+typedef struct
+{
+    tI2CMasterJob *psHead;
+    tI2CMasterJob *psTail;
+}
+tI2CJobQueue;
+
+static tI2CJobQueue g_sI2CJobQueue[2];
+
+//*****************************************************************************
+//
+// Master transfer on one I2C bus, as I2CMasterHandler() runs it.
+//
+// The buffers are walked with pointers and down counters, so a data byte
+// costs one load or store; ulWCount/ulRCount of psCfg are written back
+// when the transfer ends. psCfg is 0 while no transfer is on the bus,
+// psJob is its queued job or 0 for an interrupt mode I2CMasterTransfer().
+//
+//*****************************************************************************
+typedef struct
+{
+    tI2CMasterTransferCfg *psCfg;
+    tI2CMasterJob *psJob;
+    const unsigned char *pucWrite;
+    unsigned char *pucRead;
+    unsigned long ulWLeft;
+    unsigned long ulRLeft;
+    unsigned long ulDir;
+}
+tI2CMasterState;
+
+static tI2CMasterState g_sI2CMaster[2];
+
+//*****************************************************************************
+//
+// Timeout counter setting of the user, kept while jobs run on the bus
+//
+//*****************************************************************************
+static unsigned long g_ulI2CJobToc[2];
+
+//*****************************************************************************
+//
+// Error of the last master transfer and error counters, per bus
+//
+//*****************************************************************************
+static unsigned long g_ulI2CMasterError[2];
+static tI2CErrorCount g_sI2CErrorCount[2];
+
+//*****************************************************************************
+//
+// Register map slave of one I2C bus.
+//
+// psMap holds the map of each own address slot. psActive is the map of the
+// address of the current transaction, 0 when that address has none or for
+// a general call. bPointer is set while the next byte written is the
+// register pointer; ulFirst and ulWritten are the registers written in the
+// transaction, for the write notify callback.
+//
+//*****************************************************************************
+typedef struct
+{
+    tI2CSlaveRegMap *psMap[4];
+    tI2CSlaveRegMap *psActive;
+    xtBoolean bPointer;
+    unsigned long ulFirst;
+    unsigned long ulWritten;
+}
+tI2CRegSlave;
+
+//*****************************************************************************
+//
+// An array is register map slave point, 0 when the bus serves no map
+//
+//*****************************************************************************
+static tI2CRegSlave g_sI2CRegSlave[2];
+static tI2CRegSlave *g_psI2CRegSlave[2] = {0};
+
+//*****************************************************************************
+//
+// Own address and address mask registers, by slot number
+//
+//*****************************************************************************
+static const unsigned long g_pulI2CAddrRegs[4] =
+{
+    I2C_O_ADDR0, I2C_O_ADDR1, I2C_O_ADDR2, I2C_O_ADDR3
+};
+static const unsigned long g_pulI2CMaskRegs[4] =
+{
+    I2C_O_ADM0, I2C_O_ADM1, I2C_O_ADM2, I2C_O_ADM3
+};
+
+//*****************************************************************************
+//
+// Returned by the polling helpers instead of an I2C status when the timeout
+// counter expired. The I2C status values are below 0x100.
+//
+//*****************************************************************************
+#define I2C_STATUS_TIMEOUT      0x00000100
+
+//*****************************************************************************
+//
+// Registers kept across the controller reset of I2CBusRecover(), the clock
+// divider first.
+//
+//*****************************************************************************
+static const unsigned long g_pulI2CKeepRegs[] =
+{
+    I2C_O_CLK, I2C_O_ADDR0, I2C_O_ADDR1, I2C_O_ADDR2, I2C_O_ADDR3,
+    I2C_O_ADM0, I2C_O_ADM1, I2C_O_ADM2, I2C_O_ADM3
+};
+
 //*****************************************************************************
 //
 //! \internal
@@ -84,6 +206,114 @@ static unsigned long I2CNumGet (unsigned long ulBase)
 	return ((ulBase == I2C0_BASE) ? 0 : 1);
 }
 
+//*****************************************************************************
+//
+//! \internal
+//! \brief Wait for the I2C interrupt flag, bounded by the timeout counter.
+//!
+//! \param ulBase specifies the I2C module base address.
+//!
+//! The 14-bit timeout counter runs while SI is clear, so it expires when the
+//! controller is stuck on a step, for instance when a slave holds SDA low.
+//!
+//! \return \b xtrue when SI was set, \b xfalse when the counter expired.
+//
+//*****************************************************************************
+static xtBoolean I2CSIWait (unsigned long ulBase)
+{
+    while (!(xHWREG(ulBase + I2C_O_CON) & I2C_CON_SI))
+    {
+        if (xHWREG(ulBase + I2C_O_TOC) & I2C_TOC_TIF)
+        {
+            xHWREG(ulBase + I2C_O_TOC) |= I2C_TOC_TIF;
+            return xfalse;
+        }
+    }
+    return xtrue;
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Turn the timeout counter on for a master transfer.
+//!
+//! \param ulBase specifies the I2C module base address.
+//!
+//! The divider set by I2CTimeoutCounterSet() is kept when the counter was
+//! already on, otherwise the longest timeout is used.
+//!
+//! \return the setting to give back to I2CTimeoutRestore().
+//
+//*****************************************************************************
+static unsigned long I2CTimeoutStart (unsigned long ulBase)
+{
+    unsigned long ulToc;
+
+    ulToc = xHWREG(ulBase + I2C_O_TOC) & (I2C_TOC_ENTI | I2C_TOC_DIV4);
+    xHWREG(ulBase + I2C_O_TOC) = ((ulToc & I2C_TOC_ENTI) ? ulToc :
+                                  (I2C_TOC_ENTI | I2C_TOC_DIV4)) | I2C_TOC_TIF;
+    return ulToc;
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Give the timeout counter setting back after a master transfer.
+//!
+//! \param ulBase specifies the I2C module base address.
+//! \param ulToc is the value returned by I2CTimeoutStart().
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void I2CTimeoutRestore (unsigned long ulBase, unsigned long ulToc)
+{
+    xHWREG(ulBase + I2C_O_TOC) = ulToc | I2C_TOC_TIF;
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Count a master transfer error.
+//!
+//! \param ulBase specifies the I2C module base address.
+//! \param ulCodeStatus is the I2C status the transfer failed on, or
+//! \b I2C_STATUS_TIMEOUT.
+//!
+//! \return the \b I2C_MASTER_ERR_ code, also kept for I2CMasterErrorGet().
+//
+//*****************************************************************************
+static unsigned long I2CMasterErrorCount (unsigned long ulBase,
+                                          unsigned long ulCodeStatus)
+{
+    unsigned long ulNum, ulError;
+
+    ulNum = I2CNumGet(ulBase);
+    switch (ulCodeStatus)
+    {
+    case I2C_STATUS_TIMEOUT:
+        ulError = I2C_MASTER_ERR_TIMEOUT;
+        g_sI2CErrorCount[ulNum].ulTimeout++;
+        break;
+    case I2C_I2STAT_M_TX_SLAW_NACK:
+    case I2C_I2STAT_M_TX_DAT_NACK:
+    case I2C_I2STAT_M_RX_SLAR_NACK:
+        ulError = I2C_MASTER_ERR_NACK;
+        g_sI2CErrorCount[ulNum].ulNack++;
+        break;
+    case I2C_I2STAT_M_TX_ARB_LOST:
+        ulError = I2C_MASTER_ERR_ARB_LOST;
+        g_sI2CErrorCount[ulNum].ulArbLost++;
+        break;
+    default:
+        ulError = I2C_MASTER_ERR_BUS;
+        g_sI2CErrorCount[ulNum].ulBus++;
+        break;
+    }
+    g_ulI2CMasterError[ulNum] = ulError;
+    return ulError;
+}
+
 //*****************************************************************************
 //
 //! \internal
@@ -99,7 +329,8 @@ static unsigned long I2CNumGet (unsigned long ulBase)
 //!
 //! \note This is only for master
 //!
-//! \return value of I2C status register after generate a start condition.
+//! \return value of I2C status register after generate a start condition,
+//! or \b I2C_STATUS_TIMEOUT.
 //
 //*****************************************************************************
 static unsigned long I2CStartSend (unsigned long ulBase)
@@ -115,7 +346,10 @@ static unsigned long I2CStartSend (unsigned long ulBase)
     //
     // Wait for complete
     //
-	while (!(xHWREG(ulBase + I2C_O_CON) & I2C_CON_SI));
+    if (!I2CSIWait(ulBase))
+    {
+        return I2C_STATUS_TIMEOUT;
+    }
 	
 	return (xHWREG(ulBase + I2C_O_STATUS) & I2C_STATUS_M);
 }
@@ -170,7 +404,8 @@ static void I2CStopSend (unsigned long ulBase)
 //!
 //! \note This is only for master
 //!
-//! \return value of I2C status register after send a byte.
+//! \return value of I2C status register after send a byte, or
+//! \b I2C_STATUS_TIMEOUT.
 //
 //*****************************************************************************
 static unsigned long I2CByteSend (unsigned long ulBase, unsigned char ucData)
@@ -201,7 +436,10 @@ static unsigned long I2CByteSend (unsigned long ulBase, unsigned char ucData)
     //
     // Wait the SI be set again by hardware
     //
-	while (!(xHWREG(ulBase + I2C_O_CON) & I2C_CON_SI));
+    if (!I2CSIWait(ulBase))
+    {
+        return I2C_STATUS_TIMEOUT;
+    }
         
     //
     // Return the i2c status
@@ -225,7 +463,8 @@ static unsigned long I2CByteSend (unsigned long ulBase, unsigned char ucData)
 //!
 //! \note This is only for master
 //!
-//! \return value of I2C status register after send a byte.
+//! \return value of I2C status register after send a byte, or
+//! \b I2C_STATUS_TIMEOUT.
 //
 //*****************************************************************************
 static unsigned long I2CByteGet (unsigned long ulBase, unsigned char *ucpData, 
@@ -249,923 +488,1948 @@ static unsigned long I2CByteGet (unsigned long ulBase, unsigned char *ucpData,
     }
 	xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
     
-	while (!(xHWREG(ulBase + I2C_O_CON) & I2C_CON_SI));
+    if (!I2CSIWait(ulBase))
+    {
+        return I2C_STATUS_TIMEOUT;
+    }
     *ucpData = (unsigned char)xHWREG(ulBase + I2C_O_DAT);
     return (xHWREG(ulBase + I2C_O_STATUS) & I2C_STATUS_M);
 }
 
 //*****************************************************************************
 //
-//! \brief I2C0 interrupt handler. Clear the I2C0 interrupt flag and execute the 
-//! callback function.
-//!
-//! \param none.
+//! \internal
+//! \brief Puts a transfer on the bus for I2CMasterHandler().
 //!
-//! This function is the I2C0 interrupt handler,it will Clear the I2C0 
-//! interrupt flag and execute the callback function if there be one.
+//! \param psState is the master state of the bus.
+//! \param psCfg is the transfer.
+//! \param psJob is its job, or 0.
 //!
-//! \note There are two source of this interrupt.One is I2C0 function
-//! and one is I2C0 time out.
+//! An empty buffer pointer counts as no data in that direction.
 //!
 //! \return None.
 //
 //*****************************************************************************
-void 
-I2C0IntHandler(void)
+static void
+I2CMasterStateLoad(tI2CMasterState *psState, tI2CMasterTransferCfg *psCfg,
+                   tI2CMasterJob *psJob)
 {
-    unsigned long ulBase = I2C0_BASE;
-    
-#if xI2C_MASTER > 0
-    I2CMasterHandler(ulBase);
-#endif
-#if xI2C_SLAVE > 0
-    I2CSlaveHandler(ulBase);
-#endif
+    psState->psCfg = psCfg;
+    psState->psJob = psJob;
+    psState->pucWrite = (const unsigned char *)psCfg->pvWBuf;
+    psState->ulWLeft = (psCfg->pvWBuf != 0) ? psCfg->ulWLen : 0;
+    psState->pucRead = (unsigned char *)psCfg->pvRBuf;
+    psState->ulRLeft = (psCfg->pvRBuf != 0) ? psCfg->ulRLen : 0;
+    psState->ulDir = 0;
+    psCfg->ulWCount = 0;
+    psCfg->ulRCount = 0;
 }
 
 //*****************************************************************************
 //
-//! \brief I2C1 interrupt handler. Clear the I2C1 interrupt flag and execute the 
-//! callback function.
+//! \internal
+//! \brief Writes back the byte counts of the transfer on the bus.
 //!
-//! \param none.
+//! \param psState is the master state of the bus.
 //!
-//! This function is the I2C1 interrupt handler,it will Clear the I2C1 
-//! interrupt flag and execute the callback function if there be one.
+//! \return None.
+//
+//*****************************************************************************
+static void
+I2CMasterStateCount(tI2CMasterState *psState)
+{
+    tI2CMasterTransferCfg *psCfg = psState->psCfg;
+
+    psCfg->ulWCount = (psCfg->pvWBuf != 0) ?
+                      (psCfg->ulWLen - psState->ulWLeft) : 0;
+    psCfg->ulRCount = (psCfg->pvRBuf != 0) ?
+                      (psCfg->ulRLen - psState->ulRLeft) : 0;
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Ends the job on the bus and starts the next one of the queue.
 //!
-//! \note There are two source of this interrupt.One is I2C1 function
-//! and one is I2C1 time out.
+//! \param ulBase specifies the I2C module base address.
+//! \param ulStatus is the status the job ends with.
+//!
+//! When another job is queued STOP and START are requested in the same
+//! write, so the bus goes to the next job without an idle interrupt between
+//! them. Otherwise a STOP ends the queue. The callback of the ended job runs
+//! last, it may queue a job again.
 //!
 //! \return None.
 //
 //*****************************************************************************
-void 
-I2C1IntHandler(void)
+static void
+I2CMasterJobEnd(unsigned long ulBase, unsigned long ulStatus)
 {
-    unsigned long ulBase = I2C1_BASE;
-    
-#if xI2C_MASTER > 0
-    I2CMasterHandler(ulBase);
-#endif
-#if xI2C_SLAVE > 0
-    I2CSlaveHandler(ulBase);
-#endif
+    tI2CJobQueue *psQueue;
+    tI2CMasterJob *psJob;
+    unsigned long ulNum, ulCon;
+
+    ulNum = I2CNumGet(ulBase);
+    psQueue = &g_sI2CJobQueue[ulNum];
+    psJob = psQueue->psHead;
+    psQueue->psHead = psJob->psNext;
+    I2CMasterStateCount(&g_sI2CMaster[ulNum]);
+
+    if (psQueue->psHead != 0)
+    {
+        I2CMasterStateLoad(&g_sI2CMaster[ulNum], &psQueue->psHead->sCfg,
+                           psQueue->psHead);
+        ulCon = xHWREG(ulBase + I2C_O_CON) &
+                ~(I2C_CON_AA | I2C_CON_STA | I2C_CON_STO);
+        xHWREG(ulBase + I2C_O_CON) = ulCon | I2C_CON_STA | I2C_CON_STO |
+                                     I2C_CON_SI;
+    }
+    else
+    {
+        psQueue->psTail = 0;
+        g_sI2CMaster[ulNum].psCfg = 0;
+        I2CStopSend(ulBase);
+        I2CTimeoutRestore(ulBase, g_ulI2CJobToc[ulNum]);
+    }
+
+    if (ulStatus == I2C_JOB_DONE)
+    {
+        g_ulI2CMasterError[ulNum] = I2C_MASTER_ERR_NONE;
+    }
+    psJob->ulStatus = ulStatus;
+    if (psJob->pfnCallback != 0)
+    {
+        psJob->pfnCallback(psJob->pvCBData, ulStatus, 0, psJob);
+    }
 }
 
 //*****************************************************************************
 //
-//! \brief General Master Interrupt handler for I2C peripheral. 
+//! \internal
+//! \brief Find the register map of the address a master sent.
 //!
 //! \param ulBase specifies the I2C module base address.
+//! \param psSlave is the register map slave of the bus.
+//! \param ulAddr is the SLA+R/W byte received.
 //!
-//! This function is to give a eneral Master Interrupt handler for I2C 
-//! peripheral
+//! The own address slots are matched like the controller does, the bits set
+//! in the address mask are don't care.
 //!
-//! The \e ulBase can be one of the following values:
-//! \b I2C0_BASE, \b I2C1_BASE.
+//! \return the map of the first slot that matches, or 0.
+//
+//*****************************************************************************
+static tI2CSlaveRegMap *
+I2CSlaveRegMapFind(unsigned long ulBase, tI2CRegSlave *psSlave,
+                   unsigned long ulAddr)
+{
+    unsigned long i, ulOwn, ulMask;
+
+    for (i = 0; i < 4; i++)
+    {
+        if (psSlave->psMap[i] == 0)
+        {
+            continue;
+        }
+        ulOwn = xHWREG(ulBase + g_pulI2CAddrRegs[i]) & I2C_ADDR0_ADDR_M;
+        ulMask = xHWREG(ulBase + g_pulI2CMaskRegs[i]) & I2C_ADM0_ADM_M;
+        if ((((ulOwn ^ ulAddr) & ~ulMask) & I2C_ADDR0_ADDR_M) == 0)
+        {
+            return psSlave->psMap[i];
+        }
+    }
+    return 0;
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Serve a slave event from the register maps.
 //!
-//! \note This is only for master
+//! \param ulBase specifies the I2C module base address.
 //!
-//! \return None.
+//! Called first by the I2C interrupt handlers. Takes the slave status codes,
+//! and the bus errors while no master job is queued, when a register map
+//! is set on the bus. The first byte a master writes is the register
+//! pointer, the next bytes are written to the registers through their write
+//! masks; reads return the registers. The pointer increments after every
+//! register and wraps to 0 after the last one; outside the map writes are
+//! dropped and reads return 0xFF. Every byte is acknowledged, so the master
+//! never sees a NACK or a stretched clock waiting for the application.
+//!
+//! \return \b xtrue when the event was served, \b xfalse when it is left
+//! to the other handlers.
 //
 //*****************************************************************************
-void 
-I2CMasterHandler (unsigned long ulBase)
+static xtBoolean
+I2CSlaveRegHandler(unsigned long ulBase)
 {
-    unsigned long ulTemp;
-    unsigned char ucReturnCode;
-    tI2CMasterTransferCfg *tpTxRxsetup;
-    
-    //
-    // Check the arguments.
-    //
-    xASSERT((ulBase == I2C0_BASE) || (ulBase == I2C1_BASE));
+    tI2CRegSlave *psSlave;
+    tI2CSlaveRegMap *psMap, *psNotify;
+    unsigned long ulNum, ulStatus, ulData, ulMask, ulFirst, ulWritten, ulCon;
 
-    ulTemp = I2CNumGet(ulBase);
-    tpTxRxsetup = (tI2CMasterTransferCfg *) g_tI2CSetup[ulTemp].ulSetup;
+    ulNum = I2CNumGet(ulBase);
+    psSlave = g_psI2CRegSlave[ulNum];
+    if (psSlave == 0)
+    {
+        return xfalse;
+    }
 
-    ucReturnCode = (xHWREG(ulBase + I2C_O_STATUS) & I2C_STATUS_M);
+    ulStatus = xHWREG(ulBase + I2C_O_STATUS) & I2C_STATUS_M;
+    if (((ulStatus < I2C_I2STAT_S_RX_SLAW_ACK) ||
+         (ulStatus > I2C_I2STAT_S_TX_LAST_DAT_ACK)) &&
+        ((ulStatus != I2C_I2STAT_BUS_ERROR) ||
+         (g_sI2CJobQueue[ulNum].psHead != 0)))
+    {
+        return xfalse;
+    }
+
+    psMap = psSlave->psActive;
+    psNotify = 0;
+    ulFirst = 0;
+    ulWritten = 0;
 
+    switch (ulStatus)
+    {
     //
-    // Save current status
+    // Own SLA+W has been received, the register pointer comes first
     //
+    case I2C_I2STAT_S_RX_SLAW_ACK:
+    case I2C_I2STAT_S_RX_ARB_LOST_M_SLA:
+        psSlave->psActive = I2CSlaveRegMapFind(ulBase, psSlave,
+                                               xHWREG(ulBase + I2C_O_DAT));
+        psSlave->bPointer = xtrue;
+        psSlave->ulWritten = 0;
+        break;
 
     //
-    // there's no relevant information
+    // General call, the bytes are acknowledged and dropped
     //
-    if (ucReturnCode == I2C_I2STAT_NO_INF)
-    {
-        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
-        return;
-    }
+    case I2C_I2STAT_S_RX_GENCALL_ACK:
+    case I2C_I2STAT_S_RX_ARB_LOST_M_GENCALL:
+        psSlave->psActive = 0;
+        psSlave->ulWritten = 0;
+        break;
 
     //
-    // TRANSMIT PHASE 
+    // Data has been received, ACK has been returned
     //
-    if (g_tI2CSetup[ulTemp].ulDir == 0)
-    {
-        switch (ucReturnCode)
+    case I2C_I2STAT_S_RX_PRE_SLA_DAT_ACK:
+    case I2C_I2STAT_S_RX_PRE_GENCALL_DAT_ACK:
+        ulData = xHWREG(ulBase + I2C_O_DAT) & I2C_DAT_DATA_M;
+        if (psMap == 0)
         {
-        //
-        // A start/repeat start condition has been transmitted 
-        //
-        case I2C_I2STAT_M_TX_START:
-        case I2C_I2STAT_M_TX_RESTART:
-            xHWREG(ulBase + I2C_O_CON) &= ~(I2C_CON_STA | I2C_CON_SI);
-            //
-            // If there's any transmit data, then start to
-            // send SLA+W right now, otherwise check whether if there's
-            // any receive data for next state.
-            // 
-            if ((tpTxRxsetup->pvWBuf != 0) && (tpTxRxsetup->ulWLen != 0))
-            {
-                xHWREG(ulBase + I2C_O_DAT) = (tpTxRxsetup->ulSlave<< 1);
-                xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
-            } 
-            else 
-            {
-                goto next_stage;
-            }
             break;
-        //
-        // SLA+W has been transmitted, ACK has been received
-        //
-        case I2C_I2STAT_M_TX_SLAW_ACK:
-        //
-        // Data has been transmitted, ACK has been received 
-        //
-        case I2C_I2STAT_M_TX_DAT_ACK:
-            //
-            // Send more data 
-            //
-            if ((tpTxRxsetup->ulWCount < tpTxRxsetup->ulWLen) 
-                && (tpTxRxsetup->pvWBuf != 0))
+        }
+        if (psSlave->bPointer)
+        {
+            psSlave->bPointer = xfalse;
+            psSlave->ulFirst = ulData;
+            psMap->ulPointer = ulData;
+            break;
+        }
+        if (psMap->ulPointer < psMap->ulCount)
+        {
+            ulMask = (psMap->pucWriteMask != 0) ?
+                     psMap->pucWriteMask[psMap->ulPointer] : 0xFF;
+            psMap->pucRegs[psMap->ulPointer] =
+                (psMap->pucRegs[psMap->ulPointer] & ~ulMask) |
+                (ulData & ulMask);
+            psSlave->ulWritten++;
+        }
+        psMap->ulPointer = (psMap->ulPointer + 1 < psMap->ulCount) ?
+                           (psMap->ulPointer + 1) : 0;
+        break;
+
+    //
+    // A STOP or a repeated START ends the write
+    //
+    case I2C_I2STAT_S_RX_STA_STO_SLVREC_SLVTRX:
+        if ((psMap != 0) && (psSlave->ulWritten != 0))
+        {
+            psNotify = psMap;
+            ulFirst = psSlave->ulFirst;
+            ulWritten = psSlave->ulWritten;
+        }
+        psSlave->ulWritten = 0;
+        break;
+
+    //
+    // Own SLA+R has been received, the first register goes out
+    //
+    case I2C_I2STAT_S_TX_SLAR_ACK:
+    case I2C_I2STAT_S_TX_ARB_LOST_M_SLA:
+        psMap = I2CSlaveRegMapFind(ulBase, psSlave,
+                                   xHWREG(ulBase + I2C_O_DAT));
+        psSlave->psActive = psMap;
+
+        //
+        // Go on with the data byte
+        //
+
+    //
+    // Data has been transmitted, ACK has been received
+    //
+    case I2C_I2STAT_S_TX_DAT_ACK:
+        ulData = 0xFF;
+        if (psMap != 0)
+        {
+            if (psMap->ulPointer < psMap->ulCount)
+            {
+                ulData = psMap->pucRegs[psMap->ulPointer];
+            }
+            psMap->ulPointer = (psMap->ulPointer + 1 < psMap->ulCount) ?
+                               (psMap->ulPointer + 1) : 0;
+        }
+        xHWREG(ulBase + I2C_O_DAT) = ulData;
+        break;
+
+    //
+    // The master ended the read, or anything else: just stay addressable
+    //
+    default:
+        break;
+    }
+
+    //
+    // Always acknowledge the next byte, a bus error is left with STO
+    //
+    ulCon = xHWREG(ulBase + I2C_O_CON) & ~(I2C_CON_STA | I2C_CON_STO);
+    if (ulStatus == I2C_I2STAT_BUS_ERROR)
+    {
+        ulCon |= I2C_CON_STO;
+    }
+    xHWREG(ulBase + I2C_O_CON) = ulCon | I2C_CON_AA | I2C_CON_SI;
+
+    //
+    // The bus is released before the application is told
+    //
+    if ((psNotify != 0) && (psNotify->pfnCallback != 0))
+    {
+        psNotify->pfnCallback(psNotify->pvCBData, ulFirst, ulWritten,
+                              psNotify);
+    }
+    return xtrue;
+}
+
+//*****************************************************************************
+//
+//! \brief I2C0 interrupt handler. Clear the I2C0 interrupt flag and execute the 
+//! callback function.
+//!
+//! \param none.
+//!
+//! This function is the I2C0 interrupt handler,it will Clear the I2C0 
+//! interrupt flag and execute the callback function if there be one.
+//!
+//! \note There are two source of this interrupt.One is I2C0 function
+//! and one is I2C0 time out.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void 
+I2C0IntHandler(void)
+{
+    unsigned long ulBase = I2C0_BASE;
+    
+    if (I2CSlaveRegHandler(ulBase))
+    {
+        return;
+    }
+#if xI2C_MASTER > 0
+    I2CMasterHandler(ulBase);
+#endif
+#if xI2C_SLAVE > 0
+    I2CSlaveHandler(ulBase);
+#endif
+}
+
+//*****************************************************************************
+//
+//! \brief I2C1 interrupt handler. Clear the I2C1 interrupt flag and execute the 
+//! callback function.
+//!
+//! \param none.
+//!
+//! This function is the I2C1 interrupt handler,it will Clear the I2C1 
+//! interrupt flag and execute the callback function if there be one.
+//!
+//! \note There are two source of this interrupt.One is I2C1 function
+//! and one is I2C1 time out.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void 
+I2C1IntHandler(void)
+{
+    unsigned long ulBase = I2C1_BASE;
+    
+    if (I2CSlaveRegHandler(ulBase))
+    {
+        return;
+    }
+#if xI2C_MASTER > 0
+    I2CMasterHandler(ulBase);
+#endif
+#if xI2C_SLAVE > 0
+    I2CSlaveHandler(ulBase);
+#endif
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Ends the master transfer on the bus.
+//!
+//! \param ulBase specifies the I2C module base address.
+//! \param psState is the master state of the bus.
+//!
+//! A job goes to I2CMasterJobEnd(), an interrupt mode transfer calls the
+//! callback, then the interrupt is disabled and a STOP sent.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+I2CMasterActEnd(unsigned long ulBase, tI2CMasterState *psState)
+{
+    unsigned long ulNum;
+
+    if (psState->psJob != 0)
+    {
+        I2CMasterJobEnd(ulBase, I2C_JOB_DONE);
+        return;
+    }
+    I2CMasterStateCount(psState);
+    psState->psCfg = 0;
+    ulNum = I2CNumGet(ulBase);
+    if(g_tI2CSetup[ulNum].g_pfnI2CHandlerCallbacks != 0)
+    {
+        g_tI2CSetup[ulNum].g_pfnI2CHandlerCallbacks(0,0,0,0);
+    }
+    I2CDisable(ulBase);
+    I2CStopSend(ulBase);
+    g_ulI2CMasterComplete[ulNum] = xtrue;
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Goes to the read phase, or ends a transfer without read data.
+//!
+//! \param ulBase specifies the I2C module base address.
+//! \param psState is the master state of the bus.
+//! \param ulCon is the CON value to write, STA/STO/SI clear.
+//!
+//! A read after written data needs a repeated START, a read alone sends
+//! SLA+R right after the START.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+I2CMasterActRead(unsigned long ulBase, tI2CMasterState *psState,
+                 unsigned long ulCon)
+{
+    psState->ulDir = 1;
+    if (psState->ulRLeft == 0)
+    {
+        I2CMasterActEnd(ulBase, psState);
+    }
+    else if ((psState->psCfg->pvWBuf != 0) && (psState->psCfg->ulWLen != 0))
+    {
+        xHWREG(ulBase + I2C_O_CON) = (ulCon & ~I2C_CON_AA) | I2C_CON_STA |
+                                     I2C_CON_SI;
+    }
+    else
+    {
+        xHWREG(ulBase + I2C_O_DAT) = (psState->psCfg->ulSlave << 1) | 0x01;
+        xHWREG(ulBase + I2C_O_CON) = ulCon | I2C_CON_SI;
+    }
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief START or repeated START sent: address the slave.
+//!
+//! \param ulBase specifies the I2C module base address.
+//! \param psState is the master state of the bus.
+//! \param ulCon is the CON value to write, STA/STO/SI clear.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+I2CMasterActStart(unsigned long ulBase, tI2CMasterState *psState,
+                  unsigned long ulCon)
+{
+    if ((psState->ulDir == 0) && (psState->ulWLeft != 0))
+    {
+        xHWREG(ulBase + I2C_O_DAT) = psState->psCfg->ulSlave << 1;
+        xHWREG(ulBase + I2C_O_CON) = ulCon | I2C_CON_SI;
+    }
+    else if (psState->ulDir == 0)
+    {
+        I2CMasterActRead(ulBase, psState, ulCon);
+    }
+    else if (psState->ulRLeft != 0)
+    {
+        xHWREG(ulBase + I2C_O_DAT) = (psState->psCfg->ulSlave << 1) | 0x01;
+        xHWREG(ulBase + I2C_O_CON) = ulCon | I2C_CON_SI;
+    }
+    else
+    {
+        I2CMasterActEnd(ulBase, psState);
+    }
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief SLA+W or data ACKed: send the next byte or go on with the read.
+//!
+//! \param ulBase specifies the I2C module base address.
+//! \param psState is the master state of the bus.
+//! \param ulCon is the CON value to write, STA/STO/SI clear.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+I2CMasterActWrite(unsigned long ulBase, tI2CMasterState *psState,
+                  unsigned long ulCon)
+{
+    if (psState->ulWLeft != 0)
+    {
+        xHWREG(ulBase + I2C_O_DAT) = *psState->pucWrite++;
+        psState->ulWLeft--;
+        xHWREG(ulBase + I2C_O_CON) = ulCon | I2C_CON_SI;
+    }
+    else
+    {
+        I2CMasterActRead(ulBase, psState, ulCon);
+    }
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief SLA+R ACKed: ACK the first byte unless it is the last one.
+//!
+//! \param ulBase specifies the I2C module base address.
+//! \param psState is the master state of the bus.
+//! \param ulCon is the CON value to write, STA/STO/SI clear.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+I2CMasterActReadAddr(unsigned long ulBase, tI2CMasterState *psState,
+                     unsigned long ulCon)
+{
+    if (psState->ulRLeft > 1)
+    {
+        ulCon |= I2C_CON_AA;
+    }
+    else
+    {
+        ulCon &= ~I2C_CON_AA;
+    }
+    xHWREG(ulBase + I2C_O_CON) = ulCon | I2C_CON_SI;
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Data received with ACK: store it, ACK all but the last byte.
+//!
+//! \param ulBase specifies the I2C module base address.
+//! \param psState is the master state of the bus.
+//! \param ulCon is the CON value to write, STA/STO/SI clear.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+I2CMasterActReadAck(unsigned long ulBase, tI2CMasterState *psState,
+                    unsigned long ulCon)
+{
+    if (psState->ulRLeft != 0)
+    {
+        *psState->pucRead++ = (unsigned char)xHWREG(ulBase + I2C_O_DAT);
+        psState->ulRLeft--;
+    }
+    if (psState->ulRLeft > 1)
+    {
+        ulCon |= I2C_CON_AA;
+    }
+    else
+    {
+        ulCon &= ~I2C_CON_AA;
+    }
+    xHWREG(ulBase + I2C_O_CON) = ulCon | I2C_CON_SI;
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Last data received with NACK: store it and end the transfer.
+//!
+//! \param ulBase specifies the I2C module base address.
+//! \param psState is the master state of the bus.
+//! \param ulCon is the CON value to write, STA/STO/SI clear.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+I2CMasterActReadLast(unsigned long ulBase, tI2CMasterState *psState,
+                     unsigned long ulCon)
+{
+    if (psState->ulRLeft != 0)
+    {
+        *psState->pucRead++ = (unsigned char)xHWREG(ulBase + I2C_O_DAT);
+        psState->ulRLeft--;
+    }
+    I2CMasterActEnd(ulBase, psState);
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief NACK, lost arbitration, bus error or a status out of place.
+//!
+//! \param ulBase specifies the I2C module base address.
+//! \param psState is the master state of the bus.
+//! \param ulCon is the CON value to write, STA/STO/SI clear.
+//!
+//! A queued job ends with its error and the next one starts. An interrupt
+//! mode I2CMasterTransfer() is started again from the first byte with a
+//! repeated START.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+I2CMasterActError(unsigned long ulBase, tI2CMasterState *psState,
+                  unsigned long ulCon)
+{
+    unsigned long ulError;
+
+    if (psState->psJob != 0)
+    {
+        ulError = I2CMasterErrorCount(ulBase,
+                                      xHWREG(ulBase + I2C_O_STATUS) &
+                                      I2C_STATUS_M);
+        I2CMasterJobEnd(ulBase, (ulError == I2C_MASTER_ERR_NACK) ?
+                        I2C_JOB_NACK : I2C_JOB_ERROR);
+        return;
+    }
+    I2CMasterStateLoad(psState, psState->psCfg, 0);
+    xHWREG(ulBase + I2C_O_CON) = (ulCon & ~I2C_CON_AA) | I2C_CON_STA |
+                                 I2C_CON_SI;
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief No relevant state information: only clear SI.
+//!
+//! \param ulBase specifies the I2C module base address.
+//! \param psState is the master state of the bus.
+//! \param ulCon is the CON value to write, STA/STO/SI clear.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+I2CMasterActNone(unsigned long ulBase, tI2CMasterState *psState,
+                 unsigned long ulCon)
+{
+    xHWREG(ulBase + I2C_O_CON) = ulCon | I2C_CON_SI;
+}
+
+//*****************************************************************************
+//
+// Master action of each I2C status, indexed by status >> 3. The statuses
+// that are not master ones are errors of the master transfer.
+//
+//*****************************************************************************
+typedef void (*tI2CMasterAction)(unsigned long ulBase,
+                                 tI2CMasterState *psState,
+                                 unsigned long ulCon);
+
+static const tI2CMasterAction g_pfnI2CMasterAction[32] =
+{
+    I2CMasterActError,      // 0x00 bus error
+    I2CMasterActStart,      // 0x08 START
+    I2CMasterActStart,      // 0x10 repeated START
+    I2CMasterActWrite,      // 0x18 SLA+W, ACK
+    I2CMasterActError,      // 0x20 SLA+W, NACK
+    I2CMasterActWrite,      // 0x28 data sent, ACK
+    I2CMasterActError,      // 0x30 data sent, NACK
+    I2CMasterActError,      // 0x38 arbitration lost
+    I2CMasterActReadAddr,   // 0x40 SLA+R, ACK
+    I2CMasterActError,      // 0x48 SLA+R, NACK
+    I2CMasterActReadAck,    // 0x50 data received, ACK
+    I2CMasterActReadLast,   // 0x58 data received, NACK
+    I2CMasterActError,      // 0x60
+    I2CMasterActError,      // 0x68
+    I2CMasterActError,      // 0x70
+    I2CMasterActError,      // 0x78
+    I2CMasterActError,      // 0x80
+    I2CMasterActError,      // 0x88
+    I2CMasterActError,      // 0x90
+    I2CMasterActError,      // 0x98
+    I2CMasterActError,      // 0xA0
+    I2CMasterActError,      // 0xA8
+    I2CMasterActError,      // 0xB0
+    I2CMasterActError,      // 0xB8
+    I2CMasterActError,      // 0xC0
+    I2CMasterActError,      // 0xC8
+    I2CMasterActError,      // 0xD0
+    I2CMasterActError,      // 0xD8
+    I2CMasterActError,      // 0xE0
+    I2CMasterActError,      // 0xE8
+    I2CMasterActError,      // 0xF0
+    I2CMasterActNone        // 0xF8 no relevant information
+};
+
+//*****************************************************************************
+//
+//! \brief General Master Interrupt handler for I2C peripheral. 
+//!
+//! \param ulBase specifies the I2C module base address.
+//!
+//! This function is to give a eneral Master Interrupt handler for I2C 
+//! peripheral
+//!
+//! Each I2C status selects its action in a constant table indexed by
+//! status >> 3; the actions walk the buffers of the transfer on the bus.
+//! Nothing is done while no master transfer is on the bus.
+//!
+//! The \e ulBase can be one of the following values:
+//! \b I2C0_BASE, \b I2C1_BASE.
+//!
+//! \note This is only for master
+//!
+//! \return None.
+//
+//*****************************************************************************
+void 
+I2CMasterHandler (unsigned long ulBase)
+{
+    tI2CMasterState *psState;
+    unsigned long ulStatus;
+    
+    //
+    // Check the arguments.
+    //
+    xASSERT((ulBase == I2C0_BASE) || (ulBase == I2C1_BASE));
+
+    psState = &g_sI2CMaster[I2CNumGet(ulBase)];
+    if (psState->psCfg == 0)
+    {
+        return;
+    }
+
+    //
+    // The timeout counter expired while a job was on the bus, it hung
+    //
+    if ((psState->psJob != 0) && (xHWREG(ulBase + I2C_O_TOC) & I2C_TOC_TIF))
+    {
+        xHWREG(ulBase + I2C_O_TOC) |= I2C_TOC_TIF;
+        I2CMasterErrorCount(ulBase, I2C_STATUS_TIMEOUT);
+        I2CBusRecover(ulBase);
+        I2CMasterJobEnd(ulBase, I2C_JOB_TIMEOUT);
+        return;
+    }
+
+    ulStatus = xHWREG(ulBase + I2C_O_STATUS) & I2C_STATUS_M;
+    g_pfnI2CMasterAction[ulStatus >> 3](ulBase, psState,
+                                        xHWREG(ulBase + I2C_O_CON) &
+                                        ~(I2C_CON_STA | I2C_CON_STO |
+                                          I2C_CON_SI));
+}
+
+//*****************************************************************************
+//
+//! \brief General slave Interrupt handler for I2C peripheral. 
+//!
+//! \param ulBase specifies the I2C module base address.
+//!
+//! This function is to give a general slave Interrupt handler for I2C 
+//! peripheral
+//!
+//! The \e ulBase can be one of the following values:
+//! \b I2C0_BASE, \b I2C1_BASE.
+//!
+//! \note this is only for slave
+//!
+//! \return None.
+//
+//*****************************************************************************
+void 
+I2CSlaveHandler (unsigned long ulBase)
+{
+    unsigned long ulTemp;
+    unsigned char ucReturnCode;
+    tI2CSlaveTransferCfg *tpTxRxsetup;
+    unsigned long ulTimeout;
+
+    ulTemp = I2CNumGet(ulBase);
+    tpTxRxsetup = (tI2CSlaveTransferCfg *) g_tI2CSetup[ulTemp].ulSetup;
+
+    ucReturnCode = xHWREG(ulBase + I2C_O_STATUS) & I2C_STATUS_M;
+
+    //
+    // Save current status
+    // txrx_setup->status = returnCode;
+    // there's no relevant information
+    //
+    if (ucReturnCode == I2C_I2STAT_NO_INF)
+    {
+        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
+        return;
+    }
+
+
+    switch (ucReturnCode)
+    {
+
+    //
+    //* No status information 
+    //
+    case I2C_I2STAT_NO_INF:
+        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_AA;
+        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
+        break;
+
+    //
+    //* Reading phase 
+    //
+    //
+    //* Own SLA+R has been received, ACK has been returned 
+    //
+    case I2C_I2STAT_S_RX_SLAW_ACK:
+    //
+    //* General call address has been received, ACK has been returned 
+    //
+    case I2C_I2STAT_S_RX_GENCALL_ACK:
+        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_AA;
+        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
+        break;
+
+    //
+    // Previously addressed with own SLA;
+    // DATA byte has been received;
+    // ACK has been returned 
+    //
+    case I2C_I2STAT_S_RX_PRE_SLA_DAT_ACK:
+    //
+    //* DATA has been received, ACK hasn been return 
+    //
+    case I2C_I2STAT_S_RX_PRE_GENCALL_DAT_ACK:
+        //
+        // All data bytes that over-flow the specified receive
+        // data length, just ignore them.
+        //
+        if ((tpTxRxsetup->ulRCount < tpTxRxsetup->ulRLen) && 
+            (tpTxRxsetup->pvRBuf != 0))
+        {
+            *(unsigned char *)((unsigned long)tpTxRxsetup->pvRBuf + tpTxRxsetup->ulRCount) = 
+            (unsigned char)(xHWREG(ulBase + I2C_O_DAT));
+            tpTxRxsetup->ulRCount++;
+        }
+        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_AA;
+        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
+        break;
+
+    //
+    // Previously addressed with own SLA;
+    // DATA byte has been received;
+    // NOT ACK has been returned 
+    //
+	case I2C_I2STAT_S_RX_PRE_SLA_DAT_NACK:
+    //
+    // DATA has been received, NOT ACK has been returned 
+    //
+	case I2C_I2STAT_S_RX_PRE_GENCALL_DAT_NACK:
+		xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
+		break;
+
+    //
+    // Note that: Return code only let us know a stop condition mixed
+    // with a repeat start condition in the same code value.
+    // So we should provide a time-out. In case this is really a stop
+    // condition, this will return back after time out condition. Otherwise,
+    // next session that is slave receive data will be completed.
+    //
+
+    //
+    // A Stop or a repeat start condition 
+    //
+    case I2C_I2STAT_S_RX_STA_STO_SLVREC_SLVTRX:
+        //
+        //Temporally lock the interrupt for timeout condition
+        //
+        I2CIntDisable(ulBase);
+        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
+        //
+        // enable time out
+        //
+        ulTimeout = 0x10000;
+        while(1)
+        {
+            if (xHWREG(ulBase + I2C_O_CON) & I2C_CON_SI)
             {
-                xHWREG(ulBase + I2C_O_DAT) =  *(unsigned char *)
-                ((unsigned long)tpTxRxsetup->pvWBuf + tpTxRxsetup->ulWCount);
-                tpTxRxsetup->ulWCount++;
-                xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
-            }
-            //
-            // no more data, switch to next stage
-            //
+                //
+				// re-Enable interrupt
+				//
+				I2CIntEnable(ulBase);
+				break;
+            } 
             else 
             {
-next_stage:
-                //
-                // change direction
-                //
-                g_tI2CSetup[ulTemp].ulDir = 1;
-                //
-                // Check if any data to receive
-                //
-                if ((tpTxRxsetup->ulRLen != 0) && 
-                    (tpTxRxsetup->pvRBuf != 0))
+                ulTimeout--;
+                if (ulTimeout == 0)
                 {
                     //
-                    // check whether if we need to issue an repeat start
+                    //timeout occur, it's really a stop condition
                     //
-                    if ((tpTxRxsetup->ulWLen != 0) && 
-                        (tpTxRxsetup->pvWBuf != 0))
-                    {
-                        //
-                        // Send out an repeat start command
-                        //
-                        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_STA;
-                        xHWREG(ulBase + I2C_O_CON) &= ~I2C_CON_AA;
-                        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
+                    goto s_int_end;
+                }
+            }
+        }
+        break;
+
+    //
+    // Writing phase 
+    //
+    // Own SLA+R has been received, ACK has been returned 
+    //
+	case I2C_I2STAT_S_TX_SLAR_ACK:
+    //
+    // Data has been transmitted, ACK has been received 
+    //
+	case I2C_I2STAT_S_TX_DAT_ACK:
+        //
+        // All data bytes that over-flow the specified receive
+        // data length, just ignore them.
+        //
+        if ((tpTxRxsetup->ulWCount < tpTxRxsetup->ulWLen) &&
+            (tpTxRxsetup->pvWBuf != 0))
+        {
+            xHWREG(ulBase + I2C_O_DAT)= 
+            *(unsigned char *) ((unsigned long)tpTxRxsetup->pvWBuf + tpTxRxsetup->ulWCount);
+            tpTxRxsetup->ulWCount++;
+        }
+        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_AA;
+        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
+        break;
+
+    //
+    // Data has been transmitted, NACK has been received,
+    // that means there's no more data to send, exit now 
+    //
+    // Note: Don't wait for stop event since in slave transmit mode,
+    // since there no proof lets us know when a stop signal has been received
+    // on slave side.
+    //
+    case I2C_I2STAT_S_TX_DAT_NACK:
+        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_AA;
+        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
+        
+        goto s_int_end;
+
+    // 
+    //Other status must be captured
+    //
+    default:
+s_int_end:
+        ulTemp = I2CNumGet(ulBase);
+        if(g_tI2CSetup[ulTemp].g_pfnI2CHandlerCallbacks != 0)
+        {
+            g_tI2CSetup[ulTemp].g_pfnI2CHandlerCallbacks(0,0,0,0);
+        }
+        //
+        //Disable interrupt
+        //
+        I2CIntDisable(ulBase);
+        xHWREG(ulBase + I2C_O_CON) &= ~I2C_CON_AA;
+        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
+        xHWREG(ulBase + I2C_O_CON) &= ~I2C_CON_STA;
+        g_ulI2CSlaveComplete[ulTemp] = xtrue;
+        break;
+    }
+}
+
+//*****************************************************************************
+//
+//! \brief Set the clock rate of the specified I2C port.
+//!
+//! \param ulBase specifies the I2C module base address.
+//! \param ulI2CClk specifies the I2C clock rate.
+//!
+//! This function is to init and set the clock rate 
+//! specified SPI port.
+//!
+//! The \e ulBase can be one of the following values:
+//! \b I2C0_BASE, \b I2C1_BASE.
+//!
+//! The \e ulI2CClk is the I2C clock rate:
+//!
+//! \note This is only for master
+//!
+//! \return None.
+//
+//*****************************************************************************
+void 
+I2CMasterInit(unsigned long ulBase, unsigned long ulI2CClk)
+{
+    unsigned long ulHclk;
+    unsigned long ulDiv;
+    
+    //
+    // Check the arguments.
+    //
+    xASSERT((ulBase == I2C0_BASE) || (ulBase == I2C1_BASE));
+    
+    if (ulBase == I2C0_BASE)
+    {
+        SysCtlPeripheralReset(SYSCTL_PERIPH_I2C0);
+    }
+    else
+    {
+        SysCtlPeripheralReset(SYSCTL_PERIPH_I2C1);
+    }
+    
+    xHWREG(ulBase + I2C_O_CON) = I2C_CON_ENS1;
+    
+    ulHclk = SysCtlHClockGet();
+    
+    ulDiv = (unsigned long) (((ulHclk * 10)/(ulI2CClk * 4) + 5) / 10 - 1);
+    xHWREG(ulBase + I2C_O_CLK) = ulDiv;
 
-                    }
-                    //
-                    // Don't need issue an repeat start, just goto send SLA+R
-                    //
-                    else 
-                    {
-                        goto send_slar;
-                    }
-                }
-                //
-                // no more data send, the go to end stage now
-                //
-                else 
-                {
-                    //
-                    // success, goto end stage
-                    //
+    xHWREG(ulBase + I2C_O_CON) = 0;
+    xHWREG(ulBase + I2C_O_CON) = I2C_CON_ENS1;
+}
 
-                    goto end_stage;
-                }
-            }
-            break;
+//*****************************************************************************
+//
+//! \brief Transmit and Receive data in master mode of the specified I2C port.
+//!
+//! \param ulBase specifies the I2C module base address.
+//! \param tCfg specifies Pointer to a I2C_M_SETUP_Type structure that
+//!  contains specified information about the configuration for master transfer.
+//! \param ulOption specifies interrupt or polling mode.
+//!
+//! This function is to Transmit and Receive data in master mode of 
+//! specified I2C port.
+//!
+//! The \e ulBase can be one of the following values:
+//! \b I2C0_BASE, \b I2C1_BASE.
+//!
+//! The \e tCfg is the I2C ...:
+//!
+//! \note This is only for master
+//! In case of using I2C to receive data only, either transmit length set to 0
+//! or transmit data pointer set to NULL.
+//! In case of using I2C to transmit data only, either receive length set to 0
+//! or receive data pointer set to NULL.
+//! In case of using I2C to transmit followed by receive data, transmit length,
+//! transmit data pointer, receive length and receive data pointer should be set
+//! corresponding.
+//!
+//! In polling mode every step is bounded by the timeout counter, see
+//! I2CTimeoutCounterSet(); it is turned on for the transfer when it is off.
+//! On failure I2CMasterErrorGet() tells why, and a hung bus is recovered
+//! with I2CBusRecover() before returning.
+//!
+//! \return \b xtrue when the transfer succeeded (or was started in
+//! interrupt mode), \b xfalse otherwise.
+//
+//*****************************************************************************
+xtBoolean 
+I2CMasterTransfer(unsigned long ulBase, tI2CMasterTransferCfg *tCfg,
+                  unsigned long ulOption)
+{
+    unsigned char *ucptxdat;
+    unsigned char *ucprxdat;
+    unsigned long ulCodeStatus;
+    unsigned long ulToc;
+    unsigned char ucTemp;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT((ulBase == I2C0_BASE) || (ulBase == I2C1_BASE));
+
+    //
+    // Check the arguments.
+    //
+    xASSERT((ulOption == I2C_TRANSFER_POLLING) || 
+            (ulOption == I2C_TRANSFER_INTERRUPT));
+    
+    //
+	// reset all default state
+	//
+	ucptxdat = (unsigned char *) tCfg->pvWBuf;
+	ucprxdat = (unsigned char *) tCfg->pvRBuf;
 
+    //
+    // Reset I2C setup value to default state
+    //
+    tCfg->ulWCount = 0;
+    tCfg->ulRCount = 0;
+
+    if (ulOption == I2C_TRANSFER_POLLING)
+    {
         //
-        // SLA+W has been transmitted, NACK has been received 
+        // First Start condition 
         //
-        case I2C_I2STAT_M_TX_SLAW_NACK:
+        //tCfg->retransmissions_count = 0;
+        
         //
-        //Data has been transmitted, NACK has been received 
+        // reset all default state
         //
-        case I2C_I2STAT_M_TX_DAT_NACK:
-            //
-            // update status
-            //
+        ucptxdat = (unsigned char *) tCfg->pvWBuf;
+        ucprxdat = (unsigned char *) tCfg->pvRBuf;
+        
+        //
+        // Reset I2C setup value to default state
+        //
+        tCfg->ulWCount = 0;
+        tCfg->ulRCount = 0;
+        ulCodeStatus = 0;
 
-            goto retry;
         //
-        //Arbitration lost in SLA+R/W or Data bytes 
+        // Bound every wait of the transfer with the timeout counter
         //
-        case I2C_I2STAT_M_TX_ARB_LOST:
-            //
-            // update status
-            //
+        ulToc = I2CTimeoutStart(ulBase);
 
-        default:
-            goto retry;
+        //
+        // Start command
+        //
+        ulCodeStatus = I2CStartSend(ulBase);
+        if ((ulCodeStatus != I2C_I2STAT_M_TX_START) &&
+            (ulCodeStatus != I2C_I2STAT_M_TX_RESTART))
+        {
+            I2CStopSend(ulBase);
+            goto error;
         }
-    }
 
-    //
-    // RECEIVE PHASE 
-    //
-    else if (g_tI2CSetup[ulTemp].ulDir == 1)
-    {
-        switch (ucReturnCode)
+        //
+        // In case of sending data first 
+        //
+        if ((tCfg->ulWLen != 0) && (tCfg->pvWBuf != 0))
         {
+            // 
+            // Send slave address + WR direction bit = 0 
             //
-            //A start/repeat start condition has been transmitted 
-            //
-        case I2C_I2STAT_M_TX_START:
-        case I2C_I2STAT_M_TX_RESTART:
-            xHWREG(ulBase + I2C_O_CON) &= ~(I2C_CON_STA | I2C_CON_SI);
+			ulCodeStatus = I2CByteSend(ulBase, (tCfg->ulSlave << 1));
+            if (ulCodeStatus != I2C_I2STAT_M_TX_SLAW_ACK)
+            {
+                I2CStopSend(ulBase);
+                goto error;
+            }
+
             //
-            // If there's any receive data, then start to
-            // send SLA+R right now, otherwise check whether if there's
-            // any receive data for end of state.
+            // Send a number of data bytes 
             //
-            if ((tpTxRxsetup->pvRBuf != 0) && 
-                (tpTxRxsetup->ulRLen != 0))
-            {
-send_slar:
-                xHWREG(ulBase + I2C_O_DAT) = (tpTxRxsetup->ulSlave << 1) |  
-                                              0x01;
-                xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
-            } 
-            else 
+            while (tCfg->ulWCount < tCfg->ulWLen)
             {
-                //
-                // Success, goto end stage
-                //
-
-                goto end_stage;
-            }
-            break;
+                ulCodeStatus = I2CByteSend(ulBase, *ucptxdat); 
+                if (ulCodeStatus != I2C_I2STAT_M_TX_DAT_ACK)
+                {
+                    I2CStopSend(ulBase);
+                    goto error;
+                }
+                ucptxdat++;
+                tCfg->ulWCount++;
+			}
+		}
 
         //
-        //SLA+R has been transmitted, ACK has been received 
+        // Second Start condition (Repeat Start)
         //
-        case I2C_I2STAT_M_RX_SLAR_ACK:
-            if (tpTxRxsetup->ulRCount < (tpTxRxsetup->ulRLen - 1)) 
+		if ((tCfg->ulWLen != 0) && (tCfg->pvWBuf != 0) &&
+            (tCfg->ulRLen != 0) && (tCfg->pvRBuf != 0))
+        {
+            ulCodeStatus = I2CStartSend(ulBase);
+            if ((ulCodeStatus != I2C_I2STAT_M_TX_START) &&
+                (ulCodeStatus != I2C_I2STAT_M_TX_RESTART))
             {
-                //
-                //Data will be received,  ACK will be return
-                //
-                xHWREG(ulBase + I2C_O_CON) |= I2C_CON_AA;
+                I2CStopSend(ulBase);
+                goto error;
             }
-            else 
+        }
+
+        // Then, start reading after sending data
+        if ((tCfg->ulRLen != 0) && (tCfg->pvRBuf != 0))
+        {
+            //
+            // Send slave address + RD direction bit = 1 
+            //
+            ulCodeStatus = I2CByteSend(ulBase, ((tCfg->ulSlave << 1) | 0x01));
+            if (ulCodeStatus != I2C_I2STAT_M_RX_SLAR_ACK)
+            {
+                I2CStopSend(ulBase);
+                goto error;
+            }
+
+            // Receive a number of data bytes
+            while (tCfg->ulRCount < tCfg->ulRLen)
             {
                 //
-                //Last data will be received,  NACK will be return
+                // Note that: if data length is only one, the master should 
+                // not issue an ACK signal on bus after reading to avoid of 
+                // next data frame on slave side
                 //
-                xHWREG(ulBase + I2C_O_CON) &= ~I2C_CON_AA;
+                if (tCfg->ulRCount< (tCfg->ulRLen- 1))
+                {
+                    //
+                    // Issue an ACK signal for next data frame
+                    //
+                    ulCodeStatus = I2CByteGet(ulBase, &ucTemp, 1);
+                    if (ulCodeStatus != I2C_I2STAT_M_RX_DAT_ACK)
+                    {
+                        I2CStopSend(ulBase);
+                        goto error;
+                    }
+                } 
+                else 
+                {
+                    //
+                    // Do not issue an ACK signal
+                    //
+                    ulCodeStatus = I2CByteGet(ulBase, &ucTemp, 0);
+                    if (ulCodeStatus != I2C_I2STAT_M_RX_DAT_NACK)
+                    {
+                        I2CStopSend(ulBase);
+                        goto error;
+					}
+                }
+				*ucprxdat++ = ucTemp;
+				tCfg->ulRCount++;
             }
-            xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
-            break;
+        }
+        //
+        // Send STOP condition 
+        //
+        I2CStopSend(ulBase);
+        I2CTimeoutRestore(ulBase, ulToc);
+        g_ulI2CMasterError[I2CNumGet(ulBase)] = I2C_MASTER_ERR_NONE;
+        return xtrue;
+error:
+        //
+        // Send stop condition
+        //
+        I2CStopSend(ulBase);
 
         //
-        //Data has been received, ACK has been returned 
+        // A step that never ended means a hung bus, recover it
+        //
+        if (I2CMasterErrorCount(ulBase, ulCodeStatus) ==
+            I2C_MASTER_ERR_TIMEOUT)
+        {
+            I2CBusRecover(ulBase);
+        }
+        I2CTimeoutRestore(ulBase, ulToc);
+        return xfalse;
+    }
+    else if (ulOption == I2C_TRANSFER_INTERRUPT)
+    {
+        //
+        // Setup tx_rx data, callback and interrupt handler
         //
-        case I2C_I2STAT_M_RX_DAT_ACK:
-            // 
-            //Note save data and increase counter first, then check later
-            // Save data  
-            //
-            if ((tpTxRxsetup->pvRBuf != 0) && 
-                (tpTxRxsetup->ulRCount < tpTxRxsetup->ulRLen))
-            {
-                *(unsigned char *)((unsigned long)tpTxRxsetup->pvRBuf+ tpTxRxsetup->ulRCount) = 
-                (xHWREG(ulBase + I2C_O_DAT) & I2C_DAT_DATA_M);
-                tpTxRxsetup->ulRCount++;
-            }
-            if (tpTxRxsetup->ulRCount < (tpTxRxsetup->ulRLen - 1)) 
-            {
-                //
-                //Data will be received,  ACK will be return
-                //
-                xHWREG(ulBase + I2C_O_CON) |= I2C_CON_AA;
-            }
-            else 
-            {
-                //
-                //Last data will be received,  NACK will be return
-                //
-                xHWREG(ulBase + I2C_O_CON) &= ~I2C_CON_AA;
-            }
-
-            xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
-            break;
+        ucTemp = I2CNumGet(ulBase);
+        xASSERT(g_sI2CJobQueue[ucTemp].psHead == 0);
 
         //
-        //Data has been received, NACK has been return 
+        // Write phase first
         //
-        case I2C_I2STAT_M_RX_DAT_NACK:
-            //
-            //Save the last data 
-            //
-            if ((tpTxRxsetup->pvRBuf != 0) && 
-                (tpTxRxsetup->ulRCount < tpTxRxsetup->ulRLen))
-            {
-                *(unsigned char *)((unsigned long)tpTxRxsetup->pvRBuf + tpTxRxsetup->ulRCount) = 
-                (xHWREG(ulBase + I2C_O_DAT) & I2C_DAT_DATA_M);
-                tpTxRxsetup->ulRCount++;
-            }
-            //
-            // success, go to end stage
-            //
-
-            goto end_stage;
+        I2CMasterStateLoad(&g_sI2CMaster[ucTemp], tCfg, 0);
 
         //
-        //SLA+R has been transmitted, NACK has been received 
+        // First Start condition 
         //
-        case I2C_I2STAT_M_RX_SLAR_NACK:
-            //
-            //update status
-            //
+        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
+        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_STA;
+		I2CIntEnable(ulBase);
 
-            goto retry;
+        return (xtrue);
+	}
 
-        //
-        //Arbitration lost
-        //
-        case I2C_I2STAT_M_TX_ARB_LOST:
-            //
-            //update status
-            //
-            
-        default:
-retry:
-            //
-            // check if retransmission is available
-            //
-            if (1)
-            {
-                //
-                //Clear tx count
-                //
-                tpTxRxsetup->ulWCount = 0;
-                xHWREG(ulBase + I2C_O_CON) |= I2C_CON_STA;
-                xHWREG(ulBase + I2C_O_CON) &= ~I2C_CON_AA;
-                xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
-            }
-            //
-            //End of stage
-            //
-            else 
-            {        
-end_stage:
-                ulTemp = I2CNumGet(ulBase);
-                if(g_tI2CSetup[ulTemp].g_pfnI2CHandlerCallbacks != 0)
-                {
-                    g_tI2CSetup[ulTemp].g_pfnI2CHandlerCallbacks(0,0,0,0);
-                }
-                //
-                //Disable interrupt
-                //
-                I2CDisable(ulBase);
-                //
-                //Send stop
-                //
-                I2CStopSend(ulBase);
-                g_ulI2CMasterComplete[ulTemp] = xtrue;
-            }
-            break;
-        }
-    }
+    return xfalse;     
 }
 
 //*****************************************************************************
 //
-//! \brief General slave Interrupt handler for I2C peripheral. 
+//! \brief Get status of Master Transfer. 
 //!
 //! \param ulBase specifies the I2C module base address.
 //!
-//! This function is to give a general slave Interrupt handler for I2C 
-//! peripheral
+//! This function is to get status of Master Transfer
 //!
 //! The \e ulBase can be one of the following values:
 //! \b I2C0_BASE, \b I2C1_BASE.
 //!
-//! \note this is only for slave
+//! \note This is only for master
 //!
-//! \return None.
+//! \return Master transfer status, could be:\b xtrue	master transfer 
+//! completed, \b xfalse master transfer have not completed yet
 //
 //*****************************************************************************
-void 
-I2CSlaveHandler (unsigned long ulBase)
+xtBoolean
+I2CMasterTransferComplete(unsigned long ulBase)
 {
-    unsigned long ulTemp;
-    unsigned char ucReturnCode;
-    tI2CSlaveTransferCfg *tpTxRxsetup;
-    unsigned long ulTimeout;
-
-    ulTemp = I2CNumGet(ulBase);
-    tpTxRxsetup = (tI2CSlaveTransferCfg *) g_tI2CSetup[ulTemp].ulSetup;
+	unsigned long ulRetval, ulTemp;
+	ulTemp = I2CNumGet(ulBase);
+	ulRetval = g_ulI2CMasterComplete[ulTemp];
+	g_ulI2CMasterComplete[ulTemp] = xfalse;
+	return ulRetval;
+}
 
-    ucReturnCode = xHWREG(ulBase + I2C_O_STATUS) & I2C_STATUS_M;
+//*****************************************************************************
+//
+//! \brief Queues a master job on the specified I2C port.
+//!
+//! \param ulBase specifies the I2C module base address.
+//! \param psJob is the job, owned by the driver until it ends.
+//!
+//! Appends \e psJob to the queue of the bus and returns at once. The jobs
+//! run in order from the I2C interrupt, each one like an interrupt mode
+//! I2CMasterTransfer() of \e psJob->sCfg: SLA+W and the transmit data,
+//! a repeated START, SLA+R and the receive data. The next job follows with
+//! STOP and START back to back, so several drivers can share one bus
+//! without waiting for each other.
+//!
+//! A job is not retried. It ends with \b I2C_JOB_DONE, \b I2C_JOB_NACK
+//! when the slave did not acknowledge, \b I2C_JOB_ERROR when the
+//! arbitration was lost, or \b I2C_JOB_TIMEOUT when the timeout counter,
+//! on while jobs are queued, expired and the bus was recovered with
+//! I2CBusRecover(). Its callback is then called from the interrupt
+//! with its pvCBData, the status and \e psJob; it may queue a job again.
+//!
+//! The port must be initialized with I2CMasterInit(). The callback set by
+//! I2CIntCallbackInit() is not called for jobs, and I2CMasterTransfer() in
+//! interrupt mode must not be used while jobs are queued on the same port.
+//!
+//! The \e ulBase can be one of the following values:
+//! \b I2C0_BASE, \b I2C1_BASE.
+//!
+//! \note This is only for master
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+I2CMasterJobSubmit(unsigned long ulBase, tI2CMasterJob *psJob)
+{
+    tI2CJobQueue *psQueue;
+    unsigned long ulNum;
+    xtBoolean bMasked;
 
     //
-    // Save current status
-    // txrx_setup->status = returnCode;
-    // there's no relevant information
+    // Check the arguments.
     //
-    if (ucReturnCode == I2C_I2STAT_NO_INF)
+    xASSERT((ulBase == I2C0_BASE) || (ulBase == I2C1_BASE));
+    xASSERT(psJob != 0);
+
+    ulNum = I2CNumGet(ulBase);
+    psQueue = &g_sI2CJobQueue[ulNum];
+
+    psJob->sCfg.ulWCount = 0;
+    psJob->sCfg.ulRCount = 0;
+    psJob->ulStatus = I2C_JOB_PENDING;
+    psJob->psNext = 0;
+
+    bMasked = xIntMasterDisable();
+    if (psQueue->psTail != 0)
+    {
+        psQueue->psTail->psNext = psJob;
+    }
+    else
     {
+        //
+        // The bus is idle, the job starts now
+        //
+        psQueue->psHead = psJob;
+        I2CMasterStateLoad(&g_sI2CMaster[ulNum], &psJob->sCfg, psJob);
+        g_ulI2CJobToc[ulNum] = I2CTimeoutStart(ulBase);
+        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_ENS1;
         xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
-        return;
+        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_STA;
+        I2CIntEnable(ulBase);
     }
-
-
-    switch (ucReturnCode)
+    psQueue->psTail = psJob;
+    if (!bMasked)
     {
+        xIntMasterEnable();
+    }
+}
 
+//*****************************************************************************
+//
+//! \brief Get whether jobs are queued on the specified I2C port.
+//!
+//! \param ulBase specifies the I2C module base address.
+//!
+//! The \e ulBase can be one of the following values:
+//! \b I2C0_BASE, \b I2C1_BASE.
+//!
+//! \note This is only for master
+//!
+//! \return \b xtrue while a job queued by I2CMasterJobSubmit() has not
+//! ended, \b xfalse otherwise.
+//
+//*****************************************************************************
+xtBoolean
+I2CMasterJobBusy(unsigned long ulBase)
+{
     //
-    //* No status information 
+    // Check the arguments.
     //
-    case I2C_I2STAT_NO_INF:
-        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_AA;
-        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
-        break;
+    xASSERT((ulBase == I2C0_BASE) || (ulBase == I2C1_BASE));
 
+    return ((g_sI2CJobQueue[I2CNumGet(ulBase)].psHead != 0) ? xtrue : xfalse);
+}
+
+//*****************************************************************************
+//
+//! \brief Get the error of the last master transfer.
+//!
+//! \param ulBase specifies the I2C module base address.
+//!
+//! Covers polling mode I2CMasterTransfer() and the jobs of
+//! I2CMasterJobSubmit().
+//!
+//! The \e ulBase can be one of the following values:
+//! \b I2C0_BASE, \b I2C1_BASE.
+//!
+//! \note This is only for master
+//!
+//! \return \b I2C_MASTER_ERR_NONE, \b I2C_MASTER_ERR_NACK,
+//! \b I2C_MASTER_ERR_ARB_LOST, \b I2C_MASTER_ERR_BUS or
+//! \b I2C_MASTER_ERR_TIMEOUT.
+//
+//*****************************************************************************
+unsigned long
+I2CMasterErrorGet(unsigned long ulBase)
+{
     //
-    //* Reading phase 
-    //
-    //
-    //* Own SLA+R has been received, ACK has been returned 
-    //
-    case I2C_I2STAT_S_RX_SLAW_ACK:
-    //
-    //* General call address has been received, ACK has been returned 
+    // Check the arguments.
     //
-    case I2C_I2STAT_S_RX_GENCALL_ACK:
-        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_AA;
-        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
-        break;
+    xASSERT((ulBase == I2C0_BASE) || (ulBase == I2C1_BASE));
+
+    return g_ulI2CMasterError[I2CNumGet(ulBase)];
+}
+
+//*****************************************************************************
+//
+//! \brief Get the error counters of the specified I2C port.
+//!
+//! \param ulBase specifies the I2C module base address.
+//! \param psCount receives the counters.
+//!
+//! The counters add up the master transfer errors since the last
+//! I2CErrorCountClear(), and the runs of I2CBusRecover().
+//!
+//! The \e ulBase can be one of the following values:
+//! \b I2C0_BASE, \b I2C1_BASE.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+I2CErrorCountGet(unsigned long ulBase, tI2CErrorCount *psCount)
+{
+    xtBoolean bMasked;
 
     //
-    // Previously addressed with own SLA;
-    // DATA byte has been received;
-    // ACK has been returned 
+    // Check the arguments.
     //
-    case I2C_I2STAT_S_RX_PRE_SLA_DAT_ACK:
+    xASSERT((ulBase == I2C0_BASE) || (ulBase == I2C1_BASE));
+    xASSERT(psCount != 0);
+
+    bMasked = xIntMasterDisable();
+    *psCount = g_sI2CErrorCount[I2CNumGet(ulBase)];
+    if (!bMasked)
+    {
+        xIntMasterEnable();
+    }
+}
+
+//*****************************************************************************
+//
+//! \brief Clear the error counters of the specified I2C port.
+//!
+//! \param ulBase specifies the I2C module base address.
+//!
+//! The \e ulBase can be one of the following values:
+//! \b I2C0_BASE, \b I2C1_BASE.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+I2CErrorCountClear(unsigned long ulBase)
+{
+    tI2CErrorCount *psCount;
+    xtBoolean bMasked;
+
     //
-    //* DATA has been received, ACK hasn been return 
+    // Check the arguments.
     //
-    case I2C_I2STAT_S_RX_PRE_GENCALL_DAT_ACK:
-        //
-        // All data bytes that over-flow the specified receive
-        // data length, just ignore them.
-        //
-        if ((tpTxRxsetup->ulRCount < tpTxRxsetup->ulRLen) && 
-            (tpTxRxsetup->pvRBuf != 0))
-        {
-            *(unsigned char *)((unsigned long)tpTxRxsetup->pvRBuf + tpTxRxsetup->ulRCount) = 
-            (unsigned char)(xHWREG(ulBase + I2C_O_DAT));
-            tpTxRxsetup->ulRCount++;
-        }
-        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_AA;
-        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
-        break;
+    xASSERT((ulBase == I2C0_BASE) || (ulBase == I2C1_BASE));
+
+    psCount = &g_sI2CErrorCount[I2CNumGet(ulBase)];
+    bMasked = xIntMasterDisable();
+    psCount->ulNack = 0;
+    psCount->ulArbLost = 0;
+    psCount->ulBus = 0;
+    psCount->ulTimeout = 0;
+    psCount->ulRecover = 0;
+    if (!bMasked)
+    {
+        xIntMasterEnable();
+    }
+}
+
+//*****************************************************************************
+//
+//! \brief Free a hung bus and re-initialize the specified I2C port.
+//!
+//! \param ulBase specifies the I2C module base address.
+//!
+//! A slave reset or glitched in the middle of a byte can hold SDA low
+//! forever. SCL and SDA (PA.9/PA.8 for I2C0, PA.11/PA.10 for I2C1) are
+//! switched to open-drain GPIO and up to nine clock pulses are sent, until
+//! the slave releases SDA, then a STOP. The pins go back to I2C and the
+//! controller is reset, keeping its clock divider, timeout counter, own
+//! addresses and masks, and the interrupt enable.
+//!
+//! Called by I2CMasterTransfer() and the job queue when the timeout counter
+//! expires, it can also be called by the application, for instance at
+//! start-up. It must not be called while a transfer is on the bus.
+//!
+//! The \e ulBase can be one of the following values:
+//! \b I2C0_BASE, \b I2C1_BASE.
+//!
+//! \note This is only for master
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+I2CBusRecover(unsigned long ulBase)
+{
+    unsigned long ulSCL, ulSDA, ulDelay, ulCon, ulToc, ulPMD, ulDout, i;
+    unsigned long pulKeep[sizeof(g_pulI2CKeepRegs) /
+                          sizeof(g_pulI2CKeepRegs[0])];
 
     //
-    // Previously addressed with own SLA;
-    // DATA byte has been received;
-    // NOT ACK has been returned 
+    // Check the arguments.
     //
-	case I2C_I2STAT_S_RX_PRE_SLA_DAT_NACK:
+    xASSERT((ulBase == I2C0_BASE) || (ulBase == I2C1_BASE));
+
+    ulSCL = (ulBase == I2C0_BASE) ? GPIO_PIN_9 : GPIO_PIN_11;
+    ulSDA = (ulBase == I2C0_BASE) ? GPIO_PIN_8 : GPIO_PIN_10;
+
     //
-    // DATA has been received, NOT ACK has been returned 
+    // Save what the reset clears
     //
-	case I2C_I2STAT_S_RX_PRE_GENCALL_DAT_NACK:
-		xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
-		break;
+    for (i = 0; i < sizeof(pulKeep) / sizeof(pulKeep[0]); i++)
+    {
+        pulKeep[i] = xHWREG(ulBase + g_pulI2CKeepRegs[i]);
+    }
+    ulCon = xHWREG(ulBase + I2C_O_CON) & (I2C_CON_EI | I2C_CON_AA);
+    ulToc = xHWREG(ulBase + I2C_O_TOC) & (I2C_TOC_ENTI | I2C_TOC_DIV4);
 
     //
-    // Note that: Return code only let us know a stop condition mixed
-    // with a repeat start condition in the same code value.
-    // So we should provide a time-out. In case this is really a stop
-    // condition, this will return back after time out condition. Otherwise,
-    // next session that is slave receive data will be completed.
+    // Half an SCL period of the configured rate, SysCtlDelay() takes 3
+    // cycles a loop and the period is 4 * (CLK + 1) cycles.
     //
+    ulDelay = (2 * (pulKeep[0] + 1)) / 3 + 1;
 
     //
-    // A Stop or a repeat start condition 
+    // Take both lines as open-drain GPIO, released
     //
-    case I2C_I2STAT_S_RX_STA_STO_SLVREC_SLVTRX:
-        //
-        //Temporally lock the interrupt for timeout condition
-        //
-        I2CIntDisable(ulBase);
-        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
-        //
-        // enable time out
-        //
-        ulTimeout = 0x10000;
-        while(1)
-        {
-            if (xHWREG(ulBase + I2C_O_CON) & I2C_CON_SI)
-            {
-                //
-				// re-Enable interrupt
-				//
-				I2CIntEnable(ulBase);
-				break;
-            } 
-            else 
-            {
-                ulTimeout--;
-                if (ulTimeout == 0)
-                {
-                    //
-                    //timeout occur, it's really a stop condition
-                    //
-                    goto s_int_end;
-                }
-            }
-        }
-        break;
+    ulPMD = xHWREG(GPIO_PORTA_BASE + GPIO_PMD);
+    ulDout = xHWREG(GPIO_PORTA_BASE + GPIO_DOUT);
+    GPIOPinWrite(GPIO_PORTA_BASE, ulSCL | ulSDA, 1);
+    xGPIODirModeSet(GPIO_PORTA_BASE, ulSCL | ulSDA, GPIO_DIR_MODE_OD);
+    GPIOPinFunctionSet(GPIO_FUNCTION_GPIO, GPIO_PORTA_BASE, ulSCL | ulSDA);
+    SysCtlDelay(ulDelay);
 
     //
-    // Writing phase 
-    //
-    // Own SLA+R has been received, ACK has been returned 
+    // Clock the slave out of its byte, at most nine bits
     //
-	case I2C_I2STAT_S_TX_SLAR_ACK:
+    for (i = 0; (i < 9) && !GPIOPinRead(GPIO_PORTA_BASE, ulSDA); i++)
+    {
+        GPIOPinWrite(GPIO_PORTA_BASE, ulSCL, 0);
+        SysCtlDelay(ulDelay);
+        GPIOPinWrite(GPIO_PORTA_BASE, ulSCL, 1);
+        SysCtlDelay(ulDelay);
+    }
+
     //
-    // Data has been transmitted, ACK has been received 
+    // STOP: SDA rises while SCL is high
     //
-	case I2C_I2STAT_S_TX_DAT_ACK:
-        //
-        // All data bytes that over-flow the specified receive
-        // data length, just ignore them.
-        //
-        if ((tpTxRxsetup->ulWCount < tpTxRxsetup->ulWLen) &&
-            (tpTxRxsetup->pvWBuf != 0))
-        {
-            xHWREG(ulBase + I2C_O_DAT)= 
-            *(unsigned char *) ((unsigned long)tpTxRxsetup->pvWBuf + tpTxRxsetup->ulWCount);
-            tpTxRxsetup->ulWCount++;
-        }
-        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_AA;
-        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
-        break;
+    GPIOPinWrite(GPIO_PORTA_BASE, ulSCL, 0);
+    SysCtlDelay(ulDelay);
+    GPIOPinWrite(GPIO_PORTA_BASE, ulSDA, 0);
+    SysCtlDelay(ulDelay);
+    GPIOPinWrite(GPIO_PORTA_BASE, ulSCL, 1);
+    SysCtlDelay(ulDelay);
+    GPIOPinWrite(GPIO_PORTA_BASE, ulSDA, 1);
+    SysCtlDelay(ulDelay);
 
     //
-    // Data has been transmitted, NACK has been received,
-    // that means there's no more data to send, exit now 
-    //
-    // Note: Don't wait for stop event since in slave transmit mode,
-    // since there no proof lets us know when a stop signal has been received
-    // on slave side.
+    // Give the pins back to the controller and reset it
     //
-    case I2C_I2STAT_S_TX_DAT_NACK:
-        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_AA;
-        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
-        
-        goto s_int_end;
+    GPIOPinFunctionSet(GPIO_FUNCTION_I2C, GPIO_PORTA_BASE, ulSCL | ulSDA);
+    xHWREG(GPIO_PORTA_BASE + GPIO_PMD) = ulPMD;
+    xHWREG(GPIO_PORTA_BASE + GPIO_DOUT) = ulDout;
+
+    if (ulBase == I2C0_BASE)
+    {
+        SysCtlPeripheralReset(SYSCTL_PERIPH_I2C0);
+    }
+    else
+    {
+        SysCtlPeripheralReset(SYSCTL_PERIPH_I2C1);
+    }
+    for (i = 0; i < sizeof(pulKeep) / sizeof(pulKeep[0]); i++)
+    {
+        xHWREG(ulBase + g_pulI2CKeepRegs[i]) = pulKeep[i];
+    }
+    xHWREG(ulBase + I2C_O_TOC) = ulToc;
+    xHWREG(ulBase + I2C_O_CON) = I2C_CON_ENS1 | ulCon;
+
+    g_sI2CErrorCount[I2CNumGet(ulBase)].ulRecover++;
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Writes the register address of a slave, then writes or reads.
+//!
+//! \param ulBase specifies the I2C module base address.
+//! \param ulSlave is the 7-bit slave address.
+//! \param ucReg is the register address.
+//! \param pucWrite is the data written after the register address.
+//! \param ulWLen is the number of bytes to write, 0 for none.
+//! \param pucRead is the buffer read into after a repeated START.
+//! \param ulRLen is the number of bytes to read, 0 for none.
+//!
+//! START, SLA+W, register address, data; then repeated START, SLA+R and
+//! data, the last byte read is NACKed. No STOP is sent, so accesses can
+//! follow each other with repeated STARTs.
+//!
+//! \return the last I2C status: \b I2C_I2STAT_M_TX_DAT_ACK after a write,
+//! \b I2C_I2STAT_M_RX_DAT_NACK after a read, anything else is an error.
+//
+//*****************************************************************************
+static unsigned long
+I2CRegAccess(unsigned long ulBase, unsigned long ulSlave, unsigned char ucReg,
+             const unsigned char *pucWrite, unsigned long ulWLen,
+             unsigned char *pucRead, unsigned long ulRLen)
+{
+    unsigned long ulStatus;
+
+    ulStatus = I2CStartSend(ulBase);
+    if ((ulStatus != I2C_I2STAT_M_TX_START) &&
+        (ulStatus != I2C_I2STAT_M_TX_RESTART))
+    {
+        return ulStatus;
+    }
+    ulStatus = I2CByteSend(ulBase, ulSlave << 1);
+    if (ulStatus != I2C_I2STAT_M_TX_SLAW_ACK)
+    {
+        return ulStatus;
+    }
+    ulStatus = I2CByteSend(ulBase, ucReg);
+    while ((ulStatus == I2C_I2STAT_M_TX_DAT_ACK) && (ulWLen != 0))
+    {
+        ulStatus = I2CByteSend(ulBase, *pucWrite++);
+        ulWLen--;
+    }
+    if ((ulStatus != I2C_I2STAT_M_TX_DAT_ACK) || (ulRLen == 0))
+    {
+        return ulStatus;
+    }
+
+    ulStatus = I2CStartSend(ulBase);
+    if (ulStatus != I2C_I2STAT_M_TX_RESTART)
+    {
+        return ulStatus;
+    }
+    ulStatus = I2CByteSend(ulBase, (ulSlave << 1) | 0x01);
+    if (ulStatus != I2C_I2STAT_M_RX_SLAR_ACK)
+    {
+        return ulStatus;
+    }
 
-    // 
-    //Other status must be captured
     //
-    default:
-s_int_end:
-        ulTemp = I2CNumGet(ulBase);
-        if(g_tI2CSetup[ulTemp].g_pfnI2CHandlerCallbacks != 0)
+    // ACK every byte but the last one, the NACK ends the slave's data
+    //
+    while (ulRLen > 1)
+    {
+        ulStatus = I2CByteGet(ulBase, pucRead++, 1);
+        if (ulStatus != I2C_I2STAT_M_RX_DAT_ACK)
         {
-            g_tI2CSetup[ulTemp].g_pfnI2CHandlerCallbacks(0,0,0,0);
+            return ulStatus;
         }
-        //
-        //Disable interrupt
-        //
-        I2CIntDisable(ulBase);
-        xHWREG(ulBase + I2C_O_CON) &= ~I2C_CON_AA;
-        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
-        xHWREG(ulBase + I2C_O_CON) &= ~I2C_CON_STA;
-        g_ulI2CSlaveComplete[ulTemp] = xtrue;
-        break;
+        ulRLen--;
     }
+    return I2CByteGet(ulBase, pucRead, 0);
 }
 
 //*****************************************************************************
 //
-//! \brief Set the clock rate of the specified I2C port.
+//! \internal
+//! \brief Ends register accesses with a STOP and records their result.
 //!
 //! \param ulBase specifies the I2C module base address.
-//! \param ulI2CClk specifies the I2C clock rate.
+//! \param ulStatus is the last status of I2CRegAccess().
+//! \param ulToc is the timeout counter setting to restore.
 //!
-//! This function is to init and set the clock rate 
-//! specified SPI port.
+//! Errors are counted like the ones of I2CMasterTransfer(), a timeout
+//! recovers the bus.
+//!
+//! \return \b xtrue if the accesses succeeded.
+//
+//*****************************************************************************
+static xtBoolean
+I2CRegStop(unsigned long ulBase, unsigned long ulStatus, unsigned long ulToc)
+{
+    I2CStopSend(ulBase);
+    if ((ulStatus == I2C_I2STAT_M_TX_DAT_ACK) ||
+        (ulStatus == I2C_I2STAT_M_RX_DAT_NACK))
+    {
+        I2CTimeoutRestore(ulBase, ulToc);
+        g_ulI2CMasterError[I2CNumGet(ulBase)] = I2C_MASTER_ERR_NONE;
+        return xtrue;
+    }
+    if (I2CMasterErrorCount(ulBase, ulStatus) == I2C_MASTER_ERR_TIMEOUT)
+    {
+        I2CBusRecover(ulBase);
+    }
+    I2CTimeoutRestore(ulBase, ulToc);
+    return xfalse;
+}
+
+//*****************************************************************************
+//
+//! \brief Reads an 8-bit register of a slave.
+//!
+//! \param ulBase specifies the I2C module base address.
+//! \param ulSlave is the 7-bit slave address.
+//! \param ucReg is the register address.
+//! \param pucValue is where the register value is stored.
+//!
+//! START, SLA+W, register address, repeated START, SLA+R, one byte NACKed
+//! and STOP, in polling mode. On failure I2CMasterErrorGet() tells why.
 //!
 //! The \e ulBase can be one of the following values:
 //! \b I2C0_BASE, \b I2C1_BASE.
 //!
-//! The \e ulI2CClk is the I2C clock rate:
+//! \note This is only for master
+//!
+//! \return \b xtrue if the register was read, \b xfalse on error.
+//
+//*****************************************************************************
+xtBoolean
+I2CRegRead8(unsigned long ulBase, unsigned long ulSlave, unsigned char ucReg,
+            unsigned char *pucValue)
+{
+    return I2CRegReadBurst(ulBase, ulSlave, ucReg, pucValue, 1);
+}
+
+//*****************************************************************************
+//
+//! \brief Reads a 16-bit register of a slave, MSB first.
+//!
+//! \param ulBase specifies the I2C module base address.
+//! \param ulSlave is the 7-bit slave address.
+//! \param ucReg is the register address.
+//! \param pusValue is where the register value is stored.
+//!
+//! Like I2CRegRead8() with two bytes read, the first one is the MSB as
+//! for the STLM75 or AD7417 registers.
+//!
+//! The \e ulBase can be one of the following values:
+//! \b I2C0_BASE, \b I2C1_BASE.
 //!
 //! \note This is only for master
 //!
-//! \return None.
+//! \return \b xtrue if the register was read, \b xfalse on error.
 //
 //*****************************************************************************
-void 
-I2CMasterInit(unsigned long ulBase, unsigned long ulI2CClk)
+xtBoolean
+I2CRegRead16(unsigned long ulBase, unsigned long ulSlave, unsigned char ucReg,
+             unsigned short *pusValue)
 {
-    unsigned long ulHclk;
-    unsigned long ulDiv;
-    
-    //
-    // Check the arguments.
-    //
-    xASSERT((ulBase == I2C0_BASE) || (ulBase == I2C1_BASE));
-    
-    if (ulBase == I2C0_BASE)
-    {
-        SysCtlPeripheralReset(SYSCTL_PERIPH_I2C0);
-    }
-    else
+    unsigned char pucData[2];
+
+    if (!I2CRegReadBurst(ulBase, ulSlave, ucReg, pucData, 2))
     {
-        SysCtlPeripheralReset(SYSCTL_PERIPH_I2C1);
+        return xfalse;
     }
-    
-    xHWREG(ulBase + I2C_O_CON) = I2C_CON_ENS1;
-    
-    ulHclk = SysCtlHClockGet();
-    
-    ulDiv = (unsigned long) (((ulHclk * 10)/(ulI2CClk * 4) + 5) / 10 - 1);
-    xHWREG(ulBase + I2C_O_CLK) = ulDiv;
+    *pusValue = ((unsigned short)pucData[0] << 8) | pucData[1];
+    return xtrue;
+}
 
-    xHWREG(ulBase + I2C_O_CON) = 0;
-    xHWREG(ulBase + I2C_O_CON) = I2C_CON_ENS1;
+//*****************************************************************************
+//
+//! \brief Writes an 8-bit register of a slave.
+//!
+//! \param ulBase specifies the I2C module base address.
+//! \param ulSlave is the 7-bit slave address.
+//! \param ucReg is the register address.
+//! \param ucValue is the register value.
+//!
+//! START, SLA+W, register address, the value and STOP, in polling mode. On
+//! failure I2CMasterErrorGet() tells why.
+//!
+//! The \e ulBase can be one of the following values:
+//! \b I2C0_BASE, \b I2C1_BASE.
+//!
+//! \note This is only for master
+//!
+//! \return \b xtrue if the register was written, \b xfalse on error.
+//
+//*****************************************************************************
+xtBoolean
+I2CRegWrite8(unsigned long ulBase, unsigned long ulSlave, unsigned char ucReg,
+             unsigned char ucValue)
+{
+    unsigned long ulToc, ulStatus;
+
+    xASSERT((ulBase == I2C0_BASE) || (ulBase == I2C1_BASE));
+
+    ulToc = I2CTimeoutStart(ulBase);
+    ulStatus = I2CRegAccess(ulBase, ulSlave, ucReg, &ucValue, 1, 0, 0);
+    return I2CRegStop(ulBase, ulStatus, ulToc);
 }
 
 //*****************************************************************************
 //
-//! \brief Transmit and Receive data in master mode of the specified I2C port.
+//! \brief Writes a 16-bit register of a slave, MSB first.
 //!
 //! \param ulBase specifies the I2C module base address.
-//! \param tCfg specifies Pointer to a I2C_M_SETUP_Type structure that
-//!  contains specified information about the configuration for master transfer.
-//! \param ulOption specifies interrupt or polling mode.
+//! \param ulSlave is the 7-bit slave address.
+//! \param ucReg is the register address.
+//! \param usValue is the register value.
 //!
-//! This function is to Transmit and Receive data in master mode of 
-//! specified I2C port.
+//! Like I2CRegWrite8() with two bytes written, the MSB first.
+//!
+//! The \e ulBase can be one of the following values:
+//! \b I2C0_BASE, \b I2C1_BASE.
+//!
+//! \note This is only for master
+//!
+//! \return \b xtrue if the register was written, \b xfalse on error.
+//
+//*****************************************************************************
+xtBoolean
+I2CRegWrite16(unsigned long ulBase, unsigned long ulSlave, unsigned char ucReg,
+              unsigned short usValue)
+{
+    unsigned char pucData[2];
+    unsigned long ulToc, ulStatus;
+
+    xASSERT((ulBase == I2C0_BASE) || (ulBase == I2C1_BASE));
+
+    pucData[0] = (unsigned char)(usValue >> 8);
+    pucData[1] = (unsigned char)usValue;
+    ulToc = I2CTimeoutStart(ulBase);
+    ulStatus = I2CRegAccess(ulBase, ulSlave, ucReg, pucData, 2, 0, 0);
+    return I2CRegStop(ulBase, ulStatus, ulToc);
+}
+
+//*****************************************************************************
+//
+//! \brief Reads consecutive registers of a slave.
+//!
+//! \param ulBase specifies the I2C module base address.
+//! \param ulSlave is the 7-bit slave address.
+//! \param ucReg is the first register address.
+//! \param pucBuf is the buffer the bytes are read into.
+//! \param ulLen is the number of bytes to read, at least 1.
+//!
+//! START, SLA+W, register address, repeated START, SLA+R, \e ulLen bytes
+//! with the last one NACKed and STOP, in polling mode. The slave must
+//! auto-increment its register pointer. On failure I2CMasterErrorGet()
+//! tells why.
 //!
 //! The \e ulBase can be one of the following values:
 //! \b I2C0_BASE, \b I2C1_BASE.
 //!
-//! The \e tCfg is the I2C ...:
-//!
 //! \note This is only for master
-//! In case of using I2C to receive data only, either transmit length set to 0
-//! or transmit data pointer set to NULL.
-//! In case of using I2C to transmit data only, either receive length set to 0
-//! or receive data pointer set to NULL.
-//! In case of using I2C to transmit followed by receive data, transmit length,
-//! transmit data pointer, receive length and receive data pointer should be set
-//! corresponding.
 //!
-//! \return None.
+//! \return \b xtrue if the registers were read, \b xfalse on error.
 //
 //*****************************************************************************
-xtBoolean 
-I2CMasterTransfer(unsigned long ulBase, tI2CMasterTransferCfg *tCfg,
-                  unsigned long ulOption)
+xtBoolean
+I2CRegReadBurst(unsigned long ulBase, unsigned long ulSlave,
+                unsigned char ucReg, unsigned char *pucBuf,
+                unsigned long ulLen)
 {
-    unsigned char *ucptxdat;
-    unsigned char *ucprxdat;
-    unsigned long ulCodeStatus;
-    unsigned char ucTemp;
+    unsigned long ulToc, ulStatus;
 
-    //
-    // Check the arguments.
-    //
     xASSERT((ulBase == I2C0_BASE) || (ulBase == I2C1_BASE));
+    xASSERT((pucBuf != 0) && (ulLen != 0));
 
-    //
-    // Check the arguments.
-    //
-    xASSERT((ulOption == I2C_TRANSFER_POLLING) || 
-            (ulOption == I2C_TRANSFER_INTERRUPT));
-    
-    //
-	// reset all default state
-	//
-	ucptxdat = (unsigned char *) tCfg->pvWBuf;
-	ucprxdat = (unsigned char *) tCfg->pvRBuf;
-
-    //
-    // Reset I2C setup value to default state
-    //
-    tCfg->ulWCount = 0;
-    tCfg->ulRCount = 0;
-
-    if (ulOption == I2C_TRANSFER_POLLING)
-    {
-        //
-        // First Start condition 
-        //
-        //tCfg->retransmissions_count = 0;
-        
-        //
-        // reset all default state
-        //
-        ucptxdat = (unsigned char *) tCfg->pvWBuf;
-        ucprxdat = (unsigned char *) tCfg->pvRBuf;
-        
-        //
-        // Reset I2C setup value to default state
-        //
-        tCfg->ulWCount = 0;
-        tCfg->ulRCount = 0;
-        ulCodeStatus = 0;
-
-        //
-        // Start command
-        //
-        ulCodeStatus = I2CStartSend(ulBase);
-        if ((ulCodeStatus != I2C_I2STAT_M_TX_START) &&
-            (ulCodeStatus != I2C_I2STAT_M_TX_RESTART))
-        {
-            I2CStopSend(ulBase);
-            goto error;
-        }
-
-        //
-        // In case of sending data first 
-        //
-        if ((tCfg->ulWLen != 0) && (tCfg->pvWBuf != 0))
-        {
-            // 
-            // Send slave address + WR direction bit = 0 
-            //
-			ulCodeStatus = I2CByteSend(ulBase, (tCfg->ulSlave << 1));
-            if (ulCodeStatus != I2C_I2STAT_M_TX_SLAW_ACK)
-            {
-                I2CStopSend(ulBase);
-                goto error;
-            }
-
-            //
-            // Send a number of data bytes 
-            //
-            while (tCfg->ulWCount < tCfg->ulWLen)
-            {
-                ulCodeStatus = I2CByteSend(ulBase, *ucptxdat); 
-                if (ulCodeStatus != I2C_I2STAT_M_TX_DAT_ACK)
-                {
-                    I2CStopSend(ulBase);
-                    goto error;
-                }
-                ucptxdat++;
-                tCfg->ulWCount++;
-			}
-		}
-
-        //
-        // Second Start condition (Repeat Start)
-        //
-		if ((tCfg->ulWLen != 0) && (tCfg->pvWBuf != 0) &&
-            (tCfg->ulRLen != 0) && (tCfg->pvRBuf != 0))
-        {
-            ulCodeStatus = I2CStartSend(ulBase);
-            if ((ulCodeStatus != I2C_I2STAT_M_TX_START) &&
-                (ulCodeStatus != I2C_I2STAT_M_TX_RESTART))
-            {
-                I2CStopSend(ulBase);
-                goto error;
-            }
-        }
-
-        // Then, start reading after sending data
-        if ((tCfg->ulRLen != 0) && (tCfg->pvRBuf != 0))
-        {
-            //
-            // Send slave address + RD direction bit = 1 
-            //
-            ulCodeStatus = I2CByteSend(ulBase, ((tCfg->ulSlave << 1) | 0x01));
-            if (ulCodeStatus != I2C_I2STAT_M_RX_SLAR_ACK)
-            {
-                I2CStopSend(ulBase);
-                goto error;
-            }
-
-            // Receive a number of data bytes
-            while (tCfg->ulRCount < tCfg->ulRLen)
-            {
-                //
-                // Note that: if data length is only one, the master should 
-                // not issue an ACK signal on bus after reading to avoid of 
-                // next data frame on slave side
-                //
-                if (tCfg->ulRCount< (tCfg->ulRLen- 1))
-                {
-                    //
-                    // Issue an ACK signal for next data frame
-                    //
-                    ulCodeStatus = I2CByteGet(ulBase, &ucTemp, 1);
-                    if (ulCodeStatus != I2C_I2STAT_M_RX_DAT_ACK)
-                    {
-                        I2CStopSend(ulBase);
-                        goto error;
-                    }
-                } 
-                else 
-                {
-                    //
-                    // Do not issue an ACK signal
-                    //
-                    ulCodeStatus = I2CByteGet(ulBase, &ucTemp, 0);
-                    if (ulCodeStatus != I2C_I2STAT_M_RX_DAT_NACK)
-                    {
-                        I2CStopSend(ulBase);
-                        goto error;
-					}
-                }
-				*ucprxdat++ = ucTemp;
-				tCfg->ulRCount++;
-            }
-        }
-        //
-        // Send STOP condition 
-        //
-        I2CStopSend(ulBase);
-        return xtrue;
-error:
-        //
-        // Send stop condition
-        //
-        I2CStopSend(ulBase);
-        return xfalse;
-    }
-    else if (ulOption == I2C_TRANSFER_INTERRUPT)
-    {
-        //
-        // Setup tx_rx data, callback and interrupt handler
-        //
-        ucTemp = I2CNumGet(ulBase);
-        g_tI2CSetup[ucTemp].ulSetup = (unsigned long) tCfg;
-        
-        //
-        // Set direction phase, write first
-        //
-        g_tI2CSetup[ucTemp].ulDir = 0;
-
-        //
-        // First Start condition 
-        //
-        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_SI;
-        xHWREG(ulBase + I2C_O_CON) |= I2C_CON_STA;
-		I2CIntEnable(ulBase);
-
-        return (xtrue);
-	}
-
-    return xfalse;     
+    ulToc = I2CTimeoutStart(ulBase);
+    ulStatus = I2CRegAccess(ulBase, ulSlave, ucReg, 0, 0, pucBuf, ulLen);
+    return I2CRegStop(ulBase, ulStatus, ulToc);
 }
 
 //*****************************************************************************
 //
-//! \brief Get status of Master Transfer. 
+//! \brief Reads several registers of one slave in one bus transaction.
 //!
 //! \param ulBase specifies the I2C module base address.
+//! \param ulSlave is the 7-bit slave address.
+//! \param psReads is the array of reads, register address and buffer.
+//! \param ulCount is the number of reads, at least 1.
 //!
-//! This function is to get status of Master Transfer
+//! Every read is done like I2CRegReadBurst(), they follow each other with
+//! repeated STARTs and a single STOP ends the last one, so the bus is not
+//! released in between. It stops at the first read that fails; on failure
+//! I2CMasterErrorGet() tells why.
 //!
 //! The \e ulBase can be one of the following values:
 //! \b I2C0_BASE, \b I2C1_BASE.
 //!
 //! \note This is only for master
 //!
-//! \return Master transfer status, could be:\b xtrue	master transfer 
-//! completed, \b xfalse master transfer have not completed yet
+//! \return \b xtrue if all the registers were read, \b xfalse on error.
 //
 //*****************************************************************************
 xtBoolean
-I2CMasterTransferComplete(unsigned long ulBase)
+I2CRegReadBatch(unsigned long ulBase, unsigned long ulSlave,
+                const tI2CRegRead *psReads, unsigned long ulCount)
 {
-	unsigned long ulRetval, ulTemp;
-	ulTemp = I2CNumGet(ulBase);
-	ulRetval = g_ulI2CMasterComplete[ulTemp];
-	g_ulI2CMasterComplete[ulTemp] = xfalse;
-	return ulRetval;
+    unsigned long ulToc, ulStatus, i;
+
+    xASSERT((ulBase == I2C0_BASE) || (ulBase == I2C1_BASE));
+    xASSERT((psReads != 0) && (ulCount != 0));
+
+    ulToc = I2CTimeoutStart(ulBase);
+    ulStatus = I2C_I2STAT_M_RX_DAT_NACK;
+    for (i = 0; (i < ulCount) && (ulStatus == I2C_I2STAT_M_RX_DAT_NACK); i++)
+    {
+        xASSERT((psReads[i].pucBuf != 0) && (psReads[i].ulLen != 0));
+        ulStatus = I2CRegAccess(ulBase, ulSlave, psReads[i].ucReg, 0, 0,
+                                psReads[i].pucBuf, psReads[i].ulLen);
+    }
+    return I2CRegStop(ulBase, ulStatus, ulToc);
 }
 
 
@@ -1599,6 +2863,104 @@ I2CSlaveOwnAddressSet(unsigned long ulBase, unsigned char ucSlaveNum,
                                             ulGeneralCall);
 }
 
+//*****************************************************************************
+//
+//! \brief Serve a register map on an own address of the specified I2C port.
+//!
+//! \param ulBase specifies the I2C module base address.
+//! \param ucSlaveNum specifies the own address slot, 0 to 3.
+//! \param psMap is the register map, or 0 to stop serving the slot.
+//!
+//! A master reads and writes \e psMap->pucRegs like the registers of a
+//! sensor: a write starts with the register pointer, then the registers
+//! from there on; a read returns the registers from the pointer. The
+//! pointer auto-increments, wraps after the last register and is kept
+//! between transactions. Each written byte only changes the bits set in
+//! \e psMap->pucWriteMask for its register.
+//!
+//! Everything is served by I2C0IntHandler()/I2C1IntHandler(), no call is
+//! needed between transactions. After a write, at the STOP or repeated
+//! START, the callback of the map is called from the interrupt with its
+//! pvCBData, the first register written, the number of registers written
+//! and \e psMap. The application should mask the I2C interrupt while it
+//! reads or writes several registers that must stay consistent.
+//!
+//! The own address of the slot must be set first with I2CSlaveInit() or
+//! I2CSlaveOwnAddressSet() (and I2CSlaveOwnAddressMaskSet()); the maps of
+//! several slots make several devices on one port. This enables the I2C
+//! interrupt and the address acknowledge. The port can still queue master
+//! jobs with I2CMasterJobSubmit().
+//!
+//! The \e ulBase can be one of the following values:
+//! \b I2C0_BASE, \b I2C1_BASE.
+//!
+//! \note this is only for slave
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+I2CSlaveRegMapSet(unsigned long ulBase, unsigned char ucSlaveNum,
+                  tI2CSlaveRegMap *psMap)
+{
+    tI2CRegSlave *psSlave;
+    unsigned long ulNum, i;
+    xtBoolean bMasked, bServe;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT((ulBase == I2C0_BASE) || (ulBase == I2C1_BASE));
+    xASSERT(ucSlaveNum < 4);
+    xASSERT((psMap == 0) ||
+            ((psMap->pucRegs != 0) && (psMap->ulCount != 0)));
+
+    ulNum = I2CNumGet(ulBase);
+    psSlave = &g_sI2CRegSlave[ulNum];
+    if (psMap != 0)
+    {
+        psMap->ulPointer = 0;
+    }
+
+    bMasked = xIntMasterDisable();
+    if (psSlave->psActive == psSlave->psMap[ucSlaveNum])
+    {
+        psSlave->psActive = 0;
+    }
+    psSlave->psMap[ucSlaveNum] = psMap;
+
+    bServe = xfalse;
+    for (i = 0; i < 4; i++)
+    {
+        if (psSlave->psMap[i] != 0)
+        {
+            bServe = xtrue;
+        }
+    }
+
+    //
+    // SI is written 0 to leave a pending event alone
+    //
+    if (bServe)
+    {
+        g_psI2CRegSlave[ulNum] = psSlave;
+        xHWREG(ulBase + I2C_O_CON) = (xHWREG(ulBase + I2C_O_CON) &
+                                      ~(I2C_CON_SI | I2C_CON_STA |
+                                        I2C_CON_STO)) |
+                                     I2C_CON_ENS1 | I2C_CON_AA;
+        I2CIntEnable(ulBase);
+    }
+    else
+    {
+        g_psI2CRegSlave[ulNum] = 0;
+        xHWREG(ulBase + I2C_O_CON) &= ~(I2C_CON_SI | I2C_CON_AA);
+    }
+    if (!bMasked)
+    {
+        xIntMasterEnable();
+    }
+}
+
 //*****************************************************************************
 //
 //! \brief Set 4 7-bit slave address mask of the specified I2C port.
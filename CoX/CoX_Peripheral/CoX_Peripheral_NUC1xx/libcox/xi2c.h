@@ -1270,6 +1270,85 @@ extern "C"
 //
 //*****************************************************************************
 
+//*****************************************************************************
+//
+//! \addtogroup NUC1xx_I2C_Job NUC1xx I2C Job
+//! \brief Status of the I2C master jobs, see I2CMasterJobSubmit().
+//! @{
+//
+//*****************************************************************************
+
+//
+//! The job has ended, all bytes were sent and received
+//
+#define I2C_JOB_DONE            0x00000000
+
+//
+//! The job is queued or on the bus
+//
+#define I2C_JOB_PENDING         0x00000001
+
+//
+//! The slave did not acknowledge its address or a data byte
+//
+#define I2C_JOB_NACK            0x00000002
+
+//
+//! Arbitration was lost or the bus was in an unexpected state
+//
+#define I2C_JOB_ERROR           0x00000003
+
+//
+//! The bus hung, it was recovered with I2CBusRecover()
+//
+#define I2C_JOB_TIMEOUT         0x00000004
+
+//*****************************************************************************
+//
+//! @}
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! \addtogroup NUC1xx_I2C_Master_Error NUC1xx I2C Master Error
+//! \brief Errors of the master transfers, see I2CMasterErrorGet().
+//! @{
+//
+//*****************************************************************************
+
+//
+//! The last transfer succeeded
+//
+#define I2C_MASTER_ERR_NONE     0x00000000
+
+//
+//! The slave did not acknowledge its address or a data byte
+//
+#define I2C_MASTER_ERR_NACK     0x00000001
+
+//
+//! Arbitration was lost to another master
+//
+#define I2C_MASTER_ERR_ARB_LOST 0x00000002
+
+//
+//! The controller reported a bus error or an unexpected status
+//
+#define I2C_MASTER_ERR_BUS      0x00000003
+
+//
+//! The controller did not finish a step before the timeout counter expired,
+//! the bus was recovered with I2CBusRecover()
+//
+#define I2C_MASTER_ERR_TIMEOUT  0x00000004
+
+//*****************************************************************************
+//
+//! @}
+//
+//*****************************************************************************
+
 //*****************************************************************************
 //
 //! \addtogroup NUC1xx_I2C_Exported_Types NUC1xx I2C Exported Types
@@ -1385,6 +1464,139 @@ typedef struct
 } 
 tI2CConfig;
 
+//*****************************************************************************
+//
+//! I2C master job, one transfer queued on a bus, see I2CMasterJobSubmit()
+//
+//*****************************************************************************
+typedef struct tI2CMasterJob
+{
+    //
+    //! Transfer of the job, the counts are reset when it is queued
+    //
+    tI2CMasterTransferCfg sCfg;
+
+    //
+    //! Called from the I2C interrupt when the job ends, 0 for none
+    //
+    xtEventCallback pfnCallback;
+
+    //
+    //! Passed to pfnCallback
+    //
+    void *pvCBData;
+
+    //
+    //! Status, I2C_JOB_PENDING until the job ends
+    //
+    volatile unsigned long ulStatus;
+
+    //
+    //! Next job in the queue, used by the driver
+    //
+    struct tI2CMasterJob *psNext;
+}
+tI2CMasterJob;
+
+//*****************************************************************************
+//
+//! Error counters of one I2C bus, see I2CErrorCountGet()
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! Transfers not acknowledged by the slave
+    //
+    unsigned long ulNack;
+
+    //
+    //! Transfers that lost the arbitration
+    //
+    unsigned long ulArbLost;
+
+    //
+    //! Bus errors and unexpected status
+    //
+    unsigned long ulBus;
+
+    //
+    //! Expiries of the timeout counter
+    //
+    unsigned long ulTimeout;
+
+    //
+    //! Runs of the bus recovery sequence
+    //
+    unsigned long ulRecover;
+}
+tI2CErrorCount;
+
+//*****************************************************************************
+//
+//! I2C slave register map, served from the interrupt, see I2CSlaveRegMapSet()
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! Register values, owned by the caller
+    //
+    unsigned char *pucRegs;
+
+    //
+    //! Bits of each register the master may write, 0 for a read-only
+    //! register; 0 when every bit is writable
+    //
+    const unsigned char *pucWriteMask;
+
+    //
+    //! Number of registers
+    //
+    unsigned long ulCount;
+
+    //
+    //! Called from the I2C interrupt after the master wrote registers, 0 for
+    //! none
+    //
+    xtEventCallback pfnCallback;
+
+    //
+    //! Passed to pfnCallback
+    //
+    void *pvCBData;
+
+    //
+    //! Register pointer, used by the driver
+    //
+    unsigned long ulPointer;
+}
+tI2CSlaveRegMap;
+
+//*****************************************************************************
+//
+//! One register read of I2CRegReadBatch()
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! First register address
+    //
+    unsigned char ucReg;
+
+    //
+    //! Buffer the bytes are read into
+    //
+    unsigned char *pucBuf;
+
+    //
+    //! Number of bytes to read, at least 1
+    //
+    unsigned long ulLen;
+}
+tI2CRegRead;
+
 
 //*****************************************************************************
 //
@@ -1409,6 +1621,28 @@ extern xtBoolean I2CSlaveTransfer(unsigned long ulBase,
                                    tI2CSlaveTransferCfg *tCfg,
                                    unsigned long ulOption);
 
+extern void I2CMasterJobSubmit(unsigned long ulBase, tI2CMasterJob *psJob);
+extern xtBoolean I2CMasterJobBusy(unsigned long ulBase);
+extern unsigned long I2CMasterErrorGet(unsigned long ulBase);
+extern void I2CErrorCountGet(unsigned long ulBase, tI2CErrorCount *psCount);
+extern void I2CErrorCountClear(unsigned long ulBase);
+extern void I2CBusRecover(unsigned long ulBase);
+
+extern xtBoolean I2CRegRead8(unsigned long ulBase, unsigned long ulSlave,
+                             unsigned char ucReg, unsigned char *pucValue);
+extern xtBoolean I2CRegRead16(unsigned long ulBase, unsigned long ulSlave,
+                              unsigned char ucReg, unsigned short *pusValue);
+extern xtBoolean I2CRegWrite8(unsigned long ulBase, unsigned long ulSlave,
+                              unsigned char ucReg, unsigned char ucValue);
+extern xtBoolean I2CRegWrite16(unsigned long ulBase, unsigned long ulSlave,
+                               unsigned char ucReg, unsigned short usValue);
+extern xtBoolean I2CRegReadBurst(unsigned long ulBase, unsigned long ulSlave,
+                                 unsigned char ucReg, unsigned char *pucBuf,
+                                 unsigned long ulLen);
+extern xtBoolean I2CRegReadBatch(unsigned long ulBase, unsigned long ulSlave,
+                                 const tI2CRegRead *psReads,
+                                 unsigned long ulCount);
+
 extern xtBoolean I2CMasterTransferComplete(unsigned long ulBase);
 extern xtBoolean I2CSlaveTransferComplete(unsigned long ulBase);
 
@@ -1433,6 +1667,8 @@ extern void I2CSlaveOwnAddressSet(unsigned long ulBase,
 extern void I2CSlaveOwnAddressMaskSet(unsigned long ulBase,
                                       unsigned char ucSlaveNum,
                                       unsigned char ucSlaveAddrMask);
+extern void I2CSlaveRegMapSet(unsigned long ulBase, unsigned char ucSlaveNum,
+                              tI2CSlaveRegMap *psMap);
 extern void I2CIntFlagClear(unsigned long ulBase);
 extern void I2CTimeoutFlagClear(unsigned long ulBase);
 extern void I2CTimeoutCounterSet(unsigned long ulBase, unsigned long ulEnable,
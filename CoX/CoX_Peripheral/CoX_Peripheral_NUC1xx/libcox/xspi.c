@@ -42,8 +42,12 @@
 #include "xhw_nvic.h"
 #include "xhw_sysctl.h"
 #include "xhw_spi.h"
+#include "xhw_dma.h"
 #include "xdebug.h"
+#include "xcore.h"
 #include "xsysctl.h"
+#include "xgpio.h"
+#include "xdma.h"
 #include "xspi.h"
 
 //*****************************************************************************
@@ -53,6 +57,425 @@
 //*****************************************************************************
 static xtEventCallback g_pfnSPIHandlerCallbacks[4]={0};
 
+//*****************************************************************************
+//
+// Job engine of one SPI port.
+//
+// psHead is the job on the bus, the rest of the queue follows psNext. One
+// frame is in flight at a time and every transfer done interrupt reads it
+// back and starts the next one, so the engine does not depend on the FIFO
+// of the NUC1x0xxxCx parts. ulCSPort/ulCSPin is the chip select held low,
+// ulCSPort is 0 when none is.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // Job queue.
+    //
+    tSPIJob *psHead;
+    tSPIJob *psTail;
+
+    //
+    // Descriptor on the bus, frames of it done, and frame size in bytes.
+    //
+    unsigned long ulDesc;
+    unsigned long ulCount;
+    unsigned long ulSize;
+
+    //
+    // Asserted chip select.
+    //
+    unsigned long ulCSPort;
+    unsigned long ulCSPin;
+
+    //
+    // A frame is on the bus.
+    //
+    xtBoolean bBusy;
+}
+tSPIJobEngine;
+
+//*****************************************************************************
+//
+// An array is SPI job engine point, 0 when the engine is not running.
+//
+//*****************************************************************************
+static tSPIJobEngine g_sSPIJob[4];
+static tSPIJobEngine *g_psSPIJob[4]={0};
+
+//*****************************************************************************
+//
+// PDMA transfer of one SPI port.
+//
+// The Rx channel always runs, into a fixed sink when the caller has no Rx
+// buffer, so its transfer done interrupt marks the end of the transfer.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // PDMA channels claimed for the transfer.
+    //
+    unsigned long ulRxChannel;
+    unsigned long ulTxChannel;
+
+    //
+    // Frames of the transfer and the caller's Rx buffer.
+    //
+    unsigned long ulLength;
+    void *pvRxBuf;
+
+    //
+    // Completion callback.
+    //
+    xtEventCallback pfnCallback;
+
+    //
+    // A transfer is in progress.
+    //
+    volatile xtBoolean bBusy;
+}
+tSPIDMAXfer;
+
+static tSPIDMAXfer g_sSPIDMAXfer[4];
+
+//
+// Base address of each SPI port by index.
+//
+static const unsigned long g_ulSPIBase[4] =
+{
+    SPI0_BASE, SPI1_BASE, SPI2_BASE, SPI3_BASE
+};
+
+//
+// Fill source of transfers without Tx data, and sink of the ones without
+// Rx buffer. Kept in SRAM for the PDMA.
+//
+static unsigned long g_ulSPIDMAFill = 0xFFFFFFFF;
+static unsigned long g_ulSPIDMASink;
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Gets the index of a SPI port.
+//!
+//! \param ulBase specifies the SPI module base address.
+//!
+//! \return Returns 0, 1, 2 or 3 for SPI0, SPI1, SPI2 or SPI3.
+//
+//*****************************************************************************
+static unsigned long
+SPIIndexGet(unsigned long ulBase)
+{
+    if (ulBase == SPI0_BASE)
+    {
+        return 0;
+    }
+    else if (ulBase == SPI1_BASE)
+    {
+        return 1;
+    }
+    else if (ulBase == SPI2_BASE)
+    {
+        return 2;
+    }
+    else
+    {
+        return 3;
+    }
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Gets the size of a buffer element of a SPI port.
+//!
+//! \param ulBase specifies the SPI module base address.
+//!
+//! \return Returns 1, 2 or 4 for frames of up to 8, up to 16 or more bits.
+//
+//*****************************************************************************
+static unsigned long
+SPIFrameSizeGet(unsigned long ulBase)
+{
+    unsigned char ucBitLength = SPIBitLengthGet(ulBase);
+
+    //
+    // A bit length of 0 means 32 bits.
+    //
+    if(ucBitLength != 0 && ucBitLength <= 8)
+    {
+        return 1;
+    }
+    else if(ucBitLength != 0 && ucBitLength <= 16)
+    {
+        return 2;
+    }
+    else
+    {
+        return 4;
+    }
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Moves the chip select of a SPI job engine.
+//!
+//! \param psEngine is the job engine.
+//! \param psDesc is the descriptor about to run, or 0 to release the bus.
+//!
+//! The asserted chip select is kept when \e psDesc uses the same one, so
+//! consecutive descriptors of a job form one transaction on the device.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+SPIJobCSSet(tSPIJobEngine *psEngine, const tSPIJobDesc *psDesc)
+{
+    if((psDesc != 0) && (psDesc->ulCSPort == psEngine->ulCSPort) &&
+       (psDesc->ulCSPin == psEngine->ulCSPin))
+    {
+        return;
+    }
+
+    if(psEngine->ulCSPort != 0)
+    {
+        GPIOPinWrite(psEngine->ulCSPort, psEngine->ulCSPin, 1);
+        psEngine->ulCSPort = 0;
+    }
+
+    if((psDesc != 0) && (psDesc->ulCSPort != 0))
+    {
+        psEngine->ulCSPort = psDesc->ulCSPort;
+        psEngine->ulCSPin = psDesc->ulCSPin;
+        GPIOPinWrite(psEngine->ulCSPort, psEngine->ulCSPin, 0);
+    }
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Starts the next frame of a SPI job engine.
+//!
+//! \param ulBase specifies the SPI module base address.
+//! \param psEngine is the job engine.
+//!
+//! Skips the descriptors without frames, calling their callbacks, and ends
+//! the job after its last descriptor. Then the next job of the queue, if
+//! any, is started. Does nothing while a frame is on the bus.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+SPIJobNext(unsigned long ulBase, tSPIJobEngine *psEngine)
+{
+    tSPIJob *psJob;
+    tSPIJobDesc *psDesc;
+    unsigned long ulData, ulEvent;
+
+    while((psEngine->psHead != 0) && !psEngine->bBusy)
+    {
+        psJob = psEngine->psHead;
+        psDesc = &psJob->psDesc[psEngine->ulDesc];
+
+        if(psEngine->ulCount < psDesc->ulLength)
+        {
+            if(psEngine->ulCount == 0)
+            {
+                psEngine->ulSize = SPIFrameSizeGet(ulBase);
+                SPIJobCSSet(psEngine, psDesc);
+            }
+
+            if(psDesc->pvTxBuf == 0)
+            {
+                ulData = 0xFFFFFFFF;
+            }
+            else if(psEngine->ulSize == 1)
+            {
+                ulData = ((const unsigned char *)psDesc->pvTxBuf)
+                         [psEngine->ulCount];
+            }
+            else if(psEngine->ulSize == 2)
+            {
+                ulData = ((const unsigned short *)psDesc->pvTxBuf)
+                         [psEngine->ulCount];
+            }
+            else
+            {
+                ulData = ((const unsigned long *)psDesc->pvTxBuf)
+                         [psEngine->ulCount];
+            }
+            psEngine->bBusy = xtrue;
+            xHWREG(ulBase + SPI_TX0) = ulData;
+            xHWREG(ulBase + SPI_CNTRL) |= SPI_CNTRL_GO_BUSY;
+            return;
+        }
+
+        //
+        // The descriptor is done. The chip select is released before the
+        // callback of the last one, so it can queue the next job.
+        //
+        ulEvent = SPI_JOB_EVENT_DESC;
+        psEngine->ulDesc++;
+        psEngine->ulCount = 0;
+        if(psEngine->ulDesc >= psJob->ulDescCount)
+        {
+            ulEvent |= SPI_JOB_EVENT_DONE;
+            SPIJobCSSet(psEngine, 0);
+            psEngine->psHead = psJob->psNext;
+            if(psEngine->psHead == 0)
+            {
+                psEngine->psTail = 0;
+            }
+            psEngine->ulDesc = 0;
+            psJob->ulStatus = SPI_JOB_DONE;
+        }
+
+        if(psDesc->pfnCallback != 0)
+        {
+            psDesc->pfnCallback(psDesc->pvCBData, ulEvent,
+                                (unsigned long)(psDesc - psJob->psDesc),
+                                psJob);
+        }
+    }
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Services the transfer done interrupt of a SPI job engine.
+//!
+//! \param ulBase specifies the SPI module base address.
+//! \param psEngine is the job engine.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+SPIJobIntService(unsigned long ulBase, tSPIJobEngine *psEngine)
+{
+    tSPIJobDesc *psDesc;
+    unsigned long ulData;
+
+    if(!psEngine->bBusy)
+    {
+        return;
+    }
+    psEngine->bBusy = xfalse;
+
+    psDesc = &psEngine->psHead->psDesc[psEngine->ulDesc];
+    ulData = xHWREG(ulBase + SPI_RX0);
+    if(psDesc->pvRxBuf != 0)
+    {
+        if(psEngine->ulSize == 1)
+        {
+            ((unsigned char *)psDesc->pvRxBuf)[psEngine->ulCount] = ulData;
+        }
+        else if(psEngine->ulSize == 2)
+        {
+            ((unsigned short *)psDesc->pvRxBuf)[psEngine->ulCount] = ulData;
+        }
+        else
+        {
+            ((unsigned long *)psDesc->pvRxBuf)[psEngine->ulCount] = ulData;
+        }
+    }
+    psEngine->ulCount++;
+
+    SPIJobNext(ulBase, psEngine);
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Gives the PDMA channels of a SPI transfer back.
+//!
+//! \param psXfer is the transfer.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+SPIDMARelease(tSPIDMAXfer *psXfer)
+{
+    PDMAChannelIntDisable(psXfer->ulRxChannel,
+                          PDMA_EVENT_TC | PDMA_EVENT_ERROR);
+    PDMAChannelIntDisable(psXfer->ulTxChannel, PDMA_EVENT_ERROR);
+    PDMAChannelIntCallbackInit(psXfer->ulRxChannel, 0);
+    PDMAChannelIntCallbackInit(psXfer->ulTxChannel, 0);
+    PDMAChannelSoftwareReset(psXfer->ulRxChannel);
+    PDMAChannelSoftwareReset(psXfer->ulTxChannel);
+    PDMADisable(psXfer->ulRxChannel);
+    PDMADisable(psXfer->ulTxChannel);
+    PDMAChannelDeAssign(psXfer->ulRxChannel);
+    PDMAChannelDeAssign(psXfer->ulTxChannel);
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief PDMA channel callback of the SPI transfers.
+//!
+//! \param pvCBData is the tSPIDMAXfer of the port.
+//! \param ulMsgParam is the PDMA event.
+//!
+//! The transfer ends when the Rx channel is done, the Tx channel only has
+//! the error interrupt enabled. Both channels are released before the
+//! callback, so it can start the next transfer.
+//!
+//! \return Always 0.
+//
+//*****************************************************************************
+static unsigned long
+SPIDMACallback(void *pvCBData, unsigned long ulEvent,
+               unsigned long ulMsgParam, void *pvMsgData)
+{
+    tSPIDMAXfer *psXfer;
+    unsigned long ulBase;
+
+    psXfer = (tSPIDMAXfer *)pvCBData;
+    if(!psXfer->bBusy)
+    {
+        return 0;
+    }
+    ulBase = g_ulSPIBase[psXfer - g_sSPIDMAXfer];
+
+    if(ulMsgParam & PDMA_EVENT_ERROR)
+    {
+        xHWREG(ulBase + SPI_DMACTL) &= ~(SPI_DMACTL_RX_DMA_GO |
+                                         SPI_DMACTL_TX_DMA_GO);
+        ulEvent = SPI_DMA_EVENT_ERROR;
+    }
+    else
+    {
+        ulEvent = SPI_DMA_EVENT_DONE;
+    }
+
+    SPIDMARelease(psXfer);
+    psXfer->bBusy = xfalse;
+
+    if(psXfer->pfnCallback != 0)
+    {
+        psXfer->pfnCallback(0, ulEvent, psXfer->ulLength, psXfer->pvRxBuf);
+    }
+    return 0;
+}
+
+//
+// PDMA requests of the SPI ports, Rx then Tx.
+//
+static const unsigned long g_ulSPIDMARequest[4][2] =
+{
+    {xDMA_REQUEST_SPI0_RX, xDMA_REQUEST_SPI0_TX},
+    {xDMA_REQUEST_SPI1_RX, xDMA_REQUEST_SPI1_TX},
+    {xDMA_REQUEST_SPI2_RX, xDMA_REQUEST_SPI2_TX},
+    {xDMA_REQUEST_SPI3_RX, xDMA_REQUEST_SPI3_TX},
+};
+
 //*****************************************************************************
 //
 //! \brief SPI0 interrupt handler. Clear the SPI interrupt flag and execute the 
@@ -89,6 +512,13 @@ SPI0IntHandler(void)
     xHWREG(ulBase + SPI_CNTRL) |= SPI_CNTRL_IF;
     xHWREG(ulBase + SPI_CNTRL2) |= SPI_CNTRL2_SLV_START_INTSTS;
     
+    //
+    // Run the job engine
+    //
+    if(g_psSPIJob[0] && (ulEventFlags & SPI_CNTRL_IF))
+    {
+        SPIJobIntService(ulBase, g_psSPIJob[0]);
+    }
     
     //
     // Call Callback function
@@ -136,6 +566,13 @@ SPI1IntHandler(void)
     xHWREG(ulBase + SPI_CNTRL) |= SPI_CNTRL_IF;
     xHWREG(ulBase + SPI_CNTRL2) |= SPI_CNTRL2_SLV_START_INTSTS;
     
+    //
+    // Run the job engine
+    //
+    if(g_psSPIJob[1] && (ulEventFlags & SPI_CNTRL_IF))
+    {
+        SPIJobIntService(ulBase, g_psSPIJob[1]);
+    }
     
     //
     // Call Callback function
@@ -182,6 +619,13 @@ SPI2IntHandler(void)
     xHWREG(ulBase + SPI_CNTRL) |= SPI_CNTRL_IF;
     xHWREG(ulBase + SPI_CNTRL2) |= SPI_CNTRL2_SLV_START_INTSTS;
     
+    //
+    // Run the job engine
+    //
+    if(g_psSPIJob[2] && (ulEventFlags & SPI_CNTRL_IF))
+    {
+        SPIJobIntService(ulBase, g_psSPIJob[2]);
+    }
     
     //
     // Call Callback function
@@ -228,6 +672,13 @@ SPI3IntHandler(void)
     xHWREG(ulBase + SPI_CNTRL) |= SPI_CNTRL_IF;
     xHWREG(ulBase + SPI_CNTRL2) |= SPI_CNTRL2_SLV_START_INTSTS;
     
+    //
+    // Run the job engine
+    //
+    if(g_psSPIJob[3] && (ulEventFlags & SPI_CNTRL_IF))
+    {
+        SPIJobIntService(ulBase, g_psSPIJob[3]);
+    }
     
     //
     // Call Callback function
@@ -1376,6 +1827,112 @@ SPIFIFOModeSet(unsigned long ulBase, xtBoolean xtEnable,
     }  
 }
 
+//*****************************************************************************
+//
+//! \brief Full-duplex block transfer through the SPI FIFO.
+//!
+//! \param ulBase specifies the SPI module base address.
+//! \param pvTxData is the data to send, or 0 to clock out 0xFF fill.
+//! \param pvRxData receives the data read back, or 0 to discard it.
+//! \param ulLength is the number of frames to transfer.
+//!
+//! This function switches the port into FIFO mode, keeps the Tx FIFO topped
+//! up and drains the Rx FIFO in the same loop, so SCLK runs back to back
+//! instead of stopping for every frame as SPIDataWrite() does. At most
+//! \b SPI_FIFO_DEPTH frames are in flight, so the Rx FIFO never overflows.
+//! The previous FIFO mode setting is restored on return; the gap between
+//! frames is whatever SPIFIFOModeSet() programmed (0 after reset).
+//!
+//! Each buffer element is an unsigned char, unsigned short or unsigned long
+//! depending on SPIBitLengthGet(), the same as SPIDataRead().
+//!
+//! \note Only the chips with the part number NUC1x0xxxCx, ex: NUC140VE3CN, 
+//! can support this function.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+SPITransfer(unsigned long ulBase, const void *pvTxData, void *pvRxData,
+            unsigned long ulLength)
+{
+    unsigned long ulTxCount, ulRxCount, ulData, ulFIFOMode, ulSize;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT((ulBase == SPI0_BASE) || (ulBase == SPI1_BASE)||
+            (ulBase == SPI2_BASE) || (ulBase == SPI3_BASE));
+
+    ulSize = SPIFrameSizeGet(ulBase);
+
+    ulFIFOMode = xHWREG(ulBase + SPI_CNTRL) & SPI_CNTRL_FIFO;
+    xHWREG(ulBase + SPI_CNTRL) |= SPI_CNTRL_FIFO;
+    xHWREG(ulBase + SPI_FIFOCTL) |= (SPI_FIFOCTL_RX_CLR | SPI_FIFOCTL_TX_CLR);
+
+    ulTxCount = 0;
+    ulRxCount = 0;
+    while(ulRxCount < ulLength)
+    {
+        //
+        // Top up the Tx FIFO, never running more than the Rx FIFO can hold
+        // ahead of the reader.
+        //
+        while((ulTxCount < ulLength) &&
+              ((ulTxCount - ulRxCount) < SPI_FIFO_DEPTH) &&
+              !(xHWREG(ulBase + SPI_CNTRL) & SPI_CNTRL_TX_FULL))
+        {
+            if(pvTxData == 0)
+            {
+                ulData = 0xFFFFFFFF;
+            }
+            else if(ulSize == 1)
+            {
+                ulData = ((const unsigned char *)pvTxData)[ulTxCount];
+            }
+            else if(ulSize == 2)
+            {
+                ulData = ((const unsigned short *)pvTxData)[ulTxCount];
+            }
+            else
+            {
+                ulData = ((const unsigned long *)pvTxData)[ulTxCount];
+            }
+            xHWREG(ulBase + SPI_TX0) = ulData;
+            ulTxCount++;
+        }
+
+        //
+        // Drain whatever has been clocked in so far.
+        //
+        while(!(xHWREG(ulBase + SPI_CNTRL) & SPI_CNTRL_RX_EMPTY))
+        {
+            ulData = xHWREG(ulBase + SPI_RX0);
+            if(pvRxData != 0)
+            {
+                if(ulSize == 1)
+                {
+                    ((unsigned char *)pvRxData)[ulRxCount] = ulData;
+                }
+                else if(ulSize == 2)
+                {
+                    ((unsigned short *)pvRxData)[ulRxCount] = ulData;
+                }
+                else
+                {
+                    ((unsigned long *)pvRxData)[ulRxCount] = ulData;
+                }
+            }
+            ulRxCount++;
+        }
+    }
+
+    if(!ulFIFOMode)
+    {
+        xHWREG(ulBase + SPI_CNTRL) &= ~SPI_CNTRL_FIFO;
+    }
+}
+
 //*****************************************************************************
 //
 //! \brief Enable/disable Byte Reorder function.
@@ -1753,3 +2310,316 @@ SPI3PDMADisable(unsigned long ulBase, unsigned long ulDmaMode)
     xHWREG(ulBase + SPI_DMACTL) &= ~ulDmaMode;
 }
 
+
+//*****************************************************************************
+//
+//! \brief Starts the job engine of the specified SPI port.
+//!
+//! \param ulBase specifies the SPI module base address.
+//!
+//! The port must be configured as master with SPIConfig(). The engine moves
+//! one frame per transfer done interrupt, so FIFO and burst mode are turned
+//! off and the SPI interrupt is enabled; the caller enables \b xINT_SPIn in
+//! the NVIC. The chip select pins of the jobs must be GPIO outputs, driven
+//! high while idle.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+SPIJobInit(unsigned long ulBase)
+{
+    tSPIJobEngine *psEngine;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT((ulBase == SPI0_BASE) || (ulBase == SPI1_BASE)||
+            (ulBase == SPI2_BASE) || (ulBase == SPI3_BASE));
+
+    psEngine = &g_sSPIJob[SPIIndexGet(ulBase)];
+    psEngine->psHead = 0;
+    psEngine->psTail = 0;
+    psEngine->ulDesc = 0;
+    psEngine->ulCount = 0;
+    psEngine->ulCSPort = 0;
+    psEngine->bBusy = xfalse;
+
+    xHWREG(ulBase + SPI_CNTRL) &= ~(SPI_CNTRL_FIFO | SPI_CNTRL_TX_NUM_M);
+    xHWREG(ulBase + SPI_CNTRL) |= SPI_CNTRL_IF | SPI_CNTRL_IE;
+    g_psSPIJob[SPIIndexGet(ulBase)] = psEngine;
+}
+
+//*****************************************************************************
+//
+//! \brief Stops the job engine of the specified SPI port.
+//!
+//! \param ulBase specifies the SPI module base address.
+//!
+//! Disables the SPI interrupt and releases the chip select. The jobs still
+//! queued end with \b SPI_JOB_ABORTED, their callbacks are not called.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+SPIJobDisable(unsigned long ulBase)
+{
+    tSPIJobEngine *psEngine;
+    tSPIJob *psJob;
+    xtBoolean bMasked;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT((ulBase == SPI0_BASE) || (ulBase == SPI1_BASE)||
+            (ulBase == SPI2_BASE) || (ulBase == SPI3_BASE));
+
+    psEngine = g_psSPIJob[SPIIndexGet(ulBase)];
+    if(psEngine == 0)
+    {
+        return;
+    }
+
+    bMasked = xIntMasterDisable();
+    xHWREG(ulBase + SPI_CNTRL) &= ~SPI_CNTRL_IE;
+    g_psSPIJob[SPIIndexGet(ulBase)] = 0;
+    if(!bMasked)
+    {
+        xIntMasterEnable();
+    }
+
+    //
+    // Let a frame on the bus finish before the chip select goes up.
+    //
+    while(xHWREG(ulBase + SPI_CNTRL) & SPI_CNTRL_GO_BUSY)
+    {
+    }
+    SPIJobCSSet(psEngine, 0);
+
+    for(psJob = psEngine->psHead; psJob != 0; psJob = psJob->psNext)
+    {
+        psJob->ulStatus = SPI_JOB_ABORTED;
+    }
+    psEngine->psHead = 0;
+    psEngine->psTail = 0;
+    psEngine->bBusy = xfalse;
+}
+
+//*****************************************************************************
+//
+//! \brief Queues a job on the specified SPI port.
+//!
+//! \param ulBase specifies the SPI module base address.
+//! \param psJob is the job, owned by the driver until it ends.
+//!
+//! Appends \e psJob to the queue of the port and returns at once. The
+//! descriptors of the job run in order from the SPI interrupt. The chip
+//! select of a descriptor is pulled low before its first frame and stays
+//! low while the next descriptor uses the same pin, so a command, an
+//! address and the data can be separate descriptors of one transaction.
+//! It goes high when the pin changes and at the end of the job.
+//!
+//! The callback of each descriptor is called from the interrupt when it
+//! ends, with \b SPI_JOB_EVENT_DESC, the index of the descriptor and
+//! \e psJob. For the last descriptor \b SPI_JOB_EVENT_DONE is added, the
+//! chip select is already high and \e psJob->ulStatus is \b SPI_JOB_DONE.
+//! A callback may change the descriptors not yet started or queue a job.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+SPIJobSubmit(unsigned long ulBase, tSPIJob *psJob)
+{
+    tSPIJobEngine *psEngine;
+    xtBoolean bMasked;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT((ulBase == SPI0_BASE) || (ulBase == SPI1_BASE)||
+            (ulBase == SPI2_BASE) || (ulBase == SPI3_BASE));
+    xASSERT(g_psSPIJob[SPIIndexGet(ulBase)] != 0);
+    xASSERT((psJob != 0) && (psJob->psDesc != 0) &&
+            (psJob->ulDescCount != 0));
+
+    psEngine = g_psSPIJob[SPIIndexGet(ulBase)];
+    psJob->ulStatus = SPI_JOB_PENDING;
+    psJob->psNext = 0;
+
+    bMasked = xIntMasterDisable();
+    if(psEngine->psTail != 0)
+    {
+        psEngine->psTail->psNext = psJob;
+    }
+    else
+    {
+        psEngine->psHead = psJob;
+    }
+    psEngine->psTail = psJob;
+    SPIJobNext(ulBase, psEngine);
+    if(!bMasked)
+    {
+        xIntMasterEnable();
+    }
+}
+
+//*****************************************************************************
+//
+//! \brief Starts a full-duplex PDMA transfer on the specified SPI port.
+//!
+//! \param ulBase specifies the SPI module base address.
+//! \param pvTxData is the data to send, or 0 to clock out 0xFF fill.
+//! \param pvRxData receives the data read back, or 0 to discard it.
+//! \param ulLength is the number of frames to transfer.
+//! \param pfnCallback is called when the transfer ends, may be 0.
+//!
+//! Claims a PDMA channel pair for the port, sets the PDMA transfer width
+//! from SPIBitLengthGet() and starts both channels, then returns at once.
+//! Each buffer element is an unsigned char, unsigned short or unsigned long
+//! like SPIDataRead(), and the transfer may be up to 0xFFFF bytes. When the
+//! last frame has been received the PDMA interrupt gives the channels back
+//! and calls \e pfnCallback with:
+//! - \e ulEvent is \b SPI_DMA_EVENT_DONE or \b SPI_DMA_EVENT_ERROR.
+//! - \e ulMsgParam is \e ulLength.
+//! - \e pvMsgData is \e pvRxData.
+//! .
+//! The callback may start the next transfer.
+//!
+//! The port must be configured as master with SPIConfig() and not be
+//! running the job queue. Chip select is left to the caller.
+//!
+//! \note The PDMA peripheral clock must be enabled, and INT_PDMA must be
+//! enabled by the application with xIntEnable().
+//!
+//! \return Returns \b xtrue if the transfer is started, or \b xfalse if the
+//! port is busy or no PDMA channel pair is free.
+//
+//*****************************************************************************
+xtBoolean
+SPIDMATransfer(unsigned long ulBase, const void *pvTxData, void *pvRxData,
+               unsigned long ulLength, xtEventCallback pfnCallback)
+{
+    tSPIDMAXfer *psXfer;
+    unsigned long ulIndex, ulSize, ulWidth, ulTxControl, ulRxControl;
+    xtBoolean bMasked;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT((ulBase == SPI0_BASE) || (ulBase == SPI1_BASE)||
+            (ulBase == SPI2_BASE) || (ulBase == SPI3_BASE));
+    xASSERT(g_psSPIJob[SPIIndexGet(ulBase)] == 0);
+    xASSERT((ulLength != 0) &&
+            (ulLength * SPIFrameSizeGet(ulBase) <= PDMA_BCR_M));
+
+    ulIndex = SPIIndexGet(ulBase);
+    psXfer = &g_sSPIDMAXfer[ulIndex];
+
+    bMasked = xIntMasterDisable();
+    if(psXfer->bBusy)
+    {
+        if(!bMasked)
+        {
+            xIntMasterEnable();
+        }
+        return xfalse;
+    }
+    psXfer->bBusy = xtrue;
+    if(!bMasked)
+    {
+        xIntMasterEnable();
+    }
+
+    psXfer->ulRxChannel = PDMAChannelDynamicAssign(
+            g_ulSPIDMARequest[ulIndex][0], xDMA_REQUEST_MEM);
+    if(psXfer->ulRxChannel == xDMA_CHANNEL_NOT_EXIST)
+    {
+        psXfer->bBusy = xfalse;
+        return xfalse;
+    }
+    psXfer->ulTxChannel = PDMAChannelDynamicAssign(xDMA_REQUEST_MEM,
+            g_ulSPIDMARequest[ulIndex][1]);
+    if(psXfer->ulTxChannel == xDMA_CHANNEL_NOT_EXIST)
+    {
+        PDMAChannelDeAssign(psXfer->ulRxChannel);
+        psXfer->bBusy = xfalse;
+        return xfalse;
+    }
+
+    psXfer->ulLength = ulLength;
+    psXfer->pvRxBuf = pvRxData;
+    psXfer->pfnCallback = pfnCallback;
+
+    //
+    // Width from the frame length, the fill and the sink stay in place.
+    //
+    ulSize = SPIFrameSizeGet(ulBase);
+    if(ulSize == 1)
+    {
+        ulWidth = PDMA_WIDTH_8BIT;
+    }
+    else if(ulSize == 2)
+    {
+        ulWidth = PDMA_WIDTH_16BIT;
+    }
+    else
+    {
+        ulWidth = PDMA_WIDTH_32BIT;
+    }
+    ulTxControl = ulWidth | PDMA_DST_DIR_FIXED | PDMA_MODE_MTOP |
+                  ((pvTxData != 0) ? PDMA_SRC_DIR_INC : PDMA_SRC_DIR_FIXED);
+    ulRxControl = ulWidth | PDMA_SRC_DIR_FIXED | PDMA_MODE_PTOM |
+                  ((pvRxData != 0) ? PDMA_DST_DIR_INC : PDMA_DST_DIR_FIXED);
+
+    PDMAChannelIntCallbackInit(psXfer->ulRxChannel, SPIDMACallback);
+    PDMAChannelIntCallbackInit(psXfer->ulTxChannel, SPIDMACallback);
+    PDMAChannelIntCallbackDataSet(psXfer->ulRxChannel, psXfer);
+    PDMAChannelIntCallbackDataSet(psXfer->ulTxChannel, psXfer);
+    PDMAEnable(psXfer->ulRxChannel);
+    PDMAEnable(psXfer->ulTxChannel);
+    PDMAChannelIntEnable(psXfer->ulRxChannel,
+                         PDMA_EVENT_TC | PDMA_EVENT_ERROR);
+    PDMAChannelIntEnable(psXfer->ulTxChannel, PDMA_EVENT_ERROR);
+
+    PDMAChannelControlSet(psXfer->ulRxChannel, ulRxControl);
+    PDMAChannelTransferSet(psXfer->ulRxChannel, (void *)(ulBase + SPI_RX0),
+                           (pvRxData != 0) ? pvRxData : &g_ulSPIDMASink,
+                           ulLength * ulSize);
+    PDMAChannelControlSet(psXfer->ulTxChannel, ulTxControl);
+    PDMAChannelTransferSet(psXfer->ulTxChannel,
+                           (pvTxData != 0) ? (void *)pvTxData : 
+                                             &g_ulSPIDMAFill,
+                           (void *)(ulBase + SPI_TX0), ulLength * ulSize);
+
+    //
+    // Rx first, so no frame is clocked before its channel listens.
+    //
+    xHWREG(ulBase + SPI_DMACTL) |= SPI_DMACTL_RX_DMA_GO;
+    xHWREG(ulBase + SPI_DMACTL) |= SPI_DMACTL_TX_DMA_GO;
+
+    return xtrue;
+}
+
+//*****************************************************************************
+//
+//! \brief Gets whether a PDMA transfer is in progress on a SPI port.
+//!
+//! \param ulBase specifies the SPI module base address.
+//!
+//! \return Returns \b xtrue while a transfer started by SPIDMATransfer()
+//! has not ended, \b xfalse otherwise.
+//
+//*****************************************************************************
+xtBoolean
+SPIDMATransferBusy(unsigned long ulBase)
+{
+    //
+    // Check the arguments.
+    //
+    xASSERT((ulBase == SPI0_BASE) || (ulBase == SPI1_BASE)||
+            (ulBase == SPI2_BASE) || (ulBase == SPI3_BASE));
+
+    return g_sSPIDMAXfer[SPIIndexGet(ulBase)].bBusy;
+}
@@ -1277,6 +1277,11 @@ extern void xSPISSSet(unsigned long ulBase, unsigned long ulSSMode,
 //
 #define SPI_CNTRL_TX_FULL       0x08000000   
 
+//
+//! Depth of the Rx and Tx FIFO in frames
+//
+#define SPI_FIFO_DEPTH          8
+
 //*****************************************************************************
 //
 //! @}
@@ -1319,6 +1324,155 @@ extern void xSPISSSet(unsigned long ulBase, unsigned long ulSSMode,
 //
 //*****************************************************************************
 
+//*****************************************************************************
+//
+//! \addtogroup NUC1xx_SPI_Job NUC1xx SPI Job
+//! \brief Status and events of the SPI jobs, see SPIJobSubmit().
+//! @{
+//
+//*****************************************************************************
+
+//
+//! The job has ended
+//
+#define SPI_JOB_DONE            0x00000000
+
+//
+//! The job is queued or on the bus
+//
+#define SPI_JOB_PENDING         0x00000001
+
+//
+//! The job was dropped by SPIJobDisable()
+//
+#define SPI_JOB_ABORTED         0x00000002
+
+//
+//! Event of a descriptor callback, the descriptor has ended
+//
+#define SPI_JOB_EVENT_DESC      0x00000001
+
+//
+//! Event of a descriptor callback, it was the last one of the job
+//
+#define SPI_JOB_EVENT_DONE      0x00000002
+
+//*****************************************************************************
+//
+//! @}
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! \addtogroup NUC1xx_SPI_DMA_Event NUC1xx SPI DMA Event
+//! \brief Events of the SPIDMATransfer() callback.
+//! @{
+//
+//*****************************************************************************
+
+//
+//! All frames have been sent and received
+//
+#define SPI_DMA_EVENT_DONE      0x00000001
+
+//
+//! A PDMA channel reported an error, the transfer is stopped
+//
+#define SPI_DMA_EVENT_ERROR     0x00000002
+
+//*****************************************************************************
+//
+//! @}
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! \addtogroup NUC1xx_SPI_Exported_Types NUC1xx SPI Exported Types
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! SPI job descriptor, one segment of a transaction, see SPIJobSubmit()
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! GPIO port base of the chip select (active low), 0 if none
+    //
+    unsigned long ulCSPort;
+
+    //
+    //! GPIO pin of the chip select
+    //
+    unsigned long ulCSPin;
+
+    //
+    //! Frames to send, 0 to send 0xFF
+    //
+    const void *pvTxBuf;
+
+    //
+    //! Buffer for the received frames, 0 to discard them
+    //
+    void *pvRxBuf;
+
+    //
+    //! Number of frames, the buffer elements are sized like SPIDataRead()
+    //
+    unsigned long ulLength;
+
+    //
+    //! Called from the SPI interrupt when the descriptor ends, 0 for none
+    //
+    xtEventCallback pfnCallback;
+
+    //
+    //! Passed to pfnCallback
+    //
+    void *pvCBData;
+}
+tSPIJobDesc;
+
+//*****************************************************************************
+//
+//! SPI job, a list of descriptors run back to back, see SPIJobSubmit()
+//
+//*****************************************************************************
+typedef struct tSPIJob
+{
+    //
+    //! Descriptors of the job
+    //
+    tSPIJobDesc *psDesc;
+
+    //
+    //! Number of descriptors
+    //
+    unsigned long ulDescCount;
+
+    //
+    //! Status, SPI_JOB_PENDING until the job ends
+    //
+    volatile unsigned long ulStatus;
+
+    //
+    //! Next job in the queue, used by the driver
+    //
+    struct tSPIJob *psNext;
+}
+tSPIJob;
+
+//*****************************************************************************
+//
+//! @}
+//
+//*****************************************************************************
+
 //*****************************************************************************
 //
 //! \addtogroup NUC1xx_SPI_Exported_APIs  NUC1xx SPI API
@@ -1368,6 +1522,8 @@ extern unsigned long SPIFIFOStatusGet(unsigned long ulBase);
 extern void SPIFIFOClear(unsigned long ulBase, unsigned long ulRxTx);
 extern void SPIFIFOModeSet(unsigned long ulBase, xtBoolean xtEnable, 
                            unsigned long ulInterval);
+extern void SPITransfer(unsigned long ulBase, const void *pvTxData,
+                        void *pvRxData, unsigned long ulLength);
 extern void SPIByteReorderSet(unsigned long ulBase, 
                               unsigned long ulByteReorder);
 extern void SPIVariableClockSet(unsigned long ulBase, unsigned long ulPattern, 
@@ -1382,6 +1538,13 @@ extern unsigned long SPI3WireStartIntFlagGet(unsigned long ulBase);
 extern void SPI3WireStartIntFlagClear(unsigned long ulBase);
 extern void SPI3PDMAEnable(unsigned long ulBase, unsigned long ulDmaMode);
 extern void SPI3PDMADisable(unsigned long ulBase, unsigned long ulDmaMode);
+extern void SPIJobInit(unsigned long ulBase);
+extern void SPIJobDisable(unsigned long ulBase);
+extern void SPIJobSubmit(unsigned long ulBase, tSPIJob *psJob);
+extern xtBoolean SPIDMATransfer(unsigned long ulBase, const void *pvTxData,
+                                void *pvRxData, unsigned long ulLength,
+                                xtEventCallback pfnCallback);
+extern xtBoolean SPIDMATransferBusy(unsigned long ulBase);
 
 
 //*****************************************************************************
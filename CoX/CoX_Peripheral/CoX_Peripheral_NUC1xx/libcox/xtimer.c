@@ -188,7 +188,6 @@ TIMER3IntHandler(void)
 
 //*****************************************************************************
 //
-//! \internal
 //! \brief The function is used to get timer clock.
 //!
 //! \param ulBase is the base address of the timer port.
@@ -199,7 +198,7 @@ TIMER3IntHandler(void)
 //! \return Returns the Current timer Clock.
 //
 //*****************************************************************************
-static unsigned long
+unsigned long
 TimerClockGet(unsigned long ulBase)
 {
     volatile unsigned long ucClockSource;
@@ -252,6 +251,48 @@ TimerClockGet(unsigned long ulBase)
     return ulTimerClock;
 }
 
+//*****************************************************************************
+//
+//! \internal
+//! \brief Computes the prescaler and the compare match of a tick frequency.
+//!
+//! \param ulClock is the timer clock, in Hz.
+//! \param ulTickFreq is the tick frequency, in Hz.
+//! \param psPlan is the plan filled, only the prescaler and the match.
+//!
+//! The divider nearest to ulClock / ulTickFreq is split in the smallest
+//! prescaler, found with a shift, and the compare match rounded, that is
+//! two divisions, the same as TIMER_PLAN().
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+TimerPlanCompute(unsigned long ulClock, unsigned long ulTickFreq,
+                 tTimerPlan *psPlan)
+{
+    unsigned long ulDiv, ulPre, ulMatch;
+
+    ulDiv = (ulClock + ulTickFreq / 2) / ulTickFreq;
+    ulPre = (ulDiv >> 24) + 1;
+    ulMatch = (ulPre == 1) ? ulDiv : ((ulDiv + ulPre / 2) / ulPre);
+
+    //
+    // Faster than half the clock, or a rounding over the 24 bits.
+    //
+    if(ulMatch < 2)
+    {
+        ulMatch = 2;
+    }
+    else if(ulMatch > TIMER_TCMPR_TCMP_M)
+    {
+        ulMatch = TIMER_TCMPR_TCMP_M;
+    }
+
+    psPlan->ulPrescale = ulPre - 1;
+    psPlan->ulMatch = ulMatch;
+}
+
 //*****************************************************************************
 //
 //! \brief Configurate The Timer's mode and tick frequency. 
@@ -267,7 +308,8 @@ TimerClockGet(unsigned long ulBase)
 //! \b TIMER_MODE_CONTINUOUS.
 //!
 //! The \e ulTickFreq parameter is the the timer tick frequency.It can be any
-//! values but ulTickFreq > 0 and ulTickFreq < timer clock source.
+//! values but ulTickFreq > 0 and ulTickFreq < timer clock source. The
+//! prescaler and the compare match are the plan of TimerPlanSolve().
 //!
 //! \note None
 //!
@@ -278,8 +320,8 @@ void
 TimerInitConfig(unsigned long ulBase, unsigned long ulConfig,
                 unsigned long ulTickFreq)
 {    
-    unsigned long ulPreScale;
-    unsigned long ulTCMPRValue;
+    tTimerPlan sPlan;
+
     //
     // Check the arguments.
     //
@@ -319,16 +361,9 @@ TimerInitConfig(unsigned long ulBase, unsigned long ulConfig,
     //
     xHWREG(ulBase + TIMER_O_TISR) |= TIMER_TISR_TIF;
     
-    for (ulPreScale=1; ulPreScale<256; ulPreScale++)
-    {
-        ulTCMPRValue = TimerClockGet(ulBase) / (ulTickFreq * ulPreScale);
-
-        /* The TCMPR value must > 1 */
-        if ((ulTCMPRValue > 1) && (ulTCMPRValue < 0x1000000))
-            break;
-    }
-    xHWREG(ulBase + TIMER_O_TCMPR) = ulTCMPRValue;
-    xHWREG(ulBase + TIMER_O_TCSR) = ulPreScale | ulConfig;
+    TimerPlanCompute(TimerClockGet(ulBase), ulTickFreq, &sPlan);
+    xHWREG(ulBase + TIMER_O_TCMPR) = sPlan.ulMatch;
+    xHWREG(ulBase + TIMER_O_TCSR) = sPlan.ulPrescale | ulConfig;
 }
 
 //*****************************************************************************
@@ -1080,3 +1115,91 @@ TimerExtClockFreqSet(unsigned long ulClockFreq)
 {
     ulEXTClockFreq = ulClockFreq;
 }
+
+//*****************************************************************************
+//
+//! \brief Solves the prescaler and the compare match of a tick frequency.
+//!
+//! \param ulClock is the timer clock, in Hz, see TimerClockGet().
+//! \param ulTickFreq is the tick frequency, in Hz.
+//! \param psPlan is the plan filled.
+//!
+//! This function computes the plan TimerInitConfig() uses, and reports the
+//! frequency achieved and its error. The plan can then be written with
+//! TimerPlanApply(). For a constant clock and frequency the same plan is
+//! given at compile time by TIMER_PLAN().
+//!
+//! The \e ulTickFreq parameter can be any value but ulTickFreq > 0 and
+//! ulTickFreq <= ulClock / 2.
+//!
+//! \note None
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+TimerPlanSolve(unsigned long ulClock, unsigned long ulTickFreq,
+               tTimerPlan *psPlan)
+{
+    unsigned long ulTotal, ulTicks, ulDiff, ulPPM;
+    unsigned long i;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT(psPlan != 0);
+    xASSERT((ulTickFreq > 0) && (ulClock != 0));
+
+    TimerPlanCompute(ulClock, ulTickFreq, psPlan);
+
+    ulTotal = (psPlan->ulPrescale + 1) * psPlan->ulMatch;
+    psPlan->ulFreq = (ulClock + ulTotal / 2) / ulTotal;
+
+    //
+    // The error is (ulClock - ulTickFreq * ulTotal) / (ulTickFreq * ulTotal),
+    // divided one decimal digit at a time to stay in 32 bits.
+    //
+    ulTicks = ulTickFreq * ulTotal;
+    ulDiff = (ulClock > ulTicks) ? (ulClock - ulTicks) : (ulTicks - ulClock);
+    ulPPM = 0;
+    for(i = 0; i < 6; i++)
+    {
+        ulDiff *= 10;
+        ulPPM = ulPPM * 10 + ulDiff / ulTicks;
+        ulDiff %= ulTicks;
+    }
+    psPlan->lErrorPPM = (ulClock > ulTicks) ? (long)ulPPM : -(long)ulPPM;
+}
+
+//*****************************************************************************
+//
+//! \brief Writes the prescaler and the compare match of a plan.
+//!
+//! \param ulBase is the base address of the Timer port.
+//! \param psPlan is the plan from TimerPlanSolve() or TIMER_PLAN().
+//!
+//! This function sets the tick of the timer without resetting it, the mode
+//! and the other settings are kept.
+//!
+//! \note None
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+TimerPlanApply(unsigned long ulBase, const tTimerPlan *psPlan)
+{
+    //
+    // Check the arguments.
+    //
+    xASSERT((ulBase == TIMER3_BASE) || (ulBase == TIMER2_BASE) ||
+            (ulBase == TIMER1_BASE) || (ulBase == TIMER0_BASE));
+    xASSERT(psPlan != 0);
+    xASSERT((psPlan->ulPrescale <= 255) && (psPlan->ulMatch > 1) &&
+            (psPlan->ulMatch <= 0xFFFFFF));
+
+    xHWREG(ulBase + TIMER_O_TCMPR) = psPlan->ulMatch;
+    xHWREG(ulBase + TIMER_O_TCSR) = (xHWREG(ulBase + TIMER_O_TCSR) &
+                                     ~TIMER_TCSR_PRESCALE_M) |
+                                    psPlan->ulPrescale;
+}
@@ -1003,6 +1003,108 @@ extern "C"
 //
 //*****************************************************************************
 
+//*****************************************************************************
+//
+//! \addtogroup NUC1xx_TIMER_Plan NUC1xx TIMER Tick Plan
+//! \brief Prescaler and compare match giving a tick frequency, solved by
+//! TimerPlanSolve() or, for constant frequencies, at compile time with
+//! TIMER_PLAN().
+//!
+//! The timer clock is divided by (prescale + 1) then by the compare match.
+//! The plan takes the divider nearest to clock / frequency, and the smallest
+//! prescaler that lets the 24-bit compare match hold it, which gives the
+//! finest step of frequency.
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! Prescaler, compare match and frequency of a timer tick.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! Prescale value, 0 to 255, the clock is divided by ulPrescale + 1
+    //
+    unsigned long ulPrescale;
+
+    //
+    //! Compare match value, 2 to 0xFFFFFF
+    //
+    unsigned long ulMatch;
+
+    //
+    //! Tick frequency achieved, rounded to the Hz
+    //
+    unsigned long ulFreq;
+
+    //
+    //! Error of the frequency achieved in parts per million, positive when
+    //! the tick is faster than asked
+    //
+    long lErrorPPM;
+}
+tTimerPlan;
+
+//
+//! Total divider of the clock, nearest to ulClock / ulFreq
+//
+#define TIMER_PLAN_DIV(ulClock, ulFreq)                                       \
+        (((ulClock) + (ulFreq) / 2) / (ulFreq))
+
+//
+//! Divider of the prescaler, 1 to 256
+//
+#define TIMER_PLAN_PRE(ulClock, ulFreq)                                       \
+        ((TIMER_PLAN_DIV(ulClock, ulFreq) >> 24) + 1)
+
+//
+//! Compare match, before the limits of the register
+//
+#define TIMER_PLAN_CMP(ulClock, ulFreq)                                       \
+        ((TIMER_PLAN_DIV(ulClock, ulFreq) +                                   \
+          TIMER_PLAN_PRE(ulClock, ulFreq) / 2) /                              \
+         TIMER_PLAN_PRE(ulClock, ulFreq))
+
+//
+//! Compare match value of the plan
+//
+#define TIMER_PLAN_MATCH(ulClock, ulFreq)                                     \
+        ((TIMER_PLAN_CMP(ulClock, ulFreq) < 2) ? 2 :                          \
+         (TIMER_PLAN_CMP(ulClock, ulFreq) > 0xFFFFFF) ? 0xFFFFFF :            \
+         TIMER_PLAN_CMP(ulClock, ulFreq))
+
+//
+//! Total divider achieved by the plan
+//
+#define TIMER_PLAN_TOTAL(ulClock, ulFreq)                                     \
+        (TIMER_PLAN_PRE(ulClock, ulFreq) * TIMER_PLAN_MATCH(ulClock, ulFreq))
+
+//
+//! Initializer of a tTimerPlan for a constant clock and tick frequency, in
+//! Hz, the same as TimerPlanSolve() gives. The error is computed with
+//! floating point constants, the arguments must be constants for the
+//! compiler to fold it.
+//
+#define TIMER_PLAN(ulClock, ulFreq)                                           \
+        {                                                                     \
+            TIMER_PLAN_PRE(ulClock, ulFreq) - 1,                              \
+            TIMER_PLAN_MATCH(ulClock, ulFreq),                                \
+            ((ulClock) + TIMER_PLAN_TOTAL(ulClock, ulFreq) / 2) /             \
+            TIMER_PLAN_TOTAL(ulClock, ulFreq),                                \
+            (long)(((double)(ulClock) /                                       \
+                    (double)TIMER_PLAN_TOTAL(ulClock, ulFreq) -               \
+                    (double)(ulFreq)) * 1000000.0 / (double)(ulFreq))         \
+        }
+
+//*****************************************************************************
+//
+//! @}
+//
+//*****************************************************************************
+
 //*****************************************************************************
 //
 //! \addtogroup NUC1xx_TIMER_Exported_APIs NUC1xx TIMER API
@@ -1049,6 +1151,11 @@ extern void TimerCounterDebounceDisable(unsigned long ulBase);
 extern void TimerCaptureDebounceEnable(unsigned long ulBase);
 extern void TimerCaptureDebounceDisable(unsigned long ulBase);
 extern void TimerExtClockFreqSet(unsigned long ulClockFreq);
+extern unsigned long TimerClockGet(unsigned long ulBase);
+
+extern void TimerPlanSolve(unsigned long ulClock, unsigned long ulTickFreq,
+                           tTimerPlan *psPlan);
+extern void TimerPlanApply(unsigned long ulBase, const tTimerPlan *psPlan);
 
 //*****************************************************************************
 //
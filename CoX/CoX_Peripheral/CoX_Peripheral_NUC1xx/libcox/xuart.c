@@ -42,8 +42,11 @@
 #include "xhw_nvic.h"
 #include "xhw_sysctl.h"
 #include "xhw_uart.h"
+#include "xhw_dma.h"
 #include "xdebug.h"
+#include "xcore.h"
 #include "xsysctl.h"
+#include "xdma.h"
 #include "xuart.h"
 
 
@@ -63,6 +66,279 @@
 //*****************************************************************************
 static xtEventCallback g_pfnUARTHandlerCallbacks[3]={0};
 
+//*****************************************************************************
+//
+// Interrupt driven ring buffer of one UART port.
+//
+// The indexes are free running, the used count is (ulHead - ulTail) and the
+// buffer position is (index & ulMask), so the size must be a power of two.
+// For Rx the interrupt handler is the only writer of ulHead and the
+// application the only writer of ulTail, for Tx the roles are swapped.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // Tx buffer, size mask and indexes.
+    //
+    unsigned char *pucTxBuf;
+    unsigned long ulTxMask;
+    volatile unsigned long ulTxHead;
+    volatile unsigned long ulTxTail;
+
+    //
+    // Rx buffer, size mask and indexes.
+    //
+    unsigned char *pucRxBuf;
+    unsigned long ulRxMask;
+    volatile unsigned long ulRxHead;
+    volatile unsigned long ulRxTail;
+
+    //
+    // Bytes lost because the Rx ring was full.
+    //
+    volatile unsigned long ulRxDropped;
+}
+tUARTRing;
+
+//*****************************************************************************
+//
+// An array is UART ring buffer point, 0 when the port is not buffered.
+//
+//*****************************************************************************
+static tUARTRing g_sUARTRing[3];
+static tUARTRing *g_psUARTRing[3]={0};
+
+//*****************************************************************************
+//
+// PDMA stream of one UART port (UART0 and UART1 only).
+//
+// Rx ping-pongs between two buffers, ulRxActive is the buffer the Rx
+// channel is filling now.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // PDMA channels claimed for the port.
+    //
+    unsigned long ulRxChannel;
+    unsigned long ulTxChannel;
+
+    //
+    // Rx buffers, their length and the buffer being filled.
+    //
+    unsigned char *pucRxBuf[2];
+    unsigned long ulRxLength;
+    volatile unsigned long ulRxActive;
+
+    //
+    // Bytes in the active buffer at the last UARTDMAStreamPoll().
+    //
+    volatile unsigned long ulRxPolled;
+
+    //
+    // Tx transfer in progress.
+    //
+    unsigned char *pucTxBuf;
+    unsigned long ulTxLength;
+    volatile xtBoolean bTxBusy;
+
+    //
+    // Application callback.
+    //
+    xtEventCallback pfnCallback;
+}
+tUARTDMAStream;
+
+//*****************************************************************************
+//
+// An array is UART DMA stream point, 0 when the port is not streaming.
+//
+//*****************************************************************************
+static tUARTDMAStream g_sUARTDMAStream[2];
+static tUARTDMAStream *g_psUARTDMAStream[2]={0};
+
+//*****************************************************************************
+//
+// Rx framing engine of one UART port.
+//
+// The interrupt handler decodes SLIP or COBS straight from the Rx FIFO into
+// a slot of the frame pool, so a frame is never copied again. Slot indexes
+// move through two single producer queues: ucFree from the application to
+// the handler, ucReady from the handler to the application. Both hold every
+// slot of the pool, so neither can overflow.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // UART_FRAME_SLIP or UART_FRAME_COBS.
+    //
+    unsigned long ulProtocol;
+
+    //
+    // Frame pool, slot size and slot count.
+    //
+    unsigned char *pucPool;
+    unsigned long ulFrameSize;
+    unsigned long ulFrameNum;
+
+    //
+    // Free slots, written by the application.
+    //
+    unsigned char ucFree[UART_FRAME_NUM_MAX];
+    volatile unsigned long ulFreeHead;
+    volatile unsigned long ulFreeTail;
+
+    //
+    // Complete frames and their lengths, written by the handler.
+    //
+    unsigned char ucReady[UART_FRAME_NUM_MAX];
+    unsigned short usLength[UART_FRAME_NUM_MAX];
+    volatile unsigned long ulReadyHead;
+    volatile unsigned long ulReadyTail;
+
+    //
+    // Decoder state: slot being filled (UART_FRAME_NUM_MAX if none), its
+    // length, the SLIP escape flag or the COBS bytes left in the block, the
+    // COBS zero owed at the end of the block, and the discard flag set on an
+    // error until the next delimiter.
+    //
+    unsigned long ulSlot;
+    unsigned long ulLength;
+    unsigned long ulState;
+    xtBoolean bZero;
+    xtBoolean bDiscard;
+
+    //
+    // Error counters, indexed by UART_FRAME_ERROR_*.
+    //
+    volatile unsigned long ulErrors[3];
+
+    //
+    // Application callback, 0 to queue frames for UARTFrameGet().
+    //
+    xtEventCallback pfnCallback;
+}
+tUARTFrame;
+
+//*****************************************************************************
+//
+// An array is UART framing engine point, 0 when the port is not framed.
+//
+//*****************************************************************************
+static tUARTFrame g_sUARTFrame[3];
+static tUARTFrame *g_psUARTFrame[3]={0};
+
+//*****************************************************************************
+//
+// RS-485 transaction engine of one UART port.
+//
+// psHead is the transfer on the bus, the rest of the queue follows psNext.
+// The engine sends the request from the THRE interrupt, then waits for the
+// response. The direction is turned by the RS-485 auto direction mode of
+// the UART (RTS), and the end of the response is the Rx time out set to a
+// 3.5 character gap.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // Transfer queue.
+    //
+    tUART485Xfer *psHead;
+    tUART485Xfer *psTail;
+
+    //
+    // UART_485_STATE_*, bytes of the request sent, and UART485Tick() periods
+    // since the end of the request.
+    //
+    volatile unsigned long ulState;
+    unsigned long ulTxCount;
+    volatile unsigned long ulTicks;
+
+    //
+    // Bus statistics.
+    //
+    tUART485Stats sStats;
+}
+tUART485;
+
+//
+// Engine states.
+//
+#define UART_485_STATE_IDLE     0
+#define UART_485_STATE_TX       1
+#define UART_485_STATE_DRAIN    2
+#define UART_485_STATE_WAIT     3
+#define UART_485_STATE_RX       4
+
+//*****************************************************************************
+//
+// An array is UART RS-485 engine point, 0 when the engine is not running.
+//
+//*****************************************************************************
+static tUART485 g_sUART485[3];
+static tUART485 *g_psUART485[3]={0};
+
+//*****************************************************************************
+//
+// Deferred log.
+//
+// Entries are reserved and filled with interrupts masked for a few
+// instructions, Cortex-M0 has no exclusive access to do it lock free for
+// any number of producers. The consumer (UARTLogFlush()) is the only writer
+// of ulTail.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // Output port, 0 when the log is not running.
+    //
+    unsigned long ulBase;
+
+    //
+    // Entry ring, its size mask and free running indexes.
+    //
+    tUARTLogEntry *psBuf;
+    unsigned long ulMask;
+    volatile unsigned long ulHead;
+    volatile unsigned long ulTail;
+
+    //
+    // Bytes of the entry at ulTail already queued, for lines longer than
+    // the Tx ring.
+    //
+    unsigned long ulSent;
+
+    //
+    // Entries lost because the ring was full.
+    //
+    volatile unsigned long ulDropped;
+
+    //
+    // UART_LOG_PENDSV or 0.
+    //
+    unsigned long ulFlags;
+}
+tUARTLog;
+
+static tUARTLog g_sUARTLog;
+
+//*****************************************************************************
+//
+// Baud rate dividers tried by UARTBaudPlanCompute(): 16 (mode 0), 15 to 9
+// (mode 1, DIV_X + 1) and 1 (mode 2). The most oversampling comes first so
+// it wins a tie.
+//
+//*****************************************************************************
+static const unsigned char g_ucUARTBaudDivider[] =
+{
+    16, 15, 14, 13, 12, 11, 10, 9, 1
+};
+
 //*****************************************************************************
 //
 //! \internal
@@ -88,845 +364,1219 @@ UARTBaseValid(unsigned long ulBase)
 //*****************************************************************************
 //
 //! \internal
-//! \brief The function is the UART0 and UART2 interrupt service.
+//! \brief Gets the index of a UART port.
 //!
-//! \param None.
+//! \param ulBase is the base address of the UART port.
 //!
-//! This function is a interrupt service routine of UART0 and UART2.
+//! \return Returns 0, 1 or 2 for UART0, UART1 or UART2.
+//
+//*****************************************************************************
+static unsigned long
+UARTIndexGet(unsigned long ulBase)
+{
+    if (ulBase == UART0_BASE)
+    {
+        return 0;
+    }
+    else if (ulBase == UART1_BASE)
+    {
+        return 1;
+    }
+    else
+    {
+        return 2;
+    }
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Services the ring buffers of a UART port.
+//!
+//! \param ulBase is the base address of the UART port.
+//! \param psRing is the ring buffer of the port.
+//! \param ulIntStatus is the UART_ISR value read by the interrupt handler.
+//!
+//! Drains the Rx FIFO into the Rx ring on a RDA or Rx time out interrupt and
+//! refills the Tx FIFO from the Tx ring on a THRE interrupt. The THRE
+//! interrupt is disabled once the Tx ring is empty, and PendSV pended again
+//! if the deferred log of the port still has entries.
 //!
 //! \return None.
 //
 //*****************************************************************************
-void 
-UART02IntHandler(void)
+static void
+UARTRingIntService(unsigned long ulBase, tUARTRing *psRing,
+                   unsigned long ulIntStatus)
 {
-    unsigned long ulUART0IntStatus,ulUART2IntStatus;
+    unsigned long ulHead, ulTail;
 
-    ulUART0IntStatus = xHWREG(UART0_BASE + UART_ISR);
-	
-	ulUART2IntStatus = xHWREG(UART2_BASE + UART_ISR);
-	
-    if(g_pfnUARTHandlerCallbacks[0] != 0)
-	{
-        g_pfnUARTHandlerCallbacks[0](0, 0, ulUART0IntStatus, 0);
+    if(ulIntStatus & (UART_ISR_RDA_INT | UART_ISR_TOUT_INT))
+    {
+        ulHead = psRing->ulRxHead;
+        while(!(xHWREG(ulBase + UART_FSR) & UART_FSR_RX_EF))
+        {
+            if((ulHead - psRing->ulRxTail) > psRing->ulRxMask)
+            {
+                //
+                // Ring is full, the byte must still be read to clear the
+                // interrupt.
+                //
+                xHWREG(ulBase + UART_RBR);
+                psRing->ulRxDropped++;
+            }
+            else
+            {
+                psRing->pucRxBuf[ulHead & psRing->ulRxMask] =
+                                      (unsigned char)xHWREG(ulBase + UART_RBR);
+                ulHead++;
+            }
+        }
+        psRing->ulRxHead = ulHead;
     }
-	if(g_pfnUARTHandlerCallbacks[2] != 0)
+
+    if(ulIntStatus & UART_ISR_THRE_INT)
     {
-        g_pfnUARTHandlerCallbacks[2](0, 0, ulUART2IntStatus, 0);
+        ulTail = psRing->ulTxTail;
+        while((ulTail != psRing->ulTxHead) &&
+              !(xHWREG(ulBase + UART_FSR) & UART_FSR_TX_FF))
+        {
+            xHWREG(ulBase + UART_THR) = psRing->pucTxBuf[ulTail &
+                                                          psRing->ulTxMask];
+            ulTail++;
+        }
+        psRing->ulTxTail = ulTail;
+
+        if(ulTail == psRing->ulTxHead)
+        {
+            xHWREG(ulBase + UART_IER) &= ~UART_IER_THRE_IEN;
+
+            //
+            // The log flush stopped on a full ring, let it go on.
+            //
+            if((g_sUARTLog.ulBase == ulBase) &&
+               (g_sUARTLog.ulFlags & UART_LOG_PENDSV) &&
+               (g_sUARTLog.ulTail != g_sUARTLog.ulHead))
+            {
+                xHWREG(NVIC_INT_CTRL) = NVIC_INT_CTRL_PEND_SV;
+            }
+        }
     }
 }
 
 //*****************************************************************************
 //
 //! \internal
-//! \brief The function is the UART1 interrupt service.
+//! \brief Stores one decoded byte in the current frame.
 //!
-//! \param None.
+//! \param psFrame is the framing engine of the port.
+//! \param ucByte is the decoded byte.
 //!
-//! This function is a interrupt service routine of UART1
+//! Takes a free slot when the frame starts. A frame without a free slot or
+//! longer than a slot is discarded up to the next delimiter.
 //!
 //! \return None.
 //
 //*****************************************************************************
-void 
-UART1IntHandler(void)
+static void
+UARTFrameStore(tUARTFrame *psFrame, unsigned char ucByte)
 {
-    unsigned long ulUART1IntStatus;
-
-	ulUART1IntStatus = xHWREG(UART1_BASE + UART_ISR);
+    if(psFrame->ulSlot == UART_FRAME_NUM_MAX)
+    {
+        if(psFrame->ulFreeHead == psFrame->ulFreeTail)
+        {
+            psFrame->ulErrors[UART_FRAME_ERROR_NO_BUFFER]++;
+            psFrame->bDiscard = xtrue;
+            return;
+        }
+        psFrame->ulSlot = psFrame->ucFree[psFrame->ulFreeTail &
+                                          (UART_FRAME_NUM_MAX - 1)];
+        psFrame->ulFreeTail++;
+        psFrame->ulLength = 0;
+    }
 
-    if(g_pfnUARTHandlerCallbacks[1] != 0)
+    if(psFrame->ulLength == psFrame->ulFrameSize)
     {
-       g_pfnUARTHandlerCallbacks[1](0, 0, ulUART1IntStatus, 0);
+        psFrame->ulErrors[UART_FRAME_ERROR_OVERRUN]++;
+        psFrame->bDiscard = xtrue;
+        return;
     }
 
+    psFrame->pucPool[psFrame->ulSlot * psFrame->ulFrameSize +
+                     psFrame->ulLength] = ucByte;
+    psFrame->ulLength++;
 }
 
 //*****************************************************************************
 //
 //! \internal
-//! \brief The function is used to get Uart clock.
+//! \brief Ends the current frame on a delimiter.
 //!
-//! \param ulBase is the base address of the UART port.
+//! \param psFrame is the framing engine of the port.
 //!
-//! This function gets the Uart clock
-//! when set the bandrate of UART.
+//! Hands a complete non-empty frame to the callback or the ready queue. The
+//! slot of a discarded or empty frame is kept for the next frame.
 //!
-//! \return Returns the Current Uart Clock.
+//! \return None.
 //
 //*****************************************************************************
-static unsigned long UARTCLkGet(void)
+static void
+UARTFrameEnd(tUARTFrame *psFrame)
 {
-    unsigned long clk =0 , div;
-    unsigned long ulPLLSrc, ulNF, ulNR, ulNO;
-    unsigned long ulMap[4] = {1, 2, 2, 4};
-    //
-    // Check UART Clock Source Setting.
-    //
-    if(((xHWREG(SYSCLK_CLKSEL1)&SYSCLK_CLKSEL1_UART_M) >> 
-          SYSCLK_CLKSEL1_UART_S) == 0)         
-    {
-        //
-        // Get External Clock From DrvSYS Setting.
-        // 
-        clk = 12000000;          
-    }   
-    else if(((xHWREG(SYSCLK_CLKSEL1)&SYSCLK_CLKSEL1_UART_M) >> 
-               SYSCLK_CLKSEL1_UART_S) == 1)
+    unsigned long ulHead;
+    unsigned char *pucData;
+
+    if((psFrame->ulSlot != UART_FRAME_NUM_MAX) && !psFrame->bDiscard &&
+       (psFrame->ulLength != 0))
     {
-        //
-        // According PLL Clock and UART_Divider to get clock.
-        //                  
-        if((xHWREG(SYSCLK_PLLCON) & SYSCLK_PLLCON_PLL_SRC))
-        {
-            ulPLLSrc = 22000000;
-        }
-        else
-        {
-            ulPLLSrc = 12*1000000;
-        }
-        if ((xHWREG(SYSCLK_PLLCON) & SYSCLK_PLLCON_PD))
+        if(psFrame->pfnCallback != 0)
         {
-            clk = 0;
+            pucData = psFrame->pucPool + psFrame->ulSlot *
+                                         psFrame->ulFrameSize;
+            psFrame->pfnCallback(0, UART_FRAME_EVENT_RX, psFrame->ulLength,
+                                 pucData);
         }
         else
         {
-            ulNF = (xHWREG(SYSCLK_PLLCON) & SYSCLK_PLLCON_FB_DV_M);
-            ulNR = (xHWREG(SYSCLK_PLLCON) & SYSCLK_PLLCON_IN_DV_M) >>          \
-                                           SYSCLK_PLLCON_IN_DV_S;
-            ulNO = (xHWREG(SYSCLK_PLLCON) & SYSCLK_PLLCON_OUT_DV_M) >>          \
-                                           SYSCLK_PLLCON_OUT_DV_S;
-            clk =  ulPLLSrc*(ulNF+2)/(ulNR+2)/(ulMap[ulNO]);
+            ulHead = psFrame->ulReadyHead & (UART_FRAME_NUM_MAX - 1);
+            psFrame->ucReady[ulHead] = (unsigned char)psFrame->ulSlot;
+            psFrame->usLength[ulHead] = (unsigned short)psFrame->ulLength;
+            psFrame->ulReadyHead++;
         }
+        psFrame->ulSlot = UART_FRAME_NUM_MAX;
     }
-    //
-    // Clock 22Mhz.
-    //    
-    else
-        clk = 22000000;  
 
-    div = (xHWREG(SYSCLK_CLKDIV) & SYSCLK_CLKDIV_UART_M) >>
-                                       SYSCLK_CLKDIV_UART_S;
-    return clk/ (div+1);
+    psFrame->ulLength = 0;
+    psFrame->ulState = 0;
+    psFrame->bZero = xfalse;
+    psFrame->bDiscard = xfalse;
 }
 
-
 //*****************************************************************************
 //
-//! \brief Sets the type of parity.
+//! \internal
+//! \brief Drains the Rx FIFO of a UART port through the framing engine.
 //!
 //! \param ulBase is the base address of the UART port.
-//! \param ulParity specifies the type of parity to use.
-//! 
-//! Sets the type of parity to use for transmitting and expect when receiving.
-//! The \e ulParity parameter must be one of \b UART_CONFIG_PAR_NONE,
-//! \b UART_CONFIG_PAR_EVEN, \b UART_CONFIG_PAR_ODD, \b UART_CONFIG_PAR_ONE,
-//! or \b UART_CONFIG_PAR_ZERO.  The last two allow direct control of the
-//! parity bit; it is always either one or zero based on the mode.
+//! \param psFrame is the framing engine of the port.
+//! \param ulIntStatus is the UART_ISR value read by the interrupt handler.
+//!
+//! Decodes every byte in the Rx FIFO on a RDA or Rx time out interrupt.
 //!
 //! \return None.
 //
 //*****************************************************************************
-void
-UARTParityModeSet(unsigned long ulBase, unsigned long ulParity)
+static void
+UARTFrameIntService(unsigned long ulBase, tUARTFrame *psFrame,
+                    unsigned long ulIntStatus)
 {
-    //
-    // Check the arguments.
-    //
-    xASSERT(UARTBaseValid(ulBase));
-    xASSERT((ulParity == UART_CONFIG_PAR_NONE) ||
-           (ulParity == UART_CONFIG_PAR_EVEN) ||
-           (ulParity == UART_CONFIG_PAR_ODD) ||
-           (ulParity == UART_CONFIG_PAR_ONE) ||
-           (ulParity == UART_CONFIG_PAR_ZERO));
+    unsigned char ucByte;
 
-    //
-    // Set the parity mode.
-    //
-    xHWREG(ulBase + UART_LCR) = ((xHWREG(ulBase + UART_LCR) &
-                                    ~(UART_LCR_PBE | UART_LCR_EPE |
-                                      UART_LCR_SPE)) | ulParity);
+    if(!(ulIntStatus & (UART_ISR_RDA_INT | UART_ISR_TOUT_INT)))
+    {
+        return;
+    }
+
+    while(!(xHWREG(ulBase + UART_FSR) & UART_FSR_RX_EF))
+    {
+        ucByte = (unsigned char)xHWREG(ulBase + UART_RBR);
+
+        if(ucByte == psFrame->ulProtocol)
+        {
+            //
+            // The delimiter is 0xC0 for SLIP and 0x00 for COBS, a COBS
+            // delimiter inside a block means the frame is truncated.
+            //
+            if((psFrame->ulProtocol == UART_FRAME_COBS) &&
+               (psFrame->ulState != 0) && !psFrame->bDiscard)
+            {
+                psFrame->ulErrors[UART_FRAME_ERROR_DECODE]++;
+                psFrame->bDiscard = xtrue;
+            }
+            UARTFrameEnd(psFrame);
+        }
+        else if(psFrame->bDiscard)
+        {
+            continue;
+        }
+        else if(psFrame->ulProtocol == UART_FRAME_SLIP)
+        {
+            if(psFrame->ulState != 0)
+            {
+                //
+                // Byte after ESC.
+                //
+                psFrame->ulState = 0;
+                if(ucByte == UART_SLIP_ESC_END)
+                {
+                    UARTFrameStore(psFrame, UART_SLIP_END);
+                }
+                else if(ucByte == UART_SLIP_ESC_ESC)
+                {
+                    UARTFrameStore(psFrame, UART_SLIP_ESC);
+                }
+                else
+                {
+                    psFrame->ulErrors[UART_FRAME_ERROR_DECODE]++;
+                    psFrame->bDiscard = xtrue;
+                }
+            }
+            else if(ucByte == UART_SLIP_ESC)
+            {
+                psFrame->ulState = 1;
+            }
+            else
+            {
+                UARTFrameStore(psFrame, ucByte);
+            }
+        }
+        else if(psFrame->ulState == 0)
+        {
+            //
+            // COBS code byte: pay the zero owed by the previous block, the
+            // zero owed by the last block of the frame is dropped.
+            //
+            if(psFrame->bZero)
+            {
+                UARTFrameStore(psFrame, 0);
+            }
+            psFrame->ulState = ucByte - 1;
+            psFrame->bZero = (ucByte != 0xFF) ? xtrue : xfalse;
+        }
+        else
+        {
+            UARTFrameStore(psFrame, ucByte);
+            psFrame->ulState--;
+        }
+    }
 }
 
 //*****************************************************************************
 //
-//! \brief Gets the type of parity currently being used.
+//! \internal
+//! \brief Starts the transfer at the head of the RS-485 queue.
 //!
 //! \param ulBase is the base address of the UART port.
+//! \param ps485 is the RS-485 engine of the port.
 //!
-//! This function gets the type of parity used for transmitting data and
-//! expected when receiving data.
+//! Enables the THRE interrupt, which sends the request.
 //!
-//! \return Returns the current parity settings, specified as one of
-//! \b UART_CONFIG_PAR_NONE, \b UART_CONFIG_PAR_EVEN, \b UART_CONFIG_PAR_ODD,
-//! \b UART_CONFIG_PAR_ONE, or \b UART_CONFIG_PAR_ZERO.
+//! \return None.
 //
 //*****************************************************************************
-unsigned long
-UARTParityModeGet(unsigned long ulBase)
+static void
+UART485XferStart(unsigned long ulBase, tUART485 *ps485)
 {
-    //
-    // Check the arguments.
-    //
-    xASSERT(UARTBaseValid(ulBase));
+    ps485->ulState = UART_485_STATE_TX;
+    ps485->ulTxCount = 0;
+    ps485->ulTicks = 0;
+    ps485->psHead->ulRxLen = 0;
+    ps485->sStats.ulRequests++;
 
-    //
-    // Return the current parity setting.
-    //
-    return(xHWREG(ulBase + UART_LCR) &
-           (UART_LCR_PBE | UART_LCR_EPE | UART_LCR_SPE));
+    xHWREG(ulBase + UART_IER) |= UART_IER_THRE_IEN;
 }
 
 //*****************************************************************************
 //
-//! \brief Sets the Sets the RX FIFO level.
+//! \internal
+//! \brief Ends the transfer at the head of the RS-485 queue.
 //!
 //! \param ulBase is the base address of the UART port.
-//! \param ulRxLevel is the transmit FIFO interrupt level, specified as one of
-//! \b UART_FIFO_1BYTES, \b UART_FIFO_4BYTES, \b UART_FIFO_8BYTES,
-//! \b UART_FIFO_14BYTES, \b UART_FIFO_46BYTES, \b UART_FIFO_30BYTES.
-//! or \b UART_FIFO_62BYTES.
+//! \param ps485 is the RS-485 engine of the port.
+//! \param ulStatus is the status of the transfer.
 //!
-//! This function sets the FIFO level at which  receive interrupts
-//! are generated.
+//! Stores the status, calls the transfer callback and starts the next
+//! transfer. Must run with the UART interrupt masked.
 //!
 //! \return None.
 //
 //*****************************************************************************
-void
-UARTFIFOTriggerLevelSet(unsigned long ulBase, unsigned long ulRxLevel)
+static void
+UART485XferEnd(unsigned long ulBase, tUART485 *ps485, unsigned long ulStatus)
 {
-    //
-    // Check the arguments.
-    //
-    xASSERT(UARTBaseValid(ulBase));
+    tUART485Xfer *psXfer;
 
-    //
-    // Sets the RX FIFO level.
-    //
-    xHWREG(ulBase + UART_FCR) &= (~(UART_FCR_RFITL_M ));
-    xHWREG(ulBase + UART_FCR) |= ((ulRxLevel ));
+    psXfer = ps485->psHead;
+    ps485->psHead = psXfer->psNext;
+    if(ps485->psHead == 0)
+    {
+        ps485->psTail = 0;
+    }
+    ps485->ulState = UART_485_STATE_IDLE;
+
+    psXfer->ulStatus = ulStatus;
+    if(psXfer->pfnCallback != 0)
+    {
+        psXfer->pfnCallback(psXfer->pvCBData, ulStatus, psXfer->ulRxLen,
+                            psXfer);
+    }
+
+    if((ps485->psHead != 0) && (ps485->ulState == UART_485_STATE_IDLE))
+    {
+        UART485XferStart(ulBase, ps485);
+    }
 }
 
 //*****************************************************************************
 //
-//! \brief Gets the Rx FIFO level at which interrupts are generated.
+//! \internal
+//! \brief Turns a RS-485 port to the response once the request is out.
 //!
 //! \param ulBase is the base address of the UART port.
-//! \param pulRxLevel is a pointer to storage for the receive FIFO level,
-//! returned as one of 
-//! \b UART_FIFO_1BYTES, \b UART_FIFO_4BYTES, \b UART_FIFO_8BYTES,
-//! \b UART_FIFO_14BYTES, \b UART_FIFO_46BYTES, \b UART_FIFO_30BYTES.
-//! or \b UART_FIFO_62BYTES.
+//! \param ps485 is the RS-485 engine of the port.
 //!
-//! This function gets the Rx FIFO level at which receive interrupts
-//! are generated.
+//! Called with the transmitter empty, UART_FSR_TE_F set, so the UART has
+//! turned the bus around. Drops anything received while sending, the echo
+//! of the request, and starts the response time out, or ends a transfer
+//! that expects no response. Must run with the UART interrupt masked.
 //!
 //! \return None.
 //
 //*****************************************************************************
-void
-UARTFIFOTriggerLevelGet(unsigned long ulBase, unsigned long *pulRxLevel)
+static void
+UART485TxDone(unsigned long ulBase, tUART485 *ps485)
 {
-    unsigned long ulTemp;
-
-    //
-    // Check the arguments.
-    //
-    xASSERT(UARTBaseValid(ulBase));
-
-    //
-    // Read the FIFO level register.
-    //
-    ulTemp = xHWREG(ulBase + UART_FCR);
-
-    //
-    // Extract the transmit and receive FIFO levels.
-    //
-    *pulRxLevel = ulTemp & UART_FCR_RFITL_M;
+    xHWREG(ulBase + UART_IER) &= ~UART_IER_THRE_IEN;
+    xHWREG(ulBase + UART_FCR) |= UART_FCR_RX_RST;
+    if(ps485->psHead->ulTimeout == 0)
+    {
+        UART485XferEnd(ulBase, ps485, UART_485_XFER_DONE);
+        return;
+    }
+    ps485->ulTicks = 0;
+    ps485->ulState = UART_485_STATE_WAIT;
 }
 
 //*****************************************************************************
 //
-//! \brief Sets the configuration of a UART.
+//! \internal
+//! \brief Services the RS-485 engine of a UART port.
 //!
 //! \param ulBase is the base address of the UART port.
-//! \param ulBaud is the desired baud rate.
-//! \param ulConfig is the data format for the port (number of data bits,
-//! number of stop bits, and parity).
-//!
-//! This function configures the UART for operation in the specified data
-//! format.  The baud rate is provided in the \e ulBaud parameter and the data
-//! format in the \e ulConfig parameter.
-//!
-//! The \e ulConfig parameter is the logical OR of three values: the number of
-//! data bits, the number of stop bits, and the parity.  \b UART_CONFIG_WLEN_8,
-//! \b UART_CONFIG_WLEN_7, \b UART_CONFIG_WLEN_6, and \b UART_CONFIG_WLEN_5
-//! select from eight to five data bits per byte (respectively).
-//! \b UART_CONFIG_STOP_ONE and \b UART_CONFIG_STOP_TWO select one or two stop
-//! bits (respectively).  \b UART_CONFIG_PAR_NONE, \b UART_CONFIG_PAR_EVEN,
-//! \b UART_CONFIG_PAR_ODD, \b UART_CONFIG_PAR_ONE, and \b UART_CONFIG_PAR_ZERO
-//! select the parity mode (no parity bit, even parity bit, odd parity bit,
-//! parity bit always one, and parity bit always zero, respectively).
+//! \param ps485 is the RS-485 engine of the port.
+//! \param ulIntStatus is the UART_ISR value read by the interrupt handler.
 //!
+//! On THRE feeds the request to the Tx FIFO, then waits for the FIFO to
+//! drain and the last character to leave the shift register, which
+//! UART485Tick() also checks. On RDA reads all but one byte of the Rx FIFO,
+//! so the Rx time out still fires after the last byte of the response. On
+//! the Rx time out reads the rest and ends the transfer.
 //!
 //! \return None.
 //
 //*****************************************************************************
-void
-UARTConfigSetExpClk(unsigned long ulBase, 
-                    unsigned long ulBaud, unsigned long ulConfig)
+static void
+UART485IntService(unsigned long ulBase, tUART485 *ps485,
+                  unsigned long ulIntStatus)
 {
-    unsigned long ulExtClk,ultemp,uldiv;
+    tUART485Xfer *psXfer;
+    unsigned long ulCount, ulStatus;
+    unsigned char ucByte;
 
-    //
-    // Check the arguments.
-    //
-    xASSERT(UARTBaseValid(ulBase));
-    xASSERT(ulBaud != 0);
-    //xASSERT(ulUARTClk >= (ulBaud * UART_CLK_DIVIDER));
+    psXfer = ps485->psHead;
 
-    //
-    // Reset UART.
-    //
-    if (ulBase == UART0_BASE)
+    if((ulIntStatus & UART_ISR_THRE_INT) &&
+       (ps485->ulState == UART_485_STATE_TX))
     {
-        SysCtlPeripheralReset(SYSCTL_PERIPH_UART0);
-        SysCtlPeripheralClockSourceSet(SYSCTL_PERIPH_UART_S_EXT12M);
+        while((ps485->ulTxCount < psXfer->ulTxLen) &&
+              !(xHWREG(ulBase + UART_FSR) & UART_FSR_TX_FF))
+        {
+            xHWREG(ulBase + UART_THR) = psXfer->pucTxBuf[ps485->ulTxCount];
+            ps485->ulTxCount++;
+        }
+
+        if(ps485->ulTxCount == psXfer->ulTxLen)
+        {
+            //
+            // Up to a FIFO of characters is still to go out, THRE fires
+            // again when the FIFO is empty.
+            //
+            ps485->ulState = UART_485_STATE_DRAIN;
+        }
     }
-    else if (ulBase == UART1_BASE)
+    else if((ulIntStatus & UART_ISR_THRE_INT) &&
+            (ps485->ulState == UART_485_STATE_DRAIN))
     {
-        SysCtlPeripheralReset(SYSCTL_PERIPH_UART1);
-        SysCtlPeripheralClockSourceSet(SYSCTL_PERIPH_UART_S_EXT12M);
+        //
+        // The last character may still be shifting out, else UART485Tick()
+        // sees the transmitter empty.
+        //
+        xHWREG(ulBase + UART_IER) &= ~UART_IER_THRE_IEN;
+        if(xHWREG(ulBase + UART_FSR) & UART_FSR_TE_F)
+        {
+            UART485TxDone(ulBase, ps485);
+            psXfer = ps485->psHead;
+        }
     }
-    else 
+
+    if(!(ulIntStatus & (UART_ISR_RDA_INT | UART_ISR_TOUT_INT)))
     {
-        SysCtlPeripheralReset(SYSCTL_PERIPH_UART2);
-        SysCtlPeripheralClockSourceSet(SYSCTL_PERIPH_UART_S_EXT12M);
+        return;
     }
 
-    //
-    // Tx FIFO Reset & Rx FIFO Reset & FIFO Mode Enable .
-    //    
-    xHWREG(ulBase + UART_FCR) |= UART_FCR_RX_RST | UART_FCR_TX_RST;
-
-    //
-    // Set Parity & Data bits & Stop bits .
-    //  
-    xHWREG(ulBase + UART_LCR) = ulConfig;
-
-    ulExtClk = UARTCLkGet();
-
-    //
-    // Source Clock mod 16 <3 => Using Divider X =16 (MODE#1).
-    //      
-    if(((ulExtClk / ulBaud)%16)<3)       
-    { 
-        xHWREG(ulBase + UART_BAUD) &= ~UART_BAUD_DIV_X_EN;
-        xHWREG(ulBase + UART_BAUD) &= ~UART_BAUD_DIV_X_ONE;
-        ultemp = ulExtClk / ulBaud/16  -2;
+    if(ulIntStatus & UART_ISR_TOUT_INT)
+    {
+        ulCount = 0xFFFFFFFF;
     }
-    //
-    // Source Clock mod 16 >3 => Up 5% Error BaudRate.
-    //     
-    else                            
+    else
     {
-        //
-        // Try to Set Divider X = 1 (MODE#3).
-        //
-        xHWREG(ulBase + UART_BAUD) |= UART_BAUD_DIV_X_EN;
-        xHWREG(ulBase + UART_BAUD) |= UART_BAUD_DIV_X_ONE;       
-        ultemp = ulExtClk / ulBaud  -2;
+        ulCount = (xHWREG(ulBase + UART_FSR) & UART_FSR_RXP_M) >>
+                  UART_FSR_RXP_S;
+        ulCount = (ulCount != 0) ? (ulCount - 1) : 0;
+    }
 
-        //
-        // If Divider > Range .
-        //
-        if(ultemp > 0xFFFF)              
+    while(ulCount-- && !(xHWREG(ulBase + UART_FSR) & UART_FSR_RX_EF))
+    {
+        ucByte = (unsigned char)xHWREG(ulBase + UART_RBR);
+        if(ps485->ulState == UART_485_STATE_WAIT)
         {
             //
-            // Try to Set Divider X up 10 (MODE#2).
+            // First byte of the response.
             //
-            xHWREG(ulBase + UART_BAUD) &= ~UART_BAUD_DIV_X_ONE;       
-            
-            for(uldiv = 8; uldiv <16;uldiv++)
+            ps485->ulState = UART_485_STATE_RX;
+            ps485->sStats.ulTurnaroundLast = ps485->ulTicks;
+            if(ps485->ulTicks > ps485->sStats.ulTurnaroundMax)
             {
-                if(((ulExtClk / ulBaud)%(uldiv+1))<3)
-                {
-                    xHWREG(ulBase + UART_BAUD) &= ~UART_BAUD_DIV_X_M;
-                    xHWREG(ulBase + UART_BAUD) |= (uldiv << UART_BAUD_DIV_X_S);
-                    ultemp = ulExtClk / ulBaud / (uldiv+1) -2;
-                    break;
-                }
+                ps485->sStats.ulTurnaroundMax = ps485->ulTicks;
             }
         }
+        if(ps485->ulState != UART_485_STATE_RX)
+        {
+            continue;
+        }
+        if(psXfer->ulRxLen < psXfer->ulRxSize)
+        {
+            psXfer->pucRxBuf[psXfer->ulRxLen] = ucByte;
+        }
+        psXfer->ulRxLen++;
     }
 
-    xHWREG(ulBase + UART_BAUD) &= ~UART_BAUD_BRD_M;
-    xHWREG(ulBase + UART_BAUD) |= (ultemp << UART_BAUD_BRD_S);
-    
-   
-}
-
-//*****************************************************************************
-//
-//! \brief Gets the current configuration of a UART.
-//!
-//! \param ulBase is the base address of the UART port.
-//! \param pulBaud is a pointer to storage for the baud rate.
-//! \param pulConfig is a pointer to storage for the data format.
-//!
-//! The baud rate and data format for the UART is determined, given an
-//! explicitly provided peripheral clock (hence the ExpClk suffix).  The
-//! returned baud rate is the actual baud rate; it may not be the exact baud
-//! rate requested or an ``official'' baud rate.  The data format returned in
-//! \e pulConfig is enumerated the same as the \e ulConfig parameter of
-//! UARTConfigSetExpClk().
+    if((ulIntStatus & UART_ISR_TOUT_INT) &&
+       (ps485->ulState == UART_485_STATE_RX))
+    {
+        //
+        // 3.5 character gap, the response is complete.
+        //
+        if(psXfer->ulRxLen > psXfer->ulRxSize)
+        {
+            psXfer->ulRxLen = psXfer->ulRxSize;
+            ulStatus = UART_485_XFER_OVERFLOW;
+            ps485->sStats.ulOverflows++;
+        }
+        else if((psXfer->ulFlags & UART_485_XFER_CRC16) &&
+                ((psXfer->ulRxLen < 2) ||
+                 (UART485CRC16(psXfer->pucRxBuf, psXfer->ulRxLen) != 0)))
+        {
+            ulStatus = UART_485_XFER_CRC_ERROR;
+            ps485->sStats.ulCRCErrors++;
+        }
+        else
+        {
+            ulStatus = UART_485_XFER_DONE;
+            ps485->sStats.ulResponses++;
+        }
+        UART485XferEnd(ulBase, ps485, ulStatus);
+    }
+}
+
+//*****************************************************************************
+//
+//! \internal
+//! \brief Arms the Rx PDMA channel of a UART stream.
+//!
+//! \param ulBase is the base address of the UART port.
+//! \param psStream is the stream of the port.
+//!
+//! Points the Rx channel at the active buffer and starts it.
 //!
 //! \return None.
 //
 //*****************************************************************************
-void
-UARTConfigGetExpClk(unsigned long ulBase, 
-                    unsigned long *pulBaud, unsigned long *pulConfig)
+static void
+UARTDMAStreamRxArm(unsigned long ulBase, tUARTDMAStream *psStream)
 {
-    unsigned long ulBaud,ulExtClk;
+    PDMAChannelControlSet(psStream->ulRxChannel, PDMA_WIDTH_8BIT | 
+                          PDMA_SRC_DIR_FIXED | PDMA_DST_DIR_INC | 
+                          PDMA_MODE_PTOM);
+    PDMAChannelTransferSet(psStream->ulRxChannel, 
+                           (void *)(ulBase + UART_RBR), 
+                           psStream->pucRxBuf[psStream->ulRxActive], 
+                           psStream->ulRxLength);
+}
 
-    //
-    // Check the arguments.
-    //
-    xASSERT(UARTBaseValid(ulBase));
+//*****************************************************************************
+//
+//! \internal
+//! \brief Swaps the Rx buffers of a UART stream.
+//!
+//! \param ulIndex is the index of the UART port.
+//! \param ulEvent is \b UART_DMA_EVENT_RX_FULL when the Rx channel finished
+//! a buffer, or \b UART_DMA_EVENT_RX_PARTIAL to flush a partial buffer.
+//!
+//! Restarts the Rx channel on the other buffer and hands the filled one to
+//! the application callback. The swap itself runs with the interrupts
+//! masked, a partial flush may be called from the thread level.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+UARTDMAStreamRxSwap(unsigned long ulIndex, unsigned long ulEvent)
+{
+    tUARTDMAStream *psStream;
+    unsigned long ulBase, ulCount, ulRemain;
+    unsigned char *pucFilled;
+    xtBoolean bMasked;
+
+    bMasked = xIntMasterDisable();
+    psStream = g_psUARTDMAStream[ulIndex];
+    if(psStream == 0)
+    {
+        if(!bMasked)
+        {
+            xIntMasterEnable();
+        }
+        return;
+    }
+    ulBase = (ulIndex == 0) ? UART0_BASE : UART1_BASE;
+    pucFilled = psStream->pucRxBuf[psStream->ulRxActive];
 
-    //
-    // Compute the baud rate.
-    //
-    ulBaud = xHWREG(ulBase + UART_BAUD);
-    ulExtClk = UARTCLkGet();
-    
-    //
-    // See if mode 3 enabled.
-    //
-    if((ulBaud & UART_BAUD_DIV_X_EN) && (ulBaud & UART_BAUD_DIV_X_ONE))
+    if(ulEvent == UART_DMA_EVENT_RX_PARTIAL)
     {
         //
-        // MODE 3 .
+        // Hold the Rx requests while the channel is stopped, bytes arriving
+        // meanwhile wait in the Rx FIFO.
         //
-        *pulBaud = ulExtClk/((ulBaud & UART_BAUD_BRD_M) +2);
-    }
-    else if ((ulBaud & UART_BAUD_DIV_X_EN))
-    {
+        xHWREG(ulBase + UART_IER) &= ~UART_IER_DMA_RX_EN;
+        ulRemain = PDMARemainTransferCountGet(psStream->ulRxChannel);
+        ulCount = psStream->ulRxLength - ulRemain;
+
         //
-        // MODE 2 .
+        // Nothing to flush, or the buffer has just been filled and the TC
+        // interrupt, pending, swaps it.
         //
-        *pulBaud = ulExtClk/((ulBaud & UART_BAUD_BRD_M) +2)/
-                   (((ulBaud & UART_BAUD_DIV_X_M)>>UART_BAUD_DIV_X_S) +1);
+        if((ulCount == 0) || (ulRemain == 0))
+        {
+            xHWREG(ulBase + UART_IER) |= UART_IER_DMA_RX_EN;
+            if(!bMasked)
+            {
+                xIntMasterEnable();
+            }
+            return;
+        }
+        PDMAChannelSoftwareReset(psStream->ulRxChannel);
     }
     else
     {
-        //
-        // MODE 1 .
-        //
-        *pulBaud = ulExtClk/((ulBaud & UART_BAUD_BRD_M) +2)/16;
+        ulCount = psStream->ulRxLength;
     }
 
-    //
-    // Get the parity, data length, and number of stop bits.
-    //
-    *pulConfig = (xHWREG(ulBase + UART_LCR) &
-                  (UART_LCR_SPE | UART_LCR_WLS_M | UART_LCR_NSB |
-                   UART_LCR_EPE | UART_LCR_PBE));
+    psStream->ulRxActive ^= 1;
+    psStream->ulRxPolled = 0;
+    UARTDMAStreamRxArm(ulBase, psStream);
+    xHWREG(ulBase + UART_IER) |= UART_IER_DMA_RX_EN;
+    if(!bMasked)
+    {
+        xIntMasterEnable();
+    }
+
+    if(psStream->pfnCallback != 0)
+    {
+        psStream->pfnCallback(0, ulEvent, ulCount, pucFilled);
+    }
 }
 
 //*****************************************************************************
 //
-//! \brief Enables SIR (IrDA) mode on the specified UART.
-//!
-//! \param ulBase is the base address of the UART port.
+//! \internal
+//! \brief Services a PDMA interrupt of a UART stream.
 //!
-//! Enables the SIREN control bit for IrDA mode on the UART. 
+//! \param ulIndex is the index of the UART port.
+//! \param bRx is \b xtrue for the Rx channel and \b xfalse for Tx.
+//! \param ulStatus is the PDMA event, \b PDMA_EVENT_TC or
+//! \b PDMA_EVENT_ERROR, as passed by PDMAIntHandler().
 //!
 //! \return None.
 //
 //*****************************************************************************
-void
-UARTEnableIrDA(unsigned long ulBase )
+static void
+UARTDMAStreamIntService(unsigned long ulIndex, xtBoolean bRx,
+                        unsigned long ulStatus)
 {
-    //
-    // Check the arguments.
-    //
-    xASSERT(UARTBaseValid(ulBase));
+    tUARTDMAStream *psStream;
 
-    //
-    // Enable SIR.
-    //
-    xHWREG(ulBase + UART_FUN_SEL) |= (UART_FUN_SEL_IRDA_EN);
-    xHWREG(ulBase + UART_FUN_SEL) &= ~(UART_FUN_SEL_LIN_EN);
+    psStream = g_psUARTDMAStream[ulIndex];
+    if(psStream == 0)
+    {
+        return;
+    }
 
+    if(ulStatus & PDMA_EVENT_ERROR)
+    {
+        if(!bRx)
+        {
+            psStream->bTxBusy = xfalse;
+        }
+        if(psStream->pfnCallback != 0)
+        {
+            psStream->pfnCallback(0, UART_DMA_EVENT_ERROR, bRx, 0);
+        }
+    }
+    else if(bRx)
+    {
+        UARTDMAStreamRxSwap(ulIndex, UART_DMA_EVENT_RX_FULL);
+    }
+    else
+    {
+        psStream->bTxBusy = xfalse;
+        if(psStream->pfnCallback != 0)
+        {
+            psStream->pfnCallback(0, UART_DMA_EVENT_TX_DONE, 
+                                  psStream->ulTxLength, psStream->pucTxBuf);
+        }
+    }
 }
 
 //*****************************************************************************
 //
-//! \brief Disables SIR (IrDA) mode on the specified UART.
-//!
-//! \param ulBase is the base address of the UART port.
+//! \internal
+//! \brief PDMA channel callbacks of the UART0 and UART1 streams.
 //!
-//! Clears the SIREN (IrDA) bits.
+//! Each channel gets its own entry, the event comes in \e ulMsgParam.
 //!
-//! \return None.
+//! \return Always 0.
 //
 //*****************************************************************************
-void
-UARTDisableIrDA(unsigned long ulBase)
+static unsigned long
+UART0DMARxCallback(void *pvCBData, unsigned long ulEvent,
+                   unsigned long ulMsgParam, void *pvMsgData)
 {
-    //
-    // Check the arguments.
-    //
-    xASSERT(UARTBaseValid(ulBase));
-
-    //
-    // Disable SIR .
-    //
-    xHWREG(ulBase + UART_FUN_SEL) &= ~(UART_FUN_SEL_IRDA_EN);
+    UARTDMAStreamIntService(0, xtrue, ulMsgParam);
+    return 0;
 }
 
-
-//*****************************************************************************
-//
-//! \brief Open SIR (IrDA) mode on the specified UART.
-//!
-//! \param ulBase is the base address of the UART port.
-//! \param ulConfig is the Config of the UART port in IrDA mode.
-//!
-//! Open the SIREN control bit for IrDA mode on the UART. 
-//!
-//! The \e ulConfig parameter is the logical OR of three values: the IrDA Tx or Rx
-//! Inverse, TX_SELECT.\b UART_CONFIG_IrDA_RX_EN ,and \b 
-//! UART_CONFIG_IrDA_TX_EN is to enable IrDA Rx or Tx.\b UART_CONFIG_IrDA_INV_TX ,
-//! \b UART_CONFIG_IrDA_INV_RX is to Inverse TX output signal or Inverse RX 
-//! input signal.
-//!
-//! \return None.
-//
-//*****************************************************************************
-void
-UARTIrDAConfig(unsigned long ulBase, unsigned long ulConfig)
+static unsigned long
+UART0DMATxCallback(void *pvCBData, unsigned long ulEvent,
+                   unsigned long ulMsgParam, void *pvMsgData)
 {
-    //
-    // Check the arguments.
-    //
-    xASSERT(UARTBaseValid(ulBase));
+    UARTDMAStreamIntService(0, xfalse, ulMsgParam);
+    return 0;
+}
 
-    //
-    // Enable SIR.
-    //
-    UARTEnableIrDA(ulBase);
-    
-    xHWREG(ulBase + UART_IRCR) = (ulConfig);
+static unsigned long
+UART1DMARxCallback(void *pvCBData, unsigned long ulEvent,
+                   unsigned long ulMsgParam, void *pvMsgData)
+{
+    UARTDMAStreamIntService(1, xtrue, ulMsgParam);
+    return 0;
+}
 
+static unsigned long
+UART1DMATxCallback(void *pvCBData, unsigned long ulEvent,
+                   unsigned long ulMsgParam, void *pvMsgData)
+{
+    UARTDMAStreamIntService(1, xfalse, ulMsgParam);
+    return 0;
 }
 
 //*****************************************************************************
 //
-//! \brief Enables LIN Function mode on the specified UART.
+//! \internal
+//! \brief The function is the UART0 and UART2 interrupt service.
 //!
-//! \param ulBase is the base address of the UART port.
+//! \param None.
 //!
-//! Enables the SIREN control bit for LIN Function on the UART. 
+//! This function is a interrupt service routine of UART0 and UART2.
 //!
 //! \return None.
 //
 //*****************************************************************************
-void
-UARTEnableLIN(unsigned long ulBase )
+void 
+UART02IntHandler(void)
 {
-    //
-    // Check the arguments.
-    //
-    xASSERT(UARTBaseValid(ulBase));
+    unsigned long ulUART0IntStatus,ulUART2IntStatus;
 
-    //
-    // Enable LIN Function.
-    //
-    xHWREG(ulBase + UART_FUN_SEL) |= (UART_FUN_SEL_LIN_EN);
-    xHWREG(ulBase + UART_FUN_SEL) &= ~(UART_FUN_SEL_IRDA_EN);
+    ulUART0IntStatus = xHWREG(UART0_BASE + UART_ISR);
+	
+	ulUART2IntStatus = xHWREG(UART2_BASE + UART_ISR);
+
+    if(g_psUART485[0] != 0)
+    {
+        UART485IntService(UART0_BASE, g_psUART485[0], ulUART0IntStatus);
+    }
+    if(g_psUART485[2] != 0)
+    {
+        UART485IntService(UART2_BASE, g_psUART485[2], ulUART2IntStatus);
+    }
+    if(g_psUARTFrame[0] != 0)
+    {
+        UARTFrameIntService(UART0_BASE, g_psUARTFrame[0], ulUART0IntStatus);
+    }
+    if(g_psUARTFrame[2] != 0)
+    {
+        UARTFrameIntService(UART2_BASE, g_psUARTFrame[2], ulUART2IntStatus);
+    }
+    if(g_psUARTRing[0] != 0)
+    {
+        UARTRingIntService(UART0_BASE, g_psUARTRing[0], ulUART0IntStatus);
+    }
+    if(g_psUARTRing[2] != 0)
+    {
+        UARTRingIntService(UART2_BASE, g_psUARTRing[2], ulUART2IntStatus);
+    }
 
+    if(g_pfnUARTHandlerCallbacks[0] != 0)
+	{
+        g_pfnUARTHandlerCallbacks[0](0, 0, ulUART0IntStatus, 0);
+    }
+	if(g_pfnUARTHandlerCallbacks[2] != 0)
+    {
+        g_pfnUARTHandlerCallbacks[2](0, 0, ulUART2IntStatus, 0);
+    }
 }
 
 //*****************************************************************************
 //
-//! \brief Enables 485 Function mode on the specified UART.
+//! \internal
+//! \brief The function is the UART1 interrupt service.
 //!
-//! \param ulBase is the base address of the UART port.
+//! \param None.
 //!
-//! Enables the 485 control bit for 485 Function on the UART. 
+//! This function is a interrupt service routine of UART1
 //!
 //! \return None.
 //
 //*****************************************************************************
-void
-UARTEnable485(unsigned long ulBase )
+void 
+UART1IntHandler(void)
 {
-    //
-    // Check the arguments.
-    //
-    xASSERT(UARTBaseValid(ulBase));
+    unsigned long ulUART1IntStatus;
 
-    //
-    // Enable LIN Function.
-    //
-    xHWREG(ulBase + UART_FUN_SEL) |= (UART_FUN_SEL_LIN_EN);
-    xHWREG(ulBase + UART_FUN_SEL) |= (UART_FUN_SEL_IRDA_EN);
+	ulUART1IntStatus = xHWREG(UART1_BASE + UART_ISR);
+
+    if(g_psUART485[1] != 0)
+    {
+        UART485IntService(UART1_BASE, g_psUART485[1], ulUART1IntStatus);
+    }
+    if(g_psUARTFrame[1] != 0)
+    {
+        UARTFrameIntService(UART1_BASE, g_psUARTFrame[1], ulUART1IntStatus);
+    }
+    if(g_psUARTRing[1] != 0)
+    {
+        UARTRingIntService(UART1_BASE, g_psUARTRing[1], ulUART1IntStatus);
+    }
+
+    if(g_pfnUARTHandlerCallbacks[1] != 0)
+    {
+       g_pfnUARTHandlerCallbacks[1](0, 0, ulUART1IntStatus, 0);
+    }
 
 }
 
 //*****************************************************************************
 //
-//! \brief Disables LIN Function mode on the specified UART.
+//! \internal
+//! \brief The function is used to get Uart clock.
 //!
 //! \param ulBase is the base address of the UART port.
 //!
-//! Clears the LIN Function bits.
+//! This function gets the Uart clock
+//! when set the bandrate of UART.
 //!
-//! \return None.
+//! \return Returns the Current Uart Clock.
 //
 //*****************************************************************************
-void
-UARTDisableLIN(unsigned long ulBase)
+static unsigned long UARTCLkGet(void)
 {
+    unsigned long clk =0 , div;
+    unsigned long ulPLLSrc, ulNF, ulNR, ulNO;
+    unsigned long ulMap[4] = {1, 2, 2, 4};
     //
-    // Check the arguments.
-    //
-    xASSERT(UARTBaseValid(ulBase));
-
+    // Check UART Clock Source Setting.
     //
-    // Disable LIN Function.
+    if(((xHWREG(SYSCLK_CLKSEL1)&SYSCLK_CLKSEL1_UART_M) >> 
+          SYSCLK_CLKSEL1_UART_S) == 0)         
+    {
+        //
+        // Get External Clock From DrvSYS Setting.
+        // 
+        clk = 12000000;          
+    }   
+    else if(((xHWREG(SYSCLK_CLKSEL1)&SYSCLK_CLKSEL1_UART_M) >> 
+               SYSCLK_CLKSEL1_UART_S) == 1)
+    {
+        //
+        // According PLL Clock and UART_Divider to get clock.
+        //                  
+        if((xHWREG(SYSCLK_PLLCON) & SYSCLK_PLLCON_PLL_SRC))
+        {
+            ulPLLSrc = 22000000;
+        }
+        else
+        {
+            ulPLLSrc = 12*1000000;
+        }
+        if ((xHWREG(SYSCLK_PLLCON) & SYSCLK_PLLCON_PD))
+        {
+            clk = 0;
+        }
+        else
+        {
+            ulNF = (xHWREG(SYSCLK_PLLCON) & SYSCLK_PLLCON_FB_DV_M);
+            ulNR = (xHWREG(SYSCLK_PLLCON) & SYSCLK_PLLCON_IN_DV_M) >>          \
+                                           SYSCLK_PLLCON_IN_DV_S;
+            ulNO = (xHWREG(SYSCLK_PLLCON) & SYSCLK_PLLCON_OUT_DV_M) >>          \
+                                           SYSCLK_PLLCON_OUT_DV_S;
+            clk =  ulPLLSrc*(ulNF+2)/(ulNR+2)/(ulMap[ulNO]);
+        }
+    }
     //
-    xHWREG(ulBase + UART_FUN_SEL) &= ~(UART_FUN_SEL_LIN_EN);
+    // Clock 22Mhz.
+    //    
+    else
+        clk = 22000000;  
+
+    div = (xHWREG(SYSCLK_CLKDIV) & SYSCLK_CLKDIV_UART_M) >>
+                                       SYSCLK_CLKDIV_UART_S;
+    return clk/ (div+1);
 }
 
+
 //*****************************************************************************
 //
-//! \brief Open LIN mode on the specified UART.
+//! \brief Sets the type of parity.
 //!
 //! \param ulBase is the base address of the UART port.
-//! \param ulConfig is the Config of the UART port in LIN mode.
-//!
-//! Open the LIN mode for the UART. 
-//!
-//! The \e ulConfig parameter is the logical OR of three values: the LIN Tx or Rx
-//! Mode, the LIN Break Field Length.\b UART_CONFIG_LIN_RX_EN ,and \b 
-//! UART_CONFIG_LIN_TX_EN is to enable LIN Rx or Tx.
+//! \param ulParity specifies the type of parity to use.
+//! 
+//! Sets the type of parity to use for transmitting and expect when receiving.
+//! The \e ulParity parameter must be one of \b UART_CONFIG_PAR_NONE,
+//! \b UART_CONFIG_PAR_EVEN, \b UART_CONFIG_PAR_ODD, \b UART_CONFIG_PAR_ONE,
+//! or \b UART_CONFIG_PAR_ZERO.  The last two allow direct control of the
+//! parity bit; it is always either one or zero based on the mode.
 //!
 //! \return None.
 //
 //*****************************************************************************
 void
-UARTLINConfig(unsigned long ulBase, unsigned long ulBaud, 
-              unsigned long ulConfig)
+UARTParityModeSet(unsigned long ulBase, unsigned long ulParity)
 {
     //
     // Check the arguments.
     //
     xASSERT(UARTBaseValid(ulBase));
-    xASSERT((ulConfig&UART_CONFIG_BKFL_MASK)<16);
-
-    //
-    // Set baud, 8 bit word length, even parity, 2 stop bits (even though the STP2
-    // bit is ignored when in smartcard mode, this lets the caller read back
-    // the actual setting in use).
-    //
-    UARTConfigSetExpClk(ulBase, ulBaud, 
-                        UART_CONFIG_WLEN_8 |
-                        UART_CONFIG_STOP_ONE |
-                        UART_CONFIG_PAR_NONE);
+    xASSERT((ulParity == UART_CONFIG_PAR_NONE) ||
+           (ulParity == UART_CONFIG_PAR_EVEN) ||
+           (ulParity == UART_CONFIG_PAR_ODD) ||
+           (ulParity == UART_CONFIG_PAR_ONE) ||
+           (ulParity == UART_CONFIG_PAR_ZERO));
 
     //
-    // Enable SIR.
+    // Set the parity mode.
     //
-    UARTEnableLIN(ulBase);
-    
-    xHWREG(ulBase + UART_LIN_BCNT) = (ulConfig);
-
+    xHWREG(ulBase + UART_LCR) = ((xHWREG(ulBase + UART_LCR) &
+                                    ~(UART_LCR_PBE | UART_LCR_EPE |
+                                      UART_LCR_SPE)) | ulParity);
 }
 
-
 //*****************************************************************************
 //
-//! \brief Get the know the Tx FIFO is Empty or not from the specified port.
+//! \brief Gets the type of parity currently being used.
 //!
 //! \param ulBase is the base address of the UART port.
 //!
-//! Get the know the Tx FIFO is Empty or not from the specified port.
+//! This function gets the type of parity used for transmitting data and
+//! expected when receiving data.
 //!
-//! \return Returns the xtrue if Tx FIFO is Empty or returns xfalse
-//! \e xtBoolean.
+//! \return Returns the current parity settings, specified as one of
+//! \b UART_CONFIG_PAR_NONE, \b UART_CONFIG_PAR_EVEN, \b UART_CONFIG_PAR_ODD,
+//! \b UART_CONFIG_PAR_ONE, or \b UART_CONFIG_PAR_ZERO.
 //
 //*****************************************************************************
-xtBoolean
-UARTFIFOTxIsEmpty(unsigned long ulBase)
+unsigned long
+UARTParityModeGet(unsigned long ulBase)
 {
     //
     // Check the arguments.
     //
     xASSERT(UARTBaseValid(ulBase));
 
-
     //
-    // Return the Tx FIFO is empty or not.
+    // Return the current parity setting.
     //
-    return((xHWREG(ulBase + UART_FSR) & UART_FSR_TX_EF) ? xtrue : xfalse);
+    return(xHWREG(ulBase + UART_LCR) &
+           (UART_LCR_PBE | UART_LCR_EPE | UART_LCR_SPE));
 }
 
 //*****************************************************************************
 //
-//! \brief Get the know the Tx FIFO is full or not from the specified port.
+//! \brief Sets the Sets the RX FIFO level.
 //!
 //! \param ulBase is the base address of the UART port.
+//! \param ulRxLevel is the transmit FIFO interrupt level, specified as one of
+//! \b UART_FIFO_1BYTES, \b UART_FIFO_4BYTES, \b UART_FIFO_8BYTES,
+//! \b UART_FIFO_14BYTES, \b UART_FIFO_46BYTES, \b UART_FIFO_30BYTES.
+//! or \b UART_FIFO_62BYTES.
 //!
-//! Get the know the Tx FIFO is full or not from the specified port.
+//! This function sets the FIFO level at which  receive interrupts
+//! are generated.
 //!
-//! \return Returns the xtrue if Tx FIFO is full or returns xfalse
-//! \e xtBoolean.
+//! \return None.
 //
 //*****************************************************************************
-xtBoolean
-UARTFIFOTxIsFull(unsigned long ulBase)
+void
+UARTFIFOTriggerLevelSet(unsigned long ulBase, unsigned long ulRxLevel)
 {
     //
     // Check the arguments.
     //
     xASSERT(UARTBaseValid(ulBase));
 
-
     //
-    // Return the Tx FIFO is full or not.
+    // Sets the RX FIFO level.
     //
-    return((xHWREG(ulBase + UART_FSR) & UART_FSR_TX_FF) ? xtrue : xfalse);
+    xHWREG(ulBase + UART_FCR) &= (~(UART_FCR_RFITL_M ));
+    xHWREG(ulBase + UART_FCR) |= ((ulRxLevel ));
 }
 
 //*****************************************************************************
 //
-//! \brief Get the know the Tx FIFO length from the specified port.
+//! \brief Gets the Rx FIFO level at which interrupts are generated.
 //!
 //! \param ulBase is the base address of the UART port.
+//! \param pulRxLevel is a pointer to storage for the receive FIFO level,
+//! returned as one of 
+//! \b UART_FIFO_1BYTES, \b UART_FIFO_4BYTES, \b UART_FIFO_8BYTES,
+//! \b UART_FIFO_14BYTES, \b UART_FIFO_46BYTES, \b UART_FIFO_30BYTES.
+//! or \b UART_FIFO_62BYTES.
 //!
-//! Get the know the Tx FIFO length from the specified port.
+//! This function gets the Rx FIFO level at which receive interrupts
+//! are generated.
 //!
-//! \return Returns the length of Tx FIFO
-//! \e long.
+//! \return None.
 //
 //*****************************************************************************
-long
-UARTFIFOTxLength(unsigned long ulBase)
+void
+UARTFIFOTriggerLevelGet(unsigned long ulBase, unsigned long *pulRxLevel)
 {
+    unsigned long ulTemp;
+
     //
     // Check the arguments.
     //
     xASSERT(UARTBaseValid(ulBase));
 
+    //
+    // Read the FIFO level register.
+    //
+    ulTemp = xHWREG(ulBase + UART_FCR);
 
     //
-    // Return the Tx FIFO length.
+    // Extract the transmit and receive FIFO levels.
     //
-    return((xHWREG(ulBase + UART_FSR) & UART_FSR_TXP_M) >> UART_FSR_TXP_S);
+    *pulRxLevel = ulTemp & UART_FCR_RFITL_M;
 }
 
 //*****************************************************************************
 //
-//! \brief Get the know the Rx FIFO is Empty or not from the specified port.
+//! \brief Sets the configuration of a UART.
 //!
 //! \param ulBase is the base address of the UART port.
+//! \param ulBaud is the desired baud rate.
+//! \param ulConfig is the data format for the port (number of data bits,
+//! number of stop bits, and parity).
 //!
-//! Get the know the Rx FIFO is Empty or not from the specified port.
+//! This function configures the UART for operation in the specified data
+//! format.  The baud rate is provided in the \e ulBaud parameter and the data
+//! format in the \e ulConfig parameter.
 //!
-//! \return Returns the xtrue if Rx FIFO is Empty or returns xfalse
-//! \e xtBoolean.
+//! The \e ulConfig parameter is the logical OR of three values: the number of
+//! data bits, the number of stop bits, and the parity.  \b UART_CONFIG_WLEN_8,
+//! \b UART_CONFIG_WLEN_7, \b UART_CONFIG_WLEN_6, and \b UART_CONFIG_WLEN_5
+//! select from eight to five data bits per byte (respectively).
+//! \b UART_CONFIG_STOP_ONE and \b UART_CONFIG_STOP_TWO select one or two stop
+//! bits (respectively).  \b UART_CONFIG_PAR_NONE, \b UART_CONFIG_PAR_EVEN,
+//! \b UART_CONFIG_PAR_ODD, \b UART_CONFIG_PAR_ONE, and \b UART_CONFIG_PAR_ZERO
+//! select the parity mode (no parity bit, even parity bit, odd parity bit,
+//! parity bit always one, and parity bit always zero, respectively).
+//!
+//! If \e ulBaud is out of reach of the UART clock, the fastest or the
+//! slowest divider is used, whichever is closer.
+//!
+//! \return None.
 //
 //*****************************************************************************
-xtBoolean
-UARTFIFORxIsEmpty(unsigned long ulBase)
+void
+UARTConfigSetExpClk(unsigned long ulBase, 
+                    unsigned long ulBaud, unsigned long ulConfig)
 {
+    tUARTBaudPlan sPlan;
+
     //
     // Check the arguments.
     //
     xASSERT(UARTBaseValid(ulBase));
+    xASSERT(ulBaud != 0);
+    //xASSERT(ulUARTClk >= (ulBaud * UART_CLK_DIVIDER));
 
+    //
+    // Reset UART.
+    //
+    if (ulBase == UART0_BASE)
+    {
+        SysCtlPeripheralReset(SYSCTL_PERIPH_UART0);
+        SysCtlPeripheralClockSourceSet(SYSCTL_PERIPH_UART_S_EXT12M);
+    }
+    else if (ulBase == UART1_BASE)
+    {
+        SysCtlPeripheralReset(SYSCTL_PERIPH_UART1);
+        SysCtlPeripheralClockSourceSet(SYSCTL_PERIPH_UART_S_EXT12M);
+    }
+    else 
+    {
+        SysCtlPeripheralReset(SYSCTL_PERIPH_UART2);
+        SysCtlPeripheralClockSourceSet(SYSCTL_PERIPH_UART_S_EXT12M);
+    }
 
     //
-    // Return the Rx FIFO is empty or not.
+    // Tx FIFO Reset & Rx FIFO Reset & FIFO Mode Enable .
+    //    
+    xHWREG(ulBase + UART_FCR) |= UART_FCR_RX_RST | UART_FCR_TX_RST;
+
     //
-    return((xHWREG(ulBase + UART_FSR) & UART_FSR_RX_EF) ? xtrue : xfalse);
+    // Set Parity & Data bits & Stop bits .
+    //  
+    xHWREG(ulBase + UART_LCR) = ulConfig;
+
+    //
+    // Set the closest divider, or the end of the range nearest to a baud
+    // rate the UART clock cannot reach.
+    //
+    if(UARTBaudPlanCompute(ulBaud, &sPlan))
+    {
+        xHWREG(ulBase + UART_BAUD) = sPlan.ulBaudReg;
+    }
+    else if(ulBaud > UARTCLkGet() / 16)
+    {
+        xHWREG(ulBase + UART_BAUD) = UART_BAUD_DIV_X_EN | UART_BAUD_DIV_X_ONE |
+                                     (3 << UART_BAUD_BRD_S);
+    }
+    else
+    {
+        xHWREG(ulBase + UART_BAUD) = UART_BAUD_BRD_M << UART_BAUD_BRD_S;
+    }
 }
 
 //*****************************************************************************
 //
-//! \brief Get the know the Rx FIFO is full or not from the specified port.
+//! \brief Gets the current configuration of a UART.
 //!
 //! \param ulBase is the base address of the UART port.
+//! \param pulBaud is a pointer to storage for the baud rate.
+//! \param pulConfig is a pointer to storage for the data format.
 //!
-//! Get the know the Rx FIFO is full or not from the specified port.
+//! The baud rate and data format for the UART is determined, given an
+//! explicitly provided peripheral clock (hence the ExpClk suffix).  The
+//! returned baud rate is the actual baud rate; it may not be the exact baud
+//! rate requested or an ``official'' baud rate.  The data format returned in
+//! \e pulConfig is enumerated the same as the \e ulConfig parameter of
+//! UARTConfigSetExpClk().
 //!
-//! \return Returns the xtrue if Rx FIFO is full or returns xfalse
-//! \e xtBoolean.
+//! \return None.
 //
 //*****************************************************************************
-xtBoolean
-UARTFIFORxIsFull(unsigned long ulBase)
+void
+UARTConfigGetExpClk(unsigned long ulBase, 
+                    unsigned long *pulBaud, unsigned long *pulConfig)
 {
+    unsigned long ulBaud,ulExtClk;
+
     //
     // Check the arguments.
     //
     xASSERT(UARTBaseValid(ulBase));
 
+    //
+    // Compute the baud rate.
+    //
+    ulBaud = xHWREG(ulBase + UART_BAUD);
+    ulExtClk = UARTCLkGet();
+    
+    //
+    // See if mode 3 enabled.
+    //
+    if((ulBaud & UART_BAUD_DIV_X_EN) && (ulBaud & UART_BAUD_DIV_X_ONE))
+    {
+        //
+        // MODE 3 .
+        //
+        *pulBaud = ulExtClk/((ulBaud & UART_BAUD_BRD_M) +2);
+    }
+    else if ((ulBaud & UART_BAUD_DIV_X_EN))
+    {
+        //
+        // MODE 2 .
+        //
+        *pulBaud = ulExtClk/((ulBaud & UART_BAUD_BRD_M) +2)/
+                   (((ulBaud & UART_BAUD_DIV_X_M)>>UART_BAUD_DIV_X_S) +1);
+    }
+    else
+    {
+        //
+        // MODE 1 .
+        //
+        *pulBaud = ulExtClk/((ulBaud & UART_BAUD_BRD_M) +2)/16;
+    }
 
     //
-    // Return the Rx FIFO is full or not.
+    // Get the parity, data length, and number of stop bits.
     //
-    return((xHWREG(ulBase + UART_FSR) & UART_FSR_RX_FF) ? xtrue : xfalse);
+    *pulConfig = (xHWREG(ulBase + UART_LCR) &
+                  (UART_LCR_SPE | UART_LCR_WLS_M | UART_LCR_NSB |
+                   UART_LCR_EPE | UART_LCR_PBE));
 }
 
 //*****************************************************************************
 //
-//! \brief Get the know the Rx FIFO length from the specified port.
+//! \brief Enables SIR (IrDA) mode on the specified UART.
 //!
 //! \param ulBase is the base address of the UART port.
 //!
-//! Get the know the Rx FIFO length from the specified port.
+//! Enables the SIREN control bit for IrDA mode on the UART. 
 //!
-//! \return Returns the length of Rx FIFO
-//! \e long.
+//! \return None.
 //
 //*****************************************************************************
-long
-UARTFIFORxLength(unsigned long ulBase)
+void
+UARTEnableIrDA(unsigned long ulBase )
 {
     //
     // Check the arguments.
     //
     xASSERT(UARTBaseValid(ulBase));
 
-
     //
-    // Return the Rx FIFO length.
+    // Enable SIR.
     //
-    return((xHWREG(ulBase + UART_FSR) & UART_FSR_RXP_M) >> UART_FSR_RXP_S);
+    xHWREG(ulBase + UART_FUN_SEL) |= (UART_FUN_SEL_IRDA_EN);
+    xHWREG(ulBase + UART_FUN_SEL) &= ~(UART_FUN_SEL_LIN_EN);
+
 }
 
 //*****************************************************************************
 //
-//! \brief Receives a character from the specified port.
+//! \brief Disables SIR (IrDA) mode on the specified UART.
 //!
 //! \param ulBase is the base address of the UART port.
 //!
-//! Gets a character from the receive FIFO for the specified port.
+//! Clears the SIREN (IrDA) bits.
 //!
-//! \return Returns the character read from the specified port, cast as a
-//! \e long.  A \b -1 is returned if there are no characters present in the
-//! receive FIFO.  The UARTCharsAvail() function should be called before
-//! attempting to call this function.
+//! \return None.
 //
 //*****************************************************************************
-long
-UARTCharGetNonBlocking(unsigned long ulBase)
+void
+UARTDisableIrDA(unsigned long ulBase)
 {
     //
     // Check the arguments.
@@ -934,40 +1584,32 @@ UARTCharGetNonBlocking(unsigned long ulBase)
     xASSERT(UARTBaseValid(ulBase));
 
     //
-    // See if there are any characters in the receive FIFO.
+    // Disable SIR .
     //
-    if(!(xHWREG(ulBase + UART_FSR) & UART_FSR_RX_EF))
-    {
-        //
-        // Read and return the next character.
-        //
-        return(xHWREG(ulBase + UART_RBR));
-    }
-    else
-    {
-        //
-        // There are no characters, so return a failure.
-        //
-        return(-1);
-    }
+    xHWREG(ulBase + UART_FUN_SEL) &= ~(UART_FUN_SEL_IRDA_EN);
 }
 
+
 //*****************************************************************************
 //
-//! \brief Waits for a character from the specified port.
+//! \brief Open SIR (IrDA) mode on the specified UART.
 //!
 //! \param ulBase is the base address of the UART port.
+//! \param ulConfig is the Config of the UART port in IrDA mode.
 //!
-//! Gets a character from the receive FIFO for the specified port.  If there
-//! are no characters available, this function waits until a character is
-//! received before returning.
+//! Open the SIREN control bit for IrDA mode on the UART. 
 //!
-//! \return Returns the character read from the specified port, cast as a
-//! \e long.
+//! The \e ulConfig parameter is the logical OR of three values: the IrDA Tx or Rx
+//! Inverse, TX_SELECT.\b UART_CONFIG_IrDA_RX_EN ,and \b 
+//! UART_CONFIG_IrDA_TX_EN is to enable IrDA Rx or Tx.\b UART_CONFIG_IrDA_INV_TX ,
+//! \b UART_CONFIG_IrDA_INV_RX is to Inverse TX output signal or Inverse RX 
+//! input signal.
+//!
+//! \return None.
 //
 //*****************************************************************************
-long
-UARTCharGet(unsigned long ulBase)
+void
+UARTIrDAConfig(unsigned long ulBase, unsigned long ulConfig)
 {
     //
     // Check the arguments.
@@ -975,74 +1617,54 @@ UARTCharGet(unsigned long ulBase)
     xASSERT(UARTBaseValid(ulBase));
 
     //
-    // Wait until a char is available.
+    // Enable SIR.
     //
-    while(xHWREG(ulBase + UART_FSR) & UART_FSR_RX_EF)
-    {
-    }
+    UARTEnableIrDA(ulBase);
+    
+    xHWREG(ulBase + UART_IRCR) = (ulConfig);
 
-    //
-    // Now get the char.
-    //
-    return(xHWREG(ulBase + UART_RBR));
 }
 
 //*****************************************************************************
 //
-//! \brief Read ulLength characters from the specified port.
+//! \brief Enables LIN Function mode on the specified UART.
 //!
 //! \param ulBase is the base address of the UART port.
-//! \param ucBuffer is the point of read buffer.
-//! \param ulBase is the length of read buffer.
 //!
-//! Read some character from the receive FIFO for the specified port.  If there
-//! are no characters available, this function waits until a character is
-//! received before returning.
+//! Enables the SIREN control bit for LIN Function on the UART. 
 //!
-//! \return xtrue
+//! \return None.
 //
 //*****************************************************************************
 void
-UARTBufferRead(unsigned long ulBase, unsigned char *ucBuffer,
-               unsigned long ulLength)
+UARTEnableLIN(unsigned long ulBase )
 {
-    unsigned long ulCount;
     //
     // Check the arguments.
     //
     xASSERT(UARTBaseValid(ulBase));
 
     //
-    // Wait until a char is available.
+    // Enable LIN Function.
     //
-    for (ulCount=0; ulCount<ulLength; ulCount++)
-    {
-        while(xHWREG(ulBase + UART_FSR) & UART_FSR_RX_EF)
-        {
-        }
-        ucBuffer[ulCount] = xHWREG(ulBase + UART_RBR);
-    }
-}
+    xHWREG(ulBase + UART_FUN_SEL) |= (UART_FUN_SEL_LIN_EN);
+    xHWREG(ulBase + UART_FUN_SEL) &= ~(UART_FUN_SEL_IRDA_EN);
 
+}
 
 //*****************************************************************************
 //
-//! \brief Sends a character to the specified port.
+//! \brief Enables 485 Function mode on the specified UART.
 //!
 //! \param ulBase is the base address of the UART port.
-//! \param ucData is the character to be transmitted.
 //!
-//! Writes the character \e ucData to the transmit FIFO for the specified port.
-//! This function does not block, so if there is no space available, then a
-//! \b false is returned, and the application must retry the function later.
+//! Enables the 485 control bit for 485 Function on the UART. 
 //!
-//! \return Returns \b true if the character was successfully placed in the
-//! transmit FIFO or \b false if there was no space available in the transmit
-//! FIFO.
+//! \return None.
 //
 //*****************************************************************************
-xtBoolean
-UARTCharPutNonBlocking(unsigned long ulBase, unsigned char ucData)
+void
+UARTEnable485(unsigned long ulBase )
 {
     //
     // Check the arguments.
@@ -1050,45 +1672,26 @@ UARTCharPutNonBlocking(unsigned long ulBase, unsigned char ucData)
     xASSERT(UARTBaseValid(ulBase));
 
     //
-    // See if there is space in the transmit FIFO.
+    // Enable LIN Function.
     //
-    if(!(xHWREG(ulBase + UART_FSR) & UART_FSR_TX_FF))
-    {
-        //
-        // Write this character to the transmit FIFO.
-        //
-        xHWREG(ulBase + UART_THR) = ucData;
+    xHWREG(ulBase + UART_FUN_SEL) |= (UART_FUN_SEL_LIN_EN);
+    xHWREG(ulBase + UART_FUN_SEL) |= (UART_FUN_SEL_IRDA_EN);
 
-        //
-        // Success.
-        //
-        return(xtrue);
-    }
-    else
-    {
-        //
-        // There is no space in the transmit FIFO, so return a failure.
-        //
-        return(xfalse);
-    }
 }
 
 //*****************************************************************************
 //
-//! \brief Waits to send a character from the specified port.
+//! \brief Disables LIN Function mode on the specified UART.
 //!
 //! \param ulBase is the base address of the UART port.
-//! \param ucData is the character to be transmitted.
 //!
-//! Sends the character \e ucData to the transmit FIFO for the specified port.
-//! If there is no space available in the transmit FIFO, this function waits
-//! until there is space available before returning.
+//! Clears the LIN Function bits.
 //!
 //! \return None.
 //
 //*****************************************************************************
 void
-UARTCharPut(unsigned long ulBase, unsigned char ucData)
+UARTDisableLIN(unsigned long ulBase)
 {
     //
     // Check the arguments.
@@ -1096,291 +1699,235 @@ UARTCharPut(unsigned long ulBase, unsigned char ucData)
     xASSERT(UARTBaseValid(ulBase));
 
     //
-    // Wait until space is available.
-    //
-    while(xHWREG(ulBase + UART_FSR) & UART_FSR_TX_FF)
-    {
-    }
-
-    //
-    // Send the char.
+    // Disable LIN Function.
     //
-    xHWREG(ulBase + UART_THR) = ucData;
+    xHWREG(ulBase + UART_FUN_SEL) &= ~(UART_FUN_SEL_LIN_EN);
 }
 
-
 //*****************************************************************************
 //
-//! \brief Waits to send a character from the specified port.
+//! \brief Open LIN mode on the specified UART.
 //!
 //! \param ulBase is the base address of the UART port.
-//! \param ucData is the character to be transmitted.
+//! \param ulConfig is the Config of the UART port in LIN mode.
 //!
-//! Sends the character \e ucData to the transmit FIFO for the specified port.
-//! If there is no space available in the transmit FIFO, this function waits
-//! until there is space available before returning.
+//! Open the LIN mode for the UART. 
+//!
+//! The \e ulConfig parameter is the logical OR of three values: the LIN Tx or Rx
+//! Mode, the LIN Break Field Length.\b UART_CONFIG_LIN_RX_EN ,and \b 
+//! UART_CONFIG_LIN_TX_EN is to enable LIN Rx or Tx.
 //!
 //! \return None.
 //
 //*****************************************************************************
 void
-UARTBufferWrite(unsigned long ulBase, unsigned char *ucBuffer,
-                unsigned long ulLength)
+UARTLINConfig(unsigned long ulBase, unsigned long ulBaud, 
+              unsigned long ulConfig)
 {
-    
-    unsigned long ulCount;
     //
     // Check the arguments.
     //
     xASSERT(UARTBaseValid(ulBase));
+    xASSERT((ulConfig&UART_CONFIG_BKFL_MASK)<16);
 
     //
-    // Wait until a char is available.
+    // Set baud, 8 bit word length, even parity, 2 stop bits (even though the STP2
+    // bit is ignored when in smartcard mode, this lets the caller read back
+    // the actual setting in use).
     //
-    for (ulCount=0; ulCount<ulLength; ulCount++)
-    {
-        while((xHWREG(ulBase + UART_FSR) & UART_FSR_TX_FF))
-        {
-        }
-        xHWREG(ulBase + UART_THR) = ucBuffer[ulCount];
-    }
+    UARTConfigSetExpClk(ulBase, ulBaud, 
+                        UART_CONFIG_WLEN_8 |
+                        UART_CONFIG_STOP_ONE |
+                        UART_CONFIG_PAR_NONE);
+
+    //
+    // Enable SIR.
+    //
+    UARTEnableLIN(ulBase);
+    
+    xHWREG(ulBase + UART_LIN_BCNT) = (ulConfig);
+
 }
 
+
 //*****************************************************************************
 //
-//! \brief Causes a BREAK to be sent.
+//! \brief Get the know the Tx FIFO is Empty or not from the specified port.
 //!
 //! \param ulBase is the base address of the UART port.
-//! \param bBreakState controls the output level.
 //!
-//! Calling this function with \e bBreakState set to \b true asserts a break
-//! condition on the UART.  Calling this function with \e bBreakState set to
-//! \b false removes the break condition.  For proper transmission of a break
-//! command, the break must be asserted for at least two complete frames.
+//! Get the know the Tx FIFO is Empty or not from the specified port.
 //!
-//! \return None.
+//! \return Returns the xtrue if Tx FIFO is Empty or returns xfalse
+//! \e xtBoolean.
 //
 //*****************************************************************************
-void
-UARTBreakCtl(unsigned long ulBase, xtBoolean bBreakState)
+xtBoolean
+UARTFIFOTxIsEmpty(unsigned long ulBase)
 {
     //
     // Check the arguments.
     //
     xASSERT(UARTBaseValid(ulBase));
 
+
     //
-    // Set the break condition as requested.
+    // Return the Tx FIFO is empty or not.
     //
-    xHWREG(ulBase + UART_LCR) =
-        (bBreakState ?
-         (xHWREG(ulBase + UART_LCR) | UART_LCR_BCB) :
-         (xHWREG(ulBase + UART_LCR) & ~(UART_LCR_BCB)));
+    return((xHWREG(ulBase + UART_FSR) & UART_FSR_TX_EF) ? xtrue : xfalse);
 }
 
 //*****************************************************************************
 //
-//! \brief Enables individual UART interrupt sources.
+//! \brief Get the know the Tx FIFO is full or not from the specified port.
 //!
 //! \param ulBase is the base address of the UART port.
-//! \param ulIntFlags is the bit mask of the interrupt sources to be enabled.
-//!
-//! Enables the indicated UART interrupt sources.  Only the sources that are
-//! enabled can be reflected to the processor interrupt; disabled sources have
-//! no effect on the processor.
-//!
-//! The \e ulIntFlags parameter is the logical OR of any of the following:
 //!
-//! - \b UART_INT_LIN    - LIN RX Break Field Detected Interrupt
-//! - \b UART_INT_WAKEUP - Wake up CPU function
-//! - \b UART_INT_BUFERR - Buffer Error Interrupt
-//! - \b UART_INT_RTO    - Rx Time out Interrupt
-//! - \b UART_INT_MOS    - RModem Status Interrupt
-//! - \b UART_INT_RLS    - Receive Line Status Interrupt
-//! - \b UART_INT_THRE   - Transmit Holding Register Empty
-//! - \b UART_INT_RDA    - Receive Data Available Interrupt
+//! Get the know the Tx FIFO is full or not from the specified port.
 //!
-//! \return None.
+//! \return Returns the xtrue if Tx FIFO is full or returns xfalse
+//! \e xtBoolean.
 //
 //*****************************************************************************
-void
-UARTIntEnable(unsigned long ulBase, unsigned long ulIntFlags)
+xtBoolean
+UARTFIFOTxIsFull(unsigned long ulBase)
 {
     //
     // Check the arguments.
     //
     xASSERT(UARTBaseValid(ulBase));
 
+
     //
-    // Enable the specified interrupts.
+    // Return the Tx FIFO is full or not.
     //
-    xHWREG(ulBase + UART_IER) |= ulIntFlags;
+    return((xHWREG(ulBase + UART_FSR) & UART_FSR_TX_FF) ? xtrue : xfalse);
 }
 
 //*****************************************************************************
 //
-//! \brief Init interrupts callback for the specified UART Port.
+//! \brief Get the know the Tx FIFO length from the specified port.
 //!
-//! \param ulPort is the base address of the UART port.
-//! \param xtI2CCallback is callback for the specified UART Port.
+//! \param ulBase is the base address of the UART port.
 //!
-//! Init interrupts callback for the specified UART Port.
+//! Get the know the Tx FIFO length from the specified port.
 //!
-//! \return None.
+//! \return Returns the length of Tx FIFO
+//! \e long.
 //
 //*****************************************************************************
-void
-UARTIntCallbackInit(unsigned long ulBase, 
-                    xtEventCallback xtUARTCallback)
+long
+UARTFIFOTxLength(unsigned long ulBase)
 {
     //
     // Check the arguments.
     //
     xASSERT(UARTBaseValid(ulBase));
 
-    if (ulBase == UART0_BASE)
-    {
-        g_pfnUARTHandlerCallbacks[0] = xtUARTCallback;
-    }
-    else if (ulBase == UART1_BASE)
-    {
-        g_pfnUARTHandlerCallbacks[1] = xtUARTCallback;    
-    }
-    else
-    {
-        g_pfnUARTHandlerCallbacks[2] = xtUARTCallback;
-    }
+
+    //
+    // Return the Tx FIFO length.
+    //
+    return((xHWREG(ulBase + UART_FSR) & UART_FSR_TXP_M) >> UART_FSR_TXP_S);
 }
 
 //*****************************************************************************
 //
-//! \brief Enables individual UART interrupt sources.
+//! \brief Get the know the Rx FIFO is Empty or not from the specified port.
 //!
 //! \param ulBase is the base address of the UART port.
-//! \param ulIntFlags is the bit mask of the interrupt sources to be enabled.
-//!
-//! Enables the indicated UART interrupt sources.  Only the sources that are
-//! enabled can be reflected to the processor interrupt; disabled sources have
-//! no effect on the processor.
-//!
-//! The \e ulIntFlags parameter is the one of any of the following:
 //!
-//! - \b UART_INT_LIN    - LIN RX Break Field Detected Interrupt
-//! - \b UART_INT_WAKEUP - Wake up CPU function
-//! - \b UART_INT_BUFERR - Buffer Error Interrupt
-//! - \b UART_INT_RTO    - Rx Time out Interrupt
-//! - \b UART_INT_MOS    - RModem Status Interrupt
-//! - \b UART_INT_RLS    - Receive Line Status Interrupt
-//! - \b UART_INT_THRE   - Transmit Holding Register Empty
-//! - \b UART_INT_RDA    - Receive Data Available Interrupt
+//! Get the know the Rx FIFO is Empty or not from the specified port.
 //!
-//! \return None.
+//! \return Returns the xtrue if Rx FIFO is Empty or returns xfalse
+//! \e xtBoolean.
 //
 //*****************************************************************************
 xtBoolean
-UARTIntEnableGet(unsigned long ulBase, unsigned long ulIntFlags)
+UARTFIFORxIsEmpty(unsigned long ulBase)
 {
     //
     // Check the arguments.
     //
     xASSERT(UARTBaseValid(ulBase));
 
+
     //
-    // Get enable the specified interrupts.
+    // Return the Rx FIFO is empty or not.
     //
-    return (xHWREG(ulBase + UART_IER) & (ulIntFlags & 0xFF)) ? xtrue : xfalse;
+    return((xHWREG(ulBase + UART_FSR) & UART_FSR_RX_EF) ? xtrue : xfalse);
 }
 
-
 //*****************************************************************************
 //
-//! \brief Disables individual UART interrupt sources.
+//! \brief Get the know the Rx FIFO is full or not from the specified port.
 //!
 //! \param ulBase is the base address of the UART port.
-//! \param ulIntFlags is the bit mask of the interrupt sources to be disabled.
 //!
-//! Disables the indicated UART interrupt sources.  Only the sources that are
-//! enabled can be reflected to the processor interrupt; disabled sources have
-//! no effect on the processor.
-//!
-//! The \e ulIntFlags parameter has the same definition as the \e ulIntFlags
-//! parameter to UARTIntEnable().
+//! Get the know the Rx FIFO is full or not from the specified port.
 //!
-//! \return None.
+//! \return Returns the xtrue if Rx FIFO is full or returns xfalse
+//! \e xtBoolean.
 //
 //*****************************************************************************
-void
-UARTIntDisable(unsigned long ulBase, unsigned long ulIntFlags)
+xtBoolean
+UARTFIFORxIsFull(unsigned long ulBase)
 {
     //
     // Check the arguments.
     //
     xASSERT(UARTBaseValid(ulBase));
 
+
     //
-    // Disable the specified interrupts.
+    // Return the Rx FIFO is full or not.
     //
-    xHWREG(ulBase + UART_IER) &= ~(ulIntFlags);
+    return((xHWREG(ulBase + UART_FSR) & UART_FSR_RX_FF) ? xtrue : xfalse);
 }
 
-
 //*****************************************************************************
 //
-//! \brief Gets the current interrupt status.
+//! \brief Get the know the Rx FIFO length from the specified port.
 //!
 //! \param ulBase is the base address of the UART port.
-//! \param bMasked is \b false if the raw interrupt status is required and
-//! \b true if the masked interrupt status is required.
 //!
-//! This returns the interrupt status for the specified UART.  Either the raw
-//! interrupt status or the status of interrupts that are allowed to reflect to
-//! the processor can be returned.
+//! Get the know the Rx FIFO length from the specified port.
 //!
-//! \return Returns the current interrupt status, enumerated as a bit field of
-//! values described in UARTIntEnable().
+//! \return Returns the length of Rx FIFO
+//! \e long.
 //
 //*****************************************************************************
-unsigned long
-UARTIntStatus(unsigned long ulBase, xtBoolean bMasked)
+long
+UARTFIFORxLength(unsigned long ulBase)
 {
     //
     // Check the arguments.
     //
     xASSERT(UARTBaseValid(ulBase));
 
+
     //
-    // Return either the interrupt status or the raw interrupt status as
-    // requested.
+    // Return the Rx FIFO length.
     //
-    if(bMasked)
-    {
-        return(xHWREG(ulBase + UART_ISR));
-    }
-    else
-    {
-        return(xHWREG(ulBase + UART_ISR));
-    }
+    return((xHWREG(ulBase + UART_FSR) & UART_FSR_RXP_M) >> UART_FSR_RXP_S);
 }
 
 //*****************************************************************************
 //
-//! \brief Clears UART interrupt sources.
+//! \brief Receives a character from the specified port.
 //!
 //! \param ulBase is the base address of the UART port.
-//! \param ulIntFlags is a bit mask of the interrupt sources to be cleared.
-//!
-//! The specified UART interrupt sources are cleared, so that they no longer
-//! assert.  This function must be called in the interrupt handler to keep the
-//! interrupt from being recognized again immediately upon exit.
 //!
-//! The \e ulIntFlags parameter has the same definition as the \e ulIntFlags
-//! parameter to UARTIntEnable().
+//! Gets a character from the receive FIFO for the specified port.
 //!
-//! \return None.
+//! \return Returns the character read from the specified port, cast as a
+//! \e long.  A \b -1 is returned if there are no characters present in the
+//! receive FIFO.  The UARTCharsAvail() function should be called before
+//! attempting to call this function.
 //
 //*****************************************************************************
-void
-UARTIntClear(unsigned long ulBase, unsigned long ulIntFlags)
+long
+UARTCharGetNonBlocking(unsigned long ulBase)
 {
     //
     // Check the arguments.
@@ -1388,62 +1935,40 @@ UARTIntClear(unsigned long ulBase, unsigned long ulIntFlags)
     xASSERT(UARTBaseValid(ulBase));
 
     //
-    // Clear the requested interrupt sources.
+    // See if there are any characters in the receive FIFO.
     //
-    if ((ulIntFlags & UART_INT_RDA) == UART_INT_RDA)
-    {
-        xHWREG(ulBase + UART_RBR);
-    }
-    if ((ulIntFlags & UART_INT_THRE) == UART_INT_THRE)
-    {
-        xHWREG(ulBase + UART_RBR) = 0;
-    }
-    if ((ulIntFlags & UART_INT_RLS) == UART_INT_RLS)
-    {
-        xHWREG(ulBase + UART_FSR) |= UART_FSR_BIF | UART_FSR_FEF | 
-                                     UART_FSR_PEF;
-    }
-    if ((ulIntFlags & UART_INT_MOS) == UART_INT_MOS)
-    {
-        xHWREG(ulBase + UART_MSR) |= UART_MSR_DCTSF;
-    }
-    if ((ulIntFlags & UART_INT_RTO) == UART_INT_RTO)
-    {
-        xHWREG(ulBase + UART_RBR);
-    }
-    if ((ulIntFlags & UART_INT_LIN) == UART_INT_LIN)
+    if(!(xHWREG(ulBase + UART_FSR) & UART_FSR_RX_EF))
     {
-        xHWREG(ulBase + UART_ISR) |= UART_ISR_LINRXB_IF;
+        //
+        // Read and return the next character.
+        //
+        return(xHWREG(ulBase + UART_RBR));
     }
-    if ((ulIntFlags & UART_INT_BUFERR) == UART_INT_BUFERR)
+    else
     {
-        xHWREG(ulBase + UART_FSR) |= UART_FSR_TXO_IF | UART_FSR_RXOIF;
+        //
+        // There are no characters, so return a failure.
+        //
+        return(-1);
     }
 }
 
 //*****************************************************************************
 //
-//! \brief Enable UART DMA operation.
+//! \brief Waits for a character from the specified port.
 //!
 //! \param ulBase is the base address of the UART port.
-//! \param ulDMAFlags is a bit mask of the DMA features to enable.
-//!
-//! The specified UART DMA features are enabled.  The UART can be
-//! configured to use DMA for transmit or receive, and to disable
-//! receive if an error occurs.  The \e ulDMAFlags parameter is the
-//! logical OR of any of the following values:
-//!
-//! - UART_DMA_RX - enable DMA for receive
-//! - UART_DMA_TX - enable DMA for transmit
 //!
-//! \note The uDMA controller must also be set up before DMA can be used
-//! with the UART.
+//! Gets a character from the receive FIFO for the specified port.  If there
+//! are no characters available, this function waits until a character is
+//! received before returning.
 //!
-//! \return None.
+//! \return Returns the character read from the specified port, cast as a
+//! \e long.
 //
 //*****************************************************************************
-void
-UARTDMAEnable(unsigned long ulBase, unsigned long ulDMAFlags)
+long
+UARTCharGet(unsigned long ulBase)
 {
     //
     // Check the arguments.
@@ -1451,286 +1976,310 @@ UARTDMAEnable(unsigned long ulBase, unsigned long ulDMAFlags)
     xASSERT(UARTBaseValid(ulBase));
 
     //
-    // Set the requested bits in the UART DMA control register.
+    // Wait until a char is available.
     //
-    xHWREG(ulBase + UART_IER) |= ulDMAFlags;
+    while(xHWREG(ulBase + UART_FSR) & UART_FSR_RX_EF)
+    {
+    }
+
+    //
+    // Now get the char.
+    //
+    return(xHWREG(ulBase + UART_RBR));
 }
 
 //*****************************************************************************
 //
-//! \brief Disable UART DMA operation.
+//! \brief Read ulLength characters from the specified port.
 //!
 //! \param ulBase is the base address of the UART port.
-//! \param ulDMAFlags is a bit mask of the DMA features to disable.
+//! \param ucBuffer is the point of read buffer.
+//! \param ulBase is the length of read buffer.
 //!
-//! This function is used to disable UART DMA features that were enabled
-//! by UARTDMAEnable().  The specified UART DMA features are disabled.  The
-//! \e ulDMAFlags parameter is the logical OR of any of the following values:
-//!
-//! - UART_DMA_RX - disable DMA for receive
-//! - UART_DMA_TX - disable DMA for transmit
+//! Read some character from the receive FIFO for the specified port.  If there
+//! are no characters available, this function waits until a character is
+//! received before returning.
 //!
-//! \return None.
+//! \return xtrue
 //
 //*****************************************************************************
 void
-UARTDMADisable(unsigned long ulBase, unsigned long ulDMAFlags)
+UARTBufferRead(unsigned long ulBase, unsigned char *ucBuffer,
+               unsigned long ulLength)
 {
+    unsigned long ulCount;
     //
     // Check the arguments.
     //
     xASSERT(UARTBaseValid(ulBase));
 
     //
-    // Clear the requested bits in the UART DMA control register.
+    // Wait until a char is available.
     //
-    xHWREG(ulBase + UART_IER) &= ~ulDMAFlags;
+    for (ulCount=0; ulCount<ulLength; ulCount++)
+    {
+        while(xHWREG(ulBase + UART_FSR) & UART_FSR_RX_EF)
+        {
+        }
+        ucBuffer[ulCount] = xHWREG(ulBase + UART_RBR);
+    }
 }
 
+
 //*****************************************************************************
 //
-//! \brief Sets the states of the RTS modem control signals and trigger level.
+//! \brief Sends a character to the specified port.
 //!
 //! \param ulBase is the base address of the UART port.
-//! \param ulControl is a bit-mapped flag indicating how the modem control bits
-//! should be set.
-//!
-//! Sets the states of the RTS modem handshake outputs from the UART.
-//!
-//! The \e ulControl parameter is the logical OR of any of the following:
-//!
-//! - \b UART_TRIGGER_RTS_H - The Modem Control DTR signal on high level triggered
-//! - \b UART_TRIGGER_RTS_L - The Modem Control RTS signal on low level triggered
-//! - \b UART_OUTPUT_RTS_SET - The Modem Control RTS signal 
+//! \param ucData is the character to be transmitted.
 //!
-//! \note It is not available on UART2.
+//! Writes the character \e ucData to the transmit FIFO for the specified port.
+//! This function does not block, so if there is no space available, then a
+//! \b false is returned, and the application must retry the function later.
 //!
-//! \return None.
+//! \return Returns \b true if the character was successfully placed in the
+//! transmit FIFO or \b false if there was no space available in the transmit
+//! FIFO.
 //
 //*****************************************************************************
-void
-UARTModemControlSet(unsigned long ulBase, unsigned long ulControl)
+xtBoolean
+UARTCharPutNonBlocking(unsigned long ulBase, unsigned char ucData)
 {
     //
     // Check the arguments.
     //
-    xASSERT((ulBase == UART0_BASE) ||(ulBase == UART1_BASE) );
+    xASSERT(UARTBaseValid(ulBase));
 
     //
-    // Set the appropriate modem control output bits.
+    // See if there is space in the transmit FIFO.
     //
-    xHWREG(ulBase + UART_MCR) &= ~(UART_MCR_RTS | UART_MCR_LEV_RTS);
-    xHWREG(ulBase + UART_MCR) |= (ulControl);
+    if(!(xHWREG(ulBase + UART_FSR) & UART_FSR_TX_FF))
+    {
+        //
+        // Write this character to the transmit FIFO.
+        //
+        xHWREG(ulBase + UART_THR) = ucData;
+
+        //
+        // Success.
+        //
+        return(xtrue);
+    }
+    else
+    {
+        //
+        // There is no space in the transmit FIFO, so return a failure.
+        //
+        return(xfalse);
+    }
 }
 
 //*****************************************************************************
 //
-//! \brief Clears the states of the RTS modem control signals.
+//! \brief Waits to send a character from the specified port.
 //!
 //! \param ulBase is the base address of the UART port.
-//! \param ulControl is a bit-mapped flag indicating how modem control bits
-//! should be Clear.
-//!
-//! Clears the states of the RTS modem handshake outputs from the UART.
-//!
-//! The \e ulControl parameter is the logical OR of any of the following:
-//!
-//! - \b UART_OUTPUT_RTS_SET - The Modem Control RTS signal 
+//! \param ucData is the character to be transmitted.
 //!
-//! \note It is not available on UART2.
+//! Sends the character \e ucData to the transmit FIFO for the specified port.
+//! If there is no space available in the transmit FIFO, this function waits
+//! until there is space available before returning.
 //!
 //! \return None.
 //
 //*****************************************************************************
 void
-UARTModemControlClear(unsigned long ulBase, unsigned long ulControl)
+UARTCharPut(unsigned long ulBase, unsigned char ucData)
 {
-
     //
     // Check the arguments.
     //
-    xASSERT((ulBase == UART0_BASE) ||(ulBase == UART1_BASE) );
+    xASSERT(UARTBaseValid(ulBase));
 
     //
-    // Set the appropriate modem control output bits.
+    // Wait until space is available.
     //
-    xHWREG(ulBase + UART_MCR) &= ~(ulControl & UART_MCR_RTS);
+    while(xHWREG(ulBase + UART_FSR) & UART_FSR_TX_FF)
+    {
+    }
+
+    //
+    // Send the char.
+    //
+    xHWREG(ulBase + UART_THR) = ucData;
 }
 
+
 //*****************************************************************************
 //
-//! \brief Gets the states of the RTS modem control signals.
+//! \brief Waits to send a character from the specified port.
 //!
 //! \param ulBase is the base address of the UART port.
+//! \param ucData is the character to be transmitted.
 //!
-//! Returns the current states of each of the UART modem control signals,
-//! RTS.
-//!
-//! \note It is not available on UART2.
+//! Sends the character \e ucData to the transmit FIFO for the specified port.
+//! If there is no space available in the transmit FIFO, this function waits
+//! until there is space available before returning.
 //!
-//! \return Returns the states of the handshake output signals. 
-//! \b UART_OUTPUT_RTS_GET_H and\b UART_OUTPUT_RTS_GET_L
+//! \return None.
 //
 //*****************************************************************************
-unsigned long
-UARTModemControlGet(unsigned long ulBase)
+void
+UARTBufferWrite(unsigned long ulBase, unsigned char *ucBuffer,
+                unsigned long ulLength)
 {
+    
+    unsigned long ulCount;
     //
     // Check the arguments.
     //
-    xASSERT((ulBase == UART0_BASE) ||(ulBase == UART1_BASE) );
-    
-    return(xHWREG(ulBase + UART_MCR) & (UART_MCR_RTS_ST));
+    xASSERT(UARTBaseValid(ulBase));
 
+    //
+    // Wait until a char is available.
+    //
+    for (ulCount=0; ulCount<ulLength; ulCount++)
+    {
+        while((xHWREG(ulBase + UART_FSR) & UART_FSR_TX_FF))
+        {
+        }
+        xHWREG(ulBase + UART_THR) = ucBuffer[ulCount];
+    }
 }
 
 //*****************************************************************************
 //
-//! \brief Sets the states of the CTS modem control signals trigger level.
+//! \brief Causes a BREAK to be sent.
 //!
 //! \param ulBase is the base address of the UART port.
-//! \param ulControl is a bit-mapped flag indicating how the modem control bits
-//! should be set.
-//!
-//! Sets the states of the RTS modem handshake outputs trigger level from the UART.
-//!
-//! The \e ulCtsTirg parameter is the logical OR of any of the following:
-//!
-//! - \b UART_TRIGGER_CTS_H - The Modem Control DTR signal on high level triggered
-//! - \b UART_TRIGGER_CTS_L - The Modem Control RTS signal on low level triggered
+//! \param bBreakState controls the output level.
 //!
-//! \note It is not available on UART2.
+//! Calling this function with \e bBreakState set to \b true asserts a break
+//! condition on the UART.  Calling this function with \e bBreakState set to
+//! \b false removes the break condition.  For proper transmission of a break
+//! command, the break must be asserted for at least two complete frames.
 //!
 //! \return None.
 //
 //*****************************************************************************
 void
-UARTModemStatusSet(unsigned long ulBase, unsigned long ulCtsTirg)
+UARTBreakCtl(unsigned long ulBase, xtBoolean bBreakState)
 {
     //
     // Check the arguments.
     //
-    xASSERT((ulBase == UART0_BASE) ||(ulBase == UART1_BASE) );
+    xASSERT(UARTBaseValid(ulBase));
 
     //
-    // Set the appropriate modem control output bits.
+    // Set the break condition as requested.
     //
-    xHWREG(ulBase + UART_MSR) &= ~(UART_TRIGGER_CTS_H);
-    xHWREG(ulBase + UART_MSR) |= (ulCtsTirg);
+    xHWREG(ulBase + UART_LCR) =
+        (bBreakState ?
+         (xHWREG(ulBase + UART_LCR) | UART_LCR_BCB) :
+         (xHWREG(ulBase + UART_LCR) & ~(UART_LCR_BCB)));
 }
 
-
 //*****************************************************************************
 //
-//! \brief Gets the states of the CTS modem status signals.
+//! \brief Enables individual UART interrupt sources.
 //!
 //! \param ulBase is the base address of the UART port.
+//! \param ulIntFlags is the bit mask of the interrupt sources to be enabled.
 //!
-//! Returns the current states of each of the UART modem status signals,
-//! CTS.
+//! Enables the indicated UART interrupt sources.  Only the sources that are
+//! enabled can be reflected to the processor interrupt; disabled sources have
+//! no effect on the processor.
 //!
-//! \note It is not available on UART2.
+//! The \e ulIntFlags parameter is the logical OR of any of the following:
 //!
-//! \return Returns the states of the handshake output signals.  
-//! \b UART_INPUT_CTS_H and\b UART_INPUT_CTS_L
+//! - \b UART_INT_LIN    - LIN RX Break Field Detected Interrupt
+//! - \b UART_INT_WAKEUP - Wake up CPU function
+//! - \b UART_INT_BUFERR - Buffer Error Interrupt
+//! - \b UART_INT_RTO    - Rx Time out Interrupt
+//! - \b UART_INT_MOS    - RModem Status Interrupt
+//! - \b UART_INT_RLS    - Receive Line Status Interrupt
+//! - \b UART_INT_THRE   - Transmit Holding Register Empty
+//! - \b UART_INT_RDA    - Receive Data Available Interrupt
+//!
+//! \return None.
 //
 //*****************************************************************************
-unsigned long
-UARTModemStatusGet(unsigned long ulBase)
+void
+UARTIntEnable(unsigned long ulBase, unsigned long ulIntFlags)
 {
     //
     // Check the arguments.
     //
-    xASSERT((ulBase == UART0_BASE) ||(ulBase == UART1_BASE) );
+    xASSERT(UARTBaseValid(ulBase));
 
-    return(xHWREG(ulBase + UART_MSR) & (UART_MSR_CTS_ST));
+    //
+    // Enable the specified interrupts.
+    //
+    xHWREG(ulBase + UART_IER) |= ulIntFlags;
 }
 
-
 //*****************************************************************************
 //
-//! \brief Sets the UART hardware flow control mode to be used.
-//!
-//! \param ulBase is the base address of the UART port.
-//! \param ulMode indicates the flow control modes to be used.  This is a
-//! logical OR combination of values \b UART_FLOWCONTROL_TX and \b
-//! UART_FLOWCONTROL_RX to enable hardware transmit (CTS) and receive (RTS)
-//! flow control or \b UART_FLOWCONTROL_NONE to disable hardware flow control.
+//! \brief Init interrupts callback for the specified UART Port.
 //!
-//! Sets the required hardware flow control modes.  If \e ulMode contains
-//! flag \b UART_FLOWCONTROL_TX, data is only transmitted if the incoming CTS
-//! signal is asserted. If \e ulMode contains flag \b UART_FLOWCONTROL_RX,
-//! the RTS output is controlled by the hardware and is asserted only when
-//! there is space available in the receive FIFO.  If no hardware flow control
-//! is required, UART_FLOWCONTROL_NONE should be passed.
+//! \param ulPort is the base address of the UART port.
+//! \param xtI2CCallback is callback for the specified UART Port.
 //!
-//! \note It is not available on UART2.
+//! Init interrupts callback for the specified UART Port.
 //!
 //! \return None.
 //
 //*****************************************************************************
 void
-UARTFlowControlSet(unsigned long ulBase, unsigned long ulMode)
+UARTIntCallbackInit(unsigned long ulBase, 
+                    xtEventCallback xtUARTCallback)
 {
     //
     // Check the arguments.
     //
-    xASSERT((ulBase == UART0_BASE) ||(ulBase == UART1_BASE));
-    xASSERT((ulMode & ~(UART_FLOWCONTROL_TX | UART_FLOWCONTROL_RX)) == 0);
+    xASSERT(UARTBaseValid(ulBase));
 
-    //
-    // Set the flow control mode as requested.
-    //
-    xHWREG(ulBase + UART_IER) = ((xHWREG(ulBase + UART_IER) &
-                                 ~(UART_FLOWCONTROL_TX |
-                                   UART_FLOWCONTROL_RX)) | ulMode);
+    if (ulBase == UART0_BASE)
+    {
+        g_pfnUARTHandlerCallbacks[0] = xtUARTCallback;
+    }
+    else if (ulBase == UART1_BASE)
+    {
+        g_pfnUARTHandlerCallbacks[1] = xtUARTCallback;    
+    }
+    else
+    {
+        g_pfnUARTHandlerCallbacks[2] = xtUARTCallback;
+    }
 }
 
 //*****************************************************************************
 //
-//! \brief Returns the UART hardware flow control mode currently in use.
+//! \brief Enables individual UART interrupt sources.
 //!
 //! \param ulBase is the base address of the UART port.
+//! \param ulIntFlags is the bit mask of the interrupt sources to be enabled.
 //!
-//! Returns the current hardware flow control mode.
+//! Enables the indicated UART interrupt sources.  Only the sources that are
+//! enabled can be reflected to the processor interrupt; disabled sources have
+//! no effect on the processor.
 //!
-//! \note It is not available on UART2.
-//!
-//! \return Returns the current flow control mode in use.  This is a
-//! logical OR combination of values \b UART_FLOWCONTROL_TX if transmit
-//! (CTS) flow control is enabled and \b UART_FLOWCONTROL_RX if receive (RTS)
-//! flow control is in use.  If hardware flow control is disabled, \b
-//! UART_FLOWCONTROL_NONE will be returned.
-//
-//*****************************************************************************
-unsigned long
-UARTFlowControlGet(unsigned long ulBase)
-{
-    //
-    // Check the arguments.
-    //
-    xASSERT((ulBase == UART0_BASE) ||(ulBase == UART1_BASE));
-
-    return(xHWREG(ulBase + UART_IER) & (UART_FLOWCONTROL_TX |
-                                         UART_FLOWCONTROL_RX));
-}
-
-//*****************************************************************************
-//
-//! \brief Gets current receiver errors.
-//!
-//! \param ulBase is the base address of the UART port.
+//! The \e ulIntFlags parameter is the one of any of the following:
 //!
-//! This function returns the current state of each of the 3 receiver error
-//! sources.  
+//! - \b UART_INT_LIN    - LIN RX Break Field Detected Interrupt
+//! - \b UART_INT_WAKEUP - Wake up CPU function
+//! - \b UART_INT_BUFERR - Buffer Error Interrupt
+//! - \b UART_INT_RTO    - Rx Time out Interrupt
+//! - \b UART_INT_MOS    - RModem Status Interrupt
+//! - \b UART_INT_RLS    - Receive Line Status Interrupt
+//! - \b UART_INT_THRE   - Transmit Holding Register Empty
+//! - \b UART_INT_RDA    - Receive Data Available Interrupt
 //!
-//! \return Returns a logical OR combination of the receiver error flags,
-//! \b UART_RXERROR_FRAMING, \b UART_RXERROR_PARITY, \b UART_RXERROR_BREAK
-//! and \b UART_RXERROR_OVERRUN.
+//! \return None.
 //
 //*****************************************************************************
-unsigned long
-UARTRxErrorGet(unsigned long ulBase)
+xtBoolean
+UARTIntEnableGet(unsigned long ulBase, unsigned long ulIntFlags)
 {
     //
     // Check the arguments.
@@ -1738,27 +2287,31 @@ UARTRxErrorGet(unsigned long ulBase)
     xASSERT(UARTBaseValid(ulBase));
 
     //
-    // Return the current value of the receive status register.
+    // Get enable the specified interrupts.
     //
-    return(xHWREG(ulBase + UART_FSR) & 0x000000FF);
+    return (xHWREG(ulBase + UART_IER) & (ulIntFlags & 0xFF)) ? xtrue : xfalse;
 }
 
+
 //*****************************************************************************
 //
-//! \brief Clears all reported receiver errors.
+//! \brief Disables individual UART interrupt sources.
 //!
 //! \param ulBase is the base address of the UART port.
+//! \param ulIntFlags is the bit mask of the interrupt sources to be disabled.
 //!
-//! This function is used to clear all receiver error conditions reported via
-//! UARTRxErrorGet().  If using the overrun, framing error, parity error or
-//! break interrupts, this function must be called after clearing the interrupt
-//! to ensure that later errors of the same type trigger another interrupt.
+//! Disables the indicated UART interrupt sources.  Only the sources that are
+//! enabled can be reflected to the processor interrupt; disabled sources have
+//! no effect on the processor.
+//!
+//! The \e ulIntFlags parameter has the same definition as the \e ulIntFlags
+//! parameter to UARTIntEnable().
 //!
 //! \return None.
 //
 //*****************************************************************************
 void
-UARTRxErrorClear(unsigned long ulBase)
+UARTIntDisable(unsigned long ulBase, unsigned long ulIntFlags)
 {
     //
     // Check the arguments.
@@ -1766,260 +2319,2287 @@ UARTRxErrorClear(unsigned long ulBase)
     xASSERT(UARTBaseValid(ulBase));
 
     //
-    // Any write to the Error Clear Register will clear all bits which are
-    // currently set.
+    // Disable the specified interrupts.
     //
-    xHWREG(ulBase + UART_FCR) &= ~0xFF;
+    xHWREG(ulBase + UART_IER) &= ~(ulIntFlags);
 }
 
 
 //*****************************************************************************
 //
-//! \brief Sets the Rx Time Out Value.
+//! \brief Gets the current interrupt status.
 //!
 //! \param ulBase is the base address of the UART port.
-//! \param ulValue Time out value
+//! \param bMasked is \b false if the raw interrupt status is required and
+//! \b true if the masked interrupt status is required.
 //!
-//! Sets the Rx Time Out Value
+//! This returns the interrupt status for the specified UART.  Either the raw
+//! interrupt status or the status of interrupts that are allowed to reflect to
+//! the processor can be returned.
 //!
-//! \return None.
+//! \return Returns the current interrupt status, enumerated as a bit field of
+//! values described in UARTIntEnable().
 //
 //*****************************************************************************
-void
-UARTRxTimeOutSet(unsigned long ulBase, unsigned long ulValue)
+unsigned long
+UARTIntStatus(unsigned long ulBase, xtBoolean bMasked)
 {
     //
     // Check the arguments.
     //
-    xASSERT((ulBase == UART0_BASE) ||(ulBase == UART1_BASE));
-    xASSERT(ulValue < 64);
+    xASSERT(UARTBaseValid(ulBase));
 
     //
-    // Set the flow control mode as requested.
+    // Return either the interrupt status or the raw interrupt status as
+    // requested.
     //
-    xHWREG(ulBase + UART_TOR) = ulValue;
-
-    xHWREG(ulBase + UART_IER) |= UART_IER_TIME_OUT_EN;
+    if(bMasked)
+    {
+        return(xHWREG(ulBase + UART_ISR));
+    }
+    else
+    {
+        return(xHWREG(ulBase + UART_ISR));
+    }
 }
 
 //*****************************************************************************
 //
-//! \brief Enables SIR (IrDA) mode on the specified UART.
+//! \brief Clears UART interrupt sources.
 //!
 //! \param ulBase is the base address of the UART port.
-//! \param ulBaud is the desired baud rate.
-//! \param ulConfig is the data format for the port (number of data bits,
-//! number of stop bits, and parity).
-//! \param ulMode is the IrDA mode. 
-//!
-//! This function configures the UART IrDA for operation in the specified data
-//! format.  The baud rate is provided in the \e ulBaud parameter,  the data
-//! format in the \e ulConfig parameter, and the ulMode is provided in the
-//! \e ulMode parameter.
-//!
-//! The \e ulConfig parameter is the logical OR of three values: the number of
-//! data bits, the number of stop bits, and the parity.  \b xUART_CONFIG_WLEN_8,
-//! \b xUART_CONFIG_WLEN_7, \b xUART_CONFIG_WLEN_6, and \b xUART_CONFIG_WLEN_5
-//! select from eight to five data bits per byte (respectively).
-//! \bX UART_CONFIG_STOP_1 and \b xUART_CONFIG_STOP_2 select one or two stop
-//! bits (respectively).  \b xUART_CONFIG_PAR_NONE, \b xUART_CONFIG_PAR_EVEN,
-//! \b xUART_CONFIG_PAR_ODD, \b xUART_CONFIG_PAR_ONE,  and
-//! \b xUART_CONFIG_PAR_ZERO select the parity mode (no parity bit, 
-//! even parity bit, odd parity bit, parity bit always one, and 
-//! parity bit always zero, respectively).
+//! \param ulIntFlags is a bit mask of the interrupt sources to be cleared.
 //!
-//! The \e ulMode parameter can be values:
-//! - \b xUART_IRDA_MODE_NORMAL - IrDA normal mode
+//! The specified UART interrupt sources are cleared, so that they no longer
+//! assert.  This function must be called in the interrupt handler to keep the
+//! interrupt from being recognized again immediately upon exit.
 //!
-//! \note SIR (IrDA) operation is not supported on Sandstorm-class devices.
+//! The \e ulIntFlags parameter has the same definition as the \e ulIntFlags
+//! parameter to UARTIntEnable().
 //!
 //! \return None.
 //
 //*****************************************************************************
-void 
-xUARTIrDAConfig(unsigned long ulBase, unsigned long ulBaud, 
-                unsigned long ulConfig, unsigned long ulMode)
+void
+UARTIntClear(unsigned long ulBase, unsigned long ulIntFlags)
 {
-    unsigned long ulExtClk,ultemp,uldiv;
-
     //
     // Check the arguments.
     //
     xASSERT(UARTBaseValid(ulBase));
-    xASSERT(ulBaud != 0);
-    //xASSERT(ulUARTClk >= (ulBaud * UART_CLK_DIVIDER));
 
     //
-    // Reset UART.
+    // Clear the requested interrupt sources.
     //
-    if (ulBase == UART0_BASE)
+    if ((ulIntFlags & UART_INT_RDA) == UART_INT_RDA)
     {
-        SysCtlPeripheralReset(SYSCTL_PERIPH_UART0);
-        SysCtlPeripheralClockSourceSet(SYSCTL_PERIPH_UART_S_EXT12M);
+        xHWREG(ulBase + UART_RBR);
     }
-    else if (ulBase == UART1_BASE)
+    if ((ulIntFlags & UART_INT_THRE) == UART_INT_THRE)
     {
-        SysCtlPeripheralReset(SYSCTL_PERIPH_UART1);
-        SysCtlPeripheralClockSourceSet(SYSCTL_PERIPH_UART_S_EXT12M);
+        xHWREG(ulBase + UART_RBR) = 0;
     }
-    else 
+    if ((ulIntFlags & UART_INT_RLS) == UART_INT_RLS)
     {
-        SysCtlPeripheralReset(SYSCTL_PERIPH_UART2);
-        SysCtlPeripheralClockSourceSet(SYSCTL_PERIPH_UART_S_EXT12M);
+        xHWREG(ulBase + UART_FSR) |= UART_FSR_BIF | UART_FSR_FEF | 
+                                     UART_FSR_PEF;
     }
-
-    //
-    // Tx FIFO Reset & Rx FIFO Reset & FIFO Mode Enable .
-    //    
-    xHWREG(ulBase + UART_FCR) |= UART_FCR_RX_RST | UART_FCR_TX_RST;
-
-    //
-    // Set Parity & Data bits & Stop bits .
-    //  
-    xHWREG(ulBase + UART_LCR) = ulConfig;
-
-    ulExtClk = UARTCLkGet();
-
-    //
-    // Source Clock mod 16 <3 => Using Divider X =16 (MODE#1).
-    //      
-    if(((ulExtClk / ulBaud)%16)<3)       
-    { 
-        xHWREG(ulBase + UART_BAUD) &= ~UART_BAUD_DIV_X_EN;
-        xHWREG(ulBase + UART_BAUD) &= ~UART_BAUD_DIV_X_ONE;
-        ultemp = ulExtClk / ulBaud/16  -2;
+    if ((ulIntFlags & UART_INT_MOS) == UART_INT_MOS)
+    {
+        xHWREG(ulBase + UART_MSR) |= UART_MSR_DCTSF;
     }
-    //
-    // Source Clock mod 16 >3 => Up 5% Error BaudRate.
-    //     
-    else                            
+    if ((ulIntFlags & UART_INT_RTO) == UART_INT_RTO)
     {
-        //
-        // Try to Set Divider X = 1 (MODE#3).
-        //
-        xHWREG(ulBase + UART_BAUD) |= UART_BAUD_DIV_X_EN;
-        xHWREG(ulBase + UART_BAUD) |= UART_BAUD_DIV_X_ONE;       
-        ultemp = ulExtClk / ulBaud  -2;
-
-        //
-        // If Divider > Range .
-        //
-        if(ultemp > 0xFFFF)              
-        {
-            //
-            // Try to Set Divider X up 10 (MODE#2).
-            //
-            xHWREG(ulBase + UART_BAUD) &= ~UART_BAUD_DIV_X_ONE;       
-            
-            for(uldiv = 8; uldiv <16;uldiv++)
-            {
-                if(((ulExtClk / ulBaud)%(uldiv+1))<3)
-                {
-                    xHWREG(ulBase + UART_BAUD) &= ~UART_BAUD_DIV_X_M;
-                    xHWREG(ulBase + UART_BAUD) |= (uldiv << UART_BAUD_DIV_X_S);
-                    ultemp = ulExtClk / ulBaud / (uldiv+1) -2;
-                    break;
-                }
-            }
-        }
+        xHWREG(ulBase + UART_RBR);
+    }
+    if ((ulIntFlags & UART_INT_LIN) == UART_INT_LIN)
+    {
+        xHWREG(ulBase + UART_ISR) |= UART_ISR_LINRXB_IF;
+    }
+    if ((ulIntFlags & UART_INT_BUFERR) == UART_INT_BUFERR)
+    {
+        xHWREG(ulBase + UART_FSR) |= UART_FSR_TXO_IF | UART_FSR_RXOIF;
     }
-
-    xHWREG(ulBase + UART_BAUD) &= ~UART_BAUD_BRD_M;
-    xHWREG(ulBase + UART_BAUD) |= (ultemp << UART_BAUD_BRD_S);
 }
 
 //*****************************************************************************
 //
-//! \brief Enables transmitting or receiving.
+//! \brief Enable UART DMA operation.
 //!
 //! \param ulBase is the base address of the UART port.
-//! \param ulBlock is the block to enable. it is the logical OR of 
-//! these values: \b UART_BLOCK_UART, \b UART_BLOCK_TX, \b UART_BLOCK_RX.
+//! \param ulDMAFlags is a bit mask of the DMA features to enable.
 //!
-//! Sets the UARTEN, or TXE or RXE bits.
+//! The specified UART DMA features are enabled.  The UART can be
+//! configured to use DMA for transmit or receive, and to disable
+//! receive if an error occurs.  The \e ulDMAFlags parameter is the
+//! logical OR of any of the following values:
+//!
+//! - UART_DMA_RX - enable DMA for receive
+//! - UART_DMA_TX - enable DMA for transmit
+//!
+//! \note The uDMA controller must also be set up before DMA can be used
+//! with the UART.
 //!
 //! \return None.
 //
 //*****************************************************************************
 void
-UARTEnable(unsigned long ulBase, unsigned long ulBlock)
+UARTDMAEnable(unsigned long ulBase, unsigned long ulDMAFlags)
 {
     //
     // Check the arguments.
     //
     xASSERT(UARTBaseValid(ulBase));
-    xASSERT((ulBlock & ~(0 | 0x80 | 0x40)) == 0);
 
     //
-    // Enable RX | TX | the UART.
+    // Set the requested bits in the UART DMA control register.
     //
-    xHWREG(ulBase + UART_LIN_BCNT) |= ulBlock & (UART_LIN_BCNT_RX_EN | 
-                                      UART_LIN_BCNT_TX_EN);
-    if (ulBlock & UART_LIN_BCNT_TX_EN)
-    {
-        xHWREG(ulBase + UART_IRCR) |= UART_IRCR_TX_SELECT;
-    }
+    xHWREG(ulBase + UART_IER) |= ulDMAFlags;
+}
+
+//*****************************************************************************
+//
+//! \brief Disable UART DMA operation.
+//!
+//! \param ulBase is the base address of the UART port.
+//! \param ulDMAFlags is a bit mask of the DMA features to disable.
+//!
+//! This function is used to disable UART DMA features that were enabled
+//! by UARTDMAEnable().  The specified UART DMA features are disabled.  The
+//! \e ulDMAFlags parameter is the logical OR of any of the following values:
+//!
+//! - UART_DMA_RX - disable DMA for receive
+//! - UART_DMA_TX - disable DMA for transmit
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+UARTDMADisable(unsigned long ulBase, unsigned long ulDMAFlags)
+{
+    //
+    // Check the arguments.
+    //
+    xASSERT(UARTBaseValid(ulBase));
+
+    //
+    // Clear the requested bits in the UART DMA control register.
+    //
+    xHWREG(ulBase + UART_IER) &= ~ulDMAFlags;
+}
+
+//*****************************************************************************
+//
+//! \brief Sets the states of the RTS modem control signals and trigger level.
+//!
+//! \param ulBase is the base address of the UART port.
+//! \param ulControl is a bit-mapped flag indicating how the modem control bits
+//! should be set.
+//!
+//! Sets the states of the RTS modem handshake outputs from the UART.
+//!
+//! The \e ulControl parameter is the logical OR of any of the following:
+//!
+//! - \b UART_TRIGGER_RTS_H - The Modem Control DTR signal on high level triggered
+//! - \b UART_TRIGGER_RTS_L - The Modem Control RTS signal on low level triggered
+//! - \b UART_OUTPUT_RTS_SET - The Modem Control RTS signal 
+//!
+//! \note It is not available on UART2.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+UARTModemControlSet(unsigned long ulBase, unsigned long ulControl)
+{
+    //
+    // Check the arguments.
+    //
+    xASSERT((ulBase == UART0_BASE) ||(ulBase == UART1_BASE) );
+
+    //
+    // Set the appropriate modem control output bits.
+    //
+    xHWREG(ulBase + UART_MCR) &= ~(UART_MCR_RTS | UART_MCR_LEV_RTS);
+    xHWREG(ulBase + UART_MCR) |= (ulControl);
+}
+
+//*****************************************************************************
+//
+//! \brief Clears the states of the RTS modem control signals.
+//!
+//! \param ulBase is the base address of the UART port.
+//! \param ulControl is a bit-mapped flag indicating how modem control bits
+//! should be Clear.
+//!
+//! Clears the states of the RTS modem handshake outputs from the UART.
+//!
+//! The \e ulControl parameter is the logical OR of any of the following:
+//!
+//! - \b UART_OUTPUT_RTS_SET - The Modem Control RTS signal 
+//!
+//! \note It is not available on UART2.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+UARTModemControlClear(unsigned long ulBase, unsigned long ulControl)
+{
+
+    //
+    // Check the arguments.
+    //
+    xASSERT((ulBase == UART0_BASE) ||(ulBase == UART1_BASE) );
+
+    //
+    // Set the appropriate modem control output bits.
+    //
+    xHWREG(ulBase + UART_MCR) &= ~(ulControl & UART_MCR_RTS);
+}
+
+//*****************************************************************************
+//
+//! \brief Gets the states of the RTS modem control signals.
+//!
+//! \param ulBase is the base address of the UART port.
+//!
+//! Returns the current states of each of the UART modem control signals,
+//! RTS.
+//!
+//! \note It is not available on UART2.
+//!
+//! \return Returns the states of the handshake output signals. 
+//! \b UART_OUTPUT_RTS_GET_H and\b UART_OUTPUT_RTS_GET_L
+//
+//*****************************************************************************
+unsigned long
+UARTModemControlGet(unsigned long ulBase)
+{
+    //
+    // Check the arguments.
+    //
+    xASSERT((ulBase == UART0_BASE) ||(ulBase == UART1_BASE) );
+    
+    return(xHWREG(ulBase + UART_MCR) & (UART_MCR_RTS_ST));
+
+}
+
+//*****************************************************************************
+//
+//! \brief Sets the states of the CTS modem control signals trigger level.
+//!
+//! \param ulBase is the base address of the UART port.
+//! \param ulControl is a bit-mapped flag indicating how the modem control bits
+//! should be set.
+//!
+//! Sets the states of the RTS modem handshake outputs trigger level from the UART.
+//!
+//! The \e ulCtsTirg parameter is the logical OR of any of the following:
+//!
+//! - \b UART_TRIGGER_CTS_H - The Modem Control DTR signal on high level triggered
+//! - \b UART_TRIGGER_CTS_L - The Modem Control RTS signal on low level triggered
+//!
+//! \note It is not available on UART2.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+UARTModemStatusSet(unsigned long ulBase, unsigned long ulCtsTirg)
+{
+    //
+    // Check the arguments.
+    //
+    xASSERT((ulBase == UART0_BASE) ||(ulBase == UART1_BASE) );
+
+    //
+    // Set the appropriate modem control output bits.
+    //
+    xHWREG(ulBase + UART_MSR) &= ~(UART_TRIGGER_CTS_H);
+    xHWREG(ulBase + UART_MSR) |= (ulCtsTirg);
+}
+
+
+//*****************************************************************************
+//
+//! \brief Gets the states of the CTS modem status signals.
+//!
+//! \param ulBase is the base address of the UART port.
+//!
+//! Returns the current states of each of the UART modem status signals,
+//! CTS.
+//!
+//! \note It is not available on UART2.
+//!
+//! \return Returns the states of the handshake output signals.  
+//! \b UART_INPUT_CTS_H and\b UART_INPUT_CTS_L
+//
+//*****************************************************************************
+unsigned long
+UARTModemStatusGet(unsigned long ulBase)
+{
+    //
+    // Check the arguments.
+    //
+    xASSERT((ulBase == UART0_BASE) ||(ulBase == UART1_BASE) );
+
+    return(xHWREG(ulBase + UART_MSR) & (UART_MSR_CTS_ST));
+}
+
+
+//*****************************************************************************
+//
+//! \brief Sets the UART hardware flow control mode to be used.
+//!
+//! \param ulBase is the base address of the UART port.
+//! \param ulMode indicates the flow control modes to be used.  This is a
+//! logical OR combination of values \b UART_FLOWCONTROL_TX and \b
+//! UART_FLOWCONTROL_RX to enable hardware transmit (CTS) and receive (RTS)
+//! flow control or \b UART_FLOWCONTROL_NONE to disable hardware flow control.
+//!
+//! Sets the required hardware flow control modes.  If \e ulMode contains
+//! flag \b UART_FLOWCONTROL_TX, data is only transmitted if the incoming CTS
+//! signal is asserted. If \e ulMode contains flag \b UART_FLOWCONTROL_RX,
+//! the RTS output is controlled by the hardware and is asserted only when
+//! there is space available in the receive FIFO.  If no hardware flow control
+//! is required, UART_FLOWCONTROL_NONE should be passed.
+//!
+//! \note It is not available on UART2.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+UARTFlowControlSet(unsigned long ulBase, unsigned long ulMode)
+{
+    //
+    // Check the arguments.
+    //
+    xASSERT((ulBase == UART0_BASE) ||(ulBase == UART1_BASE));
+    xASSERT((ulMode & ~(UART_FLOWCONTROL_TX | UART_FLOWCONTROL_RX)) == 0);
+
+    //
+    // Set the flow control mode as requested.
+    //
+    xHWREG(ulBase + UART_IER) = ((xHWREG(ulBase + UART_IER) &
+                                 ~(UART_FLOWCONTROL_TX |
+                                   UART_FLOWCONTROL_RX)) | ulMode);
+}
+
+//*****************************************************************************
+//
+//! \brief Returns the UART hardware flow control mode currently in use.
+//!
+//! \param ulBase is the base address of the UART port.
+//!
+//! Returns the current hardware flow control mode.
+//!
+//! \note It is not available on UART2.
+//!
+//! \return Returns the current flow control mode in use.  This is a
+//! logical OR combination of values \b UART_FLOWCONTROL_TX if transmit
+//! (CTS) flow control is enabled and \b UART_FLOWCONTROL_RX if receive (RTS)
+//! flow control is in use.  If hardware flow control is disabled, \b
+//! UART_FLOWCONTROL_NONE will be returned.
+//
+//*****************************************************************************
+unsigned long
+UARTFlowControlGet(unsigned long ulBase)
+{
+    //
+    // Check the arguments.
+    //
+    xASSERT((ulBase == UART0_BASE) ||(ulBase == UART1_BASE));
+
+    return(xHWREG(ulBase + UART_IER) & (UART_FLOWCONTROL_TX |
+                                         UART_FLOWCONTROL_RX));
+}
+
+//*****************************************************************************
+//
+//! \brief Gets current receiver errors.
+//!
+//! \param ulBase is the base address of the UART port.
+//!
+//! This function returns the current state of each of the 3 receiver error
+//! sources.  
+//!
+//! \return Returns a logical OR combination of the receiver error flags,
+//! \b UART_RXERROR_FRAMING, \b UART_RXERROR_PARITY, \b UART_RXERROR_BREAK
+//! and \b UART_RXERROR_OVERRUN.
+//
+//*****************************************************************************
+unsigned long
+UARTRxErrorGet(unsigned long ulBase)
+{
+    //
+    // Check the arguments.
+    //
+    xASSERT(UARTBaseValid(ulBase));
+
+    //
+    // Return the current value of the receive status register.
+    //
+    return(xHWREG(ulBase + UART_FSR) & 0x000000FF);
+}
+
+//*****************************************************************************
+//
+//! \brief Clears all reported receiver errors.
+//!
+//! \param ulBase is the base address of the UART port.
+//!
+//! This function is used to clear all receiver error conditions reported via
+//! UARTRxErrorGet().  If using the overrun, framing error, parity error or
+//! break interrupts, this function must be called after clearing the interrupt
+//! to ensure that later errors of the same type trigger another interrupt.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+UARTRxErrorClear(unsigned long ulBase)
+{
+    //
+    // Check the arguments.
+    //
+    xASSERT(UARTBaseValid(ulBase));
+
+    //
+    // Any write to the Error Clear Register will clear all bits which are
+    // currently set.
+    //
+    xHWREG(ulBase + UART_FCR) &= ~0xFF;
+}
+
+
+//*****************************************************************************
+//
+//! \brief Sets the Rx Time Out Value.
+//!
+//! \param ulBase is the base address of the UART port.
+//! \param ulValue Time out value
+//!
+//! Sets the Rx Time Out Value
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+UARTRxTimeOutSet(unsigned long ulBase, unsigned long ulValue)
+{
+    //
+    // Check the arguments.
+    //
+    xASSERT((ulBase == UART0_BASE) ||(ulBase == UART1_BASE));
+    xASSERT(ulValue < 64);
+
+    //
+    // Set the flow control mode as requested.
+    //
+    xHWREG(ulBase + UART_TOR) = ulValue;
+
+    xHWREG(ulBase + UART_IER) |= UART_IER_TIME_OUT_EN;
+}
+
+//*****************************************************************************
+//
+//! \brief Enables SIR (IrDA) mode on the specified UART.
+//!
+//! \param ulBase is the base address of the UART port.
+//! \param ulBaud is the desired baud rate.
+//! \param ulConfig is the data format for the port (number of data bits,
+//! number of stop bits, and parity).
+//! \param ulMode is the IrDA mode. 
+//!
+//! This function configures the UART IrDA for operation in the specified data
+//! format.  The baud rate is provided in the \e ulBaud parameter,  the data
+//! format in the \e ulConfig parameter, and the ulMode is provided in the
+//! \e ulMode parameter.
+//!
+//! The \e ulConfig parameter is the logical OR of three values: the number of
+//! data bits, the number of stop bits, and the parity.  \b xUART_CONFIG_WLEN_8,
+//! \b xUART_CONFIG_WLEN_7, \b xUART_CONFIG_WLEN_6, and \b xUART_CONFIG_WLEN_5
+//! select from eight to five data bits per byte (respectively).
+//! \bX UART_CONFIG_STOP_1 and \b xUART_CONFIG_STOP_2 select one or two stop
+//! bits (respectively).  \b xUART_CONFIG_PAR_NONE, \b xUART_CONFIG_PAR_EVEN,
+//! \b xUART_CONFIG_PAR_ODD, \b xUART_CONFIG_PAR_ONE,  and
+//! \b xUART_CONFIG_PAR_ZERO select the parity mode (no parity bit, 
+//! even parity bit, odd parity bit, parity bit always one, and 
+//! parity bit always zero, respectively).
+//!
+//! The \e ulMode parameter can be values:
+//! - \b xUART_IRDA_MODE_NORMAL - IrDA normal mode
+//!
+//! \note SIR (IrDA) operation is not supported on Sandstorm-class devices.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void 
+xUARTIrDAConfig(unsigned long ulBase, unsigned long ulBaud, 
+                unsigned long ulConfig, unsigned long ulMode)
+{
+    unsigned long ulExtClk,ultemp,uldiv;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT(UARTBaseValid(ulBase));
+    xASSERT(ulBaud != 0);
+    //xASSERT(ulUARTClk >= (ulBaud * UART_CLK_DIVIDER));
+
+    //
+    // Reset UART.
+    //
+    if (ulBase == UART0_BASE)
+    {
+        SysCtlPeripheralReset(SYSCTL_PERIPH_UART0);
+        SysCtlPeripheralClockSourceSet(SYSCTL_PERIPH_UART_S_EXT12M);
+    }
+    else if (ulBase == UART1_BASE)
+    {
+        SysCtlPeripheralReset(SYSCTL_PERIPH_UART1);
+        SysCtlPeripheralClockSourceSet(SYSCTL_PERIPH_UART_S_EXT12M);
+    }
+    else 
+    {
+        SysCtlPeripheralReset(SYSCTL_PERIPH_UART2);
+        SysCtlPeripheralClockSourceSet(SYSCTL_PERIPH_UART_S_EXT12M);
+    }
+
+    //
+    // Tx FIFO Reset & Rx FIFO Reset & FIFO Mode Enable .
+    //    
+    xHWREG(ulBase + UART_FCR) |= UART_FCR_RX_RST | UART_FCR_TX_RST;
+
+    //
+    // Set Parity & Data bits & Stop bits .
+    //  
+    xHWREG(ulBase + UART_LCR) = ulConfig;
+
+    ulExtClk = UARTCLkGet();
+
+    //
+    // Source Clock mod 16 <3 => Using Divider X =16 (MODE#1).
+    //      
+    if(((ulExtClk / ulBaud)%16)<3)       
+    { 
+        xHWREG(ulBase + UART_BAUD) &= ~UART_BAUD_DIV_X_EN;
+        xHWREG(ulBase + UART_BAUD) &= ~UART_BAUD_DIV_X_ONE;
+        ultemp = ulExtClk / ulBaud/16  -2;
+    }
+    //
+    // Source Clock mod 16 >3 => Up 5% Error BaudRate.
+    //     
+    else                            
+    {
+        //
+        // Try to Set Divider X = 1 (MODE#3).
+        //
+        xHWREG(ulBase + UART_BAUD) |= UART_BAUD_DIV_X_EN;
+        xHWREG(ulBase + UART_BAUD) |= UART_BAUD_DIV_X_ONE;       
+        ultemp = ulExtClk / ulBaud  -2;
+
+        //
+        // If Divider > Range .
+        //
+        if(ultemp > 0xFFFF)              
+        {
+            //
+            // Try to Set Divider X up 10 (MODE#2).
+            //
+            xHWREG(ulBase + UART_BAUD) &= ~UART_BAUD_DIV_X_ONE;       
+            
+            for(uldiv = 8; uldiv <16;uldiv++)
+            {
+                if(((ulExtClk / ulBaud)%(uldiv+1))<3)
+                {
+                    xHWREG(ulBase + UART_BAUD) &= ~UART_BAUD_DIV_X_M;
+                    xHWREG(ulBase + UART_BAUD) |= (uldiv << UART_BAUD_DIV_X_S);
+                    ultemp = ulExtClk / ulBaud / (uldiv+1) -2;
+                    break;
+                }
+            }
+        }
+    }
+
+    xHWREG(ulBase + UART_BAUD) &= ~UART_BAUD_BRD_M;
+    xHWREG(ulBase + UART_BAUD) |= (ultemp << UART_BAUD_BRD_S);
+}
+
+//*****************************************************************************
+//
+//! \brief Enables transmitting or receiving.
+//!
+//! \param ulBase is the base address of the UART port.
+//! \param ulBlock is the block to enable. it is the logical OR of 
+//! these values: \b UART_BLOCK_UART, \b UART_BLOCK_TX, \b UART_BLOCK_RX.
+//!
+//! Sets the UARTEN, or TXE or RXE bits.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+UARTEnable(unsigned long ulBase, unsigned long ulBlock)
+{
+    //
+    // Check the arguments.
+    //
+    xASSERT(UARTBaseValid(ulBase));
+    xASSERT((ulBlock & ~(0 | 0x80 | 0x40)) == 0);
+
+    //
+    // Enable RX | TX | the UART.
+    //
+    xHWREG(ulBase + UART_LIN_BCNT) |= ulBlock & (UART_LIN_BCNT_RX_EN | 
+                                      UART_LIN_BCNT_TX_EN);
+    if (ulBlock & UART_LIN_BCNT_TX_EN)
+    {
+        xHWREG(ulBase + UART_IRCR) |= UART_IRCR_TX_SELECT;
+    }
+    else
+    {
+        xHWREG(ulBase + UART_IRCR) &= ~UART_IRCR_TX_SELECT;
+    }
+}
+
+
+//*****************************************************************************
+//
+//! \brief Open 485 mode on the specified UART.
+//!
+//! \param ulBase is the base address of the UART port.
+//! \param ul485Config is the Config of the UART port in 485 mode.
+//! \param ulUARTConfig is the Config for UART.
+//!
+//! Open the 485 mode for the UART. 
+//!
+//! The baud rate is provided in the \e ulBaud parameter and the data
+//! format in the \e ulUARTConfig parameter.
+//!
+//! The \e ulUARTConfig parameter is the logical OR of three values: the number of
+//! data bits, the number of stop bits, and the parity.  \b UART_CONFIG_WLEN_8,
+//! \b UART_CONFIG_WLEN_7, \b UART_CONFIG_WLEN_6, and \b UART_CONFIG_WLEN_5
+//! select from eight to five data bits per byte (respectively).
+//! \b UART_CONFIG_STOP_ONE and \b UART_CONFIG_STOP_TWO select one or two stop
+//! bits (respectively).  \b UART_CONFIG_PAR_NONE, \b UART_CONFIG_PAR_EVEN,
+//! \b UART_CONFIG_PAR_ODD, \b UART_CONFIG_PAR_ONE, and \b UART_CONFIG_PAR_ZERO
+//! select the parity mode (no parity bit, even parity bit, odd parity bit,
+//! parity bit always one, and parity bit always zero, respectively).
+//!
+//! The \e ul485Config parameter is the logical OR of five values: the 
+//! Address match value,RS-485 Address Detection Enable,RS-485 Auto Direction
+//! Mode (AUD),RS-485 Auto Address Detection Operation Mode (AAD),RS-485 Normal
+//! Multi-drop Operation Mode (NMM).
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+UART485Config(unsigned long ulBase, unsigned long ulBaud,
+              unsigned long ul485Config, unsigned long ulUARTConfig)
+{
+    //
+    // Check the arguments.
+    //
+    xASSERT(UARTBaseValid(ulBase));
+
+
+    //
+    // Set baud, 8 bit word length, even parity, 2 stop bits (even though the STP2
+    // bit is ignored when in smartcard mode, this lets the caller read back
+    // the actual setting in use).
+    //
+    UARTConfigSetExpClk(ulBase, ulBaud, ulUARTConfig);
+
+    //
+    // Enable 485.
+    //
+    UARTEnable485(ulBase);
+    xHWREG(ulBase + UART_LIN_BCNT) &= 0xFFFFFF00;
+    xHWREG(ulBase + UART_LIN_BCNT) |= ul485Config;
+
+}
+
+//*****************************************************************************
+//
+//! \brief Enables the interrupt driven ring buffers of a UART port.
+//!
+//! \param ulBase is the base address of the UART port.
+//! \param pucTxBuf is the buffer used to queue transmit data.
+//! \param ulTxSize is the size of \e pucTxBuf, must be a power of two.
+//! \param pucRxBuf is the buffer used to store received data.
+//! \param ulRxSize is the size of \e pucRxBuf, must be a power of two.
+//!
+//! Hangs the caller supplied buffers off the UART port and enables the RDA,
+//! Rx time out and (on demand) THRE interrupts. From then on the UART
+//! interrupt handler moves the data between the FIFOs and the buffers, and
+//! the application uses UARTRingWrite(), UARTRingRead() and
+//! UARTRingAvailable(), which never wait for the hardware.
+//!
+//! The Rx FIFO trigger level is set to \b UART_FIFO_8BYTES and the Rx time
+//! out to \b UART_RING_RX_TIMEOUT bit times, so a short burst is delivered
+//! without waiting for the FIFO to fill.
+//!
+//! \note The buffers must stay valid until UARTRingBufferDisable() is called.
+//! The UART interrupt (INT_UART02 or INT_UART1) must be enabled by the
+//! application with xIntEnable().
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+UARTRingBufferInit(unsigned long ulBase, unsigned char *pucTxBuf,
+                   unsigned long ulTxSize, unsigned char *pucRxBuf,
+                   unsigned long ulRxSize)
+{
+    tUARTRing *psRing;
+    unsigned long ulIndex;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT(UARTBaseValid(ulBase));
+    xASSERT((pucTxBuf != 0) && (pucRxBuf != 0));
+    xASSERT((ulTxSize != 0) && ((ulTxSize & (ulTxSize - 1)) == 0));
+    xASSERT((ulRxSize != 0) && ((ulRxSize & (ulRxSize - 1)) == 0));
+
+    ulIndex = UARTIndexGet(ulBase);
+    psRing = &g_sUARTRing[ulIndex];
+
+    //
+    // Stop servicing the port while the ring is set up.
+    //
+    xHWREG(ulBase + UART_IER) &= ~(UART_IER_RDA_IEN | UART_IER_THRE_IEN |
+                                   UART_IER_RTO_IEN);
+    g_psUARTRing[ulIndex] = 0;
+
+    psRing->pucTxBuf = pucTxBuf;
+    psRing->ulTxMask = ulTxSize - 1;
+    psRing->ulTxHead = 0;
+    psRing->ulTxTail = 0;
+    psRing->pucRxBuf = pucRxBuf;
+    psRing->ulRxMask = ulRxSize - 1;
+    psRing->ulRxHead = 0;
+    psRing->ulRxTail = 0;
+    psRing->ulRxDropped = 0;
+
+    g_psUARTRing[ulIndex] = psRing;
+
+    //
+    // Rx FIFO threshold and Rx time out.
+    //
+    xHWREG(ulBase + UART_FCR) &= ~UART_FCR_RFITL_M;
+    xHWREG(ulBase + UART_FCR) |= UART_FIFO_8BYTES;
+    xHWREG(ulBase + UART_TOR) = UART_RING_RX_TIMEOUT;
+
+    xHWREG(ulBase + UART_IER) |= UART_IER_RDA_IEN | UART_IER_RTO_IEN |
+                                 UART_IER_TIME_OUT_EN;
+}
+
+//*****************************************************************************
+//
+//! \brief Disables the ring buffers of a UART port.
+//!
+//! \param ulBase is the base address of the UART port.
+//!
+//! Disables the interrupts used by the ring buffers and detaches the buffers
+//! from the port. Data still queued in the buffers is discarded.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+UARTRingBufferDisable(unsigned long ulBase)
+{
+    //
+    // Check the arguments.
+    //
+    xASSERT(UARTBaseValid(ulBase));
+
+    xHWREG(ulBase + UART_IER) &= ~(UART_IER_RDA_IEN | UART_IER_THRE_IEN |
+                                   UART_IER_RTO_IEN | UART_IER_TIME_OUT_EN);
+    g_psUARTRing[UARTIndexGet(ulBase)] = 0;
+}
+
+//*****************************************************************************
+//
+//! \brief Queues data in the Tx ring buffer of a UART port.
+//!
+//! \param ulBase is the base address of the UART port.
+//! \param pucData is the data to be transmitted.
+//! \param ulLength is the number of bytes in \e pucData.
+//!
+//! Copies as much of \e pucData as fits into the Tx ring buffer and enables
+//! the THRE interrupt, which feeds the Tx FIFO from the ring. This function
+//! does not wait for space in the ring.
+//!
+//! \return Returns the number of bytes queued, which is less than
+//! \e ulLength when the ring is full.
+//
+//*****************************************************************************
+unsigned long
+UARTRingWrite(unsigned long ulBase, const unsigned char *pucData,
+              unsigned long ulLength)
+{
+    tUARTRing *psRing;
+    unsigned long ulHead, ulFree, ulCount;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT(UARTBaseValid(ulBase));
+    xASSERT(g_psUARTRing[UARTIndexGet(ulBase)] != 0);
+
+    psRing = g_psUARTRing[UARTIndexGet(ulBase)];
+    ulHead = psRing->ulTxHead;
+    ulFree = psRing->ulTxMask + 1 - (ulHead - psRing->ulTxTail);
+    if(ulLength > ulFree)
+    {
+        ulLength = ulFree;
+    }
+
+    for(ulCount = 0; ulCount < ulLength; ulCount++)
+    {
+        psRing->pucTxBuf[ulHead & psRing->ulTxMask] = pucData[ulCount];
+        ulHead++;
+    }
+    psRing->ulTxHead = ulHead;
+
+    //
+    // The THRE interrupt fires at once if the Tx FIFO is already empty.
+    //
+    if(ulLength != 0)
+    {
+        xHWREG(ulBase + UART_IER) |= UART_IER_THRE_IEN;
+    }
+
+    return ulLength;
+}
+
+//*****************************************************************************
+//
+//! \brief Reads data from the Rx ring buffer of a UART port.
+//!
+//! \param ulBase is the base address of the UART port.
+//! \param pucData is the buffer that receives the data.
+//! \param ulLength is the size of \e pucData.
+//!
+//! Copies up to \e ulLength received bytes out of the Rx ring buffer. This
+//! function does not wait for data.
+//!
+//! \return Returns the number of bytes read, 0 if the ring is empty.
+//
+//*****************************************************************************
+unsigned long
+UARTRingRead(unsigned long ulBase, unsigned char *pucData,
+             unsigned long ulLength)
+{
+    tUARTRing *psRing;
+    unsigned long ulTail, ulUsed, ulCount;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT(UARTBaseValid(ulBase));
+    xASSERT(g_psUARTRing[UARTIndexGet(ulBase)] != 0);
+
+    psRing = g_psUARTRing[UARTIndexGet(ulBase)];
+    ulTail = psRing->ulRxTail;
+    ulUsed = psRing->ulRxHead - ulTail;
+    if(ulLength > ulUsed)
+    {
+        ulLength = ulUsed;
+    }
+
+    for(ulCount = 0; ulCount < ulLength; ulCount++)
+    {
+        pucData[ulCount] = psRing->pucRxBuf[ulTail & psRing->ulRxMask];
+        ulTail++;
+    }
+    psRing->ulRxTail = ulTail;
+
+    return ulLength;
+}
+
+//*****************************************************************************
+//
+//! \brief Gets the number of bytes waiting in the Rx ring buffer.
+//!
+//! \param ulBase is the base address of the UART port.
+//!
+//! \return Returns the number of bytes that UARTRingRead() can return.
+//
+//*****************************************************************************
+unsigned long
+UARTRingAvailable(unsigned long ulBase)
+{
+    tUARTRing *psRing;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT(UARTBaseValid(ulBase));
+    xASSERT(g_psUARTRing[UARTIndexGet(ulBase)] != 0);
+
+    psRing = g_psUARTRing[UARTIndexGet(ulBase)];
+
+    return (psRing->ulRxHead - psRing->ulRxTail);
+}
+
+//*****************************************************************************
+//
+//! \brief Gets the free space in the Tx ring buffer.
+//!
+//! \param ulBase is the base address of the UART port.
+//!
+//! \return Returns the number of bytes that UARTRingWrite() can accept.
+//
+//*****************************************************************************
+unsigned long
+UARTRingSpaceAvail(unsigned long ulBase)
+{
+    tUARTRing *psRing;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT(UARTBaseValid(ulBase));
+    xASSERT(g_psUARTRing[UARTIndexGet(ulBase)] != 0);
+
+    psRing = g_psUARTRing[UARTIndexGet(ulBase)];
+
+    return (psRing->ulTxMask + 1 - (psRing->ulTxHead - psRing->ulTxTail));
+}
+
+//*****************************************************************************
+//
+//! \brief Gets the number of received bytes lost because the Rx ring was full.
+//!
+//! \param ulBase is the base address of the UART port.
+//!
+//! \return Returns the count of dropped bytes since UARTRingBufferInit().
+//
+//*****************************************************************************
+unsigned long
+UARTRingRxDroppedGet(unsigned long ulBase)
+{
+    //
+    // Check the arguments.
+    //
+    xASSERT(UARTBaseValid(ulBase));
+    xASSERT(g_psUARTRing[UARTIndexGet(ulBase)] != 0);
+
+    return g_psUARTRing[UARTIndexGet(ulBase)]->ulRxDropped;
+}
+
+//*****************************************************************************
+//
+//! \brief Starts PDMA streaming on a UART port.
+//!
+//! \param ulBase is the base address of the UART port, \b UART0_BASE or
+//! \b UART1_BASE.
+//! \param pucBuf0 is the first Rx buffer.
+//! \param pucBuf1 is the second Rx buffer.
+//! \param ulLength is the size in bytes of each Rx buffer, up to 0xFFFF.
+//! \param pfnCallback is the stream event callback.
+//!
+//! Claims one PDMA channel for UART Rx and one for UART Tx and starts
+//! receiving into \e pucBuf0. When a buffer is full the PDMA interrupt
+//! restarts the Rx channel on the other buffer and passes the full one to
+//! \e pfnCallback, so no received byte needs the CPU. A partial buffer is
+//! handed over the same way by UARTDMAStreamPoll(), called periodically, once
+//! the line is idle, or at once by UARTDMAStreamFlush(). The UART Rx time
+//! out interrupt cannot do it: it only fires on a non-empty Rx FIFO, which
+//! the PDMA keeps empty.
+//!
+//! The callback gets:
+//! - \e ulEvent is one of \b UART_DMA_EVENT_RX_FULL,
+//! \b UART_DMA_EVENT_RX_PARTIAL, \b UART_DMA_EVENT_TX_DONE or
+//! \b UART_DMA_EVENT_ERROR.
+//! - \e ulMsgParam is the number of bytes in the buffer (for
+//! \b UART_DMA_EVENT_ERROR, 1 for the Rx and 0 for the Tx channel).
+//! - \e pvMsgData is the buffer.
+//! .
+//! The Rx buffer passed to the callback is not written again until the
+//! other buffer is handed over, the callback must consume it before then.
+//!
+//! \note The PDMA peripheral clock must be enabled, and INT_PDMA and the UART
+//! interrupt must be enabled by the application with xIntEnable().
+//!
+//! \return Returns \b xtrue if the stream is started, or \b xfalse if no
+//! PDMA channel is free.
+//
+//*****************************************************************************
+xtBoolean
+UARTDMAStreamStart(unsigned long ulBase, unsigned char *pucBuf0,
+                   unsigned char *pucBuf1, unsigned long ulLength,
+                   xtEventCallback pfnCallback)
+{
+    tUARTDMAStream *psStream;
+    unsigned long ulIndex;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT((ulBase == UART0_BASE) || (ulBase == UART1_BASE));
+    xASSERT((pucBuf0 != 0) && (pucBuf1 != 0));
+    xASSERT((ulLength != 0) && (ulLength <= PDMA_BCR_M));
+
+    ulIndex = UARTIndexGet(ulBase);
+    psStream = &g_sUARTDMAStream[ulIndex];
+
+    psStream->ulRxChannel = PDMAChannelDynamicAssign(
+            (ulIndex == 0) ? xDMA_REQUEST_UART0_RX : xDMA_REQUEST_UART1_RX,
+            xDMA_REQUEST_MEM);
+    if(psStream->ulRxChannel == xDMA_CHANNEL_NOT_EXIST)
+    {
+        return xfalse;
+    }
+    psStream->ulTxChannel = PDMAChannelDynamicAssign(xDMA_REQUEST_MEM,
+            (ulIndex == 0) ? xDMA_REQUEST_UART0_TX : xDMA_REQUEST_UART1_TX);
+    if(psStream->ulTxChannel == xDMA_CHANNEL_NOT_EXIST)
+    {
+        PDMAChannelDeAssign(psStream->ulRxChannel);
+        return xfalse;
+    }
+
+    psStream->pucRxBuf[0] = pucBuf0;
+    psStream->pucRxBuf[1] = pucBuf1;
+    psStream->ulRxLength = ulLength;
+    psStream->ulRxActive = 0;
+    psStream->ulRxPolled = 0;
+    psStream->pucTxBuf = 0;
+    psStream->ulTxLength = 0;
+    psStream->bTxBusy = xfalse;
+    psStream->pfnCallback = pfnCallback;
+
+    PDMAChannelIntCallbackInit(psStream->ulRxChannel,
+                       (ulIndex == 0) ? UART0DMARxCallback : UART1DMARxCallback);
+    PDMAChannelIntCallbackInit(psStream->ulTxChannel,
+                       (ulIndex == 0) ? UART0DMATxCallback : UART1DMATxCallback);
+    PDMAEnable(psStream->ulRxChannel);
+    PDMAEnable(psStream->ulTxChannel);
+    PDMAChannelIntEnable(psStream->ulRxChannel,
+                         PDMA_EVENT_TC | PDMA_EVENT_ERROR);
+    PDMAChannelIntEnable(psStream->ulTxChannel,
+                         PDMA_EVENT_TC | PDMA_EVENT_ERROR);
+
+    g_psUARTDMAStream[ulIndex] = psStream;
+
+    //
+    // Start receiving.
+    //
+    UARTDMAStreamRxArm(ulBase, psStream);
+    xHWREG(ulBase + UART_IER) |= UART_IER_DMA_RX_EN;
+
+    return xtrue;
+}
+
+//*****************************************************************************
+//
+//! \brief Transmits a buffer through the PDMA stream of a UART port.
+//!
+//! \param ulBase is the base address of the UART port.
+//! \param pucData is the data to be transmitted.
+//! \param ulLength is the number of bytes to transmit, up to 0xFFFF.
+//!
+//! Starts the Tx channel on \e pucData and returns at once. The stream
+//! callback gets \b UART_DMA_EVENT_TX_DONE when the last byte has been moved
+//! to the Tx FIFO, \e pucData must stay valid until then.
+//!
+//! \return Returns \b xtrue if the transfer is started, or \b xfalse if the
+//! previous transfer is still in progress.
+//
+//*****************************************************************************
+xtBoolean
+UARTDMAStreamWrite(unsigned long ulBase, unsigned char *pucData,
+                   unsigned long ulLength)
+{
+    tUARTDMAStream *psStream;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT((ulBase == UART0_BASE) || (ulBase == UART1_BASE));
+    xASSERT(g_psUARTDMAStream[UARTIndexGet(ulBase)] != 0);
+    xASSERT((ulLength != 0) && (ulLength <= PDMA_BCR_M));
+
+    psStream = g_psUARTDMAStream[UARTIndexGet(ulBase)];
+    if(psStream->bTxBusy)
+    {
+        return xfalse;
+    }
+    psStream->bTxBusy = xtrue;
+    psStream->pucTxBuf = pucData;
+    psStream->ulTxLength = ulLength;
+
+    PDMAChannelControlSet(psStream->ulTxChannel, PDMA_WIDTH_8BIT |
+                          PDMA_SRC_DIR_INC | PDMA_DST_DIR_FIXED |
+                          PDMA_MODE_MTOP);
+    PDMAChannelTransferSet(psStream->ulTxChannel, pucData,
+                           (void *)(ulBase + UART_THR), ulLength);
+    xHWREG(ulBase + UART_IER) |= UART_IER_DMA_TX_EN;
+
+    return xtrue;
+}
+
+//*****************************************************************************
+//
+//! \brief Gets whether the PDMA stream of a UART port is transmitting.
+//!
+//! \param ulBase is the base address of the UART port.
+//!
+//! \return Returns \b xtrue if a UARTDMAStreamWrite() transfer is still in
+//! progress, or \b xfalse otherwise.
+//
+//*****************************************************************************
+xtBoolean
+UARTDMAStreamTxBusy(unsigned long ulBase)
+{
+    //
+    // Check the arguments.
+    //
+    xASSERT((ulBase == UART0_BASE) || (ulBase == UART1_BASE));
+    xASSERT(g_psUARTDMAStream[UARTIndexGet(ulBase)] != 0);
+
+    return g_psUARTDMAStream[UARTIndexGet(ulBase)]->bTxBusy;
+}
+
+//*****************************************************************************
+//
+//! \brief Flushes the partial Rx buffer of a UART stream.
+//!
+//! \param ulBase is the base address of the UART port.
+//!
+//! Hands the bytes received so far to the stream callback with
+//! \b UART_DMA_EVENT_RX_PARTIAL and continues on the other buffer. Nothing
+//! happens if the buffer is empty.
+//!
+//! \note Must not be called from a priority higher than the PDMA interrupt.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+UARTDMAStreamFlush(unsigned long ulBase)
+{
+    //
+    // Check the arguments.
+    //
+    xASSERT((ulBase == UART0_BASE) || (ulBase == UART1_BASE));
+
+    UARTDMAStreamRxSwap(UARTIndexGet(ulBase), UART_DMA_EVENT_RX_PARTIAL);
+}
+
+//*****************************************************************************
+//
+//! \brief Flushes the partial Rx buffer of a UART stream once the line is
+//! idle.
+//!
+//! \param ulBase is the base address of the UART port.
+//!
+//! Reads the remaining count of the Rx PDMA channel. When bytes are waiting
+//! and none came since the previous call, the line is idle and the partial
+//! buffer is flushed as by UARTDMAStreamFlush(). Call it from a timer or the
+//! main loop, the period sets how long a partial buffer may wait.
+//!
+//! \note Must not be called from a priority higher than the PDMA interrupt.
+//!
+//! \return Returns \b xtrue if a partial buffer is flushed, or \b xfalse
+//! otherwise.
+//
+//*****************************************************************************
+xtBoolean
+UARTDMAStreamPoll(unsigned long ulBase)
+{
+    tUARTDMAStream *psStream;
+    unsigned long ulCount;
+    xtBoolean bMasked, bIdle;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT((ulBase == UART0_BASE) || (ulBase == UART1_BASE));
+
+    bMasked = xIntMasterDisable();
+    psStream = g_psUARTDMAStream[UARTIndexGet(ulBase)];
+    bIdle = xfalse;
+    if(psStream != 0)
+    {
+        ulCount = psStream->ulRxLength -
+                  PDMARemainTransferCountGet(psStream->ulRxChannel);
+        if((ulCount != 0) && (ulCount == psStream->ulRxPolled))
+        {
+            bIdle = xtrue;
+        }
+        psStream->ulRxPolled = ulCount;
+    }
+    if(!bMasked)
+    {
+        xIntMasterEnable();
+    }
+
+    if(bIdle)
+    {
+        UARTDMAStreamRxSwap(UARTIndexGet(ulBase), UART_DMA_EVENT_RX_PARTIAL);
+    }
+    return bIdle;
+}
+
+//*****************************************************************************
+//
+//! \brief Stops PDMA streaming on a UART port.
+//!
+//! \param ulBase is the base address of the UART port.
+//!
+//! Stops both channels and gives them back to the PDMA channel pool. Data
+//! not yet passed to the callback is discarded.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+UARTDMAStreamStop(unsigned long ulBase)
+{
+    tUARTDMAStream *psStream;
+    unsigned long ulIndex;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT((ulBase == UART0_BASE) || (ulBase == UART1_BASE));
+
+    ulIndex = UARTIndexGet(ulBase);
+    psStream = g_psUARTDMAStream[ulIndex];
+    if(psStream == 0)
+    {
+        return;
+    }
+
+    xHWREG(ulBase + UART_IER) &= ~(UART_IER_DMA_RX_EN | UART_IER_DMA_TX_EN);
+    g_psUARTDMAStream[ulIndex] = 0;
+
+    PDMAChannelIntDisable(psStream->ulRxChannel,
+                          PDMA_EVENT_TC | PDMA_EVENT_ERROR);
+    PDMAChannelIntDisable(psStream->ulTxChannel,
+                          PDMA_EVENT_TC | PDMA_EVENT_ERROR);
+    PDMAChannelIntCallbackInit(psStream->ulRxChannel, 0);
+    PDMAChannelIntCallbackInit(psStream->ulTxChannel, 0);
+    PDMAChannelSoftwareReset(psStream->ulRxChannel);
+    PDMAChannelSoftwareReset(psStream->ulTxChannel);
+    PDMADisable(psStream->ulRxChannel);
+    PDMADisable(psStream->ulTxChannel);
+    PDMAChannelDeAssign(psStream->ulRxChannel);
+    PDMAChannelDeAssign(psStream->ulTxChannel);
+}
+
+//*****************************************************************************
+//
+//! \brief Starts the Rx framing engine of a UART port.
+//!
+//! \param ulBase is the base address of the UART port.
+//! \param ulProtocol is the framing, \b UART_FRAME_SLIP or
+//! \b UART_FRAME_COBS.
+//! \param pucPool is the frame pool, \e ulFrameNum slots of \e ulFrameSize
+//! bytes.
+//! \param ulFrameSize is the largest decoded frame in bytes.
+//! \param ulFrameNum is the number of slots, up to \b UART_FRAME_NUM_MAX.
+//! \param pfnCallback is the frame callback, or 0 to queue the frames for
+//! UARTFrameGet().
+//!
+//! The UART interrupt handler decodes the Rx data in the interrupt and
+//! writes the decoded bytes straight into a slot of \e pucPool. A complete
+//! frame is then handed over as a pointer into the pool and a length,
+//! without any further copy.
+//!
+//! When \e pfnCallback is given it is called from the interrupt for every
+//! frame with \b UART_FRAME_EVENT_RX, \e ulMsgParam is the frame length and
+//! \e pvMsgData the frame. Either way the slot belongs to the application
+//! until it is given back with UARTFrameRelease().
+//!
+//! Frames that are too long, badly encoded or that find no free slot are
+//! dropped and counted, see UARTFrameErrorCountGet(). Empty frames are
+//! ignored.
+//!
+//! The engine takes over the Rx interrupt of the port, UARTRingWrite() can
+//! still be used for Tx but UARTRingBufferInit() must be called first since
+//! it sets the Rx interrupts too.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+UARTFrameInit(unsigned long ulBase, unsigned long ulProtocol,
+              unsigned char *pucPool, unsigned long ulFrameSize,
+              unsigned long ulFrameNum, xtEventCallback pfnCallback)
+{
+    tUARTFrame *psFrame;
+    unsigned long ulIndex, i;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT(UARTBaseValid(ulBase));
+    xASSERT((ulProtocol == UART_FRAME_SLIP) ||
+            (ulProtocol == UART_FRAME_COBS));
+    xASSERT(pucPool != 0);
+    xASSERT((ulFrameSize != 0) && (ulFrameSize <= 0xFFFF));
+    xASSERT((ulFrameNum != 0) && (ulFrameNum <= UART_FRAME_NUM_MAX));
+
+    ulIndex = UARTIndexGet(ulBase);
+    psFrame = &g_sUARTFrame[ulIndex];
+
+    //
+    // Stop servicing the port while the engine is set up.
+    //
+    xHWREG(ulBase + UART_IER) &= ~(UART_IER_RDA_IEN | UART_IER_RTO_IEN);
+    g_psUARTFrame[ulIndex] = 0;
+
+    psFrame->ulProtocol = ulProtocol;
+    psFrame->pucPool = pucPool;
+    psFrame->ulFrameSize = ulFrameSize;
+    psFrame->ulFrameNum = ulFrameNum;
+    for(i = 0; i < ulFrameNum; i++)
+    {
+        psFrame->ucFree[i] = (unsigned char)i;
+    }
+    psFrame->ulFreeHead = ulFrameNum;
+    psFrame->ulFreeTail = 0;
+    psFrame->ulReadyHead = 0;
+    psFrame->ulReadyTail = 0;
+    psFrame->ulSlot = UART_FRAME_NUM_MAX;
+    psFrame->ulLength = 0;
+    psFrame->ulState = 0;
+    psFrame->bZero = xfalse;
+    psFrame->bDiscard = xfalse;
+    psFrame->ulErrors[UART_FRAME_ERROR_OVERRUN] = 0;
+    psFrame->ulErrors[UART_FRAME_ERROR_DECODE] = 0;
+    psFrame->ulErrors[UART_FRAME_ERROR_NO_BUFFER] = 0;
+    psFrame->pfnCallback = pfnCallback;
+
+    g_psUARTFrame[ulIndex] = psFrame;
+
+    //
+    // Rx FIFO threshold and Rx time out, the time out delivers the tail of
+    // a frame shorter than the threshold.
+    //
+    xHWREG(ulBase + UART_FCR) &= ~UART_FCR_RFITL_M;
+    xHWREG(ulBase + UART_FCR) |= UART_FIFO_8BYTES;
+    xHWREG(ulBase + UART_TOR) = UART_RING_RX_TIMEOUT;
+
+    xHWREG(ulBase + UART_IER) |= UART_IER_RDA_IEN | UART_IER_RTO_IEN |
+                                 UART_IER_TIME_OUT_EN;
+}
+
+//*****************************************************************************
+//
+//! \brief Stops the Rx framing engine of a UART port.
+//!
+//! \param ulBase is the base address of the UART port.
+//!
+//! Disables the Rx interrupts and detaches the frame pool from the port.
+//! Frames not yet released are discarded.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+UARTFrameDisable(unsigned long ulBase)
+{
+    //
+    // Check the arguments.
+    //
+    xASSERT(UARTBaseValid(ulBase));
+
+    xHWREG(ulBase + UART_IER) &= ~(UART_IER_RDA_IEN | UART_IER_RTO_IEN |
+                                   UART_IER_TIME_OUT_EN);
+    g_psUARTFrame[UARTIndexGet(ulBase)] = 0;
+}
+
+//*****************************************************************************
+//
+//! \brief Gets the next received frame of a UART port.
+//!
+//! \param ulBase is the base address of the UART port.
+//! \param ppucFrame is where the frame pointer is stored.
+//!
+//! Takes the oldest frame from the ready queue. Only used when
+//! UARTFrameInit() was called without a callback. The frame stays valid
+//! until it is given back with UARTFrameRelease().
+//!
+//! \return Returns the frame length, or 0 if no frame is ready.
+//
+//*****************************************************************************
+unsigned long
+UARTFrameGet(unsigned long ulBase, unsigned char **ppucFrame)
+{
+    tUARTFrame *psFrame;
+    unsigned long ulTail;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT(UARTBaseValid(ulBase));
+    xASSERT(g_psUARTFrame[UARTIndexGet(ulBase)] != 0);
+    xASSERT(ppucFrame != 0);
+
+    psFrame = g_psUARTFrame[UARTIndexGet(ulBase)];
+    if(psFrame->ulReadyTail == psFrame->ulReadyHead)
+    {
+        return 0;
+    }
+
+    ulTail = psFrame->ulReadyTail & (UART_FRAME_NUM_MAX - 1);
+    *ppucFrame = psFrame->pucPool + psFrame->ucReady[ulTail] *
+                                    psFrame->ulFrameSize;
+    psFrame->ulReadyTail++;
+
+    return psFrame->usLength[ulTail];
+}
+
+//*****************************************************************************
+//
+//! \brief Gives a frame back to the frame pool of a UART port.
+//!
+//! \param ulBase is the base address of the UART port.
+//! \param pucFrame is a frame pointer got from UARTFrameGet() or the frame
+//! callback.
+//!
+//! Each frame must be released exactly once. Can be called from the frame
+//! callback, but not from a priority higher than the UART interrupt.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+UARTFrameRelease(unsigned long ulBase, unsigned char *pucFrame)
+{
+    tUARTFrame *psFrame;
+    unsigned long ulSlot;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT(UARTBaseValid(ulBase));
+    xASSERT(g_psUARTFrame[UARTIndexGet(ulBase)] != 0);
+
+    psFrame = g_psUARTFrame[UARTIndexGet(ulBase)];
+    ulSlot = (unsigned long)(pucFrame - psFrame->pucPool) /
+             psFrame->ulFrameSize;
+    xASSERT(ulSlot < psFrame->ulFrameNum);
+
+    psFrame->ucFree[psFrame->ulFreeHead & (UART_FRAME_NUM_MAX - 1)] =
+                                                    (unsigned char)ulSlot;
+    psFrame->ulFreeHead++;
+}
+
+//*****************************************************************************
+//
+//! \brief Gets an error counter of the framing engine of a UART port.
+//!
+//! \param ulBase is the base address of the UART port.
+//! \param ulError is the counter, one of \b UART_FRAME_ERROR_OVERRUN,
+//! \b UART_FRAME_ERROR_DECODE or \b UART_FRAME_ERROR_NO_BUFFER.
+//!
+//! \return Returns the number of frames dropped for that reason since
+//! UARTFrameInit().
+//
+//*****************************************************************************
+unsigned long
+UARTFrameErrorCountGet(unsigned long ulBase, unsigned long ulError)
+{
+    //
+    // Check the arguments.
+    //
+    xASSERT(UARTBaseValid(ulBase));
+    xASSERT(g_psUARTFrame[UARTIndexGet(ulBase)] != 0);
+    xASSERT(ulError <= UART_FRAME_ERROR_NO_BUFFER);
+
+    return g_psUARTFrame[UARTIndexGet(ulBase)]->ulErrors[ulError];
+}
+
+//*****************************************************************************
+//
+//! \brief Computes the baud rate divider of a UART.
+//!
+//! \param ulBaud is the desired baud rate.
+//! \param psPlan is where the result is stored.
+//!
+//! Tries every divider mode of the UART_BAUD register for the UART clock in
+//! effect and keeps the one closest to \e ulBaud. The result only depends
+//! on the UART clock, so a set of plans can be computed once at start up and
+//! switched with UARTBaudPlanApply(), which is a single register write.
+//!
+//! \return Returns \b xtrue if a divider is found, or \b xfalse if
+//! \e ulBaud cannot be reached from the UART clock.
+//
+//*****************************************************************************
+xtBoolean
+UARTBaudPlanCompute(unsigned long ulBaud, tUARTBaudPlan *psPlan)
+{
+    unsigned long ulClk, ulDivider, ulBRD, ulActual, ulDiff, ulBestDiff;
+    unsigned long i;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT(ulBaud != 0);
+    xASSERT(psPlan != 0);
+
+    ulClk = UARTCLkGet();
+    ulBestDiff = 0xFFFFFFFF;
+    psPlan->ulBaudReg = 0;
+    psPlan->ulBaud = 0;
+    psPlan->lError = 0;
+
+    for(i = 0; i < sizeof(g_ucUARTBaudDivider); i++)
+    {
+        //
+        // The divisor is Divider * (BRD + 2), BRD is rounded to nearest.
+        //
+        ulDivider = g_ucUARTBaudDivider[i];
+        ulBRD = (ulClk + (ulDivider * ulBaud) / 2) / (ulDivider * ulBaud);
+        if((ulBRD < ((ulDivider == 1) ? 5 : 2)) ||
+           (ulBRD - 2 > UART_BAUD_BRD_M))
+        {
+            continue;
+        }
+
+        ulActual = ulClk / (ulDivider * ulBRD);
+        ulDiff = (ulActual > ulBaud) ? (ulActual - ulBaud) :
+                                       (ulBaud - ulActual);
+        if(ulDiff >= ulBestDiff)
+        {
+            continue;
+        }
+        ulBestDiff = ulDiff;
+
+        if(ulDivider == 16)
+        {
+            psPlan->ulBaudReg = 0;
+        }
+        else if(ulDivider == 1)
+        {
+            psPlan->ulBaudReg = UART_BAUD_DIV_X_EN | UART_BAUD_DIV_X_ONE;
+        }
+        else
+        {
+            psPlan->ulBaudReg = UART_BAUD_DIV_X_EN |
+                                ((ulDivider - 1) << UART_BAUD_DIV_X_S);
+        }
+        psPlan->ulBaudReg |= (ulBRD - 2) << UART_BAUD_BRD_S;
+        psPlan->ulBaud = ulActual;
+
+        //
+        // Error in 0.01 %, kept in range for any sane divider.
+        //
+        ulDiff = (ulDiff < 0x7FFFFFFF / 10000) ? (ulDiff * 10000 / ulBaud) :
+                                                 (ulDiff / ulBaud * 10000);
+        psPlan->lError = (ulActual > ulBaud) ? (long)ulDiff : -(long)ulDiff;
+    }
+
+    return (ulBestDiff != 0xFFFFFFFF) ? xtrue : xfalse;
+}
+
+//*****************************************************************************
+//
+//! \brief Switches a UART to a precomputed baud rate.
+//!
+//! \param ulBase is the base address of the UART port.
+//! \param psPlan is a plan filled by UARTBaudPlanCompute().
+//!
+//! Writes the UART_BAUD register only, the line settings, FIFOs and
+//! interrupts are left alone. Should be called with the Tx FIFO empty, see
+//! UARTFIFOTxIsEmpty(), so no character is sent at a mixed rate.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+UARTBaudPlanApply(unsigned long ulBase, const tUARTBaudPlan *psPlan)
+{
+    //
+    // Check the arguments.
+    //
+    xASSERT(UARTBaseValid(ulBase));
+    xASSERT(psPlan != 0);
+
+    xHWREG(ulBase + UART_BAUD) = psPlan->ulBaudReg;
+}
+
+//*****************************************************************************
+//
+//! \brief Starts the RS-485 transaction engine of a UART port.
+//!
+//! \param ulBase is the base address of the UART port.
+//!
+//! The port must be set up with UART485Config() first. The engine turns on
+//! the RS-485 auto direction mode, so the UART drives RTS, wired to the
+//! transceiver driver enable, exactly while the request is on the line and
+//! turns the bus around by itself when the last bit is out. The receiver of
+//! the transceiver must be off while driving.
+//!
+//! The end of a response is found with the Rx time out, set to a 3.5
+//! character gap for the current line settings as Modbus RTU requires. The
+//! response time out is counted by UART485Tick(), which the application
+//! calls from a periodic timer.
+//!
+//! The engine takes over the interrupts of the port, the ring buffers and
+//! the framing engine must not be used on it.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+UART485XferInit(unsigned long ulBase)
+{
+    tUART485 *ps485;
+    unsigned long ulIndex, ulLCR, ulBits;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT(UARTBaseValid(ulBase));
+    xASSERT(g_psUARTRing[UARTIndexGet(ulBase)] == 0);
+    xASSERT(g_psUARTFrame[UARTIndexGet(ulBase)] == 0);
+
+    ulIndex = UARTIndexGet(ulBase);
+    ps485 = &g_sUART485[ulIndex];
+
+    //
+    // Stop servicing the port while the engine is set up.
+    //
+    xHWREG(ulBase + UART_IER) &= ~(UART_IER_RDA_IEN | UART_IER_THRE_IEN |
+                                   UART_IER_RTO_IEN);
+    g_psUART485[ulIndex] = 0;
+
+    ps485->psHead = 0;
+    ps485->psTail = 0;
+    ps485->ulState = UART_485_STATE_IDLE;
+    ps485->ulTxCount = 0;
+    ps485->ulTicks = 0;
+
+    g_psUART485[ulIndex] = ps485;
+    UART485StatsClear(ulBase);
+
+    //
+    // Bits per character: start, data, parity and stop bits.
+    //
+    ulLCR = xHWREG(ulBase + UART_LCR);
+    ulBits = 1 + ((ulLCR & UART_LCR_WLS_M) >> UART_LCR_WLS_S) + 5;
+    ulBits += (ulLCR & UART_LCR_PBE) ? 1 : 0;
+    ulBits += (ulLCR & UART_LCR_NSB) ? 2 : 1;
+
+    xHWREG(ulBase + UART_LIN_BCNT) |= UART_LIN_BCNT_RS485_AUD;
+    xHWREG(ulBase + UART_TOR) = (ulBits * 7 + 1) / 2;
+    xHWREG(ulBase + UART_FCR) &= ~UART_FCR_RFITL_M;
+    xHWREG(ulBase + UART_FCR) |= UART_FIFO_8BYTES | UART_FCR_RX_RST;
+
+    xHWREG(ulBase + UART_IER) |= UART_IER_RDA_IEN | UART_IER_RTO_IEN |
+                                 UART_IER_TIME_OUT_EN;
+}
+
+//*****************************************************************************
+//
+//! \brief Stops the RS-485 transaction engine of a UART port.
+//!
+//! \param ulBase is the base address of the UART port.
+//!
+//! Disables the interrupts used by the engine and the RS-485 auto direction
+//! mode turned on by UART485XferInit(). Queued transfers are dropped and
+//! stay \b UART_485_XFER_PENDING.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+UART485XferDisable(unsigned long ulBase)
+{
+    //
+    // Check the arguments.
+    //
+    xASSERT(UARTBaseValid(ulBase));
+
+    xHWREG(ulBase + UART_IER) &= ~(UART_IER_RDA_IEN | UART_IER_THRE_IEN |
+                                   UART_IER_RTO_IEN | UART_IER_TIME_OUT_EN);
+    xHWREG(ulBase + UART_LIN_BCNT) &= ~UART_LIN_BCNT_RS485_AUD;
+    g_psUART485[UARTIndexGet(ulBase)] = 0;
+}
+
+//*****************************************************************************
+//
+//! \brief Queues a RS-485 transfer.
+//!
+//! \param ulBase is the base address of the UART port.
+//! \param psXfer is the transfer, owned by the driver until it ends.
+//!
+//! Appends \e psXfer to the queue of the port and returns at once. The
+//! request is sent from the UART interrupt as soon as the bus is free, then
+//! the response is collected into \e psXfer->pucRxBuf. When the transfer
+//! ends \e psXfer->ulStatus is set and \e psXfer->pfnCallback, if not 0, is
+//! called from the interrupt with the status and the response length.
+//!
+//! Can be called from the transfer callback to chain requests.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+UART485XferQueue(unsigned long ulBase, tUART485Xfer *psXfer)
+{
+    tUART485 *ps485;
+    xtBoolean bMasked;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT(UARTBaseValid(ulBase));
+    xASSERT(g_psUART485[UARTIndexGet(ulBase)] != 0);
+    xASSERT((psXfer != 0) && (psXfer->ulTxLen != 0));
+    xASSERT((psXfer->ulTimeout == 0) || (psXfer->pucRxBuf != 0));
+
+    ps485 = g_psUART485[UARTIndexGet(ulBase)];
+    psXfer->ulStatus = UART_485_XFER_PENDING;
+    psXfer->ulRxLen = 0;
+    psXfer->psNext = 0;
+
+    bMasked = xIntMasterDisable();
+    if(ps485->psTail != 0)
+    {
+        ps485->psTail->psNext = psXfer;
+    }
     else
     {
-        xHWREG(ulBase + UART_IRCR) &= ~UART_IRCR_TX_SELECT;
+        ps485->psHead = psXfer;
+    }
+    ps485->psTail = psXfer;
+    if(ps485->ulState == UART_485_STATE_IDLE)
+    {
+        UART485XferStart(ulBase, ps485);
+    }
+    if(!bMasked)
+    {
+        xIntMasterEnable();
     }
 }
 
-
 //*****************************************************************************
 //
-//! \brief Open 485 mode on the specified UART.
+//! \brief Counts the response time out of a RS-485 port.
 //!
 //! \param ulBase is the base address of the UART port.
-//! \param ul485Config is the Config of the UART port in 485 mode.
-//! \param ulUARTConfig is the Config for UART.
 //!
-//! Open the 485 mode for the UART. 
+//! Must be called periodically, typically from a 1 ms timer interrupt. The
+//! transfer time outs and the turnaround statistics are counted in periods
+//! of this call, from the first call that sees the request fully sent. A
+//! transfer whose response has not started within its \e ulTimeout periods
+//! ends with \b UART_485_XFER_TIMEOUT. A request whose last character is
+//! still shifting out when the Tx FIFO empties is turned around here.
 //!
-//! The baud rate is provided in the \e ulBaud parameter and the data
-//! format in the \e ulUARTConfig parameter.
+//! \return None.
+//
+//*****************************************************************************
+void
+UART485Tick(unsigned long ulBase)
+{
+    tUART485 *ps485;
+    xtBoolean bMasked;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT(UARTBaseValid(ulBase));
+
+    ps485 = g_psUART485[UARTIndexGet(ulBase)];
+    if(ps485 == 0)
+    {
+        return;
+    }
+
+    bMasked = xIntMasterDisable();
+    if((ps485->ulState == UART_485_STATE_DRAIN) &&
+       (xHWREG(ulBase + UART_FSR) & UART_FSR_TE_F))
+    {
+        UART485TxDone(ulBase, ps485);
+    }
+    else if(ps485->ulState == UART_485_STATE_WAIT)
+    {
+        ps485->ulTicks++;
+        if(ps485->ulTicks >= ps485->psHead->ulTimeout)
+        {
+            ps485->sStats.ulTimeouts++;
+            UART485XferEnd(ulBase, ps485, UART_485_XFER_TIMEOUT);
+        }
+    }
+    if(!bMasked)
+    {
+        xIntMasterEnable();
+    }
+}
+
+//*****************************************************************************
+//
+//! \brief Gets the bus statistics of a RS-485 port.
 //!
-//! The \e ulUARTConfig parameter is the logical OR of three values: the number of
-//! data bits, the number of stop bits, and the parity.  \b UART_CONFIG_WLEN_8,
-//! \b UART_CONFIG_WLEN_7, \b UART_CONFIG_WLEN_6, and \b UART_CONFIG_WLEN_5
-//! select from eight to five data bits per byte (respectively).
-//! \b UART_CONFIG_STOP_ONE and \b UART_CONFIG_STOP_TWO select one or two stop
-//! bits (respectively).  \b UART_CONFIG_PAR_NONE, \b UART_CONFIG_PAR_EVEN,
-//! \b UART_CONFIG_PAR_ODD, \b UART_CONFIG_PAR_ONE, and \b UART_CONFIG_PAR_ZERO
-//! select the parity mode (no parity bit, even parity bit, odd parity bit,
-//! parity bit always one, and parity bit always zero, respectively).
+//! \param ulBase is the base address of the UART port.
+//! \param psStats is where the statistics are copied.
 //!
-//! The \e ul485Config parameter is the logical OR of five values: the 
-//! Address match value,RS-485 Address Detection Enable,RS-485 Auto Direction
-//! Mode (AUD),RS-485 Auto Address Detection Operation Mode (AAD),RS-485 Normal
-//! Multi-drop Operation Mode (NMM).
+//! \return None.
+//
+//*****************************************************************************
+void
+UART485StatsGet(unsigned long ulBase, tUART485Stats *psStats)
+{
+    xtBoolean bMasked;
+
+    //
+    // Check the arguments.
+    //
+    xASSERT(UARTBaseValid(ulBase));
+    xASSERT(g_psUART485[UARTIndexGet(ulBase)] != 0);
+    xASSERT(psStats != 0);
+
+    bMasked = xIntMasterDisable();
+    *psStats = g_psUART485[UARTIndexGet(ulBase)]->sStats;
+    if(!bMasked)
+    {
+        xIntMasterEnable();
+    }
+}
+
+//*****************************************************************************
+//
+//! \brief Clears the bus statistics of a RS-485 port.
+//!
+//! \param ulBase is the base address of the UART port.
 //!
 //! \return None.
 //
 //*****************************************************************************
 void
-UART485Config(unsigned long ulBase, unsigned long ulBaud,
-              unsigned long ul485Config, unsigned long ulUARTConfig)
+UART485StatsClear(unsigned long ulBase)
 {
+    tUART485Stats *psStats;
+    xtBoolean bMasked;
+
     //
     // Check the arguments.
     //
     xASSERT(UARTBaseValid(ulBase));
+    xASSERT(g_psUART485[UARTIndexGet(ulBase)] != 0);
+
+    psStats = &g_psUART485[UARTIndexGet(ulBase)]->sStats;
+
+    bMasked = xIntMasterDisable();
+    psStats->ulRequests = 0;
+    psStats->ulResponses = 0;
+    psStats->ulCRCErrors = 0;
+    psStats->ulOverflows = 0;
+    psStats->ulTimeouts = 0;
+    psStats->ulTurnaroundLast = 0;
+    psStats->ulTurnaroundMax = 0;
+    if(!bMasked)
+    {
+        xIntMasterEnable();
+    }
+}
+
+//*****************************************************************************
+//
+//! \brief Computes the Modbus CRC-16 of a buffer.
+//!
+//! \param pucData is the data.
+//! \param ulLength is the number of bytes in \e pucData.
+//!
+//! The CRC is sent low byte first after the data. Over a frame including
+//! its CRC the result is 0, which is how \b UART_485_XFER_CRC16 checks a
+//! response.
+//!
+//! \return Returns the CRC.
+//
+//*****************************************************************************
+unsigned short
+UART485CRC16(const unsigned char *pucData, unsigned long ulLength)
+{
+    unsigned long ulCRC, i;
+
+    ulCRC = 0xFFFF;
+    while(ulLength--)
+    {
+        ulCRC ^= *pucData++;
+        for(i = 0; i < 8; i++)
+        {
+            ulCRC = (ulCRC & 1) ? ((ulCRC >> 1) ^ 0xA001) : (ulCRC >> 1);
+        }
+    }
 
+    return (unsigned short)ulCRC;
+}
 
+//*****************************************************************************
+//
+//! \brief Starts the deferred log.
+//!
+//! \param ulBase is the base address of the UART port the log goes to.
+//! \param psBuf is the entry ring.
+//! \param ulEntries is the number of entries in \e psBuf, must be a power of
+//! two.
+//! \param ulFlags is \b UART_LOG_PENDSV to pend PendSV on every UARTLog(),
+//! or 0 to leave the calls of UARTLogFlush() to the application.
+//!
+//! UARTLog() only stores the format pointer and the raw arguments in the
+//! ring, the text is formatted and sent later by UARTLogFlush(). With
+//! \b UART_LOG_PENDSV the application must call UARTLogFlush() from its
+//! PendSVIntHandler(), so the output runs at the lowest priority.
+//!
+//! If the port has ring buffers (UARTRingBufferInit()) the text is queued in
+//! the Tx ring and UARTLogFlush() never waits, otherwise it is sent with
+//! UARTBufferWrite().
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+UARTLogInit(unsigned long ulBase, tUARTLogEntry *psBuf,
+            unsigned long ulEntries, unsigned long ulFlags)
+{
     //
-    // Set baud, 8 bit word length, even parity, 2 stop bits (even though the STP2
-    // bit is ignored when in smartcard mode, this lets the caller read back
-    // the actual setting in use).
+    // Check the arguments.
     //
-    UARTConfigSetExpClk(ulBase, ulBaud, ulUARTConfig);
+    xASSERT(UARTBaseValid(ulBase));
+    xASSERT(psBuf != 0);
+    xASSERT((ulEntries != 0) && ((ulEntries & (ulEntries - 1)) == 0));
+    xASSERT((ulFlags & ~UART_LOG_PENDSV) == 0);
+
+    g_sUARTLog.ulBase = 0;
+    g_sUARTLog.psBuf = psBuf;
+    g_sUARTLog.ulMask = ulEntries - 1;
+    g_sUARTLog.ulHead = 0;
+    g_sUARTLog.ulTail = 0;
+    g_sUARTLog.ulSent = 0;
+    g_sUARTLog.ulDropped = 0;
+    g_sUARTLog.ulFlags = ulFlags;
+    g_sUARTLog.ulBase = ulBase;
+}
+
+//*****************************************************************************
+//
+//! \brief Logs a message without formatting it.
+//!
+//! \param pcFormat is the format string.
+//! \param ulArg0 is the first argument.
+//! \param ulArg1 is the second argument.
+//! \param ulArg2 is the third argument.
+//! \param ulArg3 is the fourth argument.
+//!
+//! Stores \e pcFormat and the arguments in the log ring and returns, it can
+//! be called from any interrupt. \e pcFormat and the strings passed to
+//! \b %s are used when the entry is flushed, so they must not be on the
+//! stack. See UARTLogFormat() for the conversions.
+//!
+//! The UARTLog0() to UARTLog4() macros fill the unused arguments.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+UARTLog(const char *pcFormat, unsigned long ulArg0, unsigned long ulArg1,
+        unsigned long ulArg2, unsigned long ulArg3)
+{
+    tUARTLogEntry *psEntry;
+    unsigned long ulHead;
+    xtBoolean bMasked, bStored;
+
+    bMasked = xIntMasterDisable();
+    ulHead = g_sUARTLog.ulHead;
+    bStored = xfalse;
+    if((g_sUARTLog.ulBase == 0) ||
+       ((ulHead - g_sUARTLog.ulTail) > g_sUARTLog.ulMask))
+    {
+        g_sUARTLog.ulDropped++;
+    }
+    else
+    {
+        psEntry = &g_sUARTLog.psBuf[ulHead & g_sUARTLog.ulMask];
+        psEntry->pcFormat = pcFormat;
+        psEntry->ulArg[0] = ulArg0;
+        psEntry->ulArg[1] = ulArg1;
+        psEntry->ulArg[2] = ulArg2;
+        psEntry->ulArg[3] = ulArg3;
+        g_sUARTLog.ulHead = ulHead + 1;
+        bStored = xtrue;
+    }
+    if(!bMasked)
+    {
+        xIntMasterEnable();
+    }
+
+    if(bStored && (g_sUARTLog.ulFlags & UART_LOG_PENDSV))
+    {
+        xHWREG(NVIC_INT_CTRL) = NVIC_INT_CTRL_PEND_SV;
+    }
+}
+
+//*****************************************************************************
+//
+//! \brief Formats and sends the pending log entries.
+//!
+//! Formats the entries in order and sends them to the log port. When the
+//! port has a Tx ring the function stops at the first entry that does not
+//! fit, the entry stays in the log for the next call. An entry longer than
+//! the whole Tx ring is queued in pieces over several calls instead. With
+//! \b UART_LOG_PENDSV the next call is pended by the UART interrupt when
+//! the Tx ring runs empty.
+//!
+//! Must be called from one context only, the PendSV handler when the log is
+//! started with \b UART_LOG_PENDSV.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+UARTLogFlush(void)
+{
+    char pcLine[UART_LOG_LINE_MAX];
+    tUARTLogEntry *psEntry;
+    tUARTRing *psRing;
+    unsigned long ulBase, ulTail, ulLength, ulSpace;
+
+    ulBase = g_sUARTLog.ulBase;
+    if(ulBase == 0)
+    {
+        return;
+    }
+
+    psRing = g_psUARTRing[UARTIndexGet(ulBase)];
+    ulTail = g_sUARTLog.ulTail;
+    while(ulTail != g_sUARTLog.ulHead)
+    {
+        psEntry = &g_sUARTLog.psBuf[ulTail & g_sUARTLog.ulMask];
+        ulLength = UARTLogFormat(pcLine, sizeof(pcLine), psEntry->pcFormat,
+                                 psEntry->ulArg);
+
+        if(psRing != 0)
+        {
+            //
+            // A line that fits the ring is queued whole, a longer one as
+            // much as there is room for at each call.
+            //
+            ulLength -= g_sUARTLog.ulSent;
+            ulSpace = UARTRingSpaceAvail(ulBase);
+            if(ulSpace < ulLength)
+            {
+                if((ulLength > psRing->ulTxMask + 1) && (ulSpace != 0))
+                {
+                    UARTRingWrite(ulBase,
+                                  (unsigned char *)pcLine + g_sUARTLog.ulSent,
+                                  ulSpace);
+                    g_sUARTLog.ulSent += ulSpace;
+                }
+                break;
+            }
+            UARTRingWrite(ulBase, (unsigned char *)pcLine + g_sUARTLog.ulSent,
+                          ulLength);
+            g_sUARTLog.ulSent = 0;
+        }
+        else
+        {
+            UARTBufferWrite(ulBase, (unsigned char *)pcLine, ulLength);
+        }
+
+        ulTail++;
+        g_sUARTLog.ulTail = ulTail;
+    }
+}
+
+//*****************************************************************************
+//
+//! \brief Gets the number of log entries lost.
+//!
+//! \return Returns the number of UARTLog() calls dropped because the log
+//! ring was full or the log was not started.
+//
+//*****************************************************************************
+unsigned long
+UARTLogDroppedGet(void)
+{
+    return g_sUARTLog.ulDropped;
+}
+
+//*****************************************************************************
+//
+//! \brief Formats a log message.
+//!
+//! \param pcBuf is where the text is stored.
+//! \param ulSize is the size of \e pcBuf, the text is cut to fit.
+//! \param pcFormat is the format string.
+//! \param pulArgs is the \b UART_LOG_ARGS arguments.
+//!
+//! Supports the conversions \b %d, \b %i, \b %u, \b %x, \b %X, \b %p,
+//! \b %c, \b %s and \b %%, with an optional \b 0 flag, a field width and
+//! an \b l length modifier, which is ignored. Each conversion takes the next
+//! argument.
+//!
+//! \return Returns the length of the text, not counting the terminating 0.
+//
+//*****************************************************************************
+unsigned long
+UARTLogFormat(char *pcBuf, unsigned long ulSize, const char *pcFormat,
+              const unsigned long *pulArgs)
+{
+    char pcNum[12];
+    const char *pcDigits, *pcStr;
+    unsigned long ulPos, ulArg, ulValue, ulRadix, ulWidth, ulLength, i;
+    char cFill;
+    xtBoolean bNeg;
 
     //
-    // Enable 485.
+    // Check the arguments.
     //
-    UARTEnable485(ulBase);
-    xHWREG(ulBase + UART_LIN_BCNT) &= 0xFFFFFF00;
-    xHWREG(ulBase + UART_LIN_BCNT) |= ul485Config;
+    xASSERT((pcBuf != 0) && (ulSize != 0));
+    xASSERT((pcFormat != 0) && (pulArgs != 0));
+
+    ulPos = 0;
+    ulArg = 0;
+    while((*pcFormat != 0) && (ulPos < ulSize - 1))
+    {
+        if(*pcFormat != '%')
+        {
+            pcBuf[ulPos++] = *pcFormat++;
+            continue;
+        }
+        pcFormat++;
+
+        //
+        // Flag, width and length.
+        //
+        cFill = ' ';
+        if(*pcFormat == '0')
+        {
+            cFill = '0';
+            pcFormat++;
+        }
+        ulWidth = 0;
+        while((*pcFormat >= '0') && (*pcFormat <= '9'))
+        {
+            ulWidth = ulWidth * 10 + (*pcFormat++ - '0');
+        }
+        if(*pcFormat == 'l')
+        {
+            pcFormat++;
+        }
+        if(*pcFormat == 0)
+        {
+            break;
+        }
+
+        ulValue = (ulArg < UART_LOG_ARGS) ? pulArgs[ulArg] : 0;
+        ulArg++;
+        ulRadix = 0;
+        bNeg = xfalse;
+        pcDigits = "0123456789abcdef";
+        pcStr = pcNum;
+        ulLength = 1;
+
+        switch(*pcFormat++)
+        {
+            case 'd':
+            case 'i':
+            {
+                if((long)ulValue < 0)
+                {
+                    bNeg = xtrue;
+                    ulValue = 0 - ulValue;
+                }
+                ulRadix = 10;
+                break;
+            }
+            case 'u':
+            {
+                ulRadix = 10;
+                break;
+            }
+            case 'X':
+            {
+                pcDigits = "0123456789ABCDEF";
+                ulRadix = 16;
+                break;
+            }
+            case 'x':
+            case 'p':
+            {
+                ulRadix = 16;
+                break;
+            }
+            case 'c':
+            {
+                pcNum[0] = (char)ulValue;
+                break;
+            }
+            case 's':
+            {
+                pcStr = (ulValue != 0) ? (const char *)ulValue : "(null)";
+                for(ulLength = 0; pcStr[ulLength] != 0; ulLength++)
+                {
+                }
+                break;
+            }
+            default:
+            {
+                //
+                // %% and unknown conversions print the character and take
+                // no argument.
+                //
+                pcNum[0] = pcFormat[-1];
+                ulArg--;
+                break;
+            }
+        }
+
+        if(ulRadix != 0)
+        {
+            i = sizeof(pcNum);
+            do
+            {
+                pcNum[--i] = pcDigits[ulValue % ulRadix];
+                ulValue /= ulRadix;
+            }
+            while(ulValue != 0);
+            if(bNeg)
+            {
+                pcNum[--i] = '-';
+            }
+            pcStr = &pcNum[i];
+            ulLength = sizeof(pcNum) - i;
+
+            //
+            // The sign goes before zero padding.
+            //
+            if(bNeg && (cFill == '0') && (ulPos < ulSize - 1))
+            {
+                pcBuf[ulPos++] = *pcStr++;
+                ulLength--;
+                ulWidth = (ulWidth != 0) ? (ulWidth - 1) : 0;
+            }
+        }
+
+        while((ulWidth > ulLength) && (ulPos < ulSize - 1))
+        {
+            pcBuf[ulPos++] = cFill;
+            ulWidth--;
+        }
+        while((ulLength != 0) && (ulPos < ulSize - 1))
+        {
+            pcBuf[ulPos++] = *pcStr++;
+            ulLength--;
+        }
+    }
 
+    pcBuf[ulPos] = 0;
+    return ulPos;
 }
 
@@ -1690,6 +1690,372 @@ extern void xUARTIrDAConfig(unsigned long ulBase, unsigned long ulBaud,
 //
 //*****************************************************************************
 
+//*****************************************************************************
+//
+//! \addtogroup NUC1xx_UART_Ring_Config NUC1xx UART Ring Buffer Configuration
+//! \brief Values that show NUC1xx UART Ring Buffer Configuration
+//! Values used by UARTRingBufferInit().
+//! @{
+//
+//*****************************************************************************
+
+//
+//! Rx time out in bit times, a partial FIFO is drained after this idle time.
+//
+#ifndef UART_RING_RX_TIMEOUT
+#define UART_RING_RX_TIMEOUT    40
+#endif
+
+//*****************************************************************************
+//
+//! @}
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! \addtogroup NUC1xx_UART_DMA_Stream NUC1xx UART DMA Stream
+//! \brief Values that show NUC1xx UART DMA Stream
+//! Events passed to the callback of UARTDMAStreamStart().
+//! @{
+//
+//*****************************************************************************
+
+//
+//! A Rx buffer is full.
+//
+#define UART_DMA_EVENT_RX_FULL  0x00000001
+
+//
+//! A partial Rx buffer is flushed by UARTDMAStreamPoll() or
+//! UARTDMAStreamFlush().
+//
+#define UART_DMA_EVENT_RX_PARTIAL                                             \
+                                0x00000002
+
+//
+//! A UARTDMAStreamWrite() transfer is done.
+//
+#define UART_DMA_EVENT_TX_DONE  0x00000004
+
+//
+//! A PDMA transfer error.
+//
+#define UART_DMA_EVENT_ERROR    0x00000008
+
+//*****************************************************************************
+//
+//! @}
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! \addtogroup NUC1xx_UART_Frame NUC1xx UART Frame
+//! \brief Values that show NUC1xx UART Frame
+//! Protocols, events and error counters of the Rx framing engine, see
+//! UARTFrameInit().
+//! @{
+//
+//*****************************************************************************
+
+//
+//! SLIP framing (RFC 1055), the value is the frame delimiter.
+//
+#define UART_FRAME_SLIP         0x000000C0
+
+//
+//! COBS framing, the value is the frame delimiter.
+//
+#define UART_FRAME_COBS         0x00000000
+
+//
+//! A frame is received.
+//
+#define UART_FRAME_EVENT_RX     0x00000001
+
+//
+//! Frames longer than a pool slot.
+//
+#define UART_FRAME_ERROR_OVERRUN                                              \
+                                0
+
+//
+//! Frames with a bad SLIP escape or a truncated COBS block.
+//
+#define UART_FRAME_ERROR_DECODE 1
+
+//
+//! Frames that found no free pool slot.
+//
+#define UART_FRAME_ERROR_NO_BUFFER                                            \
+                                2
+
+//
+//! Most slots in a frame pool, must be a power of two up to 256.
+//
+#ifndef UART_FRAME_NUM_MAX
+#define UART_FRAME_NUM_MAX      16
+#endif
+
+//
+//! SLIP special characters.
+//
+#define UART_SLIP_END           0xC0
+#define UART_SLIP_ESC           0xDB
+#define UART_SLIP_ESC_END       0xDC
+#define UART_SLIP_ESC_ESC       0xDD
+
+//*****************************************************************************
+//
+//! @}
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! \addtogroup NUC1xx_UART_485_Xfer NUC1xx UART RS-485 Transfer
+//! \brief Values that show NUC1xx UART RS-485 Transfer
+//! Flags and status of a tUART485Xfer, see UART485XferQueue().
+//! @{
+//
+//*****************************************************************************
+
+//
+//! Check the Modbus CRC-16 at the end of the response.
+//
+#define UART_485_XFER_CRC16     0x00000001
+
+//
+//! The transfer is queued or running.
+//
+#define UART_485_XFER_PENDING   0x00000000
+
+//
+//! The transfer is done.
+//
+#define UART_485_XFER_DONE      0x00000001
+
+//
+//! No response within the transfer time out.
+//
+#define UART_485_XFER_TIMEOUT   0x00000002
+
+//
+//! The response CRC is wrong.
+//
+#define UART_485_XFER_CRC_ERROR 0x00000003
+
+//
+//! The response is longer than the Rx buffer.
+//
+#define UART_485_XFER_OVERFLOW  0x00000004
+
+//*****************************************************************************
+//
+//! @}
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! \addtogroup NUC1xx_UART_Log NUC1xx UART Log
+//! \brief Values that show NUC1xx UART Log
+//! Settings of the deferred log, see UARTLogInit().
+//! @{
+//
+//*****************************************************************************
+
+//
+//! Pend PendSV on every UARTLog(), the PendSV handler calls UARTLogFlush().
+//
+#define UART_LOG_PENDSV         0x00000001
+
+//
+//! Arguments stored with each log entry.
+//
+#define UART_LOG_ARGS           4
+
+//
+//! Longest formatted log line, longer lines are cut.
+//
+#ifndef UART_LOG_LINE_MAX
+#define UART_LOG_LINE_MAX       80
+#endif
+
+//*****************************************************************************
+//
+//! @}
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! \addtogroup NUC1xx_UART_Exported_Types NUC1xx UART Exported Types
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! UART baud rate plan, see UARTBaudPlanCompute()
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! UART_BAUD register value (DIV_X_EN, DIV_X_ONE, DIV_X and BRD)
+    //
+    unsigned long ulBaudReg;
+
+    //
+    //! Actual baud rate
+    //
+    unsigned long ulBaud;
+
+    //
+    //! Error of the actual baud rate in 0.01 %
+    //
+    long lError;
+}
+tUARTBaudPlan;
+
+//*****************************************************************************
+//
+//! UART RS-485 transfer, see UART485XferQueue()
+//
+//*****************************************************************************
+typedef struct tUART485Xfer
+{
+    //
+    //! Request to send
+    //
+    const unsigned char *pucTxBuf;
+
+    //
+    //! Length of the request
+    //
+    unsigned long ulTxLen;
+
+    //
+    //! Buffer for the response
+    //
+    unsigned char *pucRxBuf;
+
+    //
+    //! Size of the response buffer
+    //
+    unsigned long ulRxSize;
+
+    //
+    //! Response time out in UART485Tick() periods, 0 if no response is
+    //! expected (broadcast)
+    //
+    unsigned long ulTimeout;
+
+    //
+    //! 0 or UART_485_XFER_CRC16
+    //
+    unsigned long ulFlags;
+
+    //
+    //! Called when the transfer ends, ulEvent is the status and ulMsgParam
+    //! the response length
+    //
+    xtEventCallback pfnCallback;
+
+    //
+    //! Passed to pfnCallback
+    //
+    void *pvCBData;
+
+    //
+    //! Status, UART_485_XFER_PENDING until the transfer ends
+    //
+    volatile unsigned long ulStatus;
+
+    //
+    //! Length of the response
+    //
+    volatile unsigned long ulRxLen;
+
+    //
+    //! Next transfer in the queue, used by the driver
+    //
+    struct tUART485Xfer *psNext;
+}
+tUART485Xfer;
+
+//*****************************************************************************
+//
+//! UART RS-485 bus statistics, see UART485StatsGet()
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! Requests sent
+    //
+    unsigned long ulRequests;
+
+    //
+    //! Good responses
+    //
+    unsigned long ulResponses;
+
+    //
+    //! Responses with a bad CRC
+    //
+    unsigned long ulCRCErrors;
+
+    //
+    //! Responses longer than the Rx buffer
+    //
+    unsigned long ulOverflows;
+
+    //
+    //! Requests without response
+    //
+    unsigned long ulTimeouts;
+
+    //
+    //! Turnaround of the last response in UART485Tick() periods, from the
+    //! end of the request to the first response byte
+    //
+    unsigned long ulTurnaroundLast;
+
+    //
+    //! Longest turnaround seen
+    //
+    unsigned long ulTurnaroundMax;
+}
+tUART485Stats;
+
+//*****************************************************************************
+//
+//! UART log entry, see UARTLogInit()
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! Format string
+    //
+    const char *pcFormat;
+
+    //
+    //! Raw arguments
+    //
+    unsigned long ulArg[UART_LOG_ARGS];
+}
+tUARTLogEntry;
+
+//*****************************************************************************
+//
+//! @}
+//
+//*****************************************************************************
+
 //*****************************************************************************
 //
 //! \addtogroup NUC1xx_UART_Exported_APIs NUC1xx UART API
@@ -1757,6 +2123,94 @@ extern void UARTRxTimeOutSet(unsigned long ulBase, unsigned long ulValue);
 extern void UART485Config(unsigned long ulBase, unsigned long ulBaud,
                           unsigned long ul485Config,
                           unsigned long ulUARTConfig);
+extern void UARTRingBufferInit(unsigned long ulBase, unsigned char *pucTxBuf,
+                               unsigned long ulTxSize, unsigned char *pucRxBuf,
+                               unsigned long ulRxSize);
+extern void UARTRingBufferDisable(unsigned long ulBase);
+extern unsigned long UARTRingWrite(unsigned long ulBase,
+                                   const unsigned char *pucData,
+                                   unsigned long ulLength);
+extern unsigned long UARTRingRead(unsigned long ulBase, unsigned char *pucData,
+                                  unsigned long ulLength);
+extern unsigned long UARTRingAvailable(unsigned long ulBase);
+extern unsigned long UARTRingSpaceAvail(unsigned long ulBase);
+extern unsigned long UARTRingRxDroppedGet(unsigned long ulBase);
+extern xtBoolean UARTDMAStreamStart(unsigned long ulBase,
+                                    unsigned char *pucBuf0,
+                                    unsigned char *pucBuf1,
+                                    unsigned long ulLength,
+                                    xtEventCallback pfnCallback);
+extern xtBoolean UARTDMAStreamWrite(unsigned long ulBase,
+                                    unsigned char *pucData,
+                                    unsigned long ulLength);
+extern xtBoolean UARTDMAStreamTxBusy(unsigned long ulBase);
+extern void UARTDMAStreamFlush(unsigned long ulBase);
+extern xtBoolean UARTDMAStreamPoll(unsigned long ulBase);
+extern void UARTDMAStreamStop(unsigned long ulBase);
+extern void UARTFrameInit(unsigned long ulBase, unsigned long ulProtocol,
+                          unsigned char *pucPool, unsigned long ulFrameSize,
+                          unsigned long ulFrameNum,
+                          xtEventCallback pfnCallback);
+extern void UARTFrameDisable(unsigned long ulBase);
+extern unsigned long UARTFrameGet(unsigned long ulBase,
+                                  unsigned char **ppucFrame);
+extern void UARTFrameRelease(unsigned long ulBase, unsigned char *pucFrame);
+extern unsigned long UARTFrameErrorCountGet(unsigned long ulBase,
+                                            unsigned long ulError);
+extern xtBoolean UARTBaudPlanCompute(unsigned long ulBaud,
+                                     tUARTBaudPlan *psPlan);
+extern void UARTBaudPlanApply(unsigned long ulBase,
+                              const tUARTBaudPlan *psPlan);
+extern void UART485XferInit(unsigned long ulBase);
+extern void UART485XferDisable(unsigned long ulBase);
+extern void UART485XferQueue(unsigned long ulBase, tUART485Xfer *psXfer);
+extern void UART485Tick(unsigned long ulBase);
+extern void UART485StatsGet(unsigned long ulBase, tUART485Stats *psStats);
+extern void UART485StatsClear(unsigned long ulBase);
+extern unsigned short UART485CRC16(const unsigned char *pucData,
+                                   unsigned long ulLength);
+extern void UARTLogInit(unsigned long ulBase, tUARTLogEntry *psBuf,
+                        unsigned long ulEntries, unsigned long ulFlags);
+extern void UARTLog(const char *pcFormat, unsigned long ulArg0,
+                    unsigned long ulArg1, unsigned long ulArg2,
+                    unsigned long ulArg3);
+extern void UARTLogFlush(void);
+extern unsigned long UARTLogDroppedGet(void);
+extern unsigned long UARTLogFormat(char *pcBuf, unsigned long ulSize,
+                                   const char *pcFormat,
+                                   const unsigned long *pulArgs);
+
+//
+//! Logs a message with no argument.
+//
+#define UARTLog0(pcFormat)                                                    \
+        UARTLog(pcFormat, 0, 0, 0, 0)
+
+//
+//! Logs a message with one argument.
+//
+#define UARTLog1(pcFormat, a0)                                                \
+        UARTLog(pcFormat, (unsigned long)(a0), 0, 0, 0)
+
+//
+//! Logs a message with two arguments.
+//
+#define UARTLog2(pcFormat, a0, a1)                                            \
+        UARTLog(pcFormat, (unsigned long)(a0), (unsigned long)(a1), 0, 0)
+
+//
+//! Logs a message with three arguments.
+//
+#define UARTLog3(pcFormat, a0, a1, a2)                                        \
+        UARTLog(pcFormat, (unsigned long)(a0), (unsigned long)(a1),           \
+                (unsigned long)(a2), 0)
+
+//
+//! Logs a message with four arguments.
+//
+#define UARTLog4(pcFormat, a0, a1, a2, a3)                                    \
+        UARTLog(pcFormat, (unsigned long)(a0), (unsigned long)(a1),           \
+                (unsigned long)(a2), (unsigned long)(a3))
 
 
 //*****************************************************************************
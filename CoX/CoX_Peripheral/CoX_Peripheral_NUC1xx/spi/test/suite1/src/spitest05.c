@@ -0,0 +1,238 @@
+//*****************************************************************************
+//
+//! @page xspi_testcase xcore register test
+//!
+//! File: @ref spitest05.c
+//!
+//! <h2>Description</h2>
+//! This module implements the test sequence for the xspi sub component.<br><br>
+//! - \p Board: NUC140 <br><br>
+//! - \p Last-Time(about): 0.5s <br><br>
+//! - \p Phenomenon: Success or failure information will be printed on the UART. <br><br>
+//! .
+//!
+//! <h2>Preconditions</h2>
+//! The module requires the following options:<br><br>
+//! - \p Option-define:
+//! <br>(1)None.<br><br>
+//! - \p Option-hardware:
+//! <br>(1)Connect an USB cable to the development board.<br>
+//! (2)The chip must be a NUC1x0xxxCx part (SPI FIFO mode).<br><br>
+//! - \p Option-OtherModule:
+//! <br>Connect an COM cable to the development board.<br>
+//! .
+//! In case some of the required options are not enabled then some or all tests
+//! may be skipped or result FAILED.<br>
+//!
+//! <h2>Test Cases</h2>
+//! The module contain those sub tests:<br><br>
+//! - \subpage test_xspi_transfer
+//! .
+//! \file spitest05.c
+//! \brief xspi test source file
+//! \brief xspi test header file <br>
+//
+//*****************************************************************************
+#include "xhw_memmap.h"
+#include "test.h"
+#include "xspi.h"
+#include "xhw_spi.h"
+#include "xsysctl.h"
+#include "xcore.h"
+
+//*****************************************************************************
+//
+//!\page test_xspi_transfer test_xspi_transfer
+//!
+//!<h2>Description</h2>
+//!Test SPI FIFO block transfer and compare its throughput with the
+//!frame by frame path. <br>
+//!
+//
+//*****************************************************************************
+
+//
+// Number of frames moved in every measurement.
+//
+#define SPI_BENCH_FRAMES        64
+
+//
+// Bit rate of the benchmark, 2 MHz from a 36 MHz HCLK.
+//
+#define SPI_BENCH_RATE          2000000
+
+//
+// Frame widths measured.
+//
+static unsigned long ulBenchWidth[3] = {SPI_DATA_WIDTH8, SPI_DATA_WIDTH16,
+                                        SPI_DATA_WIDTH32};
+static unsigned long ulBenchBits[3] = {8, 16, 32};
+
+static unsigned long ulBenchTx[SPI_BENCH_FRAMES];
+static unsigned long ulBenchRx[SPI_BENCH_FRAMES];
+
+//
+// Effective throughput in kbit/s, [width][0] for SPITransfer() and
+// [width][1] for SPIDataWrite(). Left in RAM for inspection with a debugger.
+//
+unsigned long g_ulSPIBenchKbps[3][2];
+
+//*****************************************************************************
+//
+//! \brief Get the Test description of xspi006 transfer test.
+//!
+//! \return the desccription of the xspi006 test.
+//
+//*****************************************************************************
+static char* xSpi006GetTest(void)
+{
+    return "xspi, 006, xspi FIFO transfer throughput test";
+}
+
+//*****************************************************************************
+//
+//! \brief something should do before the test execute of xspi006 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xSpi006Setup(void)
+{
+    //
+    // Set SysClk 36MHz using Extern 12M oscillator
+    //
+    xSysCtlClockSet(36000000, xSYSCTL_OSC_MAIN | xSYSCTL_XTAL_12MHZ);
+
+    SysCtlPeripheralReset(SYSCTL_PERIPH_SPI0);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_SPI0);
+
+    xSysTickPeriodSet(0xFFFFFF);
+    xSysTickEnable();
+}
+
+//*****************************************************************************
+//
+//! \brief something should do after the test execute of xspi006 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xSpi006TearDown(void)
+{
+    unsigned long ulTemp;
+
+    xSysTickDisable();
+
+    ulTemp = SYSCTL_SYSDIV_1|SYSCTL_XTAL_12MHZ|SYSCTL_OSC_MAIN|SYSCTL_PLL_PWRDN
+                                                           | SYSCTL_INT_OSC_DIS;
+    SysCtlHClockSet(ulTemp);
+
+    SysCtlPeripheralClockSourceSet(SYSCTL_PERIPH_UART_S_EXT12M);
+    SysCtlIPClockDividerSet(SYSCTL_PERIPH_UART_D|0);
+
+    SysCtlPeripheralDisable(SYSCTL_PERIPH_SPI0);
+}
+
+//*****************************************************************************
+//
+//! \brief xspi 006 test of SPITransfer() against SPIDataWrite().
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xspi_SPITransfer_test(void)
+{
+    unsigned long i, j, ulStart, ulTicks, ulHClkKHz, ulSClkKbps, ulKbits;
+
+    for(i = 0; i < SPI_BENCH_FRAMES; i++)
+    {
+        ulBenchTx[i] = 0xA5A5A5A5 ^ (i * 0x01010101);
+    }
+
+    ulHClkKHz = SysCtlHClockGet() / 1000;
+
+    for(i = 0; i < 3; i++)
+    {
+        xHWREG(SPI0_BASE + SPI_CNTRL) &= 0x0000;
+        SPIConfig(SPI0_BASE, SPI_BENCH_RATE, SPI_FORMAT_MODE_5 |
+                  ulBenchWidth[i] | SPI_MSB_FIRST | SPI_MODE_MASTER);
+        SPIFIFOModeSet(SPI0_BASE, xtrue, 2);
+        SPIFIFOModeSet(SPI0_BASE, xfalse, 2);
+
+        ulSClkKbps = ulHClkKHz / ((xHWREG(SPI0_BASE + SPI_DIVIDER) + 1) * 2);
+        ulKbits = SPI_BENCH_FRAMES * ulBenchBits[i];
+
+        //
+        // FIFO block transfer, every frame must come back and the port must
+        // be left in the mode it was found in.
+        //
+        for(j = 0; j < SPI_BENCH_FRAMES; j++)
+        {
+            ulBenchRx[j] = 0;
+        }
+        ulStart = xSysTickValueGet();
+        SPITransfer(SPI0_BASE, ulBenchTx, ulBenchRx, SPI_BENCH_FRAMES);
+        ulTicks = (ulStart - xSysTickValueGet()) & 0xFFFFFF;
+        g_ulSPIBenchKbps[i][0] = ulKbits * ulHClkKHz / ulTicks;
+
+        TestAssert(!(xHWREG(SPI0_BASE + SPI_CNTRL) & SPI_CNTRL_FIFO),
+                   "xspi API error!");
+        TestAssert(!(xHWREG(SPI0_BASE + SPI_CNTRL) & SPI_CNTRL_GO_BUSY),
+                   "xspi API error!");
+
+        //
+        // Frame by frame write of the same block.
+        //
+        ulStart = xSysTickValueGet();
+        SPIDataWrite(SPI0_BASE, ulBenchTx, SPI_BENCH_FRAMES);
+        ulTicks = (ulStart - xSysTickValueGet()) & 0xFFFFFF;
+        g_ulSPIBenchKbps[i][1] = ulKbits * ulHClkKHz / ulTicks;
+
+        //
+        // The FIFO path must beat the per-frame path and keep the wire at
+        // least half busy.
+        //
+        TestAssert(g_ulSPIBenchKbps[i][0] > g_ulSPIBenchKbps[i][1],
+                   "xspi API error!");
+        TestAssert(g_ulSPIBenchKbps[i][0] * 2 >= ulSClkKbps,
+                   "xspi API error!");
+
+        //
+        // Receive only with the fill pattern, nothing stored.
+        //
+        SPITransfer(SPI0_BASE, 0, 0, SPI_BENCH_FRAMES);
+        TestAssert(!(xHWREG(SPI0_BASE + SPI_CNTRL) & SPI_CNTRL_GO_BUSY),
+                   "xspi API error!");
+    }
+}
+
+//*****************************************************************************
+//
+//! \brief xspi 006 test execute main body.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xSpi006Execute(void)
+{
+    xspi_SPITransfer_test();
+}
+
+//
+// xspi transfer test case struct.
+//
+const tTestCase sTestXSpi006Transfer = {
+    xSpi006GetTest,
+    xSpi006Setup,
+    xSpi006TearDown,
+    xSpi006Execute
+};
+
+//
+// Xspi test suits.
+//
+const tTestCase * const psPatternXspi05[] =
+{
+    &sTestXSpi006Transfer,
+    0
+};
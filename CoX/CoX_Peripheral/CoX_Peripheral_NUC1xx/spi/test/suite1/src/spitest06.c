@@ -0,0 +1,283 @@
+//*****************************************************************************
+//
+//! @page xspi_testcase xcore register test
+//!
+//! File: @ref spitest06.c
+//!
+//! <h2>Description</h2>
+//! This module implements the test sequence for the xspi sub component.<br><br>
+//! - \p Board: NUC140 <br><br>
+//! - \p Last-Time(about): 0.5s <br><br>
+//! - \p Phenomenon: Success or failure information will be printed on the UART. <br><br>
+//! .
+//!
+//! <h2>Preconditions</h2>
+//! The module requires the following options:<br><br>
+//! - \p Option-define:
+//! <br>(1)None.<br><br>
+//! - \p Option-hardware:
+//! <br>(1)Connect an USB cable to the development board.<br>
+//! (2)PA.0 and PA.1 are used as chip selects, leave them unconnected.<br><br>
+//! - \p Option-OtherModule:
+//! <br>Connect an COM cable to the development board.<br>
+//! .
+//! In case some of the required options are not enabled then some or all tests
+//! may be skipped or result FAILED.<br>
+//!
+//! <h2>Test Cases</h2>
+//! The module contain those sub tests:<br><br>
+//! - \subpage test_xspi_job
+//! .
+//! \file spitest06.c
+//! \brief xspi test source file
+//! \brief xspi test header file <br>
+//
+//*****************************************************************************
+#include "xhw_memmap.h"
+#include "xhw_ints.h"
+#include "test.h"
+#include "xspi.h"
+#include "xhw_spi.h"
+#include "xsysctl.h"
+#include "xhw_gpio.h"
+#include "xgpio.h"
+#include "xcore.h"
+
+//*****************************************************************************
+//
+//!\page test_xspi_job test_xspi_job
+//!
+//!<h2>Description</h2>
+//!Test the SPI job queue: descriptor order, chip select sequencing and
+//!completion. <br>
+//!
+//
+//*****************************************************************************
+
+//
+// Chip selects of the two devices.
+//
+#define SPI_JOB_CS_PORT         GPIO_PORTA_BASE
+#define SPI_JOB_CS_A            GPIO_PIN_0
+#define SPI_JOB_CS_B            GPIO_PIN_1
+
+//
+// A flash style read: command, 24 bit address, then data.
+//
+static unsigned char ucJobCmd[1] = {0x03};
+static unsigned char ucJobAddr[3] = {0x01, 0x02, 0x03};
+static unsigned char ucJobData[4];
+static unsigned char ucJobReg[2] = {0x55, 0xAA};
+
+static tSPIJobDesc sJobDescA[3];
+static tSPIJobDesc sJobDescB[1];
+static tSPIJob sJobA;
+static tSPIJob sJobB;
+
+//
+// What the callbacks saw: event, descriptor index and chip select levels.
+//
+static unsigned long ulJobEvent[4];
+static unsigned long ulJobIndex[4];
+static unsigned long ulJobCSLevel[4];
+static volatile unsigned long ulJobCalls;
+
+//*****************************************************************************
+//
+//! \brief Descriptor callback of the job test, records the call.
+//!
+//! \return 0.
+//
+//*****************************************************************************
+static unsigned long
+xspiJobCallback(void *pvCBData, unsigned long ulEvent,
+                unsigned long ulMsgParam, void *pvMsgData)
+{
+    if(ulJobCalls < 4)
+    {
+        ulJobEvent[ulJobCalls] = ulEvent;
+        ulJobIndex[ulJobCalls] = ulMsgParam;
+        ulJobCSLevel[ulJobCalls] = xHWREG(SPI_JOB_CS_PORT + GPIO_DOUT) &
+                                   (SPI_JOB_CS_A | SPI_JOB_CS_B);
+    }
+    ulJobCalls++;
+    return 0;
+}
+
+//*****************************************************************************
+//
+//! \brief Get the Test description of xspi007 job test.
+//!
+//! \return the desccription of the xspi007 test.
+//
+//*****************************************************************************
+static char* xSpi007GetTest(void)
+{
+    return "xspi, 007, xspi job queue test";
+}
+
+//*****************************************************************************
+//
+//! \brief something should do before the test execute of xspi007 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xSpi007Setup(void)
+{
+    //
+    // Set SysClk 36MHz using Extern 12M oscillator
+    //
+    xSysCtlClockSet(36000000, xSYSCTL_OSC_MAIN | xSYSCTL_XTAL_12MHZ);
+
+    SysCtlPeripheralReset(SYSCTL_PERIPH_SPI0);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_SPI0);
+
+    xGPIODirModeSet(SPI_JOB_CS_PORT, SPI_JOB_CS_A | SPI_JOB_CS_B,
+                    xGPIO_DIR_MODE_OUT);
+    GPIOPinWrite(SPI_JOB_CS_PORT, SPI_JOB_CS_A | SPI_JOB_CS_B, 1);
+
+    xHWREG(SPI0_BASE + SPI_CNTRL) &= 0x0000;
+    SPIConfig(SPI0_BASE, 2000000, SPI_FORMAT_MODE_5 | SPI_DATA_WIDTH8 |
+              SPI_MSB_FIRST | SPI_MODE_MASTER);
+    SPIJobInit(SPI0_BASE);
+    xIntEnable(INT_SPI0);
+}
+
+//*****************************************************************************
+//
+//! \brief something should do after the test execute of xspi007 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xSpi007TearDown(void)
+{
+    unsigned long ulTemp;
+
+    SPIJobDisable(SPI0_BASE);
+    xIntDisable(INT_SPI0);
+
+    ulTemp = SYSCTL_SYSDIV_1|SYSCTL_XTAL_12MHZ|SYSCTL_OSC_MAIN|SYSCTL_PLL_PWRDN
+                                                           | SYSCTL_INT_OSC_DIS;
+    SysCtlHClockSet(ulTemp);
+
+    SysCtlPeripheralClockSourceSet(SYSCTL_PERIPH_UART_S_EXT12M);
+    SysCtlIPClockDividerSet(SYSCTL_PERIPH_UART_D|0);
+
+    SysCtlPeripheralDisable(SYSCTL_PERIPH_SPI0);
+}
+
+//*****************************************************************************
+//
+//! \brief xspi 007 test of SPIJobSubmit().
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xspi_SPIJob_test(void)
+{
+    unsigned long i, ulTimeout;
+
+    for(i = 0; i < 3; i++)
+    {
+        sJobDescA[i].ulCSPort = SPI_JOB_CS_PORT;
+        sJobDescA[i].ulCSPin = SPI_JOB_CS_A;
+        sJobDescA[i].pvRxBuf = 0;
+        sJobDescA[i].pfnCallback = xspiJobCallback;
+        sJobDescA[i].pvCBData = 0;
+    }
+    sJobDescA[0].pvTxBuf = ucJobCmd;
+    sJobDescA[0].ulLength = 1;
+    sJobDescA[1].pvTxBuf = ucJobAddr;
+    sJobDescA[1].ulLength = 3;
+    sJobDescA[2].pvTxBuf = 0;
+    sJobDescA[2].pvRxBuf = ucJobData;
+    sJobDescA[2].ulLength = 4;
+    sJobA.psDesc = sJobDescA;
+    sJobA.ulDescCount = 3;
+
+    sJobDescB[0].ulCSPort = SPI_JOB_CS_PORT;
+    sJobDescB[0].ulCSPin = SPI_JOB_CS_B;
+    sJobDescB[0].pvTxBuf = ucJobReg;
+    sJobDescB[0].pvRxBuf = 0;
+    sJobDescB[0].ulLength = 2;
+    sJobDescB[0].pfnCallback = xspiJobCallback;
+    sJobDescB[0].pvCBData = 0;
+    sJobB.psDesc = sJobDescB;
+    sJobB.ulDescCount = 1;
+
+    //
+    // Both jobs are queued at once and the caller does not wait.
+    //
+    ulJobCalls = 0;
+    SPIJobSubmit(SPI0_BASE, &sJobA);
+    SPIJobSubmit(SPI0_BASE, &sJobB);
+    TestAssert(sJobB.ulStatus == SPI_JOB_PENDING, "xspi API error!");
+
+    ulTimeout = 0x100000;
+    while((sJobB.ulStatus == SPI_JOB_PENDING) && (ulTimeout != 0))
+    {
+        ulTimeout--;
+    }
+    TestAssert(ulTimeout != 0, "xspi API error!");
+    TestAssert(sJobA.ulStatus == SPI_JOB_DONE, "xspi API error!");
+    TestAssert(sJobB.ulStatus == SPI_JOB_DONE, "xspi API error!");
+    TestAssert(ulJobCalls == 4, "xspi API error!");
+
+    //
+    // Job A: CS A held low across command and address, high at the end.
+    //
+    for(i = 0; i < 3; i++)
+    {
+        TestAssert(ulJobIndex[i] == i, "xspi API error!");
+    }
+    TestAssert(ulJobEvent[0] == SPI_JOB_EVENT_DESC, "xspi API error!");
+    TestAssert(ulJobEvent[1] == SPI_JOB_EVENT_DESC, "xspi API error!");
+    TestAssert(ulJobEvent[2] == (SPI_JOB_EVENT_DESC | SPI_JOB_EVENT_DONE),
+               "xspi API error!");
+    TestAssert(ulJobCSLevel[0] == SPI_JOB_CS_B, "xspi API error!");
+    TestAssert(ulJobCSLevel[1] == SPI_JOB_CS_B, "xspi API error!");
+    TestAssert(ulJobCSLevel[2] == (SPI_JOB_CS_A | SPI_JOB_CS_B),
+               "xspi API error!");
+
+    //
+    // Job B: its own descriptor, both chip selects released at the end.
+    //
+    TestAssert(ulJobIndex[3] == 0, "xspi API error!");
+    TestAssert(ulJobEvent[3] == (SPI_JOB_EVENT_DESC | SPI_JOB_EVENT_DONE),
+               "xspi API error!");
+    TestAssert(ulJobCSLevel[3] == (SPI_JOB_CS_A | SPI_JOB_CS_B),
+               "xspi API error!");
+}
+
+//*****************************************************************************
+//
+//! \brief xspi 007 test execute main body.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xSpi007Execute(void)
+{
+    xspi_SPIJob_test();
+}
+
+//
+// xspi job test case struct.
+//
+const tTestCase sTestXSpi007Job = {
+    xSpi007GetTest,
+    xSpi007Setup,
+    xSpi007TearDown,
+    xSpi007Execute
+};
+
+//
+// Xspi test suits.
+//
+const tTestCase * const psPatternXspi06[] =
+{
+    &sTestXSpi007Job,
+    0
+};
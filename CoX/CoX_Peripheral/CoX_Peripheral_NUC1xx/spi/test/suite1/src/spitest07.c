@@ -0,0 +1,268 @@
+//*****************************************************************************
+//
+//! @page xspi_testcase xcore register test
+//!
+//! File: @ref spitest07.c
+//!
+//! <h2>Description</h2>
+//! This module implements the test sequence for the xspi sub component.<br><br>
+//! - \p Board: NUC140 <br><br>
+//! - \p Last-Time(about): 0.5s <br><br>
+//! - \p Phenomenon: Success or failure information will be printed on the UART. <br><br>
+//! .
+//!
+//! <h2>Preconditions</h2>
+//! The module requires the following options:<br><br>
+//! - \p Option-define:
+//! <br>(1)None.<br><br>
+//! - \p Option-hardware:
+//! <br>(1)Connect an USB cable to the development board.<br><br>
+//! - \p Option-OtherModule:
+//! <br>Connect an COM cable to the development board.<br>
+//! .
+//! In case some of the required options are not enabled then some or all tests
+//! may be skipped or result FAILED.<br>
+//!
+//! <h2>Test Cases</h2>
+//! The module contain those sub tests:<br><br>
+//! - \subpage test_xspi_dma
+//! .
+//! \file spitest07.c
+//! \brief xspi test source file
+//! \brief xspi test header file <br>
+//
+//*****************************************************************************
+#include "xhw_memmap.h"
+#include "xhw_ints.h"
+#include "test.h"
+#include "xspi.h"
+#include "xhw_spi.h"
+#include "xsysctl.h"
+#include "xdma.h"
+#include "xcore.h"
+
+//*****************************************************************************
+//
+//!\page test_xspi_dma test_xspi_dma
+//!
+//!<h2>Description</h2>
+//!Test SPI PDMA transfers on every port: completion callback and channel
+//!release. <br>
+//!
+//
+//*****************************************************************************
+
+//
+// SPI Base Address Group Array
+//
+static unsigned long ulSPIDMABase[4] = {SPI0_BASE, SPI1_BASE, SPI2_BASE,
+                                        SPI3_BASE};
+
+static unsigned short usDMATx[32];
+static unsigned short usDMARx[32];
+
+//
+// What the completion callback saw.
+//
+static volatile unsigned long ulDMAEvent;
+static volatile unsigned long ulDMALength;
+static void * volatile pvDMARx;
+
+//*****************************************************************************
+//
+//! \brief Completion callback of the PDMA test, records the call.
+//!
+//! \return 0.
+//
+//*****************************************************************************
+static unsigned long
+xspiDMACallback(void *pvCBData, unsigned long ulEvent,
+                unsigned long ulMsgParam, void *pvMsgData)
+{
+    ulDMAEvent = ulEvent;
+    ulDMALength = ulMsgParam;
+    pvDMARx = pvMsgData;
+    return 0;
+}
+
+//*****************************************************************************
+//
+//! \brief Waits for the PDMA transfer of a SPI port to end.
+//!
+//! \return xtrue if it ended in time.
+//
+//*****************************************************************************
+static xtBoolean
+xspiDMAWait(unsigned long ulBase)
+{
+    unsigned long ulTimeout = 0x100000;
+
+    while(SPIDMATransferBusy(ulBase) && (ulTimeout != 0))
+    {
+        ulTimeout--;
+    }
+    return (ulTimeout != 0) ? xtrue : xfalse;
+}
+
+//*****************************************************************************
+//
+//! \brief Get the Test description of xspi008 PDMA test.
+//!
+//! \return the desccription of the xspi008 test.
+//
+//*****************************************************************************
+static char* xSpi008GetTest(void)
+{
+    return "xspi, 008, xspi PDMA transfer test";
+}
+
+//*****************************************************************************
+//
+//! \brief something should do before the test execute of xspi008 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xSpi008Setup(void)
+{
+    //
+    // Set SysClk 36MHz using Extern 12M oscillator
+    //
+    xSysCtlClockSet(36000000, xSYSCTL_OSC_MAIN | xSYSCTL_XTAL_12MHZ);
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_PDMA);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_SPI0);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_SPI1);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_SPI2);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_SPI3);
+    xIntEnable(INT_PDMA);
+}
+
+//*****************************************************************************
+//
+//! \brief something should do after the test execute of xspi008 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xSpi008TearDown(void)
+{
+    unsigned long ulTemp;
+
+    xIntDisable(INT_PDMA);
+
+    ulTemp = SYSCTL_SYSDIV_1|SYSCTL_XTAL_12MHZ|SYSCTL_OSC_MAIN|SYSCTL_PLL_PWRDN
+                                                           | SYSCTL_INT_OSC_DIS;
+    SysCtlHClockSet(ulTemp);
+
+    SysCtlPeripheralClockSourceSet(SYSCTL_PERIPH_UART_S_EXT12M);
+    SysCtlIPClockDividerSet(SYSCTL_PERIPH_UART_D|0);
+
+    SysCtlPeripheralDisable(SYSCTL_PERIPH_SPI0);
+    SysCtlPeripheralDisable(SYSCTL_PERIPH_SPI1);
+    SysCtlPeripheralDisable(SYSCTL_PERIPH_SPI2);
+    SysCtlPeripheralDisable(SYSCTL_PERIPH_SPI3);
+}
+
+//*****************************************************************************
+//
+//! \brief xspi 008 test of SPIDMATransfer().
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xspi_SPIDMATransfer_test(void)
+{
+    unsigned long i, ulChannel;
+    xtBoolean bRet;
+
+    for(i = 0; i < 32; i++)
+    {
+        usDMATx[i] = 0x1234 + i;
+    }
+
+    for(i = 0; i < 4; i++)
+    {
+        xHWREG(ulSPIDMABase[i] + SPI_CNTRL) &= 0x0000;
+        SPIConfig(ulSPIDMABase[i], 4000000, SPI_FORMAT_MODE_5 |
+                  SPI_DATA_WIDTH16 | SPI_MSB_FIRST | SPI_MODE_MASTER);
+
+        //
+        // Full duplex, the caller returns before the transfer ends and a
+        // second transfer on the same port is refused meanwhile.
+        //
+        ulDMAEvent = 0;
+        bRet = SPIDMATransfer(ulSPIDMABase[i], usDMATx, usDMARx, 32,
+                              xspiDMACallback);
+        TestAssert(bRet == xtrue, "xspi API error!");
+        bRet = SPIDMATransfer(ulSPIDMABase[i], usDMATx, usDMARx, 32,
+                              xspiDMACallback);
+        TestAssert(bRet == xfalse, "xspi API error!");
+        TestAssert(xspiDMAWait(ulSPIDMABase[i]) == xtrue, "xspi API error!");
+        TestAssert(ulDMAEvent == SPI_DMA_EVENT_DONE, "xspi API error!");
+        TestAssert(ulDMALength == 32, "xspi API error!");
+        TestAssert(pvDMARx == usDMARx, "xspi API error!");
+
+        //
+        // Receive only, clocking the fill pattern.
+        //
+        ulDMAEvent = 0;
+        bRet = SPIDMATransfer(ulSPIDMABase[i], 0, usDMARx, 8,
+                              xspiDMACallback);
+        TestAssert(bRet == xtrue, "xspi API error!");
+        TestAssert(xspiDMAWait(ulSPIDMABase[i]) == xtrue, "xspi API error!");
+        TestAssert(ulDMAEvent == SPI_DMA_EVENT_DONE, "xspi API error!");
+
+        //
+        // Transmit only, without callback.
+        //
+        bRet = SPIDMATransfer(ulSPIDMABase[i], usDMATx, 0, 8, 0);
+        TestAssert(bRet == xtrue, "xspi API error!");
+        TestAssert(xspiDMAWait(ulSPIDMABase[i]) == xtrue, "xspi API error!");
+    }
+
+    //
+    // Every channel pair went back to the pool.
+    //
+    for(i = 0; i < 9; i++)
+    {
+        ulChannel = PDMAChannelDynamicAssign(xDMA_REQUEST_MEM,
+                                             xDMA_REQUEST_MEM);
+        TestAssert(ulChannel != xDMA_CHANNEL_NOT_EXIST, "xspi API error!");
+    }
+    for(i = 0; i < 9; i++)
+    {
+        PDMAChannelDeAssign(i);
+    }
+}
+
+//*****************************************************************************
+//
+//! \brief xspi 008 test execute main body.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xSpi008Execute(void)
+{
+    xspi_SPIDMATransfer_test();
+}
+
+//
+// xspi PDMA test case struct.
+//
+const tTestCase sTestXSpi008DMA = {
+    xSpi008GetTest,
+    xSpi008Setup,
+    xSpi008TearDown,
+    xSpi008Execute
+};
+
+//
+// Xspi test suits.
+//
+const tTestCase * const psPatternXspi07[] =
+{
+    &sTestXSpi008DMA,
+    0
+};
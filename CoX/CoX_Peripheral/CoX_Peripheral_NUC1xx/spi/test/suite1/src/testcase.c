@@ -29,6 +29,9 @@ const tTestCase * const* g_psPatterns[] =  {
     psPatternXspi02,
     psPatternXspi03,
     psPatternXspi04,
+    psPatternXspi05,
+    psPatternXspi06,
+    psPatternXspi07,
     //
     // end
     //
@@ -62,6 +62,9 @@ extern const tTestCase * const psPatternXspi01[];
 extern const tTestCase * const psPatternXspi02[];
 extern const tTestCase * const psPatternXspi03[];
 extern const tTestCase * const psPatternXspi04[];
+extern const tTestCase * const psPatternXspi05[];
+extern const tTestCase * const psPatternXspi06[];
+extern const tTestCase * const psPatternXspi07[];
 //*****************************************************************************
 //
 // Mark the end of the C bindings section for C++ compilers.
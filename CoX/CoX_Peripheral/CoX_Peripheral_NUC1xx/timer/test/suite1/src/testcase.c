@@ -24,6 +24,7 @@ const tTestCase * const* g_psPatterns[] =  {
     psPatternXtimer001,
     psPatternXtimer002,
     psPatternXtimer003,
+    psPatternXtimer004,
     //
     // end
     //
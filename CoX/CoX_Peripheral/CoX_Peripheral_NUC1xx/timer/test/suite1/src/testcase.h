@@ -60,6 +60,7 @@ extern const tTestCase * const* g_psPatterns[];
 extern const tTestCase * const psPatternXtimer001[];
 extern const tTestCase * const psPatternXtimer002[];
 extern const tTestCase * const psPatternXtimer003[];
+extern const tTestCase * const psPatternXtimer004[];
 
 //*****************************************************************************
 //
@@ -0,0 +1,269 @@
+//*****************************************************************************
+//
+//! @page xtimer_testcase xtimer tick plan test
+//!
+//! File: @ref xtimertest4.c
+//!
+//! <h2>Description</h2>
+//! This module implements the test sequence for the xtimer sub component.<br><br>
+//! - \p Board: NUC140VE3CN board <br><br>
+//! - \p Last-Time(about): 0.5s <br><br>
+//! - \p Phenomenon: Success or failure information will be printed on the UART. <br><br>
+//! .
+//!
+//! <h2>Preconditions</h2>
+//! The module requires the following options:<br><br>
+//! - \p Option-define:
+//! <br>(1)None.<br><br>
+//! - \p Option-hardware:
+//! <br>(1)Connect an USB cable to the development board.<br><br>
+//! - \p Option-OtherModule:
+//! <br>Connect an COM cable to the development board.<br>
+//! .
+//! In case some of the required options are not enabled then some or all tests
+//! may be skipped or result FAILED.<br>
+//!
+//! <h2>Test Cases</h2>
+//! The module contain those sub tests:<br><br>
+//! - \subpage test_xtimer_plan
+//! .
+//! \file xtimertest4.c
+//! \brief xtimer test source file
+//! \brief xtimer test header file <br>
+//
+//*****************************************************************************
+
+#include "test.h"
+#include "xhw_types.h"
+#include "xhw_ints.h"
+#include "xhw_memmap.h"
+#include "xhw_timer.h"
+#include "xsysctl.h"
+#include "xcore.h"
+#include "xtimer.h"
+
+//*****************************************************************************
+//
+//!\page test_xtimer_plan test_xtimer_plan
+//!
+//!<h2>Description</h2>
+//!Test the tick plan: solved values, the same plans at compile time, the
+//!registers written by TimerInitConfig() and TimerPlanApply(), and the time
+//!taken, measured with SysTick. <br>
+//!
+//
+//*****************************************************************************
+
+//
+// Clocks and tick frequencies of the plans, and what is expected of them:
+// prescale, match, frequency achieved and error in ppm.
+//
+#define TIMER_TEST_PLANS        6
+
+static const unsigned long ulPlanClock[TIMER_TEST_PLANS] = {
+    12000000, 12000000, 32768, 22118400, 50000000, 12000000
+};
+static const unsigned long ulPlanFreq[TIMER_TEST_PLANS] = {
+    1000, 1, 3, 7, 1, 9000000
+};
+static const tTimerPlan sPlanExpect[TIMER_TEST_PLANS] = {
+    {0, 12000, 1000, 0},
+    {0, 12000000, 1, 0},
+    {0, 10923, 3, -30},
+    {0, 3159771, 7, 0},
+    {2, 16666667, 1, 0},
+    {0, 2, 6000000, -333333}
+};
+
+//
+// The same plans, solved by the compiler.
+//
+static const tTimerPlan sPlanConst[TIMER_TEST_PLANS] = {
+    TIMER_PLAN(12000000, 1000),
+    TIMER_PLAN(12000000, 1),
+    TIMER_PLAN(32768, 3),
+    TIMER_PLAN(22118400, 7),
+    TIMER_PLAN(50000000, 1),
+    TIMER_PLAN(12000000, 9000000)
+};
+
+//
+// SysTick ticks of TimerInitConfig() at 1KHz [0], and over half the clock
+// [1], the worst case of a search, and of TimerPlanSolve() [2].
+// Left in RAM for inspection with a debugger.
+//
+unsigned long g_ulTimerPlanBenchTicks[3];
+
+//*****************************************************************************
+//
+//! \brief Get the Test description of xtimer004 tick plan test.
+//!
+//! \return the desccription of the xtimer004 test.
+//
+//*****************************************************************************
+static char* xTimer004GetTest(void)
+{
+    return "xTimer [004]: xtimer tick plan test";
+}
+
+//*****************************************************************************
+//
+//! \brief something should do before the test execute of xtimer004 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xTimer004Setup(void)
+{
+    SysCtlKeyAddrUnlock();
+    xSysCtlClockSet(12000000, xSYSCTL_XTAL_12MHZ | xSYSCTL_OSC_MAIN);
+
+    SysCtlPeripheralClockSourceSet(SYSCTL_PERIPH_TMR0_S_EXT12M);
+    xSysCtlPeripheralEnable(xSYSCTL_PERIPH_TIMER0);
+
+    xSysTickPeriodSet(0xFFFFFF);
+    xSysTickEnable();
+}
+
+//*****************************************************************************
+//
+//! \brief something should do after the test execute of xtimer004 test.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xTimer004TearDown(void)
+{
+    xSysTickDisable();
+    xSysCtlPeripheralDisable(xSYSCTL_PERIPH_TIMER0);
+}
+
+//*****************************************************************************
+//
+//! \brief xtimer 004 test of TimerPlanSolve() and TIMER_PLAN().
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xtimer_TimerPlanSolve_test(void)
+{
+    tTimerPlan sPlan;
+    unsigned long i;
+
+    for(i = 0; i < TIMER_TEST_PLANS; i++)
+    {
+        TimerPlanSolve(ulPlanClock[i], ulPlanFreq[i], &sPlan);
+        TestAssert((sPlan.ulPrescale == sPlanExpect[i].ulPrescale) &&
+                   (sPlan.ulMatch == sPlanExpect[i].ulMatch) &&
+                   (sPlan.ulFreq == sPlanExpect[i].ulFreq) &&
+                   (sPlan.lErrorPPM == sPlanExpect[i].lErrorPPM),
+                   "xtimer API \"TimerPlanSolve\" error!");
+
+        //
+        // The error of the constant plan is computed in floating point.
+        //
+        TestAssert((sPlanConst[i].ulPrescale == sPlan.ulPrescale) &&
+                   (sPlanConst[i].ulMatch == sPlan.ulMatch) &&
+                   (sPlanConst[i].ulFreq == sPlan.ulFreq) &&
+                   (sPlanConst[i].lErrorPPM >= sPlan.lErrorPPM - 1) &&
+                   (sPlanConst[i].lErrorPPM <= sPlan.lErrorPPM + 1),
+                   "xtimer API \"TIMER_PLAN\" error!");
+    }
+}
+
+//*****************************************************************************
+//
+//! \brief xtimer 004 test of TimerInitConfig() and TimerPlanApply().
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xtimer_TimerPlanApply_test(void)
+{
+    tTimerPlan sPlan;
+    unsigned long ulStart, ulTemp;
+
+    TestAssert(TimerClockGet(TIMER0_BASE) == 12000000,
+               "xtimer API \"TimerClockGet\" error!");
+
+    //
+    // The divider in one compare match.
+    //
+    ulStart = xSysTickValueGet();
+    TimerInitConfig(TIMER0_BASE, TIMER_MODE_PERIODIC, 1000);
+    g_ulTimerPlanBenchTicks[0] = (ulStart - xSysTickValueGet()) & 0xFFFFFF;
+    TestAssert((TimerPrescaleGet(TIMER0_BASE) == 0) &&
+               (TimerMatchGet(TIMER0_BASE) == 12000),
+               "xtimer API \"TimerInitConfig\" error!");
+
+    //
+    // Over half the clock, the fastest tick, the mode bits are kept.
+    //
+    ulStart = xSysTickValueGet();
+    TimerInitConfig(TIMER0_BASE, TIMER_MODE_PERIODIC, 9000000);
+    g_ulTimerPlanBenchTicks[1] = (ulStart - xSysTickValueGet()) & 0xFFFFFF;
+    TestAssert((TimerPrescaleGet(TIMER0_BASE) == 0) &&
+               (TimerMatchGet(TIMER0_BASE) == 2),
+               "xtimer API \"TimerInitConfig\" error!");
+    ulTemp = xHWREG(TIMER0_BASE + TIMER_O_TCSR) & TIMER_TCSR_MODE_M;
+    TestAssert(ulTemp == TIMER_MODE_PERIODIC,
+               "xtimer API \"TimerInitConfig\" error!");
+
+    //
+    // No search, about the same time in both cases.
+    //
+    TestAssert(g_ulTimerPlanBenchTicks[1] < 2 * g_ulTimerPlanBenchTicks[0],
+               "xtimer API \"TimerInitConfig\" error!");
+
+    ulStart = xSysTickValueGet();
+    TimerPlanSolve(TimerClockGet(TIMER0_BASE), 3, &sPlan);
+    g_ulTimerPlanBenchTicks[2] = (ulStart - xSysTickValueGet()) & 0xFFFFFF;
+
+    //
+    // The plan is written without touching the mode.
+    //
+    TimerPlanApply(TIMER0_BASE, &sPlan);
+    TestAssert((TimerPrescaleGet(TIMER0_BASE) == sPlan.ulPrescale) &&
+               (TimerMatchGet(TIMER0_BASE) == sPlan.ulMatch),
+               "xtimer API \"TimerPlanApply\" error!");
+    ulTemp = xHWREG(TIMER0_BASE + TIMER_O_TCSR) & TIMER_TCSR_MODE_M;
+    TestAssert(ulTemp == TIMER_MODE_PERIODIC,
+               "xtimer API \"TimerPlanApply\" error!");
+
+    TimerPlanApply(TIMER0_BASE, &sPlanConst[4]);
+    TestAssert((TimerPrescaleGet(TIMER0_BASE) == 2) &&
+               (TimerMatchGet(TIMER0_BASE) == 16666667),
+               "xtimer API \"TimerPlanApply\" error!");
+}
+
+//*****************************************************************************
+//
+//! \brief xtimer 004 test execute main body.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void xTimer004Execute(void)
+{
+    xtimer_TimerPlanSolve_test();
+    xtimer_TimerPlanApply_test();
+}
+
+//
+// xtimer tick plan test case struct.
+//
+const tTestCase sTestxTimer004Plan = {
+    xTimer004GetTest,
+    xTimer004Setup,
+    xTimer004TearDown,
+    xTimer004Execute
+};
+
+//
+// xtimer test suits.
+//
+const tTestCase * const psPatternXtimer004[] =
+{
+    &sTestxTimer004Plan,
+    0
+};
@@ -204,7 +204,7 @@ __Vectors       DCD     __initial_sp              ; Top of Stack
                 DCD     SVC_Handler               ; SVCall Handler
                 DCD     0                         ; Reserved
                 DCD     0                         ; Reserved
-                DCD     PendSV_Handler            ; PendSV Handler
+                DCD     PendSVIntHandler          ; PendSV Handler
                 DCD     SysTick_Handler           ; SysTick Handler
 
                 ; External Interrupts
@@ -314,8 +314,8 @@ SVC_Handler     PROC
                 EXPORT  SVC_Handler               [WEAK]
                 B       .
                 ENDP
-PendSV_Handler  PROC
-                EXPORT  PendSV_Handler            [WEAK]
+PendSVIntHandler PROC
+                EXPORT  PendSVIntHandler          [WEAK]
                 B       .
                 ENDP
 SysTick_Handler PROC
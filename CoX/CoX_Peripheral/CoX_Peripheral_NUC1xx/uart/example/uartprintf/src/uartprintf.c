@@ -11,8 +11,25 @@
 #include "xhw_uart.h"
 #include "xuart.h"
 
+//
+// Tx ring the log is queued in, and the deferred log entries.
+//
+static unsigned char ucTxBuf[256];
+static unsigned char ucRxBuf[16];
+static tUARTLogEntry sLogBuf[16];
+
+//
+// The log is formatted here, at the lowest priority.
+//
+void PendSVIntHandler(void)
+{
+    UARTLogFlush();
+}
+
 void uartprinntf()
 {
+    unsigned long i;
+
   
     SysCtlKeyAddrUnlock();
     xHWREG(SYSCLK_PWRCON) |= (SYSCLK_PWRCON_XTL12M_EN | SYSCLK_PWRCON_OSC22M_EN);;
@@ -37,4 +54,19 @@ void uartprinntf()
     UARTEnable(UART0_BASE, (UART_BLOCK_UART | UART_BLOCK_TX | UART_BLOCK_RX));
 
     UARTBufferWrite(UART0_BASE, "NUC1xx.UART.BAUDRATE EXAMPLE \r\n", sizeof("NUC1xx.UART.BAUDRATE EXAMPLE \r\n")); 
+
+    //
+    // Deferred log: UARTLog() only stores the format and the arguments,
+    // PendSV formats them into the Tx ring, which the UART interrupt sends.
+    //
+    UARTRingBufferInit(UART0_BASE, ucTxBuf, sizeof(ucTxBuf), 
+                       ucRxBuf, sizeof(ucRxBuf));
+    UARTLogInit(UART0_BASE, sLogBuf, 16, UART_LOG_PENDSV);
+    xIntEnable(INT_UART02);
+    xIntMasterEnable();
+
+    for(i = 0; i < 10; i++)
+    {
+        UARTLog2("log %u: 0x%08x\r\n", i, i * 0x1111);
+    }
 }
@@ -16,7 +16,9 @@
 //! - \p Option-define: 
 //! <br>(1)None.<br><br>
 //! - \p Option-hardware: 
-//! <br>(1)Connect an USB cable to the development board.<br><br>
+//! <br>(1)Connect an USB cable to the development board.<br>
+//! <br>(2)Connect UART1 TX to UART1 RX for the DMA stream and framing
+//! tests.<br><br>
 //! - \p Option-OtherModule:         
 //! <br>None.<br>
 //! .
@@ -60,6 +62,18 @@ void xuart006Execute_ModemConfig(void);
 
 void xuart007Execute_DMAConfig(void);
 
+void xuart008Execute_RingBuffer(void);
+
+void xuart009Execute_DMAStream(void);
+
+void xuart010Execute_Frame(void);
+
+void xuart011Execute_BaudPlan(void);
+
+void xuart012Execute_RS485(void);
+
+void xuart013Execute_Log(void);
+
 
 
 #define countof(x) sizeof(x)/sizeof(*x)
@@ -138,6 +152,69 @@ unsigned long ulDMACfg[] = {UART_DMA_RX, UART_DMA_TX,
 
 #define  DMACfgNum       countof(ulDMACfg)
 
+//
+// Ring buffer test
+//
+unsigned char ucRingTxBuf[256];
+unsigned char ucRingRxBuf[16];
+#define  ringBurstNum     10
+#define  ringBurstLen     48
+
+//
+// DMA stream test
+//
+unsigned char ucStreamRxBuf0[32];
+unsigned char ucStreamRxBuf1[32];
+unsigned char ucStreamTxBuf[] = "xuart DMA stream\r\n";
+volatile unsigned long ulStreamEvents = 0;
+volatile unsigned long ulStreamTxCount = 0;
+
+//
+// Rx of the DMA stream, the Tx data is looped back from UART1 TX to UART1
+// RX: full buffers, bytes of the last partial buffer, bytes received, bytes
+// or buffers out of order, and the last buffer handed over.
+//
+volatile unsigned long ulStreamRxFull = 0;
+volatile unsigned long ulStreamRxPartial = 0;
+volatile unsigned long ulStreamRxCount = 0;
+volatile unsigned long ulStreamRxMismatch = 0;
+void *pvStreamRxLast = 0;
+
+//
+// Framing test, frames are looped back from UART1 TX to UART1 RX.
+//
+unsigned char ucFramePool[4][16];
+const unsigned char ucFramePayload[] = {0x11, 0x00, 0x22, 0xC0, 0xDB, 0x00};
+const unsigned char ucFrameCOBS[] = {0x02, 0x11, 0x04, 0x22, 0xC0, 0xDB,
+                                     0x01, 0x00};
+const unsigned char ucFrameSLIP[] = {0xC0, 0x11, 0x00, 0x22, 0xDB, 0xDC,
+                                     0xDB, 0xDD, 0x00, 0xC0};
+const unsigned char ucFrameSLIPBad[] = {0x11, 0xDB, 0x22, 0xC0};
+
+//
+// Baud plan test
+//
+const unsigned long ulPlanBaud[] = {9600, 19200, 38400, 57600, 115200};
+#define planNum          countof(ulPlanBaud)
+
+//
+// RS-485 test, the bus is left idle so requests get no response.
+//
+const unsigned char ucCRCData[] = "123456789";
+unsigned char uc485Request[] = {0x01, 0x03, 0x00, 0x00, 0x00, 0x01, 0, 0};
+unsigned char uc485Response[16];
+volatile unsigned long ul485CallbackStatus = 0;
+
+//
+// RS-485 transfers ended while the request was still being sent
+//
+volatile unsigned long ul485CallbackTxBusy = 0;
+
+//
+// Deferred log test
+//
+tUARTLogEntry sLogBuf[8];
+
 
 //*****************************************************************************
 //
@@ -927,6 +1004,915 @@ const tTestCase sTestxuart007DMA = {
     xuart007Execute
 };
 
+//*****************************************************************************
+//
+//
+//*****************************************************************************
+static char* xuart008GetTest(void)
+{
+    return "xuart [008]: xuart ring buffer test";
+}
+
+//*****************************************************************************
+//
+//
+//*****************************************************************************
+static void xuart008Setup(void)
+{
+    UARTIntCallbackInit(UART0_BASE, 0);
+    UARTRingBufferInit(UART0_BASE, ucRingTxBuf, sizeof(ucRingTxBuf), 
+                       ucRingRxBuf, sizeof(ucRingRxBuf));
+    xIntEnable(INT_UART02);
+    xIntMasterEnable();
+}
+
+//*****************************************************************************
+//
+//
+//*****************************************************************************
+static void xuart008TearDown(void)
+{
+    //
+    // Let the ring drain before the test frame prints by polling again.
+    //
+    while(UARTRingSpaceAvail(UART0_BASE) != sizeof(ucRingTxBuf));
+    while(!UARTFIFOTxIsEmpty(UART0_BASE));
+
+    UARTRingBufferDisable(UART0_BASE);
+    xIntDisable(INT_UART02);
+}
+
+void xuart008Execute_RingBuffer(void)
+{
+    unsigned char ucBurst[ringBurstLen];
+    unsigned char info[] = "\r\nPlease input(0123456789) : ";
+    unsigned long ulSent, ulTemp1;
+    int i, j;
+    
+    for(i=0; i<ringBurstLen; i++)
+    {
+        ucBurst[i] = (i == ringBurstLen - 1) ? '\n' : ('A' + (i % 26));
+    }
+
+    //
+    // A burst bigger than the Tx FIFO is queued without waiting.
+    //
+    ulTemp1 = UARTRingWrite(UART0_BASE, ucBurst, ringBurstLen);
+    TestAssert(ulTemp1 == ringBurstLen, 
+               "xuart API \"UARTRingWrite\" error!");
+    TestAssert(UARTRingSpaceAvail(UART0_BASE) != sizeof(ucRingTxBuf), 
+               "xuart API \"UARTRingSpaceAvail\" error!");
+
+    //
+    // Bursty producer: push faster than the line rate, retry the remainder
+    // whenever the ring is full, no byte may be lost.
+    //
+    for(j=0; j<ringBurstNum; j++)
+    {
+        ulSent = 0;
+        while(ulSent < ringBurstLen)
+        {
+            ulSent += UARTRingWrite(UART0_BASE, ucBurst + ulSent, 
+                                    ringBurstLen - ulSent);
+        }
+    }
+    while(UARTRingSpaceAvail(UART0_BASE) != sizeof(ucRingTxBuf));
+
+    //
+    // Receive through the Rx ring, input smaller than one FIFO threshold
+    // must be delivered by the Rx time out.
+    //
+    recNum = 0;
+    InitRecData();
+    UARTRingWrite(UART0_BASE, info, countof(info) - 1);
+    while(recNum < dataNum)
+    {
+        recNum += UARTRingRead(UART0_BASE, (unsigned char *)&recData[recNum], 
+                               dataNum - recNum);
+    }
+    TestAssert(UARTRingAvailable(UART0_BASE) == 0, 
+               "xuart API \"UARTRingAvailable\" error!");
+    TestAssert(UARTRingRxDroppedGet(UART0_BASE) == 0, 
+               "xuart API \"UARTRingRxDroppedGet\" error!");
+    for(i=0; i<dataNum; i++)
+    {
+        TestAssert(recData[i] == ('0' + i), 
+                    "xuart API \"UARTRingRead\" error!");      
+    }
+}
+
+//*****************************************************************************
+//
+//
+//*****************************************************************************
+static void xuart008Execute(void)
+{
+    //
+    // test for interrupt driven ring buffers
+    //
+    xuart008Execute_RingBuffer();
+}
+
+//
+// xuart ring buffer test case struct.
+//
+const tTestCase sTestxuart008Ring = {
+    xuart008GetTest,
+    xuart008Setup,
+    xuart008TearDown,
+    xuart008Execute
+};
+
+//*****************************************************************************
+//
+//
+//*****************************************************************************
+static char* xuart009GetTest(void)
+{
+    return "xuart [009]: xuart DMA stream test";
+}
+
+//*****************************************************************************
+//
+//
+//*****************************************************************************
+static void xuart009Setup(void)
+{
+    xSysCtlPeripheralReset(xSYSCTL_PERIPH_UART1);
+    xSysCtlPeripheralEnable(xSYSCTL_PERIPH_UART1);
+    xSysCtlPeripheralEnable(xSYSCTL_PERIPH_DMA);
+    UARTConfigSetExpClk(UART1_BASE, 115200, (UART_CONFIG_WLEN_8 | 
+                                             UART_CONFIG_STOP_ONE | 
+                                             UART_CONFIG_PAR_NONE));
+    UARTIntCallbackInit(UART1_BASE, 0);
+    xIntEnable(INT_PDMA);
+    xIntEnable(INT_UART1);
+    xIntMasterEnable();
+}
+
+//*****************************************************************************
+//
+//
+//*****************************************************************************
+static void xuart009TearDown(void)
+{
+    UARTDMAStreamStop(UART1_BASE);
+    xIntDisable(INT_UART1);
+    xIntDisable(INT_PDMA);
+}
+
+//*****************************************************************************
+//
+//
+//*****************************************************************************
+unsigned long uartStreamCallbackFunc(void *pvCBData, 
+                                     unsigned long ulEvent,
+                                     unsigned long ulMsgParam,
+                                     void *pvMsgData)
+{
+    unsigned char *pucData = (unsigned char *)pvMsgData;
+    unsigned long i;
+
+    ulStreamEvents |= ulEvent;
+    if(ulEvent == UART_DMA_EVENT_TX_DONE)
+    {
+        ulStreamTxCount += ulMsgParam;
+    }
+    else if((ulEvent == UART_DMA_EVENT_RX_FULL) ||
+            (ulEvent == UART_DMA_EVENT_RX_PARTIAL))
+    {
+        //
+        // The buffers must alternate, and hold the Tx data in order.
+        //
+        if(pvMsgData == pvStreamRxLast)
+        {
+            ulStreamRxMismatch++;
+        }
+        pvStreamRxLast = pvMsgData;
+        for(i=0; i<ulMsgParam; i++)
+        {
+            if(pucData[i] != 
+               ucStreamTxBuf[ulStreamRxCount % (sizeof(ucStreamTxBuf) - 1)])
+            {
+                ulStreamRxMismatch++;
+            }
+            ulStreamRxCount++;
+        }
+        if(ulEvent == UART_DMA_EVENT_RX_FULL)
+        {
+            ulStreamRxFull++;
+        }
+        else
+        {
+            ulStreamRxPartial = ulMsgParam;
+        }
+    }
+    return 0;
+}
+
+//*****************************************************************************
+//
+//! Waits about a few characters time at 115200 baud.
+//
+//*****************************************************************************
+static void 
+xuart009Delay(void)
+{
+    volatile unsigned long i;
+
+    for(i=0; i<20000; i++);
+}
+
+void xuart009Execute_DMAStream(void)
+{
+    xtBoolean bRet;
+    unsigned long ulTemp1;
+    int i;
+
+    ulStreamEvents = 0;
+    ulStreamTxCount = 0;
+    ulStreamRxFull = 0;
+    ulStreamRxPartial = 0;
+    ulStreamRxCount = 0;
+    ulStreamRxMismatch = 0;
+    pvStreamRxLast = 0;
+    bRet = UARTDMAStreamStart(UART1_BASE, ucStreamRxBuf0, ucStreamRxBuf1, 
+                              sizeof(ucStreamRxBuf0), uartStreamCallbackFunc);
+    TestAssert(bRet == xtrue, "xuart API \"UARTDMAStreamStart\" error!");
+
+    //
+    // Rx must be running on the PDMA, the Rx time out is not used.
+    //
+    ulTemp1 = xHWREG(UART1_BASE + UART_IER);
+    TestAssert((ulTemp1 & (UART_IER_DMA_RX_EN | UART_IER_RTO_IEN)) == 
+               UART_IER_DMA_RX_EN, 
+               "xuart API \"UARTDMAStreamStart\" error!");
+
+    //
+    // Send a few buffers, each one must be reported done.
+    //
+    for(i=0; i<4; i++)
+    {
+        bRet = UARTDMAStreamWrite(UART1_BASE, ucStreamTxBuf, 
+                                  sizeof(ucStreamTxBuf) - 1);
+        TestAssert(bRet == xtrue, "xuart API \"UARTDMAStreamWrite\" error!");
+        bRet = UARTDMAStreamWrite(UART1_BASE, ucStreamTxBuf, 
+                                  sizeof(ucStreamTxBuf) - 1);
+        TestAssert(bRet == xfalse, "xuart API \"UARTDMAStreamWrite\" error!");
+        while(UARTDMAStreamTxBusy(UART1_BASE));
+    }
+    TestAssert(ulStreamTxCount == 4 * (sizeof(ucStreamTxBuf) - 1), 
+               "xuart API \"UARTDMAStreamWrite\" error!");
+    TestAssert((ulStreamEvents & UART_DMA_EVENT_ERROR) == 0, 
+               "xuart API \"UARTDMAStreamWrite\" error!");
+
+    //
+    // Rx ping-pong: the 72 bytes looped back fill both buffers once, in
+    // turn, and leave 8 bytes in the first one.
+    //
+    for(i=0; (i<100) && (ulStreamRxFull < 2); i++)
+    {
+        xuart009Delay();
+    }
+    TestAssert(ulStreamRxFull == 2, 
+               "xuart API \"UARTDMAStreamStart\" error!");
+    TestAssert((ulStreamRxCount == 2 * sizeof(ucStreamRxBuf0)) &&
+               (pvStreamRxLast == ucStreamRxBuf1), 
+               "xuart API \"UARTDMAStreamStart\" error!");
+    TestAssert((ulStreamEvents & UART_DMA_EVENT_RX_PARTIAL) == 0, 
+               "xuart API \"UARTDMAStreamStart\" error!");
+
+    //
+    // The partial buffer is flushed by the poll once the count stops
+    // moving, not before.
+    //
+    bRet = xfalse;
+    for(i=0; (i<100) && (bRet == xfalse); i++)
+    {
+        xuart009Delay();
+        bRet = UARTDMAStreamPoll(UART1_BASE);
+    }
+    TestAssert(bRet == xtrue, "xuart API \"UARTDMAStreamPoll\" error!");
+    TestAssert((ulStreamRxPartial == 4 * (sizeof(ucStreamTxBuf) - 1) - 
+                2 * sizeof(ucStreamRxBuf0)) &&
+               (ulStreamRxCount == 4 * (sizeof(ucStreamTxBuf) - 1)) &&
+               (pvStreamRxLast == ucStreamRxBuf0), 
+               "xuart API \"UARTDMAStreamPoll\" error!");
+    TestAssert(ulStreamRxMismatch == 0, 
+               "xuart API \"UARTDMAStreamPoll\" error!");
+
+    //
+    // Nothing left, neither the poll nor the flush report an empty buffer.
+    //
+    ulStreamEvents = 0;
+    TestAssert(UARTDMAStreamPoll(UART1_BASE) == xfalse, 
+               "xuart API \"UARTDMAStreamPoll\" error!");
+    TestAssert(UARTDMAStreamPoll(UART1_BASE) == xfalse, 
+               "xuart API \"UARTDMAStreamPoll\" error!");
+    UARTDMAStreamFlush(UART1_BASE);
+    TestAssert((ulStreamEvents & UART_DMA_EVENT_RX_PARTIAL) == 0, 
+               "xuart API \"UARTDMAStreamFlush\" error!");
+
+    //
+    // The flush hands over a partial buffer at once.
+    //
+    bRet = UARTDMAStreamWrite(UART1_BASE, ucStreamTxBuf, 5);
+    TestAssert(bRet == xtrue, "xuart API \"UARTDMAStreamWrite\" error!");
+    while(UARTDMAStreamTxBusy(UART1_BASE));
+    xuart009Delay();
+    UARTDMAStreamFlush(UART1_BASE);
+    TestAssert((ulStreamEvents & UART_DMA_EVENT_RX_PARTIAL) && 
+               (ulStreamRxPartial == 5) && (pvStreamRxLast == ucStreamRxBuf1),
+               "xuart API \"UARTDMAStreamFlush\" error!");
+    TestAssert(ulStreamRxMismatch == 0, 
+               "xuart API \"UARTDMAStreamFlush\" error!");
+
+    //
+    // Stopping must release both channels.
+    //
+    UARTDMAStreamStop(UART1_BASE);
+    ulTemp1 = xHWREG(UART1_BASE + UART_IER);
+    TestAssert((ulTemp1 & (UART_IER_DMA_RX_EN | UART_IER_DMA_TX_EN)) == 0, 
+               "xuart API \"UARTDMAStreamStop\" error!");
+    bRet = UARTDMAStreamStart(UART1_BASE, ucStreamRxBuf0, ucStreamRxBuf1, 
+                              sizeof(ucStreamRxBuf0), uartStreamCallbackFunc);
+    TestAssert(bRet == xtrue, "xuart API \"UARTDMAStreamStop\" error!");
+    UARTDMAStreamStop(UART1_BASE);
+}
+
+//*****************************************************************************
+//
+//
+//*****************************************************************************
+static void xuart009Execute(void)
+{
+    //
+    // test for PDMA streaming
+    //
+    xuart009Execute_DMAStream();
+}
+
+//
+// xuart DMA stream test case struct.
+//
+const tTestCase sTestxuart009DMAStream = {
+    xuart009GetTest,
+    xuart009Setup,
+    xuart009TearDown,
+    xuart009Execute
+};
+
+//*****************************************************************************
+//
+//
+//*****************************************************************************
+static char* xuart010GetTest(void)
+{
+    return "xuart [010]: xuart framing test";
+}
+
+//*****************************************************************************
+//
+//
+//*****************************************************************************
+static void xuart010Setup(void)
+{
+    xSysCtlPeripheralReset(xSYSCTL_PERIPH_UART1);
+    xSysCtlPeripheralEnable(xSYSCTL_PERIPH_UART1);
+    UARTConfigSetExpClk(UART1_BASE, 115200, (UART_CONFIG_WLEN_8 | 
+                                             UART_CONFIG_STOP_ONE | 
+                                             UART_CONFIG_PAR_NONE));
+    UARTIntCallbackInit(UART1_BASE, 0);
+    xIntEnable(INT_UART1);
+    xIntMasterEnable();
+}
+
+//*****************************************************************************
+//
+//
+//*****************************************************************************
+static void xuart010TearDown(void)
+{
+    UARTFrameDisable(UART1_BASE);
+    xIntDisable(INT_UART1);
+}
+
+//*****************************************************************************
+//
+//! Sends raw bytes on UART1 and waits for a decoded frame.
+//
+//*****************************************************************************
+static unsigned long 
+xuart010FrameLoop(const unsigned char *pucData, unsigned long ulLength,
+                  unsigned char **ppucFrame)
+{
+    unsigned long i, ulFrameLen;
+
+    for(i=0; i<ulLength; i++)
+    {
+        UARTCharPut(UART1_BASE, pucData[i]);
+    }
+
+    //
+    // Wait for the Rx time out to deliver the frame tail.
+    //
+    for(i=0; i<100000; i++)
+    {
+        ulFrameLen = UARTFrameGet(UART1_BASE, ppucFrame);
+        if(ulFrameLen != 0)
+        {
+            return ulFrameLen;
+        }
+    }
+    return 0;
+}
+
+void xuart010Execute_Frame(void)
+{
+    unsigned char *pucFrame;
+    unsigned long ulFrameLen;
+    int i, j;
+
+    //
+    // COBS: zero bytes in the payload come back in place in the pool.
+    //
+    UARTFrameInit(UART1_BASE, UART_FRAME_COBS, &ucFramePool[0][0], 
+                  sizeof(ucFramePool[0]), 4, 0);
+    for(j=0; j<8; j++)
+    {
+        ulFrameLen = xuart010FrameLoop(ucFrameCOBS, sizeof(ucFrameCOBS), 
+                                       &pucFrame);
+        TestAssert(ulFrameLen == sizeof(ucFramePayload), 
+                   "xuart API \"UARTFrameGet\" error!");
+        TestAssert((pucFrame >= &ucFramePool[0][0]) && 
+                   (pucFrame <= &ucFramePool[3][0]), 
+                   "xuart API \"UARTFrameGet\" error!");
+        for(i=0; i<sizeof(ucFramePayload); i++)
+        {
+            TestAssert(pucFrame[i] == ucFramePayload[i], 
+                       "xuart API \"UARTFrameGet\" error!");
+        }
+        UARTFrameRelease(UART1_BASE, pucFrame);
+    }
+    TestAssert(UARTFrameErrorCountGet(UART1_BASE, 
+                                      UART_FRAME_ERROR_DECODE) == 0, 
+               "xuart API \"UARTFrameErrorCountGet\" error!");
+
+    //
+    // SLIP: escaped END and ESC are decoded, a bad escape drops the frame.
+    //
+    UARTFrameInit(UART1_BASE, UART_FRAME_SLIP, &ucFramePool[0][0], 
+                  sizeof(ucFramePool[0]), 4, 0);
+    ulFrameLen = xuart010FrameLoop(ucFrameSLIPBad, sizeof(ucFrameSLIPBad), 
+                                   &pucFrame);
+    TestAssert(ulFrameLen == 0, "xuart API \"UARTFrameGet\" error!");
+    TestAssert(UARTFrameErrorCountGet(UART1_BASE, 
+                                      UART_FRAME_ERROR_DECODE) == 1, 
+               "xuart API \"UARTFrameErrorCountGet\" error!");
+
+    ulFrameLen = xuart010FrameLoop(ucFrameSLIP, sizeof(ucFrameSLIP), 
+                                   &pucFrame);
+    TestAssert(ulFrameLen == sizeof(ucFramePayload), 
+               "xuart API \"UARTFrameGet\" error!");
+    for(i=0; i<sizeof(ucFramePayload); i++)
+    {
+        TestAssert(pucFrame[i] == ucFramePayload[i], 
+                   "xuart API \"UARTFrameGet\" error!");
+    }
+
+    //
+    // Frames held by the application exhaust the pool.
+    //
+    for(j=0; j<4; j++)
+    {
+        xuart010FrameLoop(ucFrameSLIP, sizeof(ucFrameSLIP), &pucFrame);
+    }
+    TestAssert(UARTFrameErrorCountGet(UART1_BASE, 
+                                      UART_FRAME_ERROR_NO_BUFFER) == 1, 
+               "xuart API \"UARTFrameErrorCountGet\" error!");
+}
+
+//*****************************************************************************
+//
+//
+//*****************************************************************************
+static void xuart010Execute(void)
+{
+    //
+    // test for SLIP and COBS framing
+    //
+    xuart010Execute_Frame();
+}
+
+//
+// xuart framing test case struct.
+//
+const tTestCase sTestxuart010Frame = {
+    xuart010GetTest,
+    xuart010Setup,
+    xuart010TearDown,
+    xuart010Execute
+};
+
+//*****************************************************************************
+//
+//
+//*****************************************************************************
+static char* xuart011GetTest(void)
+{
+    return "xuart [011]: xuart baud plan test";
+}
+
+//*****************************************************************************
+//
+//
+//*****************************************************************************
+static void xuart011Setup(void)
+{
+    xSysCtlPeripheralEnable(xSYSCTL_PERIPH_UART1);
+    UARTConfigSetExpClk(UART1_BASE, 115200, (UART_CONFIG_WLEN_8 | 
+                                             UART_CONFIG_STOP_ONE | 
+                                             UART_CONFIG_PAR_NONE));
+    xSysTickPeriodSet(0xFFFFFF);
+    xSysTickEnable();
+}
+
+//*****************************************************************************
+//
+//
+//*****************************************************************************
+static void xuart011TearDown(void)
+{
+    xSysTickDisable();
+}
+
+void xuart011Execute_BaudPlan(void)
+{
+    tUARTBaudPlan sPlan[planNum];
+    unsigned long ulLCR, ulStart, ulApplyTicks, ulConfigTicks;
+    xtBoolean bRet;
+    int i;
+
+    //
+    // Every standard rate must be reachable within 2 %.
+    //
+    for(i=0; i<planNum; i++)
+    {
+        bRet = UARTBaudPlanCompute(ulPlanBaud[i], &sPlan[i]);
+        TestAssert(bRet == xtrue, 
+                   "xuart API \"UARTBaudPlanCompute\" error!");
+        TestAssert((sPlan[i].lError < 200) && (sPlan[i].lError > -200), 
+                   "xuart API \"UARTBaudPlanCompute\" error!");
+    }
+
+    //
+    // Apply writes the baud register only.
+    //
+    ulLCR = xHWREG(UART1_BASE + UART_LCR);
+    for(i=0; i<planNum; i++)
+    {
+        UARTBaudPlanApply(UART1_BASE, &sPlan[i]);
+        TestAssert(xHWREG(UART1_BASE + UART_BAUD) == sPlan[i].ulBaudReg, 
+                   "xuart API \"UARTBaudPlanApply\" error!");
+        TestAssert(xHWREG(UART1_BASE + UART_LCR) == ulLCR, 
+                   "xuart API \"UARTBaudPlanApply\" error!");
+    }
+
+    //
+    // Switching with a plan must be cheaper than a full reconfiguration,
+    // which also reads the clock tree and searches the dividers.
+    //
+    ulStart = xSysTickValueGet();
+    UARTBaudPlanApply(UART1_BASE, &sPlan[0]);
+    ulApplyTicks = ulStart - xSysTickValueGet();
+
+    ulStart = xSysTickValueGet();
+    UARTConfigSetExpClk(UART1_BASE, ulPlanBaud[0], ulLCR);
+    ulConfigTicks = ulStart - xSysTickValueGet();
+
+    TestAssert(ulApplyTicks < ulConfigTicks, 
+               "xuart API \"UARTBaudPlanApply\" error!");
+    TestAssert(xHWREG(UART1_BASE + UART_BAUD) == sPlan[0].ulBaudReg, 
+               "xuart API \"UARTConfigSetExpClk\" error!");
+}
+
+//*****************************************************************************
+//
+//
+//*****************************************************************************
+static void xuart011Execute(void)
+{
+    //
+    // test for precomputed baud rate plans
+    //
+    xuart011Execute_BaudPlan();
+}
+
+//
+// xuart baud plan test case struct.
+//
+const tTestCase sTestxuart011BaudPlan = {
+    xuart011GetTest,
+    xuart011Setup,
+    xuart011TearDown,
+    xuart011Execute
+};
+
+//*****************************************************************************
+//
+//
+//*****************************************************************************
+static char* xuart012GetTest(void)
+{
+    return "xuart [012]: xuart RS-485 transfer test";
+}
+
+//*****************************************************************************
+//
+//
+//*****************************************************************************
+static void xuart012Setup(void)
+{
+    xSysCtlPeripheralEnable(xSYSCTL_PERIPH_UART1);
+    UART485Config(UART1_BASE, 9600, UART_LIN_BCNT_RS485_AUD, 
+                  (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | 
+                   UART_CONFIG_PAR_NONE));
+    UARTIntCallbackInit(UART1_BASE, 0);
+    xIntEnable(INT_UART1);
+    xIntMasterEnable();
+}
+
+//*****************************************************************************
+//
+//
+//*****************************************************************************
+static void xuart012TearDown(void)
+{
+    UART485XferDisable(UART1_BASE);
+    xIntDisable(INT_UART1);
+}
+
+//*****************************************************************************
+//
+//
+//*****************************************************************************
+unsigned long uart485CallbackFunc(void *pvCBData, 
+                                  unsigned long ulEvent,
+                                  unsigned long ulMsgParam,
+                                  void *pvMsgData)
+{
+    ul485CallbackStatus = ulEvent;
+    if(!(xHWREG(UART1_BASE + UART_FSR) & UART_FSR_TE_F))
+    {
+        ul485CallbackTxBusy++;
+    }
+    return 0;
+}
+
+void xuart012Execute_RS485(void)
+{
+    tUART485Xfer sXfer[2];
+    tUART485Stats sStats;
+    unsigned short usCRC;
+    int i;
+
+    //
+    // Modbus CRC-16 check value.
+    //
+    usCRC = UART485CRC16(ucCRCData, 9);
+    TestAssert(usCRC == 0x4B37, "xuart API \"UART485CRC16\" error!");
+
+    usCRC = UART485CRC16(uc485Request, 6);
+    uc485Request[6] = (unsigned char)usCRC;
+    uc485Request[7] = (unsigned char)(usCRC >> 8);
+    TestAssert(UART485CRC16(uc485Request, 8) == 0, 
+               "xuart API \"UART485CRC16\" error!");
+
+    //
+    // 8N1 gives a 35 bit gap.
+    //
+    UART485XferInit(UART1_BASE);
+    TestAssert(xHWREG(UART1_BASE + UART_TOR) == 35, 
+               "xuart API \"UART485XferInit\" error!");
+    TestAssert(xHWREG(UART1_BASE + UART_LIN_BCNT) & UART_LIN_BCNT_RS485_AUD, 
+               "xuart API \"UART485XferInit\" error!");
+
+    //
+    // A broadcast ends when the last character is out, the request queued
+    // behind it times out, counted from its own end.
+    //
+    for(i=0; i<2; i++)
+    {
+        sXfer[i].pucTxBuf = uc485Request;
+        sXfer[i].ulTxLen = sizeof(uc485Request);
+        sXfer[i].pucRxBuf = uc485Response;
+        sXfer[i].ulRxSize = sizeof(uc485Response);
+        sXfer[i].ulFlags = UART_485_XFER_CRC16;
+        sXfer[i].pfnCallback = uart485CallbackFunc;
+        sXfer[i].pvCBData = 0;
+    }
+    sXfer[0].ulTimeout = 0;
+    sXfer[1].ulTimeout = 5;
+    ul485CallbackStatus = UART_485_XFER_PENDING;
+    ul485CallbackTxBusy = 0;
+    UART485XferQueue(UART1_BASE, &sXfer[0]);
+    UART485XferQueue(UART1_BASE, &sXfer[1]);
+
+    while(sXfer[0].ulStatus == UART_485_XFER_PENDING)
+    {
+        UART485Tick(UART1_BASE);
+    }
+    TestAssert(sXfer[0].ulStatus == UART_485_XFER_DONE, 
+               "xuart API \"UART485XferQueue\" error!");
+
+    while(sXfer[1].ulStatus == UART_485_XFER_PENDING)
+    {
+        UART485Tick(UART1_BASE);
+    }
+    TestAssert(sXfer[1].ulStatus == UART_485_XFER_TIMEOUT, 
+               "xuart API \"UART485Tick\" error!");
+    TestAssert(ul485CallbackStatus == UART_485_XFER_TIMEOUT, 
+               "xuart API \"UART485XferQueue\" error!");
+    TestAssert(ul485CallbackTxBusy == 0, 
+               "xuart API \"UART485Tick\" error!");
+
+    UART485StatsGet(UART1_BASE, &sStats);
+    TestAssert((sStats.ulRequests == 2) && (sStats.ulTimeouts == 1) && 
+               (sStats.ulResponses == 0), 
+               "xuart API \"UART485StatsGet\" error!");
+    UART485StatsClear(UART1_BASE);
+    UART485StatsGet(UART1_BASE, &sStats);
+    TestAssert(sStats.ulRequests == 0, 
+               "xuart API \"UART485StatsClear\" error!");
+    UART485XferDisable(UART1_BASE);
+    TestAssert(!(xHWREG(UART1_BASE + UART_LIN_BCNT) & UART_LIN_BCNT_RS485_AUD),
+               "xuart API \"UART485XferDisable\" error!");
+}
+
+//*****************************************************************************
+//
+//
+//*****************************************************************************
+static void xuart012Execute(void)
+{
+    //
+    // test for the RS-485 transaction engine
+    //
+    xuart012Execute_RS485();
+}
+
+//
+// xuart RS-485 transfer test case struct.
+//
+const tTestCase sTestxuart012RS485 = {
+    xuart012GetTest,
+    xuart012Setup,
+    xuart012TearDown,
+    xuart012Execute
+};
+
+//*****************************************************************************
+//
+//
+//*****************************************************************************
+static char* xuart013GetTest(void)
+{
+    return "xuart [013]: xuart deferred log test";
+}
+
+//*****************************************************************************
+//
+//
+//*****************************************************************************
+static void xuart013Setup(void)
+{
+    UARTLogInit(UART0_BASE, sLogBuf, countof(sLogBuf), 0);
+}
+
+//*****************************************************************************
+//
+//
+//*****************************************************************************
+static void xuart013TearDown(void)
+{
+    UARTLogFlush();
+}
+
+//*****************************************************************************
+//
+//! Compares a formatted log line.
+//
+//*****************************************************************************
+static xtBoolean 
+xuart013FormatCheck(const char *pcFormat, unsigned long ulArg0, 
+                    unsigned long ulArg1, const char *pcExpect)
+{
+    char pcLine[UART_LOG_LINE_MAX];
+    unsigned long ulArgs[UART_LOG_ARGS] = {0};
+    unsigned long i;
+
+    ulArgs[0] = ulArg0;
+    ulArgs[1] = ulArg1;
+    UARTLogFormat(pcLine, sizeof(pcLine), pcFormat, ulArgs);
+    for(i=0; pcExpect[i] != 0; i++)
+    {
+        if(pcLine[i] != pcExpect[i])
+        {
+            return xfalse;
+        }
+    }
+    return (pcLine[i] == 0) ? xtrue : xfalse;
+}
+
+void xuart013Execute_Log(void)
+{
+    char pcLine[8];
+    unsigned long ulArgs[UART_LOG_ARGS] = {0};
+    int i;
+
+    //
+    // Formatter.
+    //
+    TestAssert(xuart013FormatCheck("%d %u", (unsigned long)-42, 42, 
+                                   "-42 42"), 
+               "xuart API \"UARTLogFormat\" error!");
+    TestAssert(xuart013FormatCheck("%04X:%x", 0xAB, 0x1f, "00AB:1f"), 
+               "xuart API \"UARTLogFormat\" error!");
+    TestAssert(xuart013FormatCheck("[%05d][%3u]", (unsigned long)-7, 5, 
+                                   "[-0007][  5]"), 
+               "xuart API \"UARTLogFormat\" error!");
+    TestAssert(xuart013FormatCheck("%s=%c%%", (unsigned long)"ab", 'z', 
+                                   "ab=z%"), 
+               "xuart API \"UARTLogFormat\" error!");
+    TestAssert(UARTLogFormat(pcLine, sizeof(pcLine), "0123456789", ulArgs) == 7, 
+               "xuart API \"UARTLogFormat\" error!");
+
+    //
+    // Entries are only stored until flushed, the ring drops the overflow.
+    //
+    for(i=0; i<countof(sLogBuf) + 2; i++)
+    {
+        UARTLog2("\r\nlog entry %d of %d", i, countof(sLogBuf) + 2);
+    }
+    TestAssert(UARTLogDroppedGet() == 2, 
+               "xuart API \"UARTLog\" error!");
+
+    UARTLogFlush();
+    UARTLog0("\r\nlog after flush");
+    TestAssert(UARTLogDroppedGet() == 2, 
+               "xuart API \"UARTLogFlush\" error!");
+    UARTLogFlush();
+
+    //
+    // A line longer than the whole Tx ring is queued in pieces, one per
+    // flush, and leaves the log. The log must then take a full ring.
+    //
+    UARTIntCallbackInit(UART0_BASE, 0);
+    UARTRingBufferInit(UART0_BASE, ucRingTxBuf, 16, 
+                       ucRingRxBuf, sizeof(ucRingRxBuf));
+    xIntEnable(INT_UART02);
+    xIntMasterEnable();
+    UARTLog0("\r\nlog line longer than the 16 byte Tx ring");
+    for(i=0; i<8; i++)
+    {
+        UARTLogFlush();
+        while(UARTRingSpaceAvail(UART0_BASE) != 16);
+    }
+    for(i=0; i<countof(sLogBuf); i++)
+    {
+        UARTLog0(".");
+    }
+    TestAssert(UARTLogDroppedGet() == 2, 
+               "xuart API \"UARTLogFlush\" error!");
+    UARTLogFlush();
+    while(UARTRingSpaceAvail(UART0_BASE) != 16);
+    while(!UARTFIFOTxIsEmpty(UART0_BASE));
+    UARTRingBufferDisable(UART0_BASE);
+    xIntDisable(INT_UART02);
+}
+
+//*****************************************************************************
+//
+//
+//*****************************************************************************
+static void xuart013Execute(void)
+{
+    //
+    // test for the deferred log
+    //
+    xuart013Execute_Log();
+}
+
+//
+// xuart deferred log test case struct.
+//
+const tTestCase sTestxuart013Log = {
+    xuart013GetTest,
+    xuart013Setup,
+    xuart013TearDown,
+    xuart013Execute
+};
+
 //
 // xuart test suits.
 //
@@ -939,6 +1925,12 @@ const tTestCase * const psPatternxUART[] =
     &sTestxuart005flowCtl,
     &sTestxuart006Modem,
     &sTestxuart007DMA,
+    &sTestxuart008Ring,
+    &sTestxuart009DMAStream,
+    &sTestxuart010Frame,
+    &sTestxuart011BaudPlan,
+    &sTestxuart012RS485,
+    &sTestxuart013Log,
     0
 };
 
@@ -46,6 +46,14 @@
 #include "hw_hd44780.h"
 #include "hd44780.h"
 
+#ifdef xGPIOBusWrite
+//
+// The data and strobe pins of the LCD as a GPIO parallel bus, on the
+// libraries that provide one
+//
+static xtGPIOBus g_sHD44780Bus;
+#endif
+
 //*****************************************************************************
 //
 //! \brief Write data or command to the HD44780.
@@ -67,6 +75,20 @@ HD44780Write(unsigned char ucRS, unsigned char ucInstruction)
     //
     xASSERT((ucRS == HD44780_RS_COMMAND) || (ucRS == HD44780_RS_DATA));
 
+#ifdef xGPIOBusWrite
+    //
+    // RS, RW:Write, the data and an E pulse, one bus cycle per byte or
+    // nibble
+    //
+#if (HD44780_INTERFACE_DATA_LEN == HD44780_INTERFACE_DATA_LEN_8)    
+    xGPIOBusWrite(&g_sHD44780Bus, ucRS, ucInstruction);
+#else
+#if (HD44780_INTERFACE_DATA_LEN == HD44780_INTERFACE_DATA_LEN_4)  
+    xGPIOBusWrite(&g_sHD44780Bus, ucRS, ucInstruction >> 4);
+    xGPIOBusWrite(&g_sHD44780Bus, ucRS, ucInstruction & 0x0F);
+#endif    
+#endif
+#else
     //
     // RS:Command, RW:Write, E:Enable
     //
@@ -110,6 +132,7 @@ HD44780Write(unsigned char ucRS, unsigned char ucInstruction)
     // E:Disable
     //
     xGPIOSPinWrite(HD44780_PIN_E, HD44780_E_DISABLE);
+#endif
 }
 
 //*****************************************************************************
@@ -135,6 +158,20 @@ HD44780Read(unsigned char ucRS)
     //
     xASSERT((ucRS == HD44780_RS_COMMAND) || (ucRS == HD44780_RS_DATA));
 
+#ifdef xGPIOBusWrite
+    //
+    // D7 - D0 as inputs, RS, RW:Read and an E pulse sampling the data, one
+    // bus cycle per byte or nibble
+    //
+#if (HD44780_INTERFACE_DATA_LEN == HD44780_INTERFACE_DATA_LEN_8)    
+    ucData = xGPIOBusRead(&g_sHD44780Bus, ucRS);
+#else
+#if (HD44780_INTERFACE_DATA_LEN == HD44780_INTERFACE_DATA_LEN_4) 
+    ucData = xGPIOBusRead(&g_sHD44780Bus, ucRS) << 4;
+    ucData |= xGPIOBusRead(&g_sHD44780Bus, ucRS);
+#endif    
+#endif    
+#else
     //
     // Set D7 - D0 direction to GPIO Input
     //
@@ -218,6 +255,7 @@ HD44780Read(unsigned char ucRS)
     xGPIOSPinTypeGPIOOutput(HD44780_PIN_D5);
     xGPIOSPinTypeGPIOOutput(HD44780_PIN_D4);    
 #endif    
+#endif
 #endif
     return ucData;
 }
@@ -312,6 +350,10 @@ HD44780ReadData(void)
 void 
 HD44780Init(void)
 {   
+#ifdef xGPIOBusWrite
+    unsigned long ulPins[8];
+#endif
+
     //
     // Enable GPIO Port that used
     //
@@ -337,6 +379,40 @@ HD44780Init(void)
     xSysCtlPeripheralEnable(xGPIOSPinToPeripheralId(HD44780_PIN_RS));
     xSysCtlPeripheralEnable(xGPIOSPinToPeripheralId(HD44780_PIN_RW)); 
      
+#ifdef xGPIOBusWrite
+    //
+    // The data pins make a bus, D0 or D4 first. The pins and the strobes
+    // are set to GPIO output, E disable.
+    //
+#if (HD44780_INTERFACE_DATA_LEN == HD44780_INTERFACE_DATA_LEN_8)        
+    ulPins[0] = xGPIOSPinToPin(HD44780_PIN_D0);
+    ulPins[1] = xGPIOSPinToPin(HD44780_PIN_D1);
+    ulPins[2] = xGPIOSPinToPin(HD44780_PIN_D2);
+    ulPins[3] = xGPIOSPinToPin(HD44780_PIN_D3);
+    ulPins[4] = xGPIOSPinToPin(HD44780_PIN_D4);
+    ulPins[5] = xGPIOSPinToPin(HD44780_PIN_D5);
+    ulPins[6] = xGPIOSPinToPin(HD44780_PIN_D6);
+    ulPins[7] = xGPIOSPinToPin(HD44780_PIN_D7);
+    xGPIOBusInit(&g_sHD44780Bus, xGPIOSPinToPort(HD44780_PIN_D0), ulPins, 8);
+#else
+#if (HD44780_INTERFACE_DATA_LEN == HD44780_INTERFACE_DATA_LEN_4)   
+    ulPins[0] = xGPIOSPinToPin(HD44780_PIN_D4);
+    ulPins[1] = xGPIOSPinToPin(HD44780_PIN_D5);
+    ulPins[2] = xGPIOSPinToPin(HD44780_PIN_D6);
+    ulPins[3] = xGPIOSPinToPin(HD44780_PIN_D7);
+    xGPIOBusInit(&g_sHD44780Bus, xGPIOSPinToPort(HD44780_PIN_D4), ulPins, 4);
+#endif    
+#endif 
+    
+    xGPIOBusStrobeSet(&g_sHD44780Bus,
+                      xGPIOSPinToPort(HD44780_PIN_RS),
+                      xGPIOSPinToPin(HD44780_PIN_RS),
+                      xGPIOSPinToPort(HD44780_PIN_RW),
+                      xGPIOSPinToPin(HD44780_PIN_RW),
+                      xGPIOSPinToPort(HD44780_PIN_E),
+                      xGPIOSPinToPin(HD44780_PIN_E));
+    xGPIOBusTimingSet(&g_sHD44780Bus, 10, 10);
+#else
     //
     // Set Pins Type to GPIO Output
     //
@@ -366,6 +442,7 @@ HD44780Init(void)
     // Output default value : E disable
     //
     xGPIOSPinWrite(HD44780_PIN_E, HD44780_E_DISABLE);
+#endif
 
     //
     // Set Entry Mode: Interface Data Length, Character Font, Display Line
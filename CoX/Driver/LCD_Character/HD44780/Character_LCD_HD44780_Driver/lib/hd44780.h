@@ -96,6 +96,10 @@ extern "C"
 //!
 //! \brief GPIO Pins Configurtions that communication with the LCD should be 
 //! set before using this driver.
+//!
+//! D7 - D0 (D7 - D4 with the 4 bits interface) are driven pin by pin. When
+//! the CoX library provides the GPIO parallel bus (xGPIOBusWrite) they are
+//! driven as a bus instead and must be pins of the same port, in any order.
 //!    
 //! @{
 //